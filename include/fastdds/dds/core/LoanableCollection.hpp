@@ -0,0 +1,217 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file LoanableCollection.hpp
+ */
+
+#ifndef _FASTDDS_DDS_CORE_LOANABLECOLLECTION_HPP_
+#define _FASTDDS_DDS_CORE_LOANABLECOLLECTION_HPP_
+
+#include <cstdint>
+
+namespace eprosima {
+namespace fastdds {
+namespace dds {
+
+//! Special value for max_samples on read / take operations, meaning as many samples as possible.
+constexpr int32_t LENGTH_UNLIMITED = -1;
+
+/**
+ * A collection of generic opaque pointers that can receive the buffer from outside (loan).
+ *
+ * This is an abstract class. See @ref LoanableSequence for details.
+ */
+class LoanableCollection
+{
+public:
+
+    using size_type = int32_t;
+    using element_type = void*;
+
+    /**
+     * Get the pointer to the elements buffer.
+     *
+     * The returned value may be nullptr if maximum() is 0.
+     * Otherwise it is guaranteed that up to maximum() elements can be accessed.
+     *
+     * @return the pointer to the elements buffer.
+     */
+    inline const element_type* buffer() const
+    {
+        return elements_;
+    }
+
+    /**
+     * Get the ownership flag.
+     *
+     * @return true if the collection owns the elements buffer, false if the buffer has been loaned to it.
+     */
+    inline bool has_ownership() const
+    {
+        return has_ownership_;
+    }
+
+    /**
+     * Get the maximum number of elements currently allocated.
+     *
+     * @return the maximum number of elements currently allocated.
+     */
+    inline size_type maximum() const
+    {
+        return maximum_;
+    }
+
+    /**
+     * Get the number of accessible elements.
+     *
+     * @return the number of accessible elements.
+     */
+    inline size_type length() const
+    {
+        return length_;
+    }
+
+    /**
+     * Set the number of accessible elements.
+     *
+     * When the collection owns its buffer, it will be enlarged if @c new_length is greater than maximum().
+     *
+     * @param [in] new_length New number of accessible elements.
+     *
+     * @return true if the new length was correctly set, false if a loaned buffer would need to be enlarged.
+     */
+    inline bool length(
+            size_type new_length)
+    {
+        if (new_length < 0)
+        {
+            return false;
+        }
+
+        if (new_length > maximum_)
+        {
+            if (!has_ownership_)
+            {
+                return false;
+            }
+
+            resize(new_length);
+        }
+
+        length_ = new_length;
+        return true;
+    }
+
+    /**
+     * Loan a buffer to the collection.
+     *
+     * @param [in] buffer       Pointer to the buffer of elements to loan.
+     * @param [in] new_maximum  Number of elements that can be accessed on the loaned buffer.
+     * @param [in] new_length   Number of accessible elements.
+     *
+     * @return false if the preconditions are not met, true if the buffer was loaned.
+     *
+     * @pre @c new_length <= @c new_maximum
+     * @pre The collection should not own any buffer, i.e. its maximum() should be 0 or it should be already loaned.
+     */
+    inline bool loan(
+            element_type* buffer,
+            size_type new_maximum,
+            size_type new_length)
+    {
+        if (new_length < 0 || new_length > new_maximum)
+        {
+            return false;
+        }
+
+        if (has_ownership_ && maximum_ > 0)
+        {
+            return false;
+        }
+
+        elements_ = buffer;
+        maximum_ = new_maximum;
+        length_ = new_length;
+        has_ownership_ = false;
+        return true;
+    }
+
+    /**
+     * Remove the loan from the collection.
+     *
+     * After a successful call, the collection will own an empty buffer.
+     *
+     * @param [out] maximum  Number of elements that could be accessed on the returned buffer.
+     * @param [out] length   Number of accessible elements on the returned buffer.
+     *
+     * @return nullptr if the collection had no loaned buffer, the returned buffer otherwise.
+     */
+    inline element_type* unloan(
+            size_type& maximum,
+            size_type& length)
+    {
+        if (has_ownership_)
+        {
+            return nullptr;
+        }
+
+        element_type* ret_val = elements_;
+        maximum = maximum_;
+        length = length_;
+
+        elements_ = nullptr;
+        maximum_ = 0;
+        length_ = 0;
+        has_ownership_ = true;
+        return ret_val;
+    }
+
+    /**
+     * Remove the loan from the collection.
+     *
+     * @return nullptr if the collection had no loaned buffer, the returned buffer otherwise.
+     */
+    inline element_type* unloan()
+    {
+        size_type maximum;
+        size_type length;
+        return unloan(maximum, length);
+    }
+
+protected:
+
+    virtual ~LoanableCollection() = default;
+
+    /**
+     * Enlarge the owned buffer so it can hold @c new_length elements.
+     *
+     * @param [in] new_length Number of elements the buffer should be able to hold.
+     *
+     * @post maximum() >= @c new_length
+     */
+    virtual void resize(
+            size_type new_length) = 0;
+
+    size_type maximum_ = 0u;
+    size_type length_ = 0u;
+    element_type* elements_ = nullptr;
+    bool has_ownership_ = true;
+};
+
+} // namespace dds
+} // namespace fastdds
+} // namespace eprosima
+
+#endif // _FASTDDS_DDS_CORE_LOANABLECOLLECTION_HPP_
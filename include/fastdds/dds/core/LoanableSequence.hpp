@@ -0,0 +1,169 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file LoanableSequence.hpp
+ */
+
+#ifndef _FASTDDS_DDS_CORE_LOANABLESEQUENCE_HPP_
+#define _FASTDDS_DDS_CORE_LOANABLESEQUENCE_HPP_
+
+#include <cassert>
+#include <stdexcept>
+#include <vector>
+
+#include <fastdds/dds/core/LoanableCollection.hpp>
+
+namespace eprosima {
+namespace fastdds {
+namespace dds {
+
+/**
+ * A type-safe, ordered collection of elements that can receive the buffer from outside (loan).
+ *
+ * When the sequence owns its buffer, elements are default constructed as the length grows, and
+ * destroyed with the sequence. When a buffer is loaned to it (e.g. by DataReader::take), the
+ * elements belong to the lender and should be returned to it (e.g. with DataReader::return_loan).
+ *
+ * @tparam T The type of elements stored on the sequence.
+ */
+template<typename T>
+class LoanableSequence : public LoanableCollection
+{
+public:
+
+    using size_type = LoanableCollection::size_type;
+    using element_type = LoanableCollection::element_type;
+
+    LoanableSequence() = default;
+
+    /**
+     * Pre-allocation constructor.
+     *
+     * @param [in] max Number of elements to pre-allocate.
+     */
+    explicit LoanableSequence(
+            size_type max)
+    {
+        if (max > 0)
+        {
+            resize(max);
+        }
+    }
+
+    ~LoanableSequence()
+    {
+        if (has_ownership_)
+        {
+            release();
+        }
+    }
+
+    // Copying a sequence that may hold a loan would leave two owners of the same elements
+    LoanableSequence(
+            const LoanableSequence&) = delete;
+
+    LoanableSequence& operator =(
+            const LoanableSequence&) = delete;
+
+    /**
+     * Get a reference to the element at a given index.
+     *
+     * @param [in] n Element index.
+     *
+     * @return a reference to the element at position @c n
+     */
+    T& operator [](
+            size_type n)
+    {
+        if (n >= length_)
+        {
+            throw std::out_of_range("Invalid index");
+        }
+
+        return *static_cast<T*>(elements_[n]);
+    }
+
+    /**
+     * Get a const reference to the element at a given index.
+     *
+     * @param [in] n Element index.
+     *
+     * @return a const reference to the element at position @c n
+     */
+    const T& operator [](
+            size_type n) const
+    {
+        if (n >= length_)
+        {
+            throw std::out_of_range("Invalid index");
+        }
+
+        return *static_cast<const T*>(elements_[n]);
+    }
+
+protected:
+
+    using LoanableCollection::maximum_;
+    using LoanableCollection::length_;
+    using LoanableCollection::elements_;
+    using LoanableCollection::has_ownership_;
+
+    void resize(
+            size_type maximum) override
+    {
+        assert(has_ownership_);
+
+        // Resize collection and get new pointer
+        data_.reserve(static_cast<size_t>(maximum));
+        data_.resize(static_cast<size_t>(maximum), nullptr);
+        elements_ = reinterpret_cast<element_type*>(data_.data());
+
+        // Allocate new values
+        for (size_type n = maximum_; n < maximum; ++n)
+        {
+            data_[n] = new T();
+        }
+
+        // Update maximum
+        maximum_ = maximum;
+    }
+
+private:
+
+    void release()
+    {
+        if (has_ownership_ && elements_ != nullptr)
+        {
+            for (T* item : data_)
+            {
+                delete item;
+            }
+            data_.clear();
+        }
+
+        maximum_ = 0u;
+        length_ = 0u;
+        elements_ = nullptr;
+        has_ownership_ = true;
+    }
+
+    std::vector<T*> data_;
+};
+
+} // namespace dds
+} // namespace fastdds
+} // namespace eprosima
+
+#endif // _FASTDDS_DDS_CORE_LOANABLESEQUENCE_HPP_
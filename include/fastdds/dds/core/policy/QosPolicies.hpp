@@ -1968,6 +1968,12 @@ public:
     //!PublishModeQosPolicyKind <br> By default, SYNCHRONOUS_PUBLISH_MODE.
     PublishModeQosPolicyKind kind;
 
+    /**
+     * Name of the flow controller of the participant used by an asynchronous writer.
+     * The flow controller should be registered on WireProtocolConfigQos::flow_controllers. <br> By default, empty.
+     */
+    std::string flow_controller_name;
+
     /**
      * @brief Constructor
      */
@@ -2582,6 +2588,7 @@ public:
                (this->builtin == b.builtin) &&
                (this->port == b.port) &&
                (this->throughput_controller == b.throughput_controller) &&
+               (this->flow_controllers == b.flow_controllers) &&
                (this->default_unicast_locator_list == b.default_unicast_locator_list) &&
                (this->default_multicast_locator_list == b.default_multicast_locator_list) &&
                QosPolicy::operator ==(b);
@@ -2608,6 +2615,9 @@ public:
     //!Throughput controller parameters. Leave default for uncontrolled flow.
     fastrtps::rtps::ThroughputControllerDescriptor throughput_controller;
 
+    //! Flow controllers the writers can reference by name on their PublishModeQosPolicy.
+    std::vector<fastrtps::rtps::FlowControllerDescriptor> flow_controllers;
+
     /**
      * Default list of Unicast Locators to be used for any Endpoint defined inside this RTPSParticipant in the case
      * that it was defined with NO UnicastLocators. At least ONE locator should be included in this list.
@@ -16,11 +16,14 @@
 #ifndef _FASTDDS_LOG_LOG_HPP_
 #define _FASTDDS_LOG_LOG_HPP_
 
-#include <fastrtps/utils/DBQueue.h>
+#include <fastrtps/utils/MPSCRingBuffer.hpp>
 #include <fastrtps/fastrtps_dll.h>
 #include <thread>
 #include <sstream>
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
 #include <regex>
 
 /**
@@ -32,9 +35,24 @@
  * * define LOG_NO_WARNING
  * * define LOG_NO_INFO
  *
+ * The same can be achieved by defining LOG_VERBOSITY_LIMIT to the highest level that should be compiled in
+ * (0 for Error, 1 for Warning, 2 for Info).
+ *
  * Additionally. the lowest level (Info) is disabled by default on release branches.
+ *
+ * Entries are pushed without locking to a bounded queue, and handed to the consumers by a background thread.
+ * When the queue is full, new entries are dropped and accounted on Log::GetDroppedEntries.
  */
 
+#if defined(LOG_VERBOSITY_LIMIT)
+#if (LOG_VERBOSITY_LIMIT < 2) && !defined(LOG_NO_INFO)
+#define LOG_NO_INFO
+#endif // if (LOG_VERBOSITY_LIMIT < 2) && !defined(LOG_NO_INFO)
+#if (LOG_VERBOSITY_LIMIT < 1) && !defined(LOG_NO_WARNING)
+#define LOG_NO_WARNING
+#endif // if (LOG_VERBOSITY_LIMIT < 1) && !defined(LOG_NO_WARNING)
+#endif // if defined(LOG_VERBOSITY_LIMIT)
+
 // Logging API:
 
 //! Logs an info message. Disable it through Log::SetVerbosity, define LOG_NO_INFO, or being in a release branch
@@ -122,6 +140,9 @@ public:
     //! Stops the logging thread. It will re-launch on the next call to a successful log macro.
     RTPS_DllAPI static void KillThread();
 
+    //! Returns the number of entries dropped because the log queue was full.
+    RTPS_DllAPI static uint64_t GetDroppedEntries();
+
     // Note: In VS2013, if you're linking this class statically, you will have to call KillThread before leaving
     // main, due to an unsolved MSVC bug.
 
@@ -152,20 +173,36 @@ public:
             const Log::Context&,
             Log::Kind);
 
+    RTPS_DllAPI static void QueueLog(
+            std::string&& message,
+            const Log::Context&,
+            Log::Kind);
+
 private:
 
+    // Entry waiting on the queue. Its timestamp is formatted by the logging thread.
+    struct QueuedEntry
+    {
+        Entry entry;
+        std::chrono::system_clock::time_point time;
+    };
+
     struct Resources
     {
-        fastrtps::DBQueue<Entry> logs;
+        fastrtps::MPSCRingBuffer<QueuedEntry> logs;
         std::vector<std::unique_ptr<LogConsumer> > consumers;
         std::unique_ptr<std::thread> logging_thread;
 
         // Condition variable segment.
         std::condition_variable cv;
         std::mutex cv_mutex;
-        bool logging;
-        bool work;
-        int current_loop;
+        std::atomic<bool> logging;
+        std::atomic<bool> sleeping;
+        // Number of entries popped from the queue and processed. Matches the queue position of the next entry.
+        uint64_t consumed;
+
+        // Queue counters.
+        std::atomic<uint64_t> dropped;
 
         // Context configuration.
         std::mutex config_mutex;
@@ -193,6 +230,7 @@ private:
     static void run();
 
     static void get_timestamp(
+            const std::chrono::system_clock::time_point&,
             std::string&);
 };
 
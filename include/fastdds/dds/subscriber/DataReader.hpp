@@ -26,6 +26,8 @@
 #include <fastdds/dds/core/status/StatusMask.hpp>
 #include <fastdds/dds/core/status/IncompatibleQosStatus.hpp>
 #include <fastdds/dds/core/Entity.hpp>
+#include <fastdds/dds/core/LoanableCollection.hpp>
+#include <fastdds/dds/subscriber/SampleInfo.hpp>
 #include <fastrtps/types/TypesBase.h>
 
 
@@ -122,12 +124,28 @@ public:
 
     ///@{
 
-    /* TODO
-       RTPS_DllAPI bool read(
-            std::vector<void*>& data_values,
-            std::vector<SampleInfo>& sample_infos,
-            uint32_t max_samples);
+    /**
+     * @brief This operation accesses a collection of Data values from the DataReader. The samples remain in the
+     * DataReader and can be read again, although they will be marked as READ.
+     *
+     * If @c data_values and @c sample_infos have no buffer (maximum() == 0) and own it, the middleware will loan
+     * buffers to both collections, which should be later returned with @ref return_loan.
+     * If they own a buffer with a maximum() greater than 0, up to maximum() samples will be copied into them.
+     *
+     * @param [in,out] data_values   A LoanableCollection object where the received data samples will be returned.
+     * @param [in,out] sample_infos  A SampleInfoSeq object where the received sample info will be returned.
+     * @param [in]     max_samples   The maximum number of samples to be returned. If the special value
+     *                               @ref LENGTH_UNLIMITED is provided, as many samples will be returned as are
+     *                               available, up to the limits described above.
+     *
+     * @return RETCODE_OK if some samples were returned, RETCODE_NO_DATA if there were no samples to return,
+     * RETCODE_PRECONDITION_NOT_MET if the collections do not fulfill the preconditions, RETCODE_NOT_ENABLED if
+     * the reader has not been enabled.
      */
+    RTPS_DllAPI ReturnCode_t read(
+            LoanableCollection& data_values,
+            SampleInfoSeq& sample_infos,
+            int32_t max_samples = LENGTH_UNLIMITED);
 
     /**
      * @brief This operation copies the next, non-previously accessed Data value from the DataReader; the operation also
@@ -149,12 +167,42 @@ public:
             void* data,
             SampleInfo* info);
 
-    /* TODO
-       RTPS_DllAPI bool take(
-            std::vector<void*>& data_values,
-            std::vector<SampleInfo>& sample_infos,
-            uint32_t max_samples);
+    /**
+     * @brief This operation accesses a collection of Data values from the DataReader and ‘removes’ them from the
+     * DataReader so they are no longer accessible.
+     *
+     * The same rules regarding the loan of buffers described for @ref read apply. When a buffer is loaned to
+     * @c data_values and the type is plain, the returned samples point directly into the received payloads, so no
+     * copy is performed. Those payloads are kept alive until the loan is returned with @ref return_loan.
+     *
+     * @param [in,out] data_values   A LoanableCollection object where the received data samples will be returned.
+     * @param [in,out] sample_infos  A SampleInfoSeq object where the received sample info will be returned.
+     * @param [in]     max_samples   The maximum number of samples to be returned.
+     *
+     * @return RETCODE_OK if some samples were returned, RETCODE_NO_DATA if there were no samples to return,
+     * RETCODE_PRECONDITION_NOT_MET if the collections do not fulfill the preconditions, RETCODE_NOT_ENABLED if
+     * the reader has not been enabled.
+     */
+    RTPS_DllAPI ReturnCode_t take(
+            LoanableCollection& data_values,
+            SampleInfoSeq& sample_infos,
+            int32_t max_samples = LENGTH_UNLIMITED);
+
+    /**
+     * @brief This operation indicates to the DataReader that the application is done accessing the collection of
+     * @c data_values and @c sample_infos obtained by some earlier invocation of @ref read or @ref take.
+     *
+     * After this call, both collections will own an empty buffer.
+     *
+     * @param [in,out] data_values   A LoanableCollection object previously loaned by this DataReader.
+     * @param [in,out] sample_infos  The SampleInfoSeq object loaned together with @c data_values.
+     *
+     * @return RETCODE_OK if the loan was returned, RETCODE_PRECONDITION_NOT_MET if the collections were not loaned
+     * by this DataReader, RETCODE_NOT_ENABLED if the reader has not been enabled.
      */
+    RTPS_DllAPI ReturnCode_t return_loan(
+            LoanableCollection& data_values,
+            SampleInfoSeq& sample_infos);
 
     /**
      * @brief This operation copies the next, non-previously accessed Data value from the DataReader and ‘removes’ it from
@@ -21,6 +21,7 @@
 #define _FASTRTPS_SAMPLEINFO_HPP_
 
 
+#include <fastdds/dds/core/LoanableSequence.hpp>
 #include <fastdds/rtps/common/Types.h>
 #include <fastdds/rtps/common/Time_t.h>
 #include <fastdds/rtps/common/InstanceHandle.h>
@@ -102,6 +103,9 @@ struct SampleInfo
 
 };
 
+//! A sequence of SampleInfo, as used by the read / take operations on DataReader
+using SampleInfoSeq = LoanableSequence<SampleInfo>;
+
 } /* namespace dds */
 } /* namespace fastdds */
 } /* namespace eprosima */
@@ -120,6 +120,28 @@ public:
             fastrtps::rtps::InstanceHandle_t* ihandle,
             bool force_md5 = false) = 0;
 
+    /**
+     * Checks if the type is plain, i.e. its in-memory representation is the same as its CDR serialized
+     * representation for the local endianness. Plain types can be loaned directly from the writer history.
+     * @return true if the type is plain.
+     */
+    RTPS_DllAPI virtual inline bool is_plain() const
+    {
+        return false;
+    }
+
+    /**
+     * Construct a sample on a memory location.
+     * @param memory Pointer to the memory location where the sample should be constructed.
+     * @return whether this type supports in-place construction or not.
+     */
+    RTPS_DllAPI virtual inline bool construct_sample(
+            void* memory) const
+    {
+        (void)memory;
+        return false;
+    }
+
     /**
      * Set topic data type name
      * @param nam Topic data type name
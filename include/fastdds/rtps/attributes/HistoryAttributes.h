@@ -53,12 +53,20 @@ class RTPS_DllAPI HistoryAttributes
          */
         int32_t maximumReservedCaches;
 
+        /**
+         * Whether payloads are reference counted, so changes received from an intraprocess writer with this option
+         * can point to the writer's payload instead of copying it. Default value is false. Publisher and subscriber
+         * histories enable it when property @c fastdds.shared_payloads is @c true.
+         */
+        bool sharedPayloads;
+
         //! Default constructor
         HistoryAttributes()
             : memoryPolicy(PREALLOCATED_MEMORY_MODE)
             , payloadMaxSize(500)
             , initialReservedCaches(500)
             , maximumReservedCaches(0)
+            , sharedPayloads(false)
         {}
 
         /** Constructor
@@ -78,6 +86,7 @@ class RTPS_DllAPI HistoryAttributes
             , payloadMaxSize(payload)
             , initialReservedCaches(initial)
             , maximumReservedCaches(maxRes)
+            , sharedPayloads(false)
         {}
 
         virtual ~HistoryAttributes(){}
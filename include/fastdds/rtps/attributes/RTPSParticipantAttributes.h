@@ -24,6 +24,7 @@
 #include <fastdds/rtps/common/PortParameters.h>
 #include <fastdds/rtps/attributes/PropertyPolicy.h>
 #include <fastdds/rtps/flowcontrol/ThroughputControllerDescriptor.h>
+#include <fastdds/rtps/flowcontrol/FlowControllerDescriptor.h>
 #include <fastdds/rtps/transport/TransportInterface.h>
 #include <fastdds/rtps/resources/ResourceManagement.h>
 #include <fastrtps/utils/fixed_size_string.hpp>
@@ -434,6 +435,9 @@ public:
     //!Throughput controller parameters. Leave default for uncontrolled flow.
     ThroughputControllerDescriptor throughputController;
 
+    //! Flow controllers the writers can reference by name.
+    std::vector<FlowControllerDescriptor> flow_controllers;
+
     //!User defined transports to use alongside or in place of builtins.
     std::vector<std::shared_ptr<fastdds::rtps::TransportDescriptorInterface> > userTransports;
 
@@ -27,6 +27,7 @@
 #include <fastrtps/qos/QosPolicies.h>
 
 #include <functional>
+#include <string>
 
 namespace eprosima {
 namespace fastrtps {
@@ -127,6 +128,9 @@ public:
     // Throughput controller, always the last one to apply
     ThroughputControllerDescriptor throughputController;
 
+    //! Name of the flow controller of the participant used by the writer. Empty when not using one.
+    std::string flow_controller_name;
+
     //! Disable the sending of heartbeat piggybacks.
     bool disable_heartbeat_piggyback;
 
@@ -337,8 +337,6 @@ public:
     //! Pointer to the RTPSParticipant.
     RTPSParticipantImpl* mp_RTPSParticipant;
 
-private:
-
     /**
      * Try to pair/unpair a local Reader against all possible writerProxy Data.
      * @param R Pointer to the Reader
@@ -362,6 +360,8 @@ private:
             const GUID_t& participant_guid,
             const WriterProxyData& wdata);
 
+private:
+
     bool checkDataRepresentationQos(
             const WriterProxyData* wdata,
             const ReaderProxyData* rdata) const;
@@ -53,6 +53,9 @@ class ReaderListener;
 class PDPListener;
 class PDPServerListener;
 
+template<class Proxy>
+class ProxyTopicIndex;
+
 
 /**
  * Abstract class PDP that implements the basic interfaces for all Participant Discovery implementations
@@ -284,6 +287,45 @@ public:
         return participant_proxies_.end();
     }
 
+    /**
+     * Keeps the collections returned by @ref reader_proxies_on_topic and @ref writer_proxies_on_topic valid while
+     * it lives, even when all the proxies on their topic are removed.
+     * The PDP mutex should be taken during its whole life.
+     */
+    class TopicIteration
+    {
+    public:
+
+        explicit TopicIteration(
+                const PDP& pdp);
+
+        ~TopicIteration();
+
+    private:
+
+        const PDP& pdp_;
+    };
+
+    /**
+     * Get the reader proxies (both local and remote) on a topic.
+     * The PDP mutex should be taken while the returned collection is used, and a @ref TopicIteration should live
+     * while it is iterated.
+     * @param topic_name Name of the topic.
+     * @return const reference to the collection of reader proxies on the topic.
+     */
+    const std::vector<ReaderProxyData*>& reader_proxies_on_topic(
+            const string_255& topic_name) const;
+
+    /**
+     * Get the writer proxies (both local and remote) on a topic.
+     * The PDP mutex should be taken while the returned collection is used, and a @ref TopicIteration should live
+     * while it is iterated.
+     * @param topic_name Name of the topic.
+     * @return const reference to the collection of writer proxies on the topic.
+     */
+    const std::vector<WriterProxyData*>& writer_proxies_on_topic(
+            const string_255& topic_name) const;
+
     /**
      * Assert the liveliness of a Remote Participant.
      * @param remote_guid GuidPrefix_t of the participant whose liveliness is being asserted.
@@ -332,6 +374,10 @@ protected:
     size_t writer_proxies_number_;
     //!Pool of writer proxy data objects ready for reuse
     ResourceLimitedVector<WriterProxyData*> writer_proxies_pool_;
+    //!Reader proxy data objects of the registered participants, by topic name
+    ProxyTopicIndex<ReaderProxyData>* reader_topic_index_;
+    //!Writer proxy data objects of the registered participants, by topic name
+    ProxyTopicIndex<WriterProxyData>* writer_topic_index_;
     //!Variable to indicate if any parameter has changed.
     std::atomic_bool m_hasChangedLocalPDP;
     //!Listener for the SPDP messages.
@@ -23,6 +23,8 @@
 #include <fastdds/rtps/common/Types.h>
 #include <fastdds/rtps/common/Guid.h>
 
+#include <functional>
+
 namespace eprosima {
 namespace fastrtps {
 namespace rtps {
@@ -240,4 +242,25 @@ inline std::ostream& operator <<(
 }
 }
 
+namespace std {
+template <>
+struct hash<eprosima::fastrtps::rtps::InstanceHandle_t>
+{
+    std::size_t operator ()(
+            const eprosima::fastrtps::rtps::InstanceHandle_t& k) const
+    {
+        // FNV-1a over the whole key, as short keys are not hashed and may only differ on a few octets
+        uint64_t hash = 14695981039346656037ull;
+        for (uint8_t i = 0; i < 16; ++i)
+        {
+            hash ^= k.value[i];
+            hash *= 1099511628211ull;
+        }
+        return static_cast<std::size_t>(hash);
+    }
+
+};
+
+} // namespace std
+
 #endif /* _FASTDDS_RTPS_INSTANCEHANDLE_H_ */
@@ -0,0 +1,86 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file FlowControllerDescriptor.h
+ */
+
+#ifndef _FASTDDS_RTPS_FLOW_CONTROLLER_DESCRIPTOR_H
+#define _FASTDDS_RTPS_FLOW_CONTROLLER_DESCRIPTOR_H
+
+#include <fastdds/rtps/common/Types.h>
+
+#include <cstdint>
+#include <string>
+
+namespace eprosima {
+namespace fastrtps {
+namespace rtps {
+
+/**
+ * Policy used by a flow controller to decide which of its writers sends next.
+ * @ingroup NETWORK_MODULE
+ */
+typedef enum FlowControllerSchedulerPolicy : octet
+{
+    //! Writers send in the order they have data available, each one until it has nothing left to send.
+    FIFO_SCHEDULER,
+    //! Writers take turns, sending a limited amount of data on each turn.
+    ROUND_ROBIN_SCHEDULER,
+    //! The writer with the highest priority sends first. Writers with the same priority take turns.
+    HIGH_PRIORITY_SCHEDULER
+} FlowControllerSchedulerPolicy;
+
+/**
+ * Descriptor of a flow controller registered on a participant.
+ *
+ * Writers reference the controller by name on their PublishModeQosPolicy, and should be asynchronous.
+ * The changes of all of them are sent by a thread of the controller, which shares the bandwidth between them with
+ * a token bucket: the bucket holds up to max_bytes_per_period bytes, and is refilled at a constant rate so it would
+ * be full again after period_ms milliseconds.
+ *
+ * The priority of a writer on a HIGH_PRIORITY_SCHEDULER is read from its property @c fastdds.sfc.priority.
+ * Lower values have higher priority. Writers without that property have priority 0.
+ * @ingroup NETWORK_MODULE
+ */
+struct FlowControllerDescriptor
+{
+    //! Name used by writers to reference the controller.
+    std::string name;
+
+    //! Policy used to decide which writer sends next.
+    FlowControllerSchedulerPolicy scheduler = FIFO_SCHEDULER;
+
+    //! Bytes the writers may send on each period. Zero means no limit.
+    uint32_t max_bytes_per_period = 0;
+
+    //! Milliseconds it takes to refill max_bytes_per_period bytes.
+    uint32_t period_ms = 100;
+
+    bool operator ==(
+            const FlowControllerDescriptor& b) const
+    {
+        return (this->name == b.name) &&
+               (this->scheduler == b.scheduler) &&
+               (this->max_bytes_per_period == b.max_bytes_per_period) &&
+               (this->period_ms == b.period_ms);
+    }
+
+};
+
+} // namespace rtps
+} // namespace fastrtps
+} // namespace eprosima
+
+#endif // _FASTDDS_RTPS_FLOW_CONTROLLER_DESCRIPTOR_H
@@ -0,0 +1,66 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file FlowControllerStatistics.h
+ */
+
+#ifndef _FASTDDS_RTPS_FLOW_CONTROLLER_STATISTICS_H
+#define _FASTDDS_RTPS_FLOW_CONTROLLER_STATISTICS_H
+
+#include <fastdds/rtps/common/Guid.h>
+
+#include <cstdint>
+
+namespace eprosima {
+namespace fastrtps {
+namespace rtps {
+
+/**
+ * Statistics of a writer attached to a flow controller.
+ * Sizes only account for the serialized payload of DATA and DATA_FRAG submessages.
+ * @ingroup NETWORK_MODULE
+ */
+struct FlowControllerWriterStatistics
+{
+    //! GUID of the writer.
+    GUID_t writer_guid;
+
+    //! Priority of the writer. Lower values have higher priority.
+    int32_t priority = 0;
+
+    //! Bytes the controller has allowed the writer to send.
+    uint64_t bytes_sent = 0;
+
+    //! Submessages the controller has allowed the writer to send.
+    uint64_t submessages_sent = 0;
+
+    //! Times a submessage had to wait for another turn of the writer.
+    uint64_t submessages_deferred = 0;
+
+    //! Bytes sent per second, measured on the last complete second.
+    uint64_t bytes_per_second = 0;
+
+    //! Bytes waiting to be sent at the end of the last turn of the writer.
+    uint64_t queued_bytes = 0;
+
+    //! Maximum value reached by queued_bytes.
+    uint64_t max_queued_bytes = 0;
+};
+
+} // namespace rtps
+} // namespace fastrtps
+} // namespace eprosima
+
+#endif // _FASTDDS_RTPS_FLOW_CONTROLLER_STATISTICS_H
@@ -101,6 +101,17 @@ public:
                        });
     }
 
+    /**
+     * Reserve a CacheChange_t from the CacheChange pool, filling it with the information of a received change.
+     * The payload pool decides whether the received payload is copied or shared.
+     * @param[out] change Pointer to pointer to the CacheChange_t to reserve
+     * @param[in] received Pointer to the received CacheChange_t.
+     * @return True is reserved
+     */
+    RTPS_DllAPI bool reserve_Cache(
+            CacheChange_t** change,
+            CacheChange_t* received);
+
     /**
      * release a previously reserved CacheChange_t.
      * @param ch Pointer to the CacheChange_t.
@@ -37,8 +37,31 @@ class IPayloadPool
 {
 public:
 
+    /**
+     * Kinds of payload owners whose payloads other pools can reference instead of copying.
+     */
+    enum class OwnerKind : uint8_t
+    {
+        //! Payloads should be copied.
+        OTHER,
+        //! Payloads are reference counted by a shared payload pool.
+        SHARED_POOL,
+        //! Payloads live on a reception buffer that can be kept alive.
+        RECEIVED_BUFFER
+    };
+
     virtual ~IPayloadPool() = default;
 
+    /**
+     * @brief Get the kind of this payload owner.
+     *
+     * It lets a pool receiving a payload check how it can be reused without any RTTI lookup.
+     */
+    OwnerKind owner_kind() const
+    {
+        return owner_kind_;
+    }
+
     /**
      * @brief Get a serialized payload for a new sample.
      *
@@ -120,6 +143,20 @@ public:
      */
     virtual bool release_payload(
             CacheChange_t& cache_change) = 0;
+
+protected:
+
+    IPayloadPool() = default;
+
+    explicit IPayloadPool(
+            OwnerKind owner_kind)
+        : owner_kind_(owner_kind)
+    {
+    }
+
+private:
+
+    OwnerKind owner_kind_ = OwnerKind::OTHER;
 };
 
 } /* namespace rtps */
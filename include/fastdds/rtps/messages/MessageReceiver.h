@@ -21,9 +21,11 @@
 #ifndef DOXYGEN_SHOULD_SKIP_THIS_PUBLIC
 
 #include <fastdds/rtps/common/all_common.h>
+#include <fastrtps/utils/SnapshotPtr.hpp>
 
+#include <memory>
 #include <unordered_map>
-#include <mutex>
+#include <vector>
 
 namespace eprosima {
 namespace fastrtps {
@@ -34,6 +36,7 @@ class Endpoint;
 class RTPSWriter;
 class RTPSReader;
 struct SubmessageHeader_t;
+class ReceivedBufferOwner;
 
 /**
  * Class MessageReceiver, process the received messages.
@@ -62,6 +65,18 @@ public:
             const Locator_t& loc,
             CDRMessage_t* msg);
 
+    /**
+     * Process a new CDR message whose buffer can be kept alive after processing.
+     * Readers may then keep the received payloads instead of copying them.
+     * @param[in] loc Locator indicating the sending address.
+     * @param[in] msg Pointer to the message
+     * @param[in] buffer Object keeping the message buffer alive.
+     */
+    void processCDRMsg(
+            const Locator_t& loc,
+            CDRMessage_t* msg,
+            const std::shared_ptr<void>& buffer);
+
     // Functions to associate/remove associatedendpoints
     void associateEndpoint(
             Endpoint* to_add);
@@ -70,9 +85,24 @@ public:
 
 private:
 
-    std::mutex mtx_;
-    std::vector<RTPSWriter*> associated_writers_;
-    std::unordered_map<EntityId_t, std::vector<RTPSReader*> > associated_readers_;
+    //! Endpoints associated with the receiver.
+    struct AssociatedEndpoints
+    {
+        std::vector<RTPSWriter*> writers;
+        std::unordered_map<EntityId_t, std::vector<RTPSReader*> > readers;
+        //! Builtin readers, which may accept messages from writers they are not matched with.
+        std::vector<RTPSReader*> builtin_readers;
+        //! User readers, checked when they are set to accept messages from writers they are not matched with.
+        std::vector<RTPSReader*> user_readers;
+    };
+
+    /**
+     * Associated endpoints. Each submessage is processed with a snapshot of them, so receiving does not wait for
+     * endpoints being associated, and removing an endpoint waits for the submessages being processed with it.
+     */
+    SnapshotPtr<AssociatedEndpoints> endpoints_;
+    //! Readers matched with the writer of the submessage being processed, when it is not directed to a reader.
+    std::vector<RTPSReader*> matched_readers_;
 
     RTPSParticipantImpl* participant_;
     //!Protocol version of the message
@@ -88,6 +118,9 @@ private:
     //!Timestamp associated with the message
     Time_t timestamp_;
 
+    //! Owner of the payloads pointing to the buffer of the message being processed.
+    std::unique_ptr<ReceivedBufferOwner> received_buffer_owner_;
+
 #if HAVE_SECURITY
     CDRMessage_t crypto_msg_;
     SerializedPayload_t crypto_payload_;
@@ -114,22 +147,42 @@ private:
             SubmessageHeader_t* smh);
 
     /**
-     * Find if there is a reader (in associated_readers_) that will accept a msg directed
+     * Find if there is a reader (in the associated endpoints) that will accept a msg directed
      * to the given entity ID.
+     * @param endpoints Associated endpoints.
+     * @param readerID ID of the reader the message is directed to. When unknown, only the builtin readers and
+     * the readers matched with the writer are considered.
+     * @param writerGUID GUID of the writer sending the message.
+     * @param[out] first_reader First reader that will accept the message.
      */
     bool willAReaderAcceptMsgDirectedTo(
+            const AssociatedEndpoints& endpoints,
             const EntityId_t& readerID,
+            const GUID_t& writerGUID,
             RTPSReader*& first_reader);
 
     /**
-     * Find all readers (in associated_readers_), with the given entity ID, and call the
+     * Find all readers (in the associated endpoints), with the given entity ID, and call the
      * callback provided.
+     * When the entity ID is unknown, the readers matched with the writer are taken from the index kept by the
+     * participant, and only the associated builtin readers, and the user readers accepting messages from unknown
+     * writers, are checked.
      */
     template<typename Functor>
     void findAllReaders(
+            const AssociatedEndpoints& endpoints,
             const EntityId_t& readerID,
+            const GUID_t& writerGUID,
             const Functor& callback);
 
+    /**
+     * Fill matched_readers_ with the associated user readers that accept messages directed to an unknown reader,
+     * and either are matched with a writer or accept messages from unknown writers.
+     */
+    void find_matched_readers(
+            const AssociatedEndpoints& endpoints,
+            const GUID_t& writerGUID);
+
     /**@name Processing methods.
      * These methods are designed to read a part of the message
      * and perform the corresponding actions:
@@ -194,6 +194,15 @@ private:
 
     void reset_to_header();
 
+    /**
+     * Chooses the buffer where the message is serialized. Should only be called when the message is empty.
+     * @param pending_size Size of the submessage that will be added first to the message.
+     */
+    void select_full_msg(
+            uint32_t pending_size);
+
+    void return_shm_loan();
+
     void flush();
 
     void send();
@@ -251,6 +260,11 @@ private:
     std::chrono::steady_clock::time_point max_blocking_time_point_;
 
     std::unique_ptr<RTPSMessageGroup_t> send_buffer_;
+
+    //! Buffer on a shared-memory segment, where messages only sent to shared-memory locators are serialized.
+    struct SharedMemLoan;
+
+    std::unique_ptr<SharedMemLoan> shm_loan_;
 };
 
 } /* namespace rtps */
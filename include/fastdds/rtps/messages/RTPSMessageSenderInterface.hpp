@@ -71,6 +71,20 @@ class RTPSMessageSenderInterface
          */
         virtual const std::vector<GUID_t>& remote_guids() const = 0;
 
+        /**
+         * Check if all the locators messages are sent to are of the same kind.
+         *
+         * @param kind Locator kind to check.
+         *
+         * @return true if there is at least one destination locator, and all of them are of the given kind.
+         */
+        virtual bool destinations_are_of_kind(
+                int32_t kind) const
+        {
+            (void)kind;
+            return false;
+        }
+
         /**
          * Send a message through this interface.
          *
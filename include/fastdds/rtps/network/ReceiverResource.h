@@ -50,6 +50,18 @@ public:
     virtual void OnDataReceived(const octet* data, const uint32_t size,
         const Locator_t& localLocator, const Locator_t& remoteLocator) override;
 
+    /**
+    * Method called by the transport when receiving data on a buffer that can be kept alive after the call.
+    * @param data Pointer to the received data.
+    * @param size Number of bytes received.
+    * @param localLocator Locator identifying the local endpoint.
+    * @param remoteLocator Locator identifying the remote endpoint.
+    * @param buffer Object keeping the received data alive while it is referenced.
+    */
+    virtual void OnDataReceived(const octet* data, const uint32_t size,
+        const Locator_t& localLocator, const Locator_t& remoteLocator,
+        const std::shared_ptr<void>& buffer) override;
+
     /**
      * Reports whether this resource supports the given local locator (i.e., said locator
      * maps to the transport channel managed by this resource).
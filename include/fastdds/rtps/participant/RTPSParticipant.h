@@ -21,8 +21,11 @@
 
 #include <cstdlib>
 #include <memory>
+#include <string>
+#include <vector>
 #include <fastrtps/fastrtps_dll.h>
 #include <fastdds/rtps/common/Guid.h>
+#include <fastdds/rtps/flowcontrol/FlowControllerStatistics.h>
 #include <fastdds/rtps/reader/StatefulReader.h>
 #include <fastdds/rtps/attributes/RTPSParticipantAttributes.h>
 #include <fastrtps/qos/ReaderQos.h>
@@ -233,6 +236,16 @@ public:
      */
     uint32_t get_domain_id() const;
 
+    /**
+     * @brief Retrieves the statistics of the writers attached to a flow controller.
+     * @param flow_controller_name Name of the flow controller.
+     * @param [out] statistics Where the statistics of each writer are appended to.
+     * @return false if there is no flow controller with that name.
+     */
+    bool get_flow_controller_statistics(
+            const std::string& flow_controller_name,
+            std::vector<FlowControllerWriterStatistics>& statistics) const;
+
     /**
      * @brief This operation enables the RTPSParticipantImpl
      */
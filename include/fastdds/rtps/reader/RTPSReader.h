@@ -38,6 +38,7 @@ class ReaderListener;
 class WriterProxy;
 struct CacheChange_t;
 struct ReaderHistoryState;
+class FragmentAssembler;
 class WriterProxyData;
 
 /**
@@ -299,24 +300,6 @@ protected:
             const GUID_t& persistence_guid,
             const SequenceNumber_t& seq);
 
-    /*!
-     * @brief Search if there is a CacheChange_t, giving SequenceNumber_t and writer GUID_t,
-     * waiting to be completed because it is fragmented.
-     * @param sequence_number SequenceNumber_t of the searched CacheChange_t.
-     * @param writer_guid writer GUID_t of the searched CacheChange_t.
-     * @param change If a CacheChange_t was found, this argument will fill with its pointer.
-     * In other case nullptr is returned.
-     * @param hint Iterator since the search will start.
-     * Used to improve the search.
-     * @return Iterator pointing to the position were CacheChange_t was found.
-     * It can be used to improve next search.
-     */
-    History::const_iterator findCacheInFragmentedProcess(
-            const SequenceNumber_t& sequence_number,
-            const GUID_t& writer_guid,
-            CacheChange_t** change,
-            History::const_iterator hint) const;
-
     //!ReaderHistory
     ReaderHistory* mp_history;
     //!Listener
@@ -333,6 +316,9 @@ protected:
     //!ReaderHistoryState
     ReaderHistoryState* history_state_;
 
+    //! Reassembles the samples received on DATA_FRAG submessages
+    FragmentAssembler* fragment_assembler_;
+
     uint64_t total_unread_ = 0;
 
     TimedConditionVariable new_notification_cv_;
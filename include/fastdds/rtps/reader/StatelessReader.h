@@ -195,7 +195,6 @@ private:
         GUID_t guid;
         GUID_t persistence_guid;
         bool has_manual_topic_liveliness = false;
-        CacheChange_t* fragmented_change = nullptr;
     };
 
     bool acceptMsgFrom(
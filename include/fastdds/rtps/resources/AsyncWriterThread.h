@@ -22,6 +22,9 @@
 #include <thread>
 #include <atomic>
 #include <list>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 #include <fastdds/rtps/resources/AsyncInterestTree.h>
 #include <fastrtps/utils/TimedMutex.hpp>
@@ -31,40 +34,73 @@ namespace eprosima {
 namespace fastrtps {
 namespace rtps {
 
+class PropertyPolicy;
 class RTPSWriter;
 
 /**
- * @brief This static class owns a thread that manages asynchronous writes.
+ * @brief This class owns the threads that manage asynchronous writes.
  * Asynchronous writes happen directly (when using an async writer) and
  * indirectly (when responding to a NACK).
+ *
+ * Each writer is attached to one of the threads, so a writer which takes long to send its data only delays the
+ * writers sharing its thread. Threads are started the first time one of their writers has something to send, and
+ * live until this object is destroyed.
+ *
+ * The threads are configured with the following properties of the participant:
+ * - @c fastdds.async_writer.threads: number of threads. Default is 1.
+ * - @c fastdds.async_writer.cpu_affinity: comma separated list of CPUs. Thread @c i is pinned to the CPU on
+ *   position <tt>i % size</tt> of the list. Only supported on Linux.
+ * - @c fastdds.async_writer.priority: real-time priority of the threads, using the SCHED_FIFO policy.
+ *   Zero keeps the default scheduling. Only supported on POSIX systems.
+ *
+ * Writers are attached to the thread with fewer writers, unless they have the property
+ * @c fastdds.async_writer.thread with the index of the thread to use.
  * @ingroup COMMON_MODULE
  */
 class AsyncWriterThread
 {
 public:
 
-    AsyncWriterThread() = default;
+    //! Construct with a single thread.
+    AsyncWriterThread();
+
+    /*!
+     * Construct with the configuration read from the properties of a participant.
+     * @param properties Properties of the participant.
+     */
+    explicit AsyncWriterThread(
+        const PropertyPolicy& properties);
 
     ~AsyncWriterThread();
 
+    /*!
+     * @brief Attach a writer to one of the threads.
+     * @param writer Asynchronous writer to be attached.
+     * @param properties Properties of the writer, where an explicit thread may be selected.
+     * @note Always call this function from writer's constructor, before waking up any thread for it.
+     */
+    void register_writer(
+        RTPSWriter* writer,
+        const PropertyPolicy& properties);
+
     /*!
      * @brief Unregister a writer if it is waiting to be processed.
+     * When the function returns, the writer is not being processed by its thread.
      * @param writer Asynchronous writer to be removed.
-     * @return Result of the operation.
      * @note Always call this function from writer's destructor.
      */
     void unregister_writer(
         RTPSWriter* writer);
 
     /*!
-     * Wakes the thread up and starts processing async writers.
+     * Wakes the thread of a writer up and starts processing its async writers.
      * @param interested_writer The writer interested in an async write.
      */
     void wake_up(
         RTPSWriter* interested_writer);
 
     /*!
-     * Wakes the thread up and starts processing async writers.
+     * Wakes the thread of a writer up and starts processing its async writers.
      * @param interested_writer The writer interested in an async write.
      * @param max_blocking_time Time point until the function must be blocked.
      * @note This method is blocked for a period of time.
@@ -73,23 +109,62 @@ public:
         RTPSWriter* interested_writer,
         const std::chrono::time_point<std::chrono::steady_clock>& max_blocking_time);
 
+    //! Number of threads writers are distributed on.
+    size_t thread_count() const
+    {
+        return workers_.size();
+    }
+
 private:
 
     AsyncWriterThread(const AsyncWriterThread&) = delete;
     const AsyncWriterThread& operator=(const AsyncWriterThread&) = delete;
 
+    //! A thread and the writers waiting to be processed by it.
+    struct Worker
+    {
+        uint32_t index = 0;
+
+        std::thread* thread_ = nullptr;
+        RecursiveTimedMutex condition_variable_mutex_;
+
+        //! List of asynchronous writers.
+        AsyncInterestTree interestTree_;
+
+        //! Number of writers attached to the thread. Must be accessed after lock writers_mutex_.
+        uint32_t writer_count_ = 0;
+
+        bool running_ = false;
+        bool run_scheduled_ = false;
+        TimedConditionVariable cv_;
+    };
+
+    void create_workers(
+        uint32_t thread_count);
+
+    Worker& worker_of(
+        const RTPSWriter* writer);
+
+    //! Starts the thread of a worker if it is not running. The mutex of the worker should be taken.
+    void start_nts(
+        Worker& worker);
+
+    //! Applies the CPU affinity and priority to the calling thread.
+    void configure_current_thread(
+        const Worker& worker) const;
+
     //! @brief runs main method
-    void run();
+    void run(
+        Worker& worker);
+
+    std::vector<std::unique_ptr<Worker>> workers_;
 
-    std::thread* thread_ = nullptr;
-    RecursiveTimedMutex condition_variable_mutex_;
+    //! Protects the number of writers of the workers.
+    std::mutex writers_mutex_;
 
-    //! List of asynchronous writers.
-    AsyncInterestTree interestTree_;
+    std::vector<uint32_t> cpu_affinity_;
 
-    bool running_ = false;
-    bool run_scheduled_ = false;
-    TimedConditionVariable cv_;
+    int32_t priority_ = 0;
 };
 
 } // namespace rtps
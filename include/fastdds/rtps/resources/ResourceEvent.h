@@ -27,6 +27,7 @@
 
 #include <thread>
 #include <atomic>
+#include <memory>
 #include <vector>
 
 namespace eprosima {
@@ -34,6 +35,8 @@ namespace fastrtps {
 namespace rtps {
 
 class TimedEventImpl;
+class TimerWheel;
+struct TimerWheelEntry;
 
 /**
  * This class centralizes all operations over timed events in the same thread.
@@ -43,7 +46,7 @@ class ResourceEvent
 {
 public:
 
-    ResourceEvent() = default;
+    ResourceEvent();
 
     ~ResourceEvent();
 
@@ -117,8 +120,11 @@ private:
     //! Collection of events pending update action.
     std::vector<TimedEventImpl*> pending_timers_;
 
-    //! Collection of registered events waiting completion.
-    std::vector<TimedEventImpl*> active_timers_;
+    //! Registered events waiting completion.
+    std::unique_ptr<TimerWheel> active_timers_;
+
+    //! Events whose trigger time has been reached on the current iteration.
+    std::vector<TimerWheelEntry*> expired_timers_;
 
     //! Current time as seen by the execution thread.
     std::chrono::steady_clock::time_point current_time_;
@@ -138,9 +144,6 @@ private:
     //! Method called by the internal thread.
     void event_service();
 
-    //! Sorts waiting timers in ascending order of trigger time.
-    void sort_timers();
-
     //! Updates internal register of current time.
     void update_current_time();
 
@@ -151,7 +154,7 @@ private:
     void resize_collections()
     {
         pending_timers_.reserve(timers_count_);
-        active_timers_.reserve(timers_count_);
+        expired_timers_.reserve(timers_count_);
     }
 
 };
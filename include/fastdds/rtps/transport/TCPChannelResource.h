@@ -23,11 +23,14 @@
 
 #include <asio.hpp>
 
+#include <functional>
+
 namespace eprosima {
 namespace fastdds {
 namespace rtps {
 
 class TCPConnector;
+class TCPFramingBuffer;
 class TCPTransportInterface;
 
 enum eSocketErrorCodes
@@ -71,8 +74,14 @@ protected:
     std::vector<uint16_t> pending_logical_output_ports_; // Must be accessed after lock pending_logical_mutex_
     std::vector<uint16_t> logical_output_ports_;
     std::mutex read_mutex_;
+    //! Serializes the writes on the socket, so messages sent from several threads do not interleave.
+    std::mutex send_mutex_;
     std::recursive_mutex pending_logical_mutex_;
     std::atomic<eConnectionStatus> connection_status_;
+    //! Whether the RTPS messages of the connection are checksummed with CRC-32C, as agreed on the bind.
+    std::atomic<bool> crc32c_;
+    //! Buffer of the asynchronous reads of the current connection. Must be accessed after lock read_mutex_
+    std::shared_ptr<TCPFramingBuffer> framing_buffer_;
 
 public:
 
@@ -109,6 +118,11 @@ public:
         return locator_;
     }
 
+    bool crc32c() const
+    {
+        return crc32c_;
+    }
+
     ResponseCode process_bind_request(
             const fastrtps::rtps::Locator_t& locator);
 
@@ -123,6 +137,27 @@ public:
             std::size_t size,
             asio::error_code& ec) = 0;
 
+    /**
+     * Starts reading the bytes available on the socket, up to @c size, without blocking the calling thread.
+     * The handler is called from a thread of the io_service of the transport.
+     * @return false when the channel only supports blocking reads.
+     */
+    virtual bool async_read_some(
+            fastrtps::rtps::octet*,
+            std::size_t,
+            const std::function<void(const asio::error_code&, std::size_t)>&)
+    {
+        return false;
+    }
+
+    /**
+     * Writes a message on the socket. Messages are written one at a time.
+     * When non_blocking_send is enabled, RTPS messages, which are passed with a separate TCP header, are discarded
+     * when they do not fit on the send buffer of the socket, and @c ec is set to asio::error::would_block.
+     * RTCP control messages, which are passed with their header already serialized on @c buffer, are always
+     * written: losing a bind, open logical port or keep alive message would stall the connection.
+     * @return Number of bytes written, including the header.
+     */
     virtual size_t send(
             const fastrtps::rtps::octet* header,
             size_t header_size,
@@ -53,6 +53,11 @@ public:
         std::size_t size,
         asio::error_code& ec) override;
 
+    bool async_read_some(
+        fastrtps::rtps::octet* buffer,
+        std::size_t size,
+        const std::function<void(const asio::error_code&, std::size_t)>& handler) override;
+
     size_t send(
         const fastrtps::rtps::octet* header,
         size_t header_size,
@@ -159,10 +159,29 @@ typedef struct TCPTransportDescriptor : public SocketTransportDescriptor
     uint16_t logical_port_range;
     uint16_t logical_port_increment;
     uint32_t tcp_negotiation_timeout;
+    /**
+     * Number of threads receiving from all the connections of the transport. Each thread waits on the sockets
+     * with data available and reads all the messages queued on them with a single call.
+     * When set to 0, every connection has its own thread blocked on the socket.
+     * Connections using TLS always have their own thread.
+     */
+    uint32_t reactor_threads;
     bool enable_tcp_nodelay;
+    /**
+     * When set to true, messages which do not fit on the send buffer of the socket are discarded, instead of
+     * blocking the sending thread until the peer reads enough data. A slow peer then loses messages, which are
+     * repaired by reliable writers, instead of delaying the messages sent to the rest of the peers.
+     * RTCP control messages are never discarded.
+     */
+    bool non_blocking_send;
     bool wait_for_tcp_negotiation;
     bool calculate_crc;
     bool check_crc;
+    /**
+     * When set to true, CRC-32C is offered on the bind of each connection, and used as the checksum of its
+     * RTPS messages when the peer supports it. Otherwise, or with older peers, the additive checksum is used.
+     */
+    bool use_crc32c;
     bool apply_security;
 
     TLSConfig tls_config;
@@ -40,6 +40,7 @@ namespace rtps{
 
 class RTCPMessageManager;
 class TCPChannelResource;
+class TCPFramingBuffer;
 
 /**
  * This is a default TCP Interface implementation.
@@ -76,7 +77,8 @@ protected:
 #if TLS_FOUND
     asio::ssl::context ssl_context_;
 #endif
-    std::shared_ptr<std::thread> io_service_thread_;
+    //! Threads running io_service_. More than one when the connections are read by reactor threads.
+    std::vector<std::shared_ptr<std::thread>> io_service_threads_;
     std::shared_ptr<std::thread> io_service_timers_thread_;
     std::shared_ptr<RTCPMessageManager> rtcp_message_manager_;
     std::mutex rtcp_message_manager_mutex_;
@@ -108,21 +110,25 @@ protected:
     virtual void fill_local_ip(fastrtps::rtps::Locator_t& loc) const = 0;
 
     //! Methods to manage the TCP headers and their CRC values.
+    //! The CRC is a CRC-32C when @c crc32c is true, and the additive checksum otherwise.
     bool check_crc(
         const TCPHeader &header,
         const fastrtps::rtps::octet *data,
-        uint32_t size) const;
+        uint32_t size,
+        bool crc32c) const;
 
     void calculate_crc(
         TCPHeader &header,
         const fastrtps::rtps::octet *data,
-        uint32_t size) const;
+        uint32_t size,
+        bool crc32c) const;
 
     void fill_rtcp_header(
         TCPHeader& header,
         const fastrtps::rtps::octet* send_buffer,
         uint32_t send_buffer_size,
-        uint16_t logical_port) const;
+        uint16_t logical_port,
+        bool crc32c) const;
 
     //! Closes the given p_channel_resource and unbind it from every resource.
     void close_tcp_socket(std::shared_ptr<TCPChannelResource>& channel);
@@ -136,11 +142,54 @@ protected:
 
     bool is_input_port_open(uint16_t port) const;
 
+    //! Starts receiving from a connected channel, either on a thread of its own or on the reactor threads.
+    void start_receiving(
+            const std::weak_ptr<TCPChannelResource>& channel);
+
+    //! Sends the bind request on the client side, or waits for it on the server side.
+    bool start_negotiation(
+            const std::weak_ptr<TCPChannelResource>& channel_weak,
+            std::weak_ptr<RTCPMessageManager>& rtcp_manager,
+            std::shared_ptr<TCPChannelResource>& channel);
+
     //! Functions to be called from new threads, which takes cares of performing a blocking receive
     void perform_listen_operation(
             std::weak_ptr<TCPChannelResource> channel,
             std::weak_ptr<RTCPMessageManager> rtcp_manager);
 
+    //! Reads asynchronously the bytes available on the channel, on a reactor thread.
+    void async_receive(
+            std::shared_ptr<TCPChannelResource> channel,
+            std::weak_ptr<RTCPMessageManager> rtcp_manager,
+            std::shared_ptr<TCPFramingBuffer> buffer);
+
+    //! Processes all the messages completed by an asynchronous read, and starts the next read.
+    void on_bytes_received(
+            std::shared_ptr<TCPChannelResource> channel,
+            std::weak_ptr<RTCPMessageManager> rtcp_manager,
+            std::shared_ptr<TCPFramingBuffer> buffer,
+            const asio::error_code& ec,
+            std::size_t bytes_received);
+
+    /**
+     * Checks the CRC of a message received, and processes it when it is a control message.
+     * @return true when the message carries RTPS data, which has to be delivered to the receiver of its logical port.
+     */
+    bool process_message(
+            std::weak_ptr<RTCPMessageManager>& rtcp_manager,
+            std::shared_ptr<TCPChannelResource>& channel,
+            const TCPHeader& tcp_header,
+            fastrtps::rtps::octet* body,
+            uint32_t body_size,
+            fastrtps::rtps::Locator_t& remote_locator);
+
+    //! Delivers RTPS data received to the receiver of the logical port on remote_locator.
+    void deliver_message(
+            std::shared_ptr<TCPChannelResource>& channel,
+            const fastrtps::rtps::octet* data,
+            uint32_t size,
+            const fastrtps::rtps::Locator_t& remote_locator);
+
     bool read_body(
         fastrtps::rtps::octet* receive_buffer,
         uint32_t receive_buffer_capacity,
@@ -243,6 +292,16 @@ public:
     //! Checks whether there are open and bound sockets for the given port.
     bool is_output_channel_open_for(const fastrtps::rtps::Locator_t&) const;
 
+    /**
+     * Checks whether a message fits on the send buffer of a socket, so writing it would not block.
+     * @param msg_size Size of the message, including its TCP header.
+     * @param socket_native_handle Socket where the message would be written.
+     * @return false when the bytes already queued on the socket plus the message exceed sendBufferSize.
+     */
+    bool check_socket_send_buffer(
+        size_t msg_size,
+        const asio::ip::tcp::socket::native_handle_type& socket_native_handle) const;
+
     /** Opens an input channel to receive incomming connections.
     *   If there is an existing channel it registers the receiver resource.
     */
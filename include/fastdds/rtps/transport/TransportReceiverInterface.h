@@ -17,6 +17,8 @@
 
 #include <fastdds/rtps/common/Locator.h>
 
+#include <memory>
+
 namespace eprosima {
 namespace fastdds {
 namespace rtps {
@@ -40,6 +42,24 @@ public:
      */
     virtual void OnDataReceived(const fastrtps::rtps::octet* data, const uint32_t size,
         const fastrtps::rtps::Locator_t& localLocator, const fastrtps::rtps::Locator_t& remote_locator) = 0;
+
+    /**
+     * Method to be called by the transport when receiving data on a buffer that can be kept alive after the call
+     * returns, so the receiver may keep parts of it instead of copying them.
+     * Default implementation ignores the buffer holder.
+     * @param data Pointer to the received data.
+     * @param size Number of bytes received.
+     * @param localLocator Locator identifying the local endpoint.
+     * @param remote_locator Locator identifying the remote endpoint.
+     * @param buffer Object keeping the received data alive while it is referenced.
+     */
+    virtual void OnDataReceived(const fastrtps::rtps::octet* data, const uint32_t size,
+        const fastrtps::rtps::Locator_t& localLocator, const fastrtps::rtps::Locator_t& remote_locator,
+        const std::shared_ptr<void>& buffer)
+    {
+        (void)buffer;
+        OnDataReceived(data, size, localLocator, remote_locator);
+    }
 };
 
 } // namespace rtps
@@ -19,6 +19,8 @@
 #include <fastdds/rtps/common/Locator.h>
 #include <asio.hpp>
 
+#include <memory>
+
 namespace eprosima{
 namespace fastdds{
 namespace rtps{
@@ -82,7 +84,8 @@ public:
         uint32_t maxMsgSize,
         const fastrtps::rtps::Locator_t& locator,
         const std::string& sInterface,
-        TransportReceiverInterface* receiver);
+        TransportReceiverInterface* receiver,
+        uint32_t receive_batch_size = 1);
 
     virtual ~UDPChannelResource() override;
 
@@ -152,6 +155,15 @@ protected:
     void perform_listen_operation(
             fastrtps::rtps::Locator_t input_locator);
 
+    /**
+     * Listening loop used when datagrams are received in batches.
+     * Each iteration blocks until at least one datagram is available, reads all the ones already queued on the
+     * socket (up to the batch size) with a single system call, and processes them before receiving again.
+     * @param input_locator - Locator that triggered the creation of the resource
+     */
+    void perform_batch_listen_operation(
+            const fastrtps::rtps::Locator_t& input_locator);
+
     /**
     * Blocking Receive from the specified channel.
     * @param receive_buffer vector with enough capacity (not size) to accomodate a full receive buffer. That
@@ -168,11 +180,14 @@ protected:
 
 private:
 
+    class BatchReceiver;
+
     TransportReceiverInterface* message_receiver_; //Associated Readers/Writers inside of MessageReceiver
     eProsimaUDPSocket socket_;
     bool only_multicast_purpose_;
     std::string interface_;
     UDPTransportInterface* transport_;
+    std::unique_ptr<BatchReceiver> batch_receiver_; //Receive buffers, when datagrams are received in batches
 
     UDPChannelResource(const UDPChannelResource&) = delete;
     UDPChannelResource& operator=(const UDPChannelResource&) = delete;
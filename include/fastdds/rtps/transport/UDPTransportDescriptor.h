@@ -53,6 +53,25 @@ typedef struct UDPTransportDescriptor: public SocketTransportDescriptor
     * datagram. This may hinder performance on high-frequency writers.
     */
    bool non_blocking_send = false;
+
+   /**
+    * Maximum number of datagrams read from the socket on each receive operation.
+    *
+    * When greater than 1, input channels read all the datagrams already queued on the socket (up to this number)
+    * with a single system call on platforms supporting it (recvmmsg), and process all of them before going back to
+    * the kernel. This reduces the number of system calls under bursty traffic, at the cost of one receive buffer
+    * of maxMessageSize bytes per datagram on each input channel.
+    */
+   uint32_t receive_batch_size = 1;
+
+   /**
+    * Whether to submit the datagrams of a send operation in batches.
+    *
+    * When set to true, a buffer sent to several destinations (i.e. a best-effort writer with many unicast readers)
+    * is submitted to all of them with a single system call on platforms supporting it (sendmmsg), instead of one
+    * send_to() per destination.
+    */
+   bool batched_send = false;
 } UDPTransportDescriptor;
 
 } // namespace rtps
@@ -28,6 +28,10 @@
 #include <map>
 #include <mutex>
 
+#ifdef __linux__
+struct mmsghdr;
+#endif // ifdef __linux__
+
 namespace eprosima{
 namespace fastdds{
 namespace rtps{
@@ -202,6 +206,45 @@ protected:
         const fastrtps::rtps::Locator_t& remote_locator,
         bool only_multicast_purpose,
         const std::chrono::microseconds& timeout);
+
+#ifdef __linux__
+    /**
+     * Send a buffer to several destinations, submitting the datagrams in batches with sendmmsg.
+     * Destinations are traversed in the same way as on the send operation with destination locators.
+     */
+    bool send_batch(
+        const fastrtps::rtps::octet* send_buffer,
+        uint32_t send_buffer_size,
+        eProsimaUDPSocket& socket,
+        fastrtps::rtps::LocatorsIterator& destination_locators_begin,
+        fastrtps::rtps::LocatorsIterator& destination_locators_end,
+        bool only_multicast_purpose,
+        const std::chrono::microseconds& timeout);
+
+    /**
+     * Submit datagrams with a single sendmmsg call. The batched send reaches the socket only through this method.
+     * @param fd Native handle of the socket.
+     * @param headers Headers of the datagrams to send.
+     * @param count Number of datagrams to send.
+     * @return Number of datagrams sent, or -1 with errno set on error.
+     */
+    virtual int send_mmsg(
+        int fd,
+        mmsghdr* headers,
+        unsigned int count);
+
+private:
+
+    /**
+     * Submit a batch of datagrams, retrying with the remaining ones when the kernel accepts only part of them.
+     * A datagram which cannot be sent, or would block, is skipped.
+     * @return false if any datagram could not be sent, true otherwise.
+     */
+    bool send_datagrams(
+        int fd,
+        mmsghdr* headers,
+        size_t count);
+#endif // ifdef __linux__
 };
 
 } // namespace rtps
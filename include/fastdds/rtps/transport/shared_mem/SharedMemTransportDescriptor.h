@@ -101,12 +101,28 @@ typedef struct SharedMemTransportDescriptor : public TransportDescriptorInterfac
         rtps_dump_file_ = rtps_dump_file;
     }
 
+    /**
+     * Whether received buffers may be kept by the readers, so payloads are not copied out of shared memory.
+     * Kept buffers cannot be reused by the sending participant until all its readers release them.
+     */
+    RTPS_DllAPI bool keep_received_buffers() const
+    {
+        return keep_received_buffers_;
+    }
+
+    RTPS_DllAPI void keep_received_buffers(
+            bool keep_received_buffers)
+    {
+        keep_received_buffers_ = keep_received_buffers;
+    }
+
 private:
 
     uint32_t segment_size_;
     uint32_t port_queue_capacity_;
     uint32_t healthy_check_timeout_ms_;
     std::string rtps_dump_file_;
+    bool keep_received_buffers_;
 
 }SharedMemTransportDescriptor;
 
@@ -321,6 +321,27 @@ public:
         return (flags_ & BIT(3)) != 0;
     }
 
+    /**
+     * Set on the bind messages of peers checksumming the RTPS messages of the connection with CRC-32C.
+     * Peers not knowing this flag ignore it, and the connection keeps the additive checksum.
+     */
+    void crc32c(bool crc32c)
+    {
+        if (crc32c)
+        {
+            flags_ |= BIT(4);
+        }
+        else
+        {
+            flags_ &= static_cast<fastrtps::rtps::octet>(~BIT(4));
+        }
+    }
+
+    bool crc32c() const
+    {
+        return (flags_ & BIT(4)) != 0;
+    }
+
     static inline size_t size()
     {
         return 16;
@@ -94,7 +94,8 @@ public:
             std::shared_ptr<TCPChannelResource>& channel,
             const ConnectionRequest_t &request,
             const TCPTransactionId &transactionId,
-            fastrtps::rtps::Locator_t &localLocator);
+            fastrtps::rtps::Locator_t &localLocator,
+            bool crc32c_offered = false);
 
     virtual ResponseCode processOpenLogicalPortRequest(
             std::shared_ptr<TCPChannelResource>& channel,
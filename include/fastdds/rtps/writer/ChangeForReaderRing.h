@@ -0,0 +1,364 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file ChangeForReaderRing.h
+ */
+#ifndef _FASTDDS_RTPS_WRITER_CHANGEFORREADERRING_H_
+#define _FASTDDS_RTPS_WRITER_CHANGEFORREADERRING_H_
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS_PUBLIC
+
+#include <fastdds/rtps/common/SequenceNumber.h>
+#include <fastdds/rtps/writer/ChangeForReader.h>
+#include <fastrtps/utils/collections/ResourceLimitedContainerConfig.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#if _MSC_VER
+#include <intrin.h>
+#endif // if _MSC_VER
+
+namespace eprosima {
+namespace fastrtps {
+namespace rtps {
+
+/**
+ * Collection of the ChangeForReader_t of a ReaderProxy, indexed by sequence number.
+ *
+ * Changes are kept on a ring of slots, where the slot of a change is given by its distance to the first sequence
+ * number of the ring, so finding a change and removing the first ones do not search nor move other changes.
+ * Sequence numbers between changes are holes, whose slots are left unused.
+ * A bitmap for each status, with a bit for each slot, allows finding the changes with a status a word at a time.
+ * The ring grows up to a maximum number of slots, given by the maximum number of changes. Changes beyond its last
+ * slot are kept on a vector ordered by sequence number, and moved to the ring when the first changes are removed.
+ */
+class ChangeForReaderRing
+{
+public:
+
+    //! Maximum number of sequence numbers the ring can span.
+    static constexpr size_t max_window_size = 64 * 1024;
+
+    /**
+     * @param allocation Allocation configuration. The initial value is used as the initial number of slots, and
+     *                   the maximum as the maximum number of changes and to limit the number of slots.
+     */
+    explicit ChangeForReaderRing(
+            const ResourceLimitedContainerConfig& allocation);
+
+    bool empty() const
+    {
+        return 0 == size_;
+    }
+
+    size_t size() const
+    {
+        return size_ + overflow_.size();
+    }
+
+    //! Maximum number of sequence numbers the ring spans before changes are kept outside of it.
+    size_t max_span() const
+    {
+        return max_slots_;
+    }
+
+    //! First change. The collection should not be empty.
+    const ChangeForReader_t& front() const
+    {
+        return changes_[slot(first_position())];
+    }
+
+    //! Last change. The collection should not be empty.
+    const ChangeForReader_t& back() const
+    {
+        return overflow_.empty() ? changes_[slot(last_ - origin_)] : overflow_.back();
+    }
+
+    //! Checks whether there is a change with a status.
+    bool has_status(
+            ChangeForReaderStatus_t status) const
+    {
+        return 0 < status_count_[status];
+    }
+
+    void clear();
+
+    /**
+     * Adds a change. Its sequence number may be lower than the ones on the collection.
+     * @param change Change to add. Its sequence number should not be on the collection.
+     * @return false when the collection is full.
+     */
+    bool insert(
+            const ChangeForReader_t& change);
+
+    /**
+     * Find a change.
+     * @param seq_num Sequence number of the change.
+     * @return Pointer to the change, nullptr when it is not on the collection.
+     */
+    ChangeForReader_t* find(
+            const SequenceNumber_t& seq_num);
+
+    const ChangeForReader_t* find(
+            const SequenceNumber_t& seq_num) const;
+
+    /**
+     * Removes a change.
+     * @param seq_num Sequence number of the change. Should be on the collection.
+     */
+    void erase(
+            const SequenceNumber_t& seq_num);
+
+    /**
+     * Removes all the changes with a lower sequence number.
+     * @param seq_num Sequence number of the first change to keep.
+     */
+    void erase_before(
+            const SequenceNumber_t& seq_num);
+
+    /**
+     * Changes the status of a change.
+     * @param change Change of the collection, as returned by find.
+     * @param status Status to apply.
+     */
+    void set_status(
+            ChangeForReader_t& change,
+            ChangeForReaderStatus_t status);
+
+    /**
+     * Converts all changes with a given status to a different status.
+     * @return true when at least one change has been modified, false otherwise.
+     */
+    bool convert_status(
+            ChangeForReaderStatus_t previous,
+            ChangeForReaderStatus_t next);
+
+    /**
+     * Applies a function object to every change, in sequence number order.
+     * @param f Function to apply. Will receive a const ChangeForReader_t&.
+     */
+    template<class UnaryFunction>
+    void for_each(
+            UnaryFunction f) const
+    {
+        if (empty())
+        {
+            return;
+        }
+
+        uint64_t end = last_ - origin_ + 1;
+        for (uint64_t word_position = 0; word_position < end; word_position += 64)
+        {
+            uint64_t bits = bits_[word(word_position)].present;
+            while (0 != bits)
+            {
+                f(changes_[slot(word_position + trailing_zeros(bits))]);
+                bits &= bits - 1;
+            }
+        }
+
+        for (const ChangeForReader_t& change : overflow_)
+        {
+            f(change);
+        }
+    }
+
+    /**
+     * Applies a function object to every unsent change and every hole on a range of sequence numbers.
+     * The changes with other status are skipped a word of the bitmaps at a time.
+     * The function may modify the collection, as the position of the next sequence number to visit is computed
+     * after each call.
+     * @param first First sequence number of the range.
+     * @param last Sequence number after the last one of the range.
+     * @param f Function to apply. Will receive a SequenceNumber_t and a const ChangeForReader_t*.
+     *          The second argument is nullptr for holes.
+     */
+    template<class BinaryFunction>
+    void for_each_unsent(
+            const SequenceNumber_t& first,
+            const SequenceNumber_t& last,
+            BinaryFunction f) const
+    {
+        uint64_t seq = first.to64long();
+        uint64_t end = last.to64long();
+        while (seq < end)
+        {
+            if (empty() || seq < origin_)
+            {
+                f(from_64(seq), nullptr);
+                ++seq;
+                continue;
+            }
+
+            if (seq > last_)
+            {
+                // Beyond the ring, changes may only be on overflow_
+                const ChangeForReader_t* change = find_in_overflow(seq);
+                if (nullptr == change)
+                {
+                    f(from_64(seq), nullptr);
+                }
+                else if (UNSENT == change->getStatus())
+                {
+                    f(from_64(seq), change);
+                }
+                ++seq;
+                continue;
+            }
+
+            // Holes and unsent changes on the rest of the word
+            uint64_t position = seq - origin_;
+            const StatusBits& bits = bits_[word(position)];
+            uint64_t candidates = (~bits.present | bits.status[UNSENT]) >> (position & 63);
+            if (0 == candidates)
+            {
+                seq += 64 - (position & 63);
+                continue;
+            }
+
+            seq += trailing_zeros(candidates);
+            if (seq < end)
+            {
+                position = seq - origin_;
+                bool present = 0 != (bits.present & (1ull << (position & 63)));
+                f(from_64(seq), present ? &changes_[slot(position)] : nullptr);
+                ++seq;
+            }
+        }
+    }
+
+private:
+
+    static constexpr size_t num_status = UNDERWAY + 1;
+
+    //! Bits of 64 consecutive slots.
+    struct StatusBits
+    {
+        //! Slots with a change.
+        uint64_t present;
+        //! Slots with a change on each status.
+        uint64_t status[num_status];
+    };
+
+    static uint32_t trailing_zeros(
+            uint64_t bits)
+    {
+#if _MSC_VER
+        unsigned long bit;
+        if (_BitScanForward(&bit, static_cast<uint32_t>(bits)))
+        {
+            return bit;
+        }
+        _BitScanForward(&bit, static_cast<uint32_t>(bits >> 32));
+        return bit + 32;
+#else
+        return static_cast<uint32_t>(__builtin_ctzll(bits));
+#endif // if _MSC_VER
+    }
+
+    static SequenceNumber_t from_64(
+            uint64_t value)
+    {
+        return { static_cast<int32_t>(value >> 32), static_cast<uint32_t>(value) };
+    }
+
+    //! Index on bits_ of the word holding the bits for a position from origin_.
+    size_t word(
+            uint64_t position) const
+    {
+        return (head_ + static_cast<size_t>(position >> 6)) & (bits_.size() - 1);
+    }
+
+    //! Index on changes_ of the slot for a position from origin_.
+    size_t slot(
+            uint64_t position) const
+    {
+        return ((head_ << 6) + static_cast<size_t>(position)) & (changes_.size() - 1);
+    }
+
+    //! Whether a sequence number is beyond the slots the ring may span, so its change would be on overflow_.
+    bool is_overflow(
+            uint64_t seq) const
+    {
+        return seq - origin_ >= max_slots_;
+    }
+
+    //! Change of overflow_ with a sequence number, nullptr if there is none.
+    const ChangeForReader_t* find_in_overflow(
+            uint64_t seq) const;
+
+    //! Position from origin_ of the first change. The collection should not be empty.
+    uint64_t first_position() const
+    {
+        return trailing_zeros(bits_[head_].present);
+    }
+
+    //! Grows the ring to span a number of sequence numbers from origin_.
+    void grow(
+            uint64_t span);
+
+    /**
+     * Moves the changes to a new ring, starting on a new origin_, which spans a number of sequence numbers.
+     * The changes which do not fit on the maximum number of slots are moved to overflow_.
+     */
+    void rebuild(
+            uint64_t new_origin,
+            uint64_t span);
+
+    //! Puts a change on its slot, which should be within the ring. It should be accounted on status_count_.
+    void place(
+            const ChangeForReader_t& change);
+
+    //! Releases the empty words at the beginning of the ring, and moves to it the changes of overflow_ that fit.
+    void refill();
+
+    //! Removes the changes of a word selected by a mask.
+    void remove_bits(
+            StatusBits& bits,
+            uint64_t mask);
+
+    //! Releases the words without changes at the beginning of the ring.
+    void release_empty_words();
+
+    //! Slots of the ring. Its size is always a power of two, and a multiple of 64.
+    std::vector<ChangeForReader_t> changes_;
+    //! Bits of the slots, a word for each 64 slots.
+    std::vector<StatusBits> bits_;
+    //! Index on bits_ of the first word of the ring.
+    size_t head_;
+    //! Sequence number of the first slot of the first word of the ring.
+    uint64_t origin_;
+    //! Sequence number of the last change.
+    uint64_t last_;
+    //! Number of changes on the ring.
+    size_t size_;
+    //! Maximum number of slots of the ring.
+    size_t max_slots_;
+    //! Maximum number of changes.
+    size_t max_size_;
+    //! Number of changes on each status, including the ones on overflow_.
+    size_t status_count_[num_status];
+    //! Changes beyond the last slot the ring may span, ordered by sequence number.
+    std::vector<ChangeForReader_t> overflow_;
+};
+
+} /* namespace rtps */
+} /* namespace fastrtps */
+} /* namespace eprosima */
+
+#endif // ifndef DOXYGEN_SHOULD_SKIP_THIS_PUBLIC
+#endif /* _FASTDDS_RTPS_WRITER_CHANGEFORREADERRING_H_ */
@@ -19,6 +19,7 @@
 #define _FASTDDS_RTPS_PERSISTENTWRITER_H_
 
 #include <fastdds/rtps/writer/RTPSWriter.h>
+#include <chrono>
 #include <string>
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS_PUBLIC
@@ -53,6 +54,13 @@ class PersistentWriter
      */
     void remove_persistent_change(CacheChange_t* change);
 
+    /**
+     * Wait until all changes added or removed so far have been stored.
+     * @param max_blocking_time Maximum time to wait.
+     * @return True if all changes were stored.
+     */
+    bool wait_for_all_stored(const std::chrono::steady_clock::time_point& max_blocking_time);
+
     private:
     //!Persistence service
     IPersistenceService* persistence_;
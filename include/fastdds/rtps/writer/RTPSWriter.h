@@ -40,6 +40,7 @@ namespace rtps {
 class WriterListener;
 class WriterHistory;
 class FlowController;
+class SchedulingFlowController;
 struct CacheChange_t;
 
 /**
@@ -52,6 +53,7 @@ class RTPSWriter : public Endpoint, public RTPSMessageSenderInterface
     friend class RTPSParticipantImpl;
     friend class RTPSMessageGroup;
     friend class AsyncInterestTree;
+    friend class AsyncWriterThread;
 
 protected:
 
@@ -222,6 +224,19 @@ public:
     virtual void add_flow_controller(
             std::unique_ptr<FlowController> controller) = 0;
 
+    /**
+     * Wake up the thread sending the unsent changes of this writer: the thread of the flow controller it is attached
+     * to, or the asynchronous thread of the participant.
+     */
+    void wake_up_async_thread();
+
+    /**
+     * Wake up the thread sending the unsent changes of this writer.
+     * @param max_blocking_time Time point until the function may be blocked.
+     */
+    void wake_up_async_thread(
+            const std::chrono::time_point<std::chrono::steady_clock>& max_blocking_time);
+
     /**
      * Get RTPS participant
      * @return RTPS participant
@@ -352,6 +367,16 @@ public:
      */
     const std::vector<GUID_t>& remote_guids() const override;
 
+    /**
+     * Check if all the locators messages are sent to are of the same kind.
+     *
+     * @param kind Locator kind to check.
+     *
+     * @return true if there is at least one destination locator, and all of them are of the given kind.
+     */
+    bool destinations_are_of_kind(
+            int32_t kind) const override;
+
     /**
      * Send a message through this interface.
      *
@@ -374,6 +399,8 @@ protected:
     bool is_async_;
     //!Separate sending activated
     bool m_separateSendingEnabled;
+    //!Flow controller of the participant this writer is attached to, if any
+    SchedulingFlowController* scheduling_flow_controller_;
 
     LocatorSelector locator_selector_;
 
@@ -387,6 +414,12 @@ protected:
 
     void update_cached_info_nts();
 
+    /**
+     * Stop sending unsent changes asynchronously.
+     * Should be called on the destructor of derived classes, without the writer mutex taken.
+     */
+    void unregister_async_thread();
+
     /**
      * Initialize the header of hte CDRMessages.
      */
@@ -422,6 +455,9 @@ private:
             const RTPSWriter&) = delete;
 
     RTPSWriter* next_[2];
+
+    //! Index of the AsyncWriterThread thread this writer is attached to.
+    uint32_t async_thread_index_;
 };
 
 } /* namespace rtps */
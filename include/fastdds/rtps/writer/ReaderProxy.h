@@ -32,10 +32,9 @@
 #include <fastdds/rtps/common/FragmentNumber.h>
 
 #include <fastdds/rtps/writer/ChangeForReader.h>
+#include <fastdds/rtps/writer/ChangeForReaderRing.h>
 #include <fastdds/rtps/writer/ReaderLocator.h>
 
-#include <fastrtps/utils/collections/ResourceLimitedVector.hpp>
-
 #include <algorithm>
 #include <mutex>
 #include <set>
@@ -110,6 +109,15 @@ public:
      */
     bool has_changes() const;
 
+    /**
+     * Check if there are changes marked to be sent to this reader.
+     * @return true when there are UNSENT changes, false otherwise.
+     */
+    bool has_unsent_changes() const
+    {
+        return changes_for_reader_.has_status(UNSENT);
+    }
+
     /**
      * Check if a specific change has been already acknowledged for this reader.
      * @param seq_num Sequence number of the change to be checked.
@@ -162,42 +170,8 @@ public:
             const SequenceNumber_t& max_seq,
             BinaryFunction f) const
     {
-        if (!changes_for_reader_.empty())
-        {
-            SequenceNumber_t current_seq = changes_low_mark_ + 1;
-            ChangeConstIterator it = changes_for_reader_.begin();
-            while (it != changes_for_reader_.end())
-            {
-                // Holes before this change are informed as irrelevant.
-                SequenceNumber_t change_seq = it->getSequenceNumber();
-                for (; current_seq < change_seq; ++current_seq)
-                {
-                    f(current_seq, nullptr);
-                }
-
-                // We then inform of this change if it is unsent, and go to the next one.
-                if (it->getStatus() == UNSENT)
-                {
-                    f(current_seq, &(*it));
-                }
-                ++current_seq;
-                ++it;
-            }
-
-            // After the last change has been checked, there may be a hole at the end.
-            for (; current_seq < max_seq; ++current_seq)
-            {
-                f(current_seq, nullptr);
-            }
-        }
-        else
-        {
-            // This may be entered if all changes where removed before being acknowledged.
-            for (SequenceNumber_t seq = changes_low_mark_ + 1; seq < max_seq; ++seq)
-            {
-                f(seq, nullptr);
-            }
-        }
+        // Holes, including the ones after the last change, are informed as irrelevant.
+        changes_for_reader_.for_each_unsent(changes_low_mark_ + 1, max_seq, f);
     }
 
     /*!
@@ -418,7 +392,7 @@ private:
     //!Pointer to the associated StatefulWriter.
     StatefulWriter* writer_;
     //!Set of the changes and its state.
-    ResourceLimitedVector<ChangeForReader_t, std::true_type> changes_for_reader_;
+    ChangeForReaderRing changes_for_reader_;
     //! Timed Event to manage the delay to mark a change as UNACKED after sending it.
     TimedEvent* nack_supression_event_;
     TimedEvent* initial_heartbeat_event_;
@@ -431,9 +405,6 @@ private:
 
     SequenceNumber_t changes_low_mark_;
 
-    using ChangeIterator = ResourceLimitedVector<ChangeForReader_t, std::true_type>::iterator;
-    using ChangeConstIterator = ResourceLimitedVector<ChangeForReader_t, std::true_type>::const_iterator;
-
     void disable_timers();
 
     /*
@@ -458,25 +429,6 @@ private:
 
     void add_change(
             const ChangeForReader_t& change);
-
-    /**
-     * @brief Find a change with the specified sequence number.
-     * @param seq_num Sequence number to find.
-     * @param exact When false, the first change with a sequence number not less than seq_num will be returned.
-     * When true, the change with a sequence number value of seq_num will be returned.
-     * @return Iterator pointing to the change, changes_for_reader_.end() if not found.
-     */
-    ChangeIterator find_change(
-            const SequenceNumber_t& seq_num,
-            bool exact);
-
-    /**
-     * @brief Find a change with the specified sequence number.
-     * @param seq_num Sequence number to find.
-     * @return Iterator pointing to the change, changes_for_reader_.end() if not found.
-     */
-    ChangeConstIterator find_change(
-            const SequenceNumber_t& seq_num) const;
 };
 
 } /* namespace rtps */
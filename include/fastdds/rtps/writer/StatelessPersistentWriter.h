@@ -56,6 +56,13 @@ class StatelessPersistentWriter : public StatelessWriter, private PersistentWrit
      * @return True if removed correctly.
      */
     bool change_removed_by_history(CacheChange_t* a_change) override;
+
+    /**
+     * Wait until all changes are acknowledged and stored, so they would be resent after a restart.
+     * @param max_wait Maximum time to wait.
+     * @return True if all changes were acknowledged and stored.
+     */
+    bool wait_for_all_acked(const Duration_t& max_wait) override;
 };
 }
 } /* namespace rtps */
@@ -21,7 +21,9 @@
 #define KEYEDCHANGES_H_
 
 #include <fastdds/rtps/common/CacheChange.h>
+#include <fastdds/rtps/common/InstanceHandle.h>
 #include <chrono>
+#include <utility>
 
 namespace eprosima{
 namespace fastrtps{
@@ -36,6 +38,8 @@ struct KeyedChanges
     KeyedChanges()
         : cache_changes()
         , next_deadline_us()
+        , prev_empty(nullptr)
+        , next_empty(nullptr)
     {
     }
 
@@ -43,6 +47,8 @@ struct KeyedChanges
     KeyedChanges(const KeyedChanges& other)
         : cache_changes(other.cache_changes)
         , next_deadline_us(other.next_deadline_us)
+        , prev_empty(nullptr)
+        , next_empty(nullptr)
     {
     }
 
@@ -55,6 +61,10 @@ struct KeyedChanges
     std::vector<rtps::CacheChange_t*> cache_changes;
     //! The time when the group will miss the deadline
     std::chrono::steady_clock::time_point next_deadline_us;
+    //! Previous instance without changes (managed by KeyedChangesMap)
+    std::pair<const rtps::InstanceHandle_t, KeyedChanges>* prev_empty;
+    //! Next instance without changes (managed by KeyedChangesMap)
+    std::pair<const rtps::InstanceHandle_t, KeyedChanges>* next_empty;
 };
 
 } /* namespace  */
@@ -0,0 +1,243 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file KeyedChangesMap.h
+ *
+ */
+
+#ifndef KEYEDCHANGESMAP_H_
+#define KEYEDCHANGESMAP_H_
+
+#include <fastdds/rtps/common/CacheChange.h>
+#include <fastdds/rtps/common/InstanceHandle.h>
+#include <fastrtps/common/KeyedChanges.h>
+
+#include <unordered_map>
+#include <vector>
+
+namespace eprosima {
+namespace fastrtps {
+
+/**
+ * @brief Hash table of the changes of each instance of a keyed topic.
+ *
+ * Instances without changes are kept on an intrusive list, in the order they became empty, so one of them can be
+ * found in constant time when the maximum number of instances is reached. The list is updated when the changes of
+ * an instance are modified through this class, so they should not be pushed or erased directly.
+ * @ingroup FASTRTPS_MODULE
+ */
+class KeyedChangesMap
+{
+    using map_type = std::unordered_map<rtps::InstanceHandle_t, KeyedChanges>;
+    using changes_type = std::vector<rtps::CacheChange_t*>;
+
+public:
+
+    using value_type = map_type::value_type;
+    using iterator = map_type::iterator;
+
+    KeyedChangesMap() = default;
+
+    // Links between empty instances point to the nodes of the map
+    KeyedChangesMap(
+            const KeyedChangesMap&) = delete;
+
+    KeyedChangesMap& operator =(
+            const KeyedChangesMap&) = delete;
+
+    /**
+     * @brief Preallocate room for a number of instances
+     * @param instances Number of instances
+     */
+    void reserve(
+            size_t instances)
+    {
+        map_.reserve(instances);
+    }
+
+    size_t size() const
+    {
+        return map_.size();
+    }
+
+    iterator begin()
+    {
+        return map_.begin();
+    }
+
+    iterator end()
+    {
+        return map_.end();
+    }
+
+    iterator find(
+            const rtps::InstanceHandle_t& handle)
+    {
+        return map_.find(handle);
+    }
+
+    /**
+     * @brief Add an instance without changes
+     * @param handle The handle of the instance, which should not be on the map
+     * @return An iterator to the new instance
+     */
+    iterator insert(
+            const rtps::InstanceHandle_t& handle)
+    {
+        iterator it = map_.emplace(handle, KeyedChanges()).first;
+        link_empty(&*it);
+        return it;
+    }
+
+    /**
+     * @brief Add an instance without changes in place of the instance that has been empty for the longest time
+     * @param handle The handle of the instance, which should not be on the map
+     * @return An iterator to the new instance, or end() if all instances have changes
+     */
+    iterator replace_empty(
+            const rtps::InstanceHandle_t& handle)
+    {
+        if (nullptr == empty_head_)
+        {
+            return map_.end();
+        }
+
+        value_type* evicted = empty_head_;
+        unlink_empty(evicted);
+        map_.erase(evicted->first);
+        return insert(handle);
+    }
+
+    /**
+     * @brief Remove an instance
+     * @param it Iterator to the instance
+     */
+    void erase(
+            iterator it)
+    {
+        if (it->second.cache_changes.empty())
+        {
+            unlink_empty(&*it);
+        }
+        map_.erase(it);
+    }
+
+    /**
+     * @brief Add a change at the end of an instance
+     * @param it Iterator to the instance
+     * @param change The change to add
+     */
+    void push_change(
+            iterator it,
+            rtps::CacheChange_t* change)
+    {
+        if (it->second.cache_changes.empty())
+        {
+            unlink_empty(&*it);
+        }
+        it->second.cache_changes.push_back(change);
+    }
+
+    /**
+     * @brief Remove a range of changes from an instance
+     * @param it Iterator to the instance
+     * @param first Iterator to the first change to remove
+     * @param last Iterator past the last change to remove
+     * @return An iterator following the last removed change
+     */
+    changes_type::iterator erase_changes(
+            iterator it,
+            changes_type::iterator first,
+            changes_type::iterator last)
+    {
+        changes_type& changes = it->second.cache_changes;
+        bool was_empty = changes.empty();
+        changes_type::iterator ret = changes.erase(first, last);
+        if (!was_empty && changes.empty())
+        {
+            link_empty(&*it);
+        }
+        return ret;
+    }
+
+    /**
+     * @brief Remove a change from an instance
+     * @param it Iterator to the instance
+     * @param chit Iterator to the change to remove
+     * @return An iterator following the removed change
+     */
+    changes_type::iterator erase_change(
+            iterator it,
+            changes_type::iterator chit)
+    {
+        return erase_changes(it, chit, chit + 1);
+    }
+
+private:
+
+    void link_empty(
+            value_type* entry)
+    {
+        entry->second.prev_empty = empty_tail_;
+        entry->second.next_empty = nullptr;
+        if (nullptr == empty_tail_)
+        {
+            empty_head_ = entry;
+        }
+        else
+        {
+            empty_tail_->second.next_empty = entry;
+        }
+        empty_tail_ = entry;
+    }
+
+    void unlink_empty(
+            value_type* entry)
+    {
+        value_type* prev = entry->second.prev_empty;
+        value_type* next = entry->second.next_empty;
+        if (nullptr == prev)
+        {
+            empty_head_ = next;
+        }
+        else
+        {
+            prev->second.next_empty = next;
+        }
+        if (nullptr == next)
+        {
+            empty_tail_ = prev;
+        }
+        else
+        {
+            next->second.prev_empty = prev;
+        }
+        entry->second.prev_empty = nullptr;
+        entry->second.next_empty = nullptr;
+    }
+
+    map_type map_;
+
+    //! Instance that has been empty for the longest time.
+    value_type* empty_head_ = nullptr;
+
+    //! Instance that has become empty most recently.
+    value_type* empty_tail_ = nullptr;
+};
+
+} /* namespace fastrtps */
+} /* namespace eprosima */
+
+#endif /* KEYEDCHANGESMAP_H_ */
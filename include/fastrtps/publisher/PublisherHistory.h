@@ -22,10 +22,11 @@
 #ifndef DOXYGEN_SHOULD_SKIP_THIS_PUBLIC
 
 #include <fastdds/rtps/resources/ResourceManagement.h>
+#include <fastdds/rtps/attributes/PropertyPolicy.h>
 
 #include <fastdds/rtps/history/WriterHistory.h>
 #include <fastrtps/qos/QosPolicies.h>
-#include <fastrtps/common/KeyedChanges.h>
+#include <fastrtps/common/KeyedChangesMap.h>
 #include <fastrtps/attributes/TopicAttributes.h>
 
 namespace eprosima {
@@ -45,11 +46,14 @@ public:
      * @param topic_att TopicAttributed
      * @param payloadMax Maximum payload size.
      * @param mempolicy Set wether the payloads ccan dynamically resized or not.
+     * @param properties Properties of the publisher. Payloads are shared with intraprocess readers, instead of
+     * copied, when property @c fastdds.shared_payloads is @c true.
      */
     PublisherHistory(
             const TopicAttributes& topic_att,
             uint32_t payloadMax,
-            rtps::MemoryManagementPolicy_t mempolicy);
+            rtps::MemoryManagementPolicy_t mempolicy,
+            const rtps::PropertyPolicy& properties = rtps::PropertyPolicy());
 
     virtual ~PublisherHistory();
 
@@ -143,7 +147,7 @@ public:
 
 private:
 
-    typedef std::map<rtps::InstanceHandle_t, KeyedChanges> t_m_Inst_Caches;
+    typedef KeyedChangesMap t_m_Inst_Caches;
 
     //!Map where keys are instance handles and values are vectors of cache changes associated
     t_m_Inst_Caches keyed_changes_;
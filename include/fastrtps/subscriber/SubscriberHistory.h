@@ -23,10 +23,11 @@
 
 #include <fastdds/dds/topic/TopicDataType.hpp>
 #include <fastdds/rtps/resources/ResourceManagement.h>
+#include <fastdds/rtps/attributes/PropertyPolicy.h>
 #include <fastrtps/qos/ReaderQos.h>
 #include <fastdds/rtps/history/ReaderHistory.h>
 #include <fastrtps/qos/QosPolicies.h>
-#include <fastrtps/common/KeyedChanges.h>
+#include <fastrtps/common/KeyedChangesMap.h>
 #include <fastrtps/subscriber/SampleInfo.h>
 #include <fastrtps/attributes/TopicAttributes.h>
 
@@ -51,13 +52,16 @@ public:
      * @param qos ReaderQoS policy.
      * @param payloadMax Maximum payload size per change.
      * @param mempolicy Set wether the payloads ccan dynamically resized or not.
+     * @param properties Properties of the subscriber. Payloads received from intraprocess writers are shared, instead
+     * of copied, when property @c fastdds.shared_payloads is @c true.
      */
     SubscriberHistory(
             const TopicAttributes& topic_att,
             fastdds::dds::TopicDataType* type,
             const fastrtps::ReaderQos& qos,
             uint32_t payloadMax,
-            rtps::MemoryManagementPolicy_t mempolicy);
+            rtps::MemoryManagementPolicy_t mempolicy,
+            const rtps::PropertyPolicy& properties = rtps::PropertyPolicy());
 
     virtual ~SubscriberHistory();
 
@@ -91,6 +95,50 @@ public:
             std::chrono::steady_clock::time_point& max_blocking_time);
     ///@}
 
+    /** @name Batch read or take methods.
+     * Methods used to read or take several samples with a single acquisition of the history mutex.
+     * They should be called with the history mutex locked.
+     */
+    ///@{
+    /**
+     * Get the next change that should be read or taken.
+     * @param[in] take Whether the change is going to be taken.
+     * @param[out] change Pointer to the next change.
+     * @param[out] ownership_strength Ownership strength of the writer of the change.
+     * @return true if a change was found.
+     */
+    bool get_next_change_nts(
+            bool take,
+            rtps::CacheChange_t** change,
+            uint32_t* ownership_strength);
+
+    /**
+     * Deserialize a change and fill its sample information.
+     * @param change The change to process.
+     * @param ownership_strength Ownership strength of the writer of the change.
+     * @param data Pointer to the object where the sample should be deserialized.
+     * @param info Pointer to a SampleInfo_t object where the sample information will be stored.
+     * @param in_place Whether @c data already points to the sample inside the change payload,
+     * in which case no deserialization is performed.
+     * @return true if correct.
+     */
+    bool deserialize_change(
+            rtps::CacheChange_t* change,
+            uint32_t ownership_strength,
+            void* data,
+            SampleInfo_t* info,
+            bool in_place = false);
+
+    /**
+     * Remove a change from the history without returning it to the pools, so its payload remains valid.
+     * The change should be given back later by calling release_Cache.
+     * @param change Pointer to the CacheChange_t.
+     * @return True if removed.
+     */
+    bool detach_change_sub(
+            rtps::CacheChange_t* change);
+    ///@}
+
     /**
      * @brief Returns information about the first untaken sample.
      * @param [out] info Pointer to a SampleInfo_t structure to store first untaken sample information.
@@ -129,7 +177,7 @@ public:
 
 private:
 
-    using t_m_Inst_Caches = std::map<rtps::InstanceHandle_t, KeyedChanges>;
+    using t_m_Inst_Caches = KeyedChangesMap;
 
     //!Map where keys are instance handles and values vectors of cache changes
     t_m_Inst_Caches keyed_changes_;
@@ -202,13 +250,14 @@ private:
 
     bool add_received_change_with_key(
             rtps::CacheChange_t* a_change,
-            std::vector<rtps::CacheChange_t*>& instance_changes);
+            t_m_Inst_Caches::iterator& map_it);
 
-    bool deserialize_change(
-            rtps::CacheChange_t* change,
-            uint32_t ownership_strength,
-            void* data,
-            SampleInfo_t* info);
+    /**
+     * @brief Remove a change from the collection of changes of its instance.
+     * @param change The change to remove.
+     */
+    void remove_from_instance(
+            rtps::CacheChange_t* change);
 };
 
 } // namespace fastrtps
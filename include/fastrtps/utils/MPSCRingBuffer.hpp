@@ -0,0 +1,187 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/*!
+ * @file MPSCRingBuffer.hpp
+ *
+ */
+
+#ifndef FASTRTPS_UTILS_MPSCRINGBUFFER_HPP_
+#define FASTRTPS_UTILS_MPSCRINGBUFFER_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS_PUBLIC
+namespace eprosima {
+namespace fastrtps {
+
+/**
+ * Bounded, lock-free queue for MPSC (multi-producer, single-consumer) comms.
+ *
+ * Every cell holds a sequence number telling whether it is ready to be written or read, so producers only
+ * contend on the reservation of a position, and never block. When the queue is full, pushing fails instead
+ * of growing it.
+ *
+ * @tparam T  Type of the elements. Should be default constructible and move assignable.
+ * @ingroup UTILITIES_MODULE
+ */
+template<class T>
+class MPSCRingBuffer
+{
+public:
+
+    /**
+     * Construct a queue.
+     * @param capacity  Maximum number of elements. It will be rounded up to the next power of two.
+     */
+    explicit MPSCRingBuffer(
+            size_t capacity)
+    {
+        size_t size = 2u;
+        while (size < capacity)
+        {
+            size <<= 1;
+        }
+
+        mask_ = size - 1u;
+        cells_.reset(new Cell[size]);
+        for (size_t i = 0; i < size; ++i)
+        {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        enqueue_pos_.store(0u, std::memory_order_relaxed);
+        dequeue_pos_ = 0u;
+    }
+
+    MPSCRingBuffer(
+            const MPSCRingBuffer&) = delete;
+
+    MPSCRingBuffer& operator =(
+            const MPSCRingBuffer&) = delete;
+
+    //! Maximum number of elements on the queue.
+    size_t capacity() const
+    {
+        return mask_ + 1u;
+    }
+
+    /**
+     * Number of positions reserved by producers since construction.
+     * Every push that succeeded, or is about to, took as ticket a position lower than this value, and will be
+     * popped as the element with that position. Can be called from any thread.
+     * @return Position the next push will reserve.
+     */
+    size_t reserved() const
+    {
+        return enqueue_pos_.load(std::memory_order_acquire);
+    }
+
+    /**
+     * Push an element to the queue. Can be called from any thread.
+     * @param item  Element to push. It is only moved from when this method succeeds.
+     * @param [out] ticket  When not null, receives the position reserved for the element.
+     * @return false when the queue is full.
+     */
+    bool try_push(
+            T&& item,
+            size_t* ticket = nullptr)
+    {
+        Cell* cell;
+        size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            cell = &cells_[pos & mask_];
+            size_t seq = cell->sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0)
+            {
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + 1u, std::memory_order_acq_rel))
+                {
+                    break;
+                }
+            }
+            else if (diff < 0)
+            {
+                // Cell has not been read since the previous lap
+                return false;
+            }
+            else
+            {
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+
+        cell->data = std::move(item);
+        cell->sequence.store(pos + 1u, std::memory_order_release);
+        if (ticket != nullptr)
+        {
+            *ticket = pos;
+        }
+        return true;
+    }
+
+    /**
+     * Pop the oldest element from the queue. Should only be called from the consumer thread.
+     * @param [out] item  Where the element is moved to.
+     * @return false when the queue is empty.
+     */
+    bool try_pop(
+            T& item)
+    {
+        Cell& cell = cells_[dequeue_pos_ & mask_];
+        if (cell.sequence.load(std::memory_order_acquire) != dequeue_pos_ + 1u)
+        {
+            return false;
+        }
+
+        item = std::move(cell.data);
+        cell.sequence.store(dequeue_pos_ + mask_ + 1u, std::memory_order_release);
+        ++dequeue_pos_;
+        return true;
+    }
+
+    /**
+     * Check whether there is an element ready to be popped. Should only be called from the consumer thread.
+     * @return true when the queue is empty.
+     */
+    bool empty() const
+    {
+        return cells_[dequeue_pos_ & mask_].sequence.load(std::memory_order_acquire) != dequeue_pos_ + 1u;
+    }
+
+private:
+
+    struct Cell
+    {
+        std::atomic<size_t> sequence;
+        T data;
+    };
+
+    std::unique_ptr<Cell[]> cells_;
+    size_t mask_;
+
+    // Producers and consumer positions are kept on different cache lines
+    alignas(64) std::atomic<size_t> enqueue_pos_;
+    alignas(64) size_t dequeue_pos_;
+};
+
+} // namespace fastrtps
+} // namespace eprosima
+
+#endif // ifndef DOXYGEN_SHOULD_SKIP_THIS_PUBLIC
+#endif // FASTRTPS_UTILS_MPSCRINGBUFFER_HPP_
@@ -0,0 +1,174 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/*!
+ * @file SnapshotPtr.hpp
+ *
+ */
+
+#ifndef FASTRTPS_UTILS_SNAPSHOTPTR_HPP_
+#define FASTRTPS_UTILS_SNAPSHOTPTR_HPP_
+
+#include <cassert>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS_PUBLIC
+namespace eprosima {
+namespace fastrtps {
+
+/**
+ * Holder of a read-mostly value, updated with a read-copy-update scheme.
+ *
+ * Readers take an immutable snapshot of the current value, which stays valid for as long as they keep it, and
+ * never wait for updates nor for other readers. Updates are serialized: they copy the current value, modify the
+ * copy and publish it for the following readers. An update may also wait until every snapshot taken before it has
+ * been released, so the caller knows no reader is using something it has just removed.
+ *
+ * Snapshots should be released before the holder is destroyed.
+ *
+ * @tparam T  Type of the value. Should be copy constructible.
+ * @ingroup UTILITIES_MODULE
+ */
+template<class T>
+class SnapshotPtr
+{
+public:
+
+    using snapshot = std::shared_ptr<const T>;
+
+    explicit SnapshotPtr(
+            T initial = T())
+    {
+        current_ = make_snapshot(std::move(initial));
+    }
+
+    ~SnapshotPtr()
+    {
+        current_.reset();
+        assert(0 == alive_);
+    }
+
+    SnapshotPtr(
+            const SnapshotPtr&) = delete;
+
+    SnapshotPtr& operator =(
+            const SnapshotPtr&) = delete;
+
+    /**
+     * Get the current value.
+     * @return a snapshot that will not be modified by following updates.
+     */
+    snapshot load() const
+    {
+        return std::atomic_load(&current_);
+    }
+
+    /**
+     * Update the value.
+     * @param modifier  Called with a copy of the current value. Returns whether it modified the copy, which is only
+     *                  published in that case.
+     * @return whether the value was updated.
+     */
+    template<typename Functor>
+    bool update(
+            const Functor& modifier)
+    {
+        std::lock_guard<std::mutex> guard(update_mutex_);
+        return publish(modifier);
+    }
+
+    /**
+     * Update the value and wait until the snapshots taken before have been released.
+     * It should not be called while holding a snapshot, as it would never return.
+     * @param modifier  Called with a copy of the current value. Returns whether it modified the copy, which is only
+     *                  published in that case.
+     * @return whether the value was updated.
+     */
+    template<typename Functor>
+    bool update_and_synchronize(
+            const Functor& modifier)
+    {
+        std::lock_guard<std::mutex> guard(update_mutex_);
+        if (!publish(modifier))
+        {
+            return false;
+        }
+
+        // Only the snapshot just published can be taken from now on
+        std::unique_lock<std::mutex> lock(alive_mutex_);
+        alive_cv_.wait(lock, [this]()
+                {
+                    return 1u == alive_;
+                });
+        return true;
+    }
+
+private:
+
+    template<typename Functor>
+    bool publish(
+            const Functor& modifier)
+    {
+        T value(*current_);
+        if (!modifier(value))
+        {
+            return false;
+        }
+
+        std::atomic_store(&current_, make_snapshot(std::move(value)));
+        return true;
+    }
+
+    snapshot make_snapshot(
+            T&& value)
+    {
+        {
+            std::lock_guard<std::mutex> guard(alive_mutex_);
+            ++alive_;
+        }
+
+        return snapshot(new T(std::move(value)), [this](const T* released)
+                       {
+                           delete released;
+                           std::lock_guard<std::mutex> guard(alive_mutex_);
+                           --alive_;
+                           alive_cv_.notify_all();
+                       });
+    }
+
+    //! Serializes updates.
+    std::mutex update_mutex_;
+
+    //! Protects the count of alive snapshots.
+    std::mutex alive_mutex_;
+
+    //! Signaled each time a snapshot is released.
+    std::condition_variable alive_cv_;
+
+    //! Number of snapshots not released yet, including the current one.
+    size_t alive_ = 0;
+
+    //! Current value. Only accessed through atomic operations.
+    snapshot current_;
+};
+
+} // namespace fastrtps
+} // namespace eprosima
+
+#endif // DOXYGEN_SHOULD_SKIP_THIS_PUBLIC
+#endif // FASTRTPS_UTILS_SNAPSHOTPTR_HPP_
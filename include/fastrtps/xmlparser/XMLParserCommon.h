@@ -60,6 +60,8 @@ extern const char* RECEIVE_BUFFER_SIZE;
 extern const char* SEND_BUFFER_SIZE;
 extern const char* TTL;
 extern const char* NON_BLOCKING_SEND;
+extern const char* RECEIVE_BATCH_SIZE;
+extern const char* BATCHED_SEND;
 extern const char* WHITE_LIST;
 extern const char* MAX_MESSAGE_SIZE;
 extern const char* MAX_INITIAL_PEERS_RANGE;
@@ -73,6 +75,8 @@ extern const char* METADATA_LOGICAL_PORT;
 extern const char* LISTENING_PORTS;
 extern const char* CALCULATE_CRC;
 extern const char* CHECK_CRC;
+extern const char* USE_CRC32C;
+extern const char* REACTOR_THREADS;
 extern const char* SEGMENT_SIZE;
 extern const char* PORT_QUEUE_CAPACITY;
 extern const char* PORT_OVERFLOW_POLICY;
@@ -81,6 +85,7 @@ extern const char* HEALTHY_CHECK_TIMEOUT_MS;
 extern const char* DISCARD;
 extern const char* FAIL;
 extern const char* RTPS_DUMP_FILE;
+extern const char* KEEP_RECEIVED_BUFFERS;
 
 // IntraprocessDeliveryType
 extern const char* OFF;
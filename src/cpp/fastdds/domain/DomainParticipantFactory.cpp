@@ -56,6 +56,7 @@ static void set_qos_from_attributes(
     qos.wire_protocol().builtin = attr.builtin;
     qos.wire_protocol().port = attr.port;
     qos.wire_protocol().throughput_controller = attr.throughputController;
+    qos.wire_protocol().flow_controllers = attr.flow_controllers;
     qos.wire_protocol().default_unicast_locator_list = attr.defaultUnicastLocatorList;
     qos.wire_protocol().default_multicast_locator_list = attr.defaultMulticastLocatorList;
     qos.transport().user_transports = attr.userTransports;
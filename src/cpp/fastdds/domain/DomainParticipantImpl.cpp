@@ -93,6 +93,7 @@ static void set_attributes_from_qos(
     attr.builtin = qos.wire_protocol().builtin;
     attr.port = qos.wire_protocol().port;
     attr.throughputController = qos.wire_protocol().throughput_controller;
+    attr.flow_controllers = qos.wire_protocol().flow_controllers;
     attr.defaultUnicastLocatorList = qos.wire_protocol().default_unicast_locator_list;
     attr.defaultMulticastLocatorList = qos.wire_protocol().default_multicast_locator_list;
     attr.userTransports = qos.transport().user_transports;
@@ -7,6 +7,10 @@
 #include <fastdds/dds/log/Colors.hpp>
 #include <iostream>
 
+#ifndef LOG_QUEUE_SIZE
+#define LOG_QUEUE_SIZE 4096
+#endif // ifndef LOG_QUEUE_SIZE
+
 using namespace std;
 namespace eprosima {
 namespace fastdds {
@@ -15,9 +19,11 @@ namespace dds {
 struct Log::Resources Log::resources_;
 
 Log::Resources::Resources()
-    : logging(false)
-    ,work(false)
-    ,current_loop(0)
+    : logs(LOG_QUEUE_SIZE)
+    ,logging(false)
+    ,sleeping(false)
+    ,consumed(0)
+    ,dropped(0)
     ,filenames(false)
     ,functions(true)
     ,verbosity(Log::Error)
@@ -40,10 +46,11 @@ void Log::RegisterConsumer(
 void Log::ClearConsumers()
 {
     std::unique_lock<std::mutex> working(resources_.cv_mutex);
+    uint64_t last_ticket = resources_.logs.reserved();
     resources_.cv.wait(working,
         [&]()
         {
-            return resources_.logs.BothEmpty();
+            return !resources_.logging || resources_.consumed >= last_ticket;
         });
     std::unique_lock<std::mutex> guard(resources_.config_mutex);
     resources_.consumers.clear();
@@ -72,33 +79,17 @@ void Log::Flush()
         return;
     }
 
-    /*   Flush() two steps strategy:
-
-         I must assure Log::Run swaps the queues because only swapping the queues the background content
-         will be consumed (first Run() loop).
-
-         Then, I must assure the new front queue content is consumed (second Run() loop).
-     */
+    // Entries are consumed in the order of the ring positions their producers reserved, so the entries of
+    // this thread, and the ones other threads reserved before, have been consumed once the consumed count
+    // passes the positions reserved up to now. Entries queued after this point are not waited for, so Flush()
+    // returns under heavy log load.
+    uint64_t last_ticket = resources_.logs.reserved();
 
-    int last_loop = -1;
-
-    for (int i = 0; i < 2; ++i)
-    {
-        resources_.cv.wait(guard,
-            [&]()
-            {
-                /* I must avoid:
-                 + the two calls be processed without an intermediate Run() loop (by using last_loop sequence number)
-                 + deadlock by absence of Run() loop activity (by using BothEmpty() call)
-                 */
-                return !resources_.logging ||
-                ( resources_.logs.Empty() &&
-                ( last_loop != resources_.current_loop || resources_.logs.BothEmpty()) );
-            });
-
-        last_loop = resources_.current_loop;
-
-    }
+    resources_.cv.wait(guard,
+        [&]()
+        {
+            return !resources_.logging || resources_.consumed >= last_ticket;
+        });
 }
 
 void Log::run()
@@ -107,39 +98,39 @@ void Log::run()
 
     while (resources_.logging)
     {
+        // Producers only take the mutex to wake us up when they see this flag
+        resources_.sleeping = true;
+        std::atomic_thread_fence(std::memory_order_seq_cst);
         resources_.cv.wait(guard,
             [&]()
             {
-                return !resources_.logging || resources_.work;
+                return !resources_.logging || !resources_.logs.empty();
             });
-
-        resources_.work = false;
+        resources_.sleeping = false;
 
         guard.unlock();
+        uint64_t processed = 0;
         {
-            resources_.logs.Swap();
-            while (!resources_.logs.Empty())
+            QueuedEntry queued;
+            while (resources_.logs.try_pop(queued))
             {
+                get_timestamp(queued.time, queued.entry.timestamp);
+
                 std::unique_lock<std::mutex> configGuard(resources_.config_mutex);
-                if (preprocess(resources_.logs.Front()))
+                if (preprocess(queued.entry))
                 {
                     for (auto& consumer : resources_.consumers)
                     {
-                        consumer->Consume(resources_.logs.Front());
+                        consumer->Consume(queued.entry);
                     }
                 }
 
-                resources_.logs.Pop();
+                ++processed;
             }
         }
         guard.lock();
 
-        // avoid overflow
-        if (++resources_.current_loop > 10000)
-        {
-            resources_.current_loop = 0;
-        }
-
+        resources_.consumed += processed;
         resources_.cv.notify_all();
     }
 }
@@ -190,7 +181,6 @@ void Log::KillThread()
     {
         std::unique_lock<std::mutex> guard(resources_.cv_mutex);
         resources_.logging = false;
-        resources_.work = false;
     }
 
     if (resources_.logging_thread)
@@ -211,6 +201,15 @@ void Log::QueueLog(
         const Log::Context& context,
         Log::Kind kind)
 {
+    QueueLog(std::string(message), context, kind);
+}
+
+void Log::QueueLog(
+        std::string&& message,
+        const Log::Context& context,
+        Log::Kind kind)
+{
+    if (!resources_.logging)
     {
         std::unique_lock<std::mutex> guard(resources_.cv_mutex);
         if (!resources_.logging && !resources_.logging_thread)
@@ -220,14 +219,25 @@ void Log::QueueLog(
         }
     }
 
-    std::string timestamp;
-    get_timestamp(timestamp);
-    resources_.logs.Push(Log::Entry{message, context, kind, timestamp});
+    QueuedEntry queued{Log::Entry{std::move(message), context, kind, std::string()}, std::chrono::system_clock::now()};
+    if (!resources_.logs.try_push(std::move(queued)))
+    {
+        resources_.dropped.fetch_add(1u, std::memory_order_relaxed);
+        return;
+    }
+
+    // Pairs with the fence on Log::run, so either the logging thread sees the entry or we see it sleeping
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (resources_.sleeping)
     {
         std::unique_lock<std::mutex> guard(resources_.cv_mutex);
-        resources_.work = true;
+        resources_.cv.notify_all();
     }
-    resources_.cv.notify_all();
+}
+
+uint64_t Log::GetDroppedEntries()
+{
+    return resources_.dropped.load(std::memory_order_relaxed);
 }
 
 Log::Kind Log::GetVerbosity()
@@ -264,10 +274,10 @@ void Log::SetErrorStringFilter(
 }
 
 void Log::get_timestamp(
+        const std::chrono::system_clock::time_point& now,
         std::string& timestamp)
 {
     std::stringstream stream;
-    auto now = std::chrono::system_clock::now();
     std::time_t now_c = std::chrono::system_clock::to_time_t(now);
     std::chrono::system_clock::duration tp = now.time_since_epoch();
     tp -= std::chrono::duration_cast<std::chrono::seconds>(tp);
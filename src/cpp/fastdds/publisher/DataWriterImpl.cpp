@@ -40,6 +40,8 @@
 #include <fastdds/rtps/builtin/liveliness/WLP.h>
 #include <fastdds/core/policy/ParameterSerializer.hpp>
 
+#include <algorithm>
+#include <cstring>
 #include <functional>
 #include <iostream>
 
@@ -67,7 +69,8 @@ DataWriterImpl::DataWriterImpl(
             + 20 /*SecureDataHeader*/ + 4 + ((2 * 16) /*EVP_MAX_IV_LENGTH max block size*/ - 1 ) /* SecureDataBodey*/
             + 16 + 4 /*SecureDataTag*/
 #endif // if HAVE_SECURITY
-            , qos_.endpoint().history_memory_policy)
+            , qos_.endpoint().history_memory_policy
+            , qos_.properties())
     , listener_(listen)
 #pragma warning (disable : 4355 )
     , writer_listener_(this)
@@ -91,6 +94,7 @@ ReturnCode_t DataWriterImpl::enable()
     w_att.endpoint.unicastLocatorList = qos_.endpoint().unicast_locator_list;
     w_att.endpoint.remoteLocatorList = qos_.endpoint().remote_locator_list;
     w_att.mode = qos_.publish_mode().kind == SYNCHRONOUS_PUBLISH_MODE ? SYNCHRONOUS_WRITER : ASYNCHRONOUS_WRITER;
+    w_att.flow_controller_name = qos_.publish_mode().flow_controller_name;
     w_att.endpoint.properties = qos_.properties();
 
     if (qos_.endpoint().entity_id > 0)
@@ -216,12 +220,131 @@ DataWriterImpl::~DataWriterImpl()
     if (writer_ != nullptr)
     {
         logInfo(PUBLISHER, guid().entityId << " in topic: " << type_->getName());
+
+        // Return samples still loaned to the user before the history goes away
+        for (CacheChange_t* loan : loans_)
+        {
+            history_.release_Cache(loan);
+        }
+        loans_.clear();
+
         RTPSDomain::removeRTPSWriter(writer_);
     }
 
     delete user_datawriter_;
 }
 
+ReturnCode_t DataWriterImpl::loan_sample(
+        void*& sample,
+        DataWriter::LoanInitializationKind initialization)
+{
+    // Type should be plain and have space for the representation header
+    if (!type_->is_plain() || type_->m_typeSize <= SerializedPayload_t::representation_header_size)
+    {
+        return ReturnCode_t::RETCODE_ILLEGAL_OPERATION;
+    }
+
+    // Writer should be enabled
+    if (writer_ == nullptr)
+    {
+        return ReturnCode_t::RETCODE_NOT_ENABLED;
+    }
+
+    std::lock_guard<RecursiveTimedMutex> lock(writer_->getMutex());
+
+    // Get a payload from the history pool. The sample is laid out after the representation header.
+    CacheChange_t* change = nullptr;
+    if (!history_.reserve_Cache(&change, type_->m_typeSize))
+    {
+        return ReturnCode_t::RETCODE_OUT_OF_RESOURCES;
+    }
+
+    sample = change->serializedPayload.data + SerializedPayload_t::representation_header_size;
+
+    switch (initialization)
+    {
+        default:
+        case DataWriter::LoanInitializationKind::NO_LOAN_INITIALIZATION:
+            break;
+
+        case DataWriter::LoanInitializationKind::ZERO_LOAN_INITIALIZATION:
+            memset(sample, 0, type_->m_typeSize - SerializedPayload_t::representation_header_size);
+            break;
+
+        case DataWriter::LoanInitializationKind::CONSTRUCTED_LOAN_INITIALIZATION:
+            if (!type_->construct_sample(sample))
+            {
+                history_.release_Cache(change);
+                sample = nullptr;
+                return ReturnCode_t::RETCODE_UNSUPPORTED;
+            }
+            break;
+    }
+
+    loans_.push_back(change);
+    return ReturnCode_t::RETCODE_OK;
+}
+
+ReturnCode_t DataWriterImpl::discard_loan(
+        void*& sample)
+{
+    // Type should be plain
+    if (!type_->is_plain())
+    {
+        return ReturnCode_t::RETCODE_ILLEGAL_OPERATION;
+    }
+
+    // Writer should be enabled
+    if (writer_ == nullptr)
+    {
+        return ReturnCode_t::RETCODE_NOT_ENABLED;
+    }
+
+    std::lock_guard<RecursiveTimedMutex> lock(writer_->getMutex());
+
+    auto it = find_loan(sample);
+    if (it == loans_.end())
+    {
+        return ReturnCode_t::RETCODE_BAD_PARAMETER;
+    }
+
+    history_.release_Cache(*it);
+    loans_.erase(it);
+    sample = nullptr;
+    return ReturnCode_t::RETCODE_OK;
+}
+
+std::vector<CacheChange_t*>::iterator DataWriterImpl::find_loan(
+        void* sample)
+{
+    return std::find_if(loans_.begin(), loans_.end(),
+                   [sample](const CacheChange_t* change)
+                   {
+                       return change->serializedPayload.data + SerializedPayload_t::representation_header_size ==
+                       static_cast<octet*>(sample);
+                   });
+}
+
+void DataWriterImpl::prepare_loaned_change(
+        CacheChange_t* change,
+        ChangeKind_t change_kind,
+        const InstanceHandle_t& handle)
+{
+    change->kind = change_kind;
+    change->instanceHandle = handle;
+    change->writerGUID = writer_->getGuid();
+
+    // Plain types are already in CDR format for the local endianness, only the header is missing
+    SerializedPayload_t& payload = change->serializedPayload;
+    payload.encapsulation = DEFAULT_ENDIAN == BIGEND ? CDR_BE : CDR_LE;
+    payload.data[0] = 0;
+    payload.data[1] = static_cast<octet>(payload.encapsulation);
+    payload.data[2] = 0;
+    payload.data[3] = 0;
+    payload.length = type_->m_typeSize;
+    payload.pos = 0;
+}
+
 bool DataWriterImpl::write(
         void* data)
 {
@@ -448,10 +571,29 @@ bool DataWriterImpl::perform_create_new_change(
     std::unique_lock<RecursiveTimedMutex> lock(writer_->getMutex());
 #endif // if HAVE_STRICT_REALTIME
     {
-        CacheChange_t* ch = writer_->new_change(type_->getSerializedSizeProvider(data), change_kind, handle);
+        // A loaned sample already lives in a history payload, so it is taken from the loans instead of serialized
+        CacheChange_t* ch = nullptr;
+        bool is_loan = false;
+        if (change_kind == ALIVE && !loans_.empty())
+        {
+            auto loan_it = find_loan(data);
+            if (loan_it != loans_.end())
+            {
+                ch = *loan_it;
+                loans_.erase(loan_it);
+                prepare_loaned_change(ch, change_kind, handle);
+                is_loan = true;
+            }
+        }
+
+        if (!is_loan)
+        {
+            ch = writer_->new_change(type_->getSerializedSizeProvider(data), change_kind, handle);
+        }
+
         if (ch != nullptr)
         {
-            if (change_kind == ALIVE)
+            if (change_kind == ALIVE && !is_loan)
             {
                 //If these two checks are correct, we asume the cachechange is valid and thwn we can write to it.
                 if (!type_->serialize(data, &ch->serializedPayload))
@@ -466,7 +608,15 @@ bool DataWriterImpl::perform_create_new_change(
 
             if (!this->history_.add_pub_change(ch, wparams, lock, max_blocking_time))
             {
-                history_.release_Cache(ch);
+                if (is_loan)
+                {
+                    // The user keeps the loan, so it can be written again or discarded
+                    loans_.push_back(ch);
+                }
+                else
+                {
+                    history_.release_Cache(ch);
+                }
                 return false;
             }
 
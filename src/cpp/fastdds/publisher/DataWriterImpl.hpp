@@ -23,6 +23,7 @@
 #include <fastdds/rtps/common/Guid.h>
 #include <fastdds/rtps/common/WriteParams.h>
 
+#include <fastdds/dds/publisher/DataWriter.hpp>
 #include <fastdds/dds/publisher/qos/DataWriterQos.hpp>
 
 #include <fastdds/rtps/attributes/WriterAttributes.h>
@@ -86,6 +87,24 @@ public:
 
     ReturnCode_t enable();
 
+    /**
+     * Get a pointer to a sample allocated on the writer's history, where the user can directly write.
+     * @param [out] sample Pointer to the loaned sample.
+     * @param [in] initialization How to initialize the loaned sample.
+     * @return Result of the operation. See DataWriter::loan_sample for the list of return codes.
+     */
+    ReturnCode_t loan_sample(
+            void*& sample,
+            DataWriter::LoanInitializationKind initialization);
+
+    /**
+     * Return a previously loaned sample to the writer's history without publishing it.
+     * @param [in,out] sample Pointer to the loaned sample. It is set to nullptr on success.
+     * @return Result of the operation. See DataWriter::discard_loan for the list of return codes.
+     */
+    ReturnCode_t discard_loan(
+            void*& sample);
+
     /**
      * Write data to the topic.
      * @param data Pointer to the data
@@ -301,6 +320,9 @@ protected:
 
     DataWriter* user_datawriter_ = nullptr;
 
+    //! Changes whose payload has been loaned to the user and not yet written or discarded
+    std::vector<fastrtps::rtps::CacheChange_t*> loans_;
+
     /**
      *
      * @param kind
@@ -368,6 +390,27 @@ protected:
             fastrtps::rtps::WriteParams& wparams,
             const fastrtps::rtps::InstanceHandle_t& handle);
 
+    /**
+     * Find the change whose payload holds a loaned sample.
+     * @param sample Pointer to the loaned sample.
+     * @return Iterator to the loan, or loans_.end() if the pointer does not correspond to a loaned sample.
+     * @pre The writer mutex should be taken.
+     */
+    std::vector<fastrtps::rtps::CacheChange_t*>::iterator find_loan(
+            void* sample);
+
+    /**
+     * Prepare a change holding a loaned sample to be added to the history.
+     * The payload is already laid out in CDR format, so only the representation header is filled.
+     * @param change The change holding the loaned sample.
+     * @param change_kind Kind of the change.
+     * @param handle Instance handle of the change.
+     */
+    void prepare_loaned_change(
+            fastrtps::rtps::CacheChange_t* change,
+            fastrtps::rtps::ChangeKind_t change_kind,
+            const fastrtps::rtps::InstanceHandle_t& handle);
+
     static fastrtps::TopicAttributes get_topic_attributes(
             const DataWriterQos& qos,
             const Topic& topic,
@@ -78,6 +78,29 @@ bool DataReader::wait_for_unread_message(
     return impl_->wait_for_unread_message(timeout);
 }
 
+ReturnCode_t DataReader::read(
+        LoanableCollection& data_values,
+        SampleInfoSeq& sample_infos,
+        int32_t max_samples)
+{
+    return impl_->read(data_values, sample_infos, max_samples);
+}
+
+ReturnCode_t DataReader::take(
+        LoanableCollection& data_values,
+        SampleInfoSeq& sample_infos,
+        int32_t max_samples)
+{
+    return impl_->take(data_values, sample_infos, max_samples);
+}
+
+ReturnCode_t DataReader::return_loan(
+        LoanableCollection& data_values,
+        SampleInfoSeq& sample_infos)
+{
+    return impl_->return_loan(data_values, sample_infos);
+}
+
 ReturnCode_t DataReader::read_next_sample(
         void* data,
         SampleInfo* info)
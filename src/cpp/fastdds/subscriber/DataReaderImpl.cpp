@@ -38,6 +38,9 @@
 
 #include <fastdds/dds/log/Log.hpp>
 
+#include <algorithm>
+#include <limits>
+
 using namespace eprosima::fastrtps;
 using namespace eprosima::fastrtps::rtps;
 using namespace std::chrono;
@@ -94,7 +97,8 @@ DataReaderImpl::DataReaderImpl(
             type_.get(),
             qos_.get_readerqos(subscriber_->get_qos()),
             type_->m_typeSize + 3,    /* Possible alignment */
-            qos_.endpoint().history_memory_policy)
+            qos_.endpoint().history_memory_policy,
+            qos_.properties())
     , listener_(listener)
     , reader_listener_(this)
     , deadline_duration_us_(qos_.deadline().period.to_ns() * 1e-3)
@@ -205,9 +209,25 @@ DataReaderImpl::~DataReaderImpl()
     if (reader_ != nullptr)
     {
         logInfo(DATA_READER, guid().entityId << " in topic: " << topic_->get_name());
+
+        // Samples still loaned to the user should be returned before the history goes away
+        {
+            std::lock_guard<RecursiveTimedMutex> lock(reader_->getMutex());
+            for (std::unique_ptr<LoanedCollection>& loan : loans_)
+            {
+                release_loan(*loan);
+            }
+            loans_.clear();
+        }
+
         RTPSDomain::removeRTPSReader(reader_);
     }
 
+    for (void* sample : free_samples_)
+    {
+        type_->deleteData(sample);
+    }
+
     delete user_datareader_;
 }
 
@@ -614,31 +634,278 @@ bool DataReaderImpl::lifespan_expired()
     return false;
 }
 
-/* TODO
-   bool DataReaderImpl::read(
-        std::vector<void *>& data_values,
-        std::vector<SampleInfo_t>& sample_infos,
-        uint32_t max_samples)
-   {
-    (void)data_values;
-    (void)sample_infos;
-    (void)max_samples;
-    // TODO Implement
-    return false;
-   }
+ReturnCode_t DataReaderImpl::read(
+        LoanableCollection& data_values,
+        SampleInfoSeq& sample_infos,
+        int32_t max_samples)
+{
+    return read_or_take(data_values, sample_infos, max_samples, false);
+}
 
-   bool DataReaderImpl::take(
-        std::vector<void *>& data_values,
-        std::vector<SampleInfo_t>& sample_infos,
-        uint32_t max_samples)
-   {
-    (void)data_values;
-    (void)sample_infos;
-    (void)max_samples;
-    // TODO Implement
-    return false;
-   }
- */
+ReturnCode_t DataReaderImpl::take(
+        LoanableCollection& data_values,
+        SampleInfoSeq& sample_infos,
+        int32_t max_samples)
+{
+    return read_or_take(data_values, sample_infos, max_samples, true);
+}
+
+ReturnCode_t DataReaderImpl::read_or_take(
+        LoanableCollection& data_values,
+        SampleInfoSeq& sample_infos,
+        int32_t max_samples,
+        bool take)
+{
+    if (reader_ == nullptr)
+    {
+        return ReturnCode_t::RETCODE_NOT_ENABLED;
+    }
+
+    ReturnCode_t code = check_collection_preconditions_and_calc_max_samples(data_values, sample_infos, max_samples);
+    if (!code)
+    {
+        return code;
+    }
+
+    auto max_blocking_time = std::chrono::steady_clock::now() +
+#if HAVE_STRICT_REALTIME
+            std::chrono::microseconds(::TimeConv::Time_t2MicroSecondsInt64(qos_.reliability().max_blocking_time));
+#else
+            std::chrono::hours(24);
+#endif // if HAVE_STRICT_REALTIME
+
+    std::unique_lock<RecursiveTimedMutex> lock(reader_->getMutex(), std::defer_lock);
+    if (!lock.try_lock_until(max_blocking_time))
+    {
+        return ReturnCode_t::RETCODE_TIMEOUT;
+    }
+
+    // When the collections have no buffer, the middleware loans one to them
+    bool is_loan = data_values.maximum() == 0;
+    std::unique_ptr<LoanedCollection> loan;
+    if (is_loan)
+    {
+        if (free_loans_.empty())
+        {
+            loan.reset(new LoanedCollection());
+        }
+        else
+        {
+            loan = std::move(free_loans_.back());
+            free_loans_.pop_back();
+        }
+    }
+
+    int32_t num_samples = 0;
+    CacheChange_t* change = nullptr;
+    uint32_t ownership_strength = 0;
+    while (num_samples < max_samples && history_.get_next_change_nts(take, &change, &ownership_strength))
+    {
+        void* sample = nullptr;
+        bool in_place = false;
+        if (is_loan)
+        {
+            // Taken samples of plain types are returned pointing to the received payload
+            in_place = take && can_loan_payload(change);
+            if (in_place)
+            {
+                sample = change->serializedPayload.data + SerializedPayload_t::representation_header_size;
+            }
+            else if (free_samples_.empty())
+            {
+                sample = type_->createData();
+            }
+            else
+            {
+                sample = free_samples_.back();
+                free_samples_.pop_back();
+            }
+        }
+        else
+        {
+            sample = data_values.buffer()[num_samples];
+        }
+
+        SampleInfo_t rtps_info;
+        bool deserialized = history_.deserialize_change(change, ownership_strength, sample, &rtps_info, in_place);
+
+        if (take)
+        {
+            // A loaned payload should remain valid until the user returns the loan
+            if (in_place && deserialized)
+            {
+                history_.detach_change_sub(change);
+            }
+            else
+            {
+                history_.remove_change_sub(change);
+            }
+        }
+
+        if (!deserialized)
+        {
+            if (is_loan && !in_place)
+            {
+                free_samples_.push_back(sample);
+            }
+            continue;
+        }
+
+        if (is_loan)
+        {
+            loan->data_buffer.push_back(sample);
+            loan->changes.push_back(in_place ? change : nullptr);
+            loan->infos.emplace_back();
+            sample_info_to_dds(rtps_info, &loan->infos.back());
+        }
+        else
+        {
+            sample_infos.length(num_samples + 1);
+            sample_info_to_dds(rtps_info, &sample_infos[num_samples]);
+        }
+
+        ++num_samples;
+    }
+
+    if (num_samples == 0)
+    {
+        if (is_loan)
+        {
+            free_loans_.push_back(std::move(loan));
+        }
+        return ReturnCode_t::RETCODE_NO_DATA;
+    }
+
+    if (is_loan)
+    {
+        // Pointers are taken once the storage of the infos will not grow anymore
+        for (SampleInfo& info : loan->infos)
+        {
+            loan->info_buffer.push_back(&info);
+        }
+
+        data_values.loan(loan->data_buffer.data(), num_samples, num_samples);
+        sample_infos.loan(loan->info_buffer.data(), num_samples, num_samples);
+        loans_.push_back(std::move(loan));
+    }
+    else
+    {
+        data_values.length(num_samples);
+    }
+
+    return ReturnCode_t::RETCODE_OK;
+}
+
+ReturnCode_t DataReaderImpl::return_loan(
+        LoanableCollection& data_values,
+        SampleInfoSeq& sample_infos)
+{
+    if (reader_ == nullptr)
+    {
+        return ReturnCode_t::RETCODE_NOT_ENABLED;
+    }
+
+    // Both collections should be loaned, and have the same length
+    if (data_values.has_ownership() || sample_infos.has_ownership() ||
+            data_values.length() != sample_infos.length())
+    {
+        return ReturnCode_t::RETCODE_PRECONDITION_NOT_MET;
+    }
+
+    std::lock_guard<RecursiveTimedMutex> lock(reader_->getMutex());
+
+    auto it = std::find_if(loans_.begin(), loans_.end(),
+                    [&data_values, &sample_infos](const std::unique_ptr<LoanedCollection>& loan)
+                    {
+                        return loan->data_buffer.data() == data_values.buffer() &&
+                        loan->info_buffer.data() == sample_infos.buffer();
+                    });
+    if (it == loans_.end())
+    {
+        return ReturnCode_t::RETCODE_PRECONDITION_NOT_MET;
+    }
+
+    release_loan(**it);
+    free_loans_.push_back(std::move(*it));
+    loans_.erase(it);
+
+    data_values.unloan();
+    sample_infos.unloan();
+
+    return ReturnCode_t::RETCODE_OK;
+}
+
+ReturnCode_t DataReaderImpl::check_collection_preconditions_and_calc_max_samples(
+        LoanableCollection& data_values,
+        SampleInfoSeq& sample_infos,
+        int32_t& max_samples)
+{
+    // Properties should be the same on both collections
+    if ((data_values.has_ownership() != sample_infos.has_ownership()) ||
+            (data_values.maximum() != sample_infos.maximum()) ||
+            (data_values.length() != sample_infos.length()))
+    {
+        return ReturnCode_t::RETCODE_PRECONDITION_NOT_MET;
+    }
+
+    // Collections currently loaned should be returned before being used again
+    if (!data_values.has_ownership())
+    {
+        return ReturnCode_t::RETCODE_PRECONDITION_NOT_MET;
+    }
+
+    if (max_samples < 0 && max_samples != LENGTH_UNLIMITED)
+    {
+        return ReturnCode_t::RETCODE_BAD_PARAMETER;
+    }
+
+    // Samples are copied into the collections when they have a buffer
+    if (data_values.maximum() > 0)
+    {
+        if (max_samples == LENGTH_UNLIMITED || max_samples > data_values.maximum())
+        {
+            max_samples = data_values.maximum();
+        }
+    }
+    else if (max_samples == LENGTH_UNLIMITED)
+    {
+        max_samples = qos_.resource_limits().max_samples > 0 ?
+                qos_.resource_limits().max_samples : std::numeric_limits<int32_t>::max();
+    }
+
+    return ReturnCode_t::RETCODE_OK;
+}
+
+bool DataReaderImpl::can_loan_payload(
+        const CacheChange_t* change) const
+{
+    const SerializedPayload_t& payload = change->serializedPayload;
+    return type_->is_plain() &&
+           change->kind == fastrtps::rtps::ALIVE &&
+           payload.encapsulation == (DEFAULT_ENDIAN == BIGEND ? CDR_BE : CDR_LE) &&
+           payload.length >= type_->m_typeSize;
+}
+
+void DataReaderImpl::release_loan(
+        LoanedCollection& loan)
+{
+    for (size_t n = 0; n < loan.changes.size(); ++n)
+    {
+        if (loan.changes[n] != nullptr)
+        {
+            history_.release_Cache(loan.changes[n]);
+        }
+        else
+        {
+            free_samples_.push_back(loan.data_buffer[n]);
+        }
+    }
+
+    loan.data_buffer.clear();
+    loan.infos.clear();
+    loan.info_buffer.clear();
+    loan.changes.clear();
+}
 
 ReturnCode_t DataReaderImpl::set_listener(
         DataReaderListener* listener)
@@ -24,8 +24,10 @@
 #include <fastdds/rtps/common/Locator.h>
 #include <fastdds/rtps/common/Guid.h>
 
+#include <fastdds/dds/core/LoanableCollection.hpp>
 #include <fastdds/dds/subscriber/qos/DataReaderQos.hpp>
 #include <fastdds/dds/subscriber/DataReaderListener.hpp>
+#include <fastdds/dds/subscriber/SampleInfo.hpp>
 
 #include <fastdds/rtps/attributes/ReaderAttributes.h>
 #include <fastrtps/subscriber/SubscriberHistory.h>
@@ -36,6 +38,9 @@
 #include <fastrtps/qos/LivelinessChangedStatus.h>
 #include <fastrtps/types/TypesBase.h>
 
+#include <memory>
+#include <vector>
+
 using eprosima::fastrtps::types::ReturnCode_t;
 
 namespace eprosima {
@@ -95,23 +100,23 @@ public:
 
     ///@{
 
-    /* TODO
-       bool read(
-            std::vector<void*>& data_values,
-            std::vector<fastrtps::SampleInfo>& sample_infos,
-            uint32_t max_samples);
-     */
+    ReturnCode_t read(
+            LoanableCollection& data_values,
+            SampleInfoSeq& sample_infos,
+            int32_t max_samples = LENGTH_UNLIMITED);
 
     ReturnCode_t read_next_sample(
             void* data,
             SampleInfo* info);
 
-    /* TODO
-       bool take(
-            std::vector<void*>& data_values,
-            std::vector<fastrtps::SampleInfo>& sample_infos,
-            uint32_t max_samples);
-     */
+    ReturnCode_t take(
+            LoanableCollection& data_values,
+            SampleInfoSeq& sample_infos,
+            int32_t max_samples = LENGTH_UNLIMITED);
+
+    ReturnCode_t return_loan(
+            LoanableCollection& data_values,
+            SampleInfoSeq& sample_infos);
 
     ReturnCode_t take_next_sample(
             void* data,
@@ -298,6 +303,28 @@ protected:
 
     DataReader* user_datareader_ = nullptr;
 
+    //! Buffers of a collection loaned to the user by read or take
+    struct LoanedCollection
+    {
+        //! Element pointers loaned to the data collection
+        std::vector<void*> data_buffer;
+        //! Storage of the loaned SampleInfo objects
+        std::vector<SampleInfo> infos;
+        //! Element pointers loaned to the sample info collection
+        std::vector<void*> info_buffer;
+        //! Changes whose payload is loaned for each sample, nullptr when the sample was deserialized
+        std::vector<fastrtps::rtps::CacheChange_t*> changes;
+    };
+
+    //! Collections currently loaned to the user
+    std::vector<std::unique_ptr<LoanedCollection> > loans_;
+
+    //! Collections already returned by the user, kept to be reused
+    std::vector<std::unique_ptr<LoanedCollection> > free_loans_;
+
+    //! Samples created by the type support for loaned collections, kept to be reused
+    std::vector<void*> free_samples_;
+
     /**
      * @brief A method called when a new cache change is added
      * @param change The cache change that has been added
@@ -321,6 +348,45 @@ protected:
      */
     bool lifespan_expired();
 
+    /**
+     * @brief Common implementation of read and take on collections.
+     * @param data_values Collection where the data samples will be returned.
+     * @param sample_infos Collection where the sample infos will be returned.
+     * @param max_samples Maximum number of samples to return.
+     * @param take Whether the samples should be taken or just read.
+     */
+    ReturnCode_t read_or_take(
+            LoanableCollection& data_values,
+            SampleInfoSeq& sample_infos,
+            int32_t max_samples,
+            bool take);
+
+    /**
+     * @brief Check the preconditions of the collections passed to read or take.
+     * @param data_values Collection where the data samples will be returned.
+     * @param sample_infos Collection where the sample infos will be returned.
+     * @param[in,out] max_samples Maximum number of samples requested, adjusted to the real limit.
+     */
+    ReturnCode_t check_collection_preconditions_and_calc_max_samples(
+            LoanableCollection& data_values,
+            SampleInfoSeq& sample_infos,
+            int32_t& max_samples);
+
+    /**
+     * @brief Check whether the payload of a change can be loaned directly to the user.
+     * @param change The change to check.
+     */
+    bool can_loan_payload(
+            const fastrtps::rtps::CacheChange_t* change) const;
+
+    /**
+     * @brief Give back the resources associated to a loaned collection.
+     * @param loan The loaned collection.
+     * @pre The reader mutex should be locked.
+     */
+    void release_loan(
+            LoanedCollection& loan);
+
     fastrtps::TopicAttributes topic_attributes() const;
 
     void subscriber_qos_updated();
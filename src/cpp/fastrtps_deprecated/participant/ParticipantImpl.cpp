@@ -186,6 +186,7 @@ Publisher* ParticipantImpl::createPublisher(
     watt.endpoint.remoteLocatorList = att.remoteLocatorList;
     watt.mode = att.qos.m_publishMode.kind ==
             eprosima::fastrtps::SYNCHRONOUS_PUBLISH_MODE ? SYNCHRONOUS_WRITER : ASYNCHRONOUS_WRITER;
+    watt.flow_controller_name = att.qos.m_publishMode.flow_controller_name;
     watt.endpoint.properties = att.properties;
     if (att.getEntityID() > 0)
     {
@@ -18,7 +18,9 @@
  */
 #include <fastrtps/config.h>
 
+#include <algorithm>
 #include <mutex>
+#include <string>
 
 #include <fastrtps/publisher/PublisherHistory.h>
 
@@ -29,6 +31,7 @@
 #include <fastdds/dds/log/Log.hpp>
 
 #include <mutex>
+#include <string>
 
 namespace eprosima {
 namespace fastrtps {
@@ -38,7 +41,8 @@ using namespace rtps;
 static HistoryAttributes to_history_attributes(
         const TopicAttributes& topic_att,
         uint32_t payloadMaxSize,
-        MemoryManagementPolicy_t mempolicy)
+        MemoryManagementPolicy_t mempolicy,
+        const PropertyPolicy& properties)
 {
     auto initial_samples = topic_att.resourceLimitsQos.allocated_samples;
     auto max_samples = topic_att.resourceLimitsQos.max_samples;
@@ -54,18 +58,37 @@ static HistoryAttributes to_history_attributes(
         initial_samples = std::min(initial_samples, max_samples);
     }
 
-    return HistoryAttributes(mempolicy, payloadMaxSize, initial_samples, max_samples);
+    HistoryAttributes att(mempolicy, payloadMaxSize, initial_samples, max_samples);
+
+    // Payloads are only shared with intraprocess endpoints when explicitly requested
+    const std::string* shared_property =
+            PropertyPolicyHelper::find_property(properties, "fastdds.shared_payloads");
+    if (shared_property != nullptr)
+    {
+        att.sharedPayloads = (shared_property->compare("true") == 0 || shared_property->compare("1") == 0);
+    }
+    return att;
 }
 
 PublisherHistory::PublisherHistory(
         const TopicAttributes& topic_att,
         uint32_t payloadMaxSize,
-        MemoryManagementPolicy_t mempolicy)
-    : WriterHistory(to_history_attributes(topic_att, payloadMaxSize, mempolicy))
+        MemoryManagementPolicy_t mempolicy,
+        const PropertyPolicy& properties)
+    : WriterHistory(to_history_attributes(topic_att, payloadMaxSize, mempolicy, properties))
     , history_qos_(topic_att.historyQos)
     , resource_limited_qos_(topic_att.resourceLimitsQos)
     , topic_att_(topic_att)
 {
+    if (topic_att.getTopicKind() == WITH_KEY)
+    {
+        // Instances with samples cannot outnumber the samples
+        int32_t instances = std::min(resource_limited_qos_.max_instances, resource_limited_qos_.max_samples);
+        if (instances > 0)
+        {
+            keyed_changes_.reserve(static_cast<size_t>(instances));
+        }
+    }
 }
 
 PublisherHistory::~PublisherHistory()
@@ -81,7 +104,7 @@ void PublisherHistory::rebuild_instances()
             t_m_Inst_Caches::iterator vit;
             if (find_or_add_key(change->instanceHandle, &vit))
             {
-                vit->second.cache_changes.push_back(change);
+                keyed_changes_.push_change(vit, change);
             }
         }
     }
@@ -181,7 +204,7 @@ bool PublisherHistory::add_pub_change(
 
             if (add)
             {
-                vit->second.cache_changes.push_back(change);
+                keyed_changes_.push_change(vit, change);
 #if HAVE_STRICT_REALTIME
                 if (this->add_change_(change, wparams, max_blocking_time))
 #else
@@ -216,7 +239,7 @@ bool PublisherHistory::find_or_add_key(
 
     if (static_cast<int>(keyed_changes_.size()) < resource_limited_qos_.max_instances)
     {
-        *vit_out = keyed_changes_.insert(std::make_pair(instance_handle, KeyedChanges())).first;
+        *vit_out = keyed_changes_.insert(instance_handle);
         return true;
     }
 
@@ -303,7 +326,7 @@ bool PublisherHistory::remove_change_pub(
             {
                 if (remove_change(change))
                 {
-                    vit->second.cache_changes.erase(chit);
+                    keyed_changes_.erase_change(vit, chit);
                     m_isHistoryFull = false;
                     return true;
                 }
@@ -354,7 +377,7 @@ bool PublisherHistory::remove_instance_changes(
         }
     }
 
-    vit->second.cache_changes.erase(vit->second.cache_changes.begin(), chit);
+    keyed_changes_.erase_changes(vit, vit->second.cache_changes.begin(), chit);
 
     if (vit->second.cache_changes.empty())
     {
@@ -382,12 +405,13 @@ bool PublisherHistory::set_next_deadline(
     }
     else if (topic_att_.getTopicKind() == WITH_KEY)
     {
-        if (keyed_changes_.find(handle) == keyed_changes_.end())
+        t_m_Inst_Caches::iterator vit = keyed_changes_.find(handle);
+        if (vit == keyed_changes_.end())
         {
             return false;
         }
 
-        keyed_changes_[handle].next_deadline_us = next_deadline_us;
+        vit->second.next_deadline_us = next_deadline_us;
         return true;
     }
 
@@ -411,8 +435,8 @@ bool PublisherHistory::get_next_deadline(
             keyed_changes_.begin(),
             keyed_changes_.end(),
             [](
-                const std::pair<InstanceHandle_t, KeyedChanges>& lhs,
-                const std::pair<InstanceHandle_t, KeyedChanges>& rhs)
+                const t_m_Inst_Caches::value_type& lhs,
+                const t_m_Inst_Caches::value_type& rhs)
             {
                 return lhs.second.next_deadline_us < rhs.second.next_deadline_us;
             });
@@ -61,7 +61,8 @@ PublisherImpl::PublisherImpl(
             + 20 /*SecureDataHeader*/ + 4 + ((2 * 16) /*EVP_MAX_IV_LENGTH max block size*/ - 1 ) /* SecureDataBodey*/
             + 16 + 4 /*SecureDataTag*/
 #endif // if HAVE_SECURITY
-            , att.historyMemoryPolicy)
+            , att.historyMemoryPolicy
+            , att.properties)
     , mp_listener(listen)
 #pragma warning (disable : 4355 )
     , m_writerListener(this)
@@ -26,7 +26,9 @@
 #include <fastdds/dds/topic/TopicDataType.hpp>
 #include <fastdds/dds/log/Log.hpp>
 
+#include <algorithm>
 #include <mutex>
+#include <string>
 
 namespace eprosima {
 namespace fastrtps {
@@ -53,7 +55,8 @@ static void get_sample_info(
 static HistoryAttributes to_history_attributes(
         const TopicAttributes& topic_att,
         uint32_t payloadMaxSize,
-        MemoryManagementPolicy_t mempolicy)
+        MemoryManagementPolicy_t mempolicy,
+        const PropertyPolicy& properties)
 {
     auto initial_samples = topic_att.resourceLimitsQos.allocated_samples;
     auto max_samples = topic_att.resourceLimitsQos.max_samples;
@@ -69,7 +72,16 @@ static HistoryAttributes to_history_attributes(
         initial_samples = std::min(initial_samples, max_samples);
     }
 
-    return HistoryAttributes(mempolicy, payloadMaxSize, initial_samples, max_samples);
+    HistoryAttributes att(mempolicy, payloadMaxSize, initial_samples, max_samples);
+
+    // Payloads are only shared with intraprocess endpoints when explicitly requested
+    const std::string* shared_property =
+            PropertyPolicyHelper::find_property(properties, "fastdds.shared_payloads");
+    if (shared_property != nullptr)
+    {
+        att.sharedPayloads = (shared_property->compare("true") == 0 || shared_property->compare("1") == 0);
+    }
+    return att;
 }
 
 SubscriberHistory::SubscriberHistory(
@@ -77,8 +89,9 @@ SubscriberHistory::SubscriberHistory(
         TopicDataType* type,
         const ReaderQos& qos,
         uint32_t payloadMaxSize,
-        MemoryManagementPolicy_t mempolicy)
-    : ReaderHistory(to_history_attributes(topic_att, payloadMaxSize, mempolicy))
+        MemoryManagementPolicy_t mempolicy,
+        const PropertyPolicy& properties)
+    : ReaderHistory(to_history_attributes(topic_att, payloadMaxSize, mempolicy, properties))
     , history_qos_(topic_att.historyQos)
     , resource_limited_qos_(topic_att.resourceLimitsQos)
     , topic_att_(topic_att)
@@ -91,6 +104,16 @@ SubscriberHistory::SubscriberHistory(
         get_key_object_ = type_->createData();
     }
 
+    if (topic_att.getTopicKind() == WITH_KEY)
+    {
+        // Instances with samples cannot outnumber the samples
+        int32_t instances = std::min(resource_limited_qos_.max_instances, resource_limited_qos_.max_samples);
+        if (instances > 0)
+        {
+            keyed_changes_.reserve(static_cast<size_t>(instances));
+        }
+    }
+
     using std::placeholders::_1;
     using std::placeholders::_2;
 
@@ -180,7 +203,7 @@ bool SubscriberHistory::received_change_keep_all_with_key(
         std::vector<CacheChange_t*>& instance_changes = vit->second.cache_changes;
         if (instance_changes.size() < static_cast<size_t>(resource_limited_qos_.max_samples_per_instance) )
         {
-            return add_received_change_with_key(a_change, vit->second.cache_changes);
+            return add_received_change_with_key(a_change, vit);
         }
 
         logWarning(SUBSCRIBER, "Change not added due to maximum number of samples per instance");
@@ -212,7 +235,7 @@ bool SubscriberHistory::received_change_keep_last_with_key(
 
         if (add)
         {
-            return add_received_change_with_key(a_change, instance_changes);
+            return add_received_change_with_key(a_change, vit);
         }
     }
 
@@ -248,7 +271,7 @@ bool SubscriberHistory::add_received_change(
 
 bool SubscriberHistory::add_received_change_with_key(
         CacheChange_t* a_change,
-        std::vector<CacheChange_t*>& instance_changes)
+        t_m_Inst_Caches::iterator& map_it)
 {
     if (m_isHistoryFull)
     {
@@ -268,7 +291,7 @@ bool SubscriberHistory::add_received_change_with_key(
 
         // As the instance should be ordered following the presentation QoS, and
         // we only support ordering by reception timestamp, we can always add at the end.
-        instance_changes.push_back(a_change);
+        keyed_changes_.push_change(map_it, a_change);
 
         logInfo(SUBSCRIBER, mp_reader->getGuid().entityId
                 << ": Change " << a_change->sequenceNumber << " added from: "
@@ -311,9 +334,10 @@ bool SubscriberHistory::deserialize_change(
         CacheChange_t* change,
         uint32_t ownership_strength,
         void* data,
-        SampleInfo_t* info)
+        SampleInfo_t* info,
+        bool in_place)
 {
-    if (change->kind == ALIVE)
+    if (change->kind == ALIVE && !in_place)
     {
         if (!type_->deserialize(&change->serializedPayload, data))
         {
@@ -401,6 +425,21 @@ bool SubscriberHistory::takeNextData(
     return false;
 }
 
+bool SubscriberHistory::get_next_change_nts(
+        bool take,
+        CacheChange_t** change,
+        uint32_t* ownership_strength)
+{
+    WriterProxy* wp = nullptr;
+    bool found = take ? mp_reader->nextUntakenCache(change, &wp) : mp_reader->nextUnreadCache(change, &wp);
+    if (found)
+    {
+        *ownership_strength = wp && qos_.m_ownership.kind == EXCLUSIVE_OWNERSHIP_QOS ? wp->ownership_strength() : 0;
+    }
+
+    return found;
+}
+
 bool SubscriberHistory::get_first_untaken_info(
         SampleInfo_t* info)
 {
@@ -432,19 +471,17 @@ bool SubscriberHistory::find_key(
 
     if (keyed_changes_.size() < static_cast<size_t>(resource_limited_qos_.max_instances))
     {
-        *vit_out = keyed_changes_.insert(std::make_pair(a_change->instanceHandle, KeyedChanges())).first;
+        *vit_out = keyed_changes_.insert(a_change->instanceHandle);
         return true;
     }
     else
     {
-        for (vit = keyed_changes_.begin(); vit != keyed_changes_.end(); ++vit)
+        // Take the place of an instance without changes
+        vit = keyed_changes_.replace_empty(a_change->instanceHandle);
+        if (vit != keyed_changes_.end())
         {
-            if (vit->second.cache_changes.size() == 0)
-            {
-                keyed_changes_.erase(vit);
-                *vit_out = keyed_changes_.insert(std::make_pair(a_change->instanceHandle, KeyedChanges())).first;
-                return true;
-            }
+            *vit_out = vit;
+            return true;
         }
         logWarning(SUBSCRIBER, "History has reached the maximum number of instances");
     }
@@ -461,6 +498,46 @@ bool SubscriberHistory::remove_change_sub(
     }
 
     std::lock_guard<RecursiveTimedMutex> guard(*mp_mutex);
+    remove_from_instance(change);
+
+    if (remove_change(change))
+    {
+        m_isHistoryFull = false;
+        return true;
+    }
+
+    return false;
+}
+
+bool SubscriberHistory::detach_change_sub(
+        CacheChange_t* change)
+{
+    if (mp_reader == nullptr || mp_mutex == nullptr)
+    {
+        logError(SUBSCRIBER, "You need to create a Reader with this History before using it");
+        return false;
+    }
+
+    std::lock_guard<RecursiveTimedMutex> guard(*mp_mutex);
+    remove_from_instance(change);
+
+    auto chit = std::find(m_changes.begin(), m_changes.end(), change);
+    if (chit == m_changes.end())
+    {
+        logWarning(SUBSCRIBER, "SequenceNumber " << change->sequenceNumber << " not found");
+        return false;
+    }
+
+    logInfo(SUBSCRIBER, "Detaching change " << change->sequenceNumber);
+    mp_reader->change_removed_by_history(change);
+    m_changes.erase(chit);
+    m_isHistoryFull = false;
+    return true;
+}
+
+void SubscriberHistory::remove_from_instance(
+        CacheChange_t* change)
+{
     if (topic_att_.getTopicKind() == WITH_KEY)
     {
         bool found = false;
@@ -471,7 +548,7 @@ bool SubscriberHistory::remove_change_sub(
             {
                 if ((*chit)->sequenceNumber == change->sequenceNumber && (*chit)->writerGUID == change->writerGUID)
                 {
-                    vit->second.cache_changes.erase(chit);
+                    keyed_changes_.erase_change(vit, chit);
                     found = true;
                     break;
                 }
@@ -482,14 +559,6 @@ bool SubscriberHistory::remove_change_sub(
             logError(SUBSCRIBER, "Change not found on this key, something is wrong");
         }
     }
-
-    if (remove_change(change))
-    {
-        m_isHistoryFull = false;
-        return true;
-    }
-
-    return false;
 }
 
 bool SubscriberHistory::set_next_deadline(
@@ -510,12 +579,13 @@ bool SubscriberHistory::set_next_deadline(
     }
     else if (topic_att_.getTopicKind() == WITH_KEY)
     {
-        if (keyed_changes_.find(handle) == keyed_changes_.end())
+        t_m_Inst_Caches::iterator vit = keyed_changes_.find(handle);
+        if (vit == keyed_changes_.end())
         {
             return false;
         }
 
-        keyed_changes_[handle].next_deadline_us = next_deadline_us;
+        vit->second.next_deadline_us = next_deadline_us;
         return true;
     }
 
@@ -543,8 +613,8 @@ bool SubscriberHistory::get_next_deadline(
         auto min = std::min_element(keyed_changes_.begin(),
                         keyed_changes_.end(),
                         [](
-                            const std::pair<InstanceHandle_t, KeyedChanges>& lhs,
-                            const std::pair<InstanceHandle_t, KeyedChanges>& rhs)
+                            const t_m_Inst_Caches::value_type& lhs,
+                            const t_m_Inst_Caches::value_type& rhs)
                         {
                             return lhs.second.next_deadline_us < rhs.second.next_deadline_us;
                         });
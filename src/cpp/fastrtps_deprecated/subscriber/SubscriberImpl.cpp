@@ -55,7 +55,8 @@ SubscriberImpl::SubscriberImpl(
             ptype,
             att.qos,
             ptype->m_typeSize  + 3 /*Possible alignment*/,
-            att.historyMemoryPolicy)
+            att.historyMemoryPolicy,
+            att.properties)
     , mp_listener(listen)
     , m_readerListener(this)
     , mp_userSubscriber(nullptr)
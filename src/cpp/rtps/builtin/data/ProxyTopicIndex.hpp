@@ -0,0 +1,154 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file ProxyTopicIndex.hpp
+ *
+ */
+
+#ifndef _FASTDDS_RTPS_BUILTIN_DATA_PROXYTOPICINDEX_HPP_
+#define _FASTDDS_RTPS_BUILTIN_DATA_PROXYTOPICINDEX_HPP_
+
+#include <fastrtps/utils/fixed_size_string.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace eprosima {
+namespace fastrtps {
+namespace rtps {
+
+/**
+ * Index of endpoint proxies by topic name.
+ *
+ * It is maintained alongside the ProxyHashTable collections of the participant proxies, so endpoint matching only
+ * needs to consider the proxies on the same topic. A proxy should be removed from the index before its topic name
+ * changes or its data is moved away.
+ *
+ * The collection of a topic is erased with its last proxy, unless the collections are being iterated (see
+ * @ref begin_iteration). In that case it is erased when the last iteration ends.
+ */
+template<class Proxy>
+class ProxyTopicIndex
+{
+public:
+
+    using proxy_collection = std::vector<Proxy*>;
+
+    /**
+     * Add a proxy to the index, using its current topic name.
+     * @param proxy Pointer to the proxy to add.
+     */
+    void add(
+            Proxy* proxy)
+    {
+        proxies_[proxy->topicName().to_string()].push_back(proxy);
+    }
+
+    /**
+     * Remove a proxy from the index.
+     * @param proxy Pointer to the proxy to remove. Its topic name should be the one it was added with.
+     */
+    void remove(
+            const Proxy* proxy)
+    {
+        auto it = proxies_.find(proxy->topicName().to_string());
+        if (it != proxies_.end())
+        {
+            proxy_collection& topic_proxies = it->second;
+            auto pit = std::find(topic_proxies.begin(), topic_proxies.end(), proxy);
+            if (pit != topic_proxies.end())
+            {
+                topic_proxies.erase(pit);
+                if (topic_proxies.empty())
+                {
+                    if (0 == iterations_)
+                    {
+                        proxies_.erase(it);
+                    }
+                    else
+                    {
+                        has_empty_ = true;
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     * Signal that collections returned by @ref find are going to be iterated.
+     * Collections are not erased from the index until the matching call to @ref end_iteration.
+     */
+    void begin_iteration()
+    {
+        ++iterations_;
+    }
+
+    /**
+     * Signal that an iteration started with @ref begin_iteration has finished.
+     * Collections emptied during the iterations are erased when the last one ends.
+     */
+    void end_iteration()
+    {
+        if (0 == --iterations_ && has_empty_)
+        {
+            for (auto it = proxies_.begin(); it != proxies_.end();)
+            {
+                it = it->second.empty() ? proxies_.erase(it) : std::next(it);
+            }
+            has_empty_ = false;
+        }
+    }
+
+    /**
+     * Get the proxies on a topic.
+     *
+     * The returned reference stays valid until the last proxy on the topic is removed, or until the end of the
+     * current iteration when one is in progress. Its contents may change when proxies are added or removed.
+     *
+     * @param topic_name Name of the topic.
+     * @return const reference to the collection of proxies on the topic.
+     */
+    const proxy_collection& find(
+            const string_255& topic_name) const
+    {
+        auto it = proxies_.find(topic_name.to_string());
+        return it == proxies_.end() ? empty_ : it->second;
+    }
+
+    //! @return the number of topics with a collection on the index.
+    size_t topic_count() const
+    {
+        return proxies_.size();
+    }
+
+private:
+
+    std::unordered_map<std::string, proxy_collection> proxies_;
+    const proxy_collection empty_;
+    //! Number of iterations in progress
+    uint32_t iterations_ = 0;
+    //! Whether some collection was emptied during an iteration
+    bool has_empty_ = false;
+};
+
+} // namespace rtps
+} // namespace fastrtps
+} // namespace eprosima
+
+#endif // _FASTDDS_RTPS_BUILTIN_DATA_PROXYTOPICINDEX_HPP_
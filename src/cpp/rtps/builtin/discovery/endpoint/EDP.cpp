@@ -955,75 +955,76 @@ bool EDP::pairingReader(
     logInfo(RTPS_EDP, rdata.guid() << " in topic: \"" << rdata.topicName() << "\"");
     std::lock_guard<std::recursive_mutex> pguard(*mp_PDP->getMutex());
 
-    for (ResourceLimitedVector<ParticipantProxyData*>::const_iterator pit = mp_PDP->ParticipantProxiesBegin();
-            pit != mp_PDP->ParticipantProxiesEnd(); ++pit)
+    // Only writers on the same topic may match. Listeners may add proxies to the collection, so it is accessed by
+    // position.
+    PDP::TopicIteration iteration(*mp_PDP);
+    const std::vector<WriterProxyData*>& writers = mp_PDP->writer_proxies_on_topic(rdata.topicName());
+    for (size_t n = 0; n < writers.size(); ++n)
     {
-        for (auto& pair : *(*pit)->m_writers)
+        WriterProxyData* wdatait = writers[n];
+        MatchingFailureMask no_match_reason;
+        fastdds::dds::PolicyMask incompatible_qos;
+        bool valid = valid_matching(&rdata, wdatait, no_match_reason, incompatible_qos);
+        const GUID_t& reader_guid = R->getGuid();
+        const GUID_t& writer_guid = wdatait->guid();
+
+        if (valid)
         {
-            WriterProxyData* wdatait = pair.second;
-            MatchingFailureMask no_match_reason;
-            fastdds::dds::PolicyMask incompatible_qos;
-            bool valid = valid_matching(&rdata, wdatait, no_match_reason, incompatible_qos);
-            const GUID_t& reader_guid = R->getGuid();
-            const GUID_t& writer_guid = wdatait->guid();
-
-            if (valid)
-            {
 #if HAVE_SECURITY
-                if (!mp_RTPSParticipant->security_manager().discovered_writer(R->m_guid, (*pit)->m_guid,
-                        *wdatait, R->getAttributes().security_attributes()))
-                {
-                    logError(RTPS_EDP, "Security manager returns an error for reader " << reader_guid);
-                }
+            GUID_t remote_participant_guid(wdatait->guid().guidPrefix, c_EntityId_RTPSParticipant);
+            if (!mp_RTPSParticipant->security_manager().discovered_writer(R->m_guid, remote_participant_guid,
+                    *wdatait, R->getAttributes().security_attributes()))
+            {
+                logError(RTPS_EDP, "Security manager returns an error for reader " << reader_guid);
+            }
 #else
-                if (R->matched_writer_add(*wdatait))
+            if (R->matched_writer_add(*wdatait))
+            {
+                logInfo(RTPS_EDP_MATCH,
+                        "WP:" << wdatait->guid() << " match R:" << R->getGuid() << ". RLoc:" <<
+                        wdatait->remote_locators());
+                //MATCHED AND ADDED CORRECTLY:
+                if (R->getListener() != nullptr)
                 {
-                    logInfo(RTPS_EDP_MATCH,
-                            "WP:" << wdatait->guid() << " match R:" << R->getGuid() << ". RLoc:" <<
-                            wdatait->remote_locators());
-                    //MATCHED AND ADDED CORRECTLY:
-                    if (R->getListener() != nullptr)
-                    {
-                        MatchingInfo info;
-                        info.status = MATCHED_MATCHING;
-                        info.remoteEndpointGuid = writer_guid;
-                        R->getListener()->onReaderMatched(R, info);
+                    MatchingInfo info;
+                    info.status = MATCHED_MATCHING;
+                    info.remoteEndpointGuid = writer_guid;
+                    R->getListener()->onReaderMatched(R, info);
 
-                        const SubscriptionMatchedStatus& sub_info =
-                                update_subscription_matched_status(reader_guid, writer_guid, 1);
-                        R->getListener()->onReaderMatched(R, sub_info);
-                    }
+                    const SubscriptionMatchedStatus& sub_info =
+                            update_subscription_matched_status(reader_guid, writer_guid, 1);
+                    R->getListener()->onReaderMatched(R, sub_info);
                 }
-#endif // if HAVE_SECURITY
             }
-            else
+#endif // if HAVE_SECURITY
+        }
+        else
+        {
+            if (no_match_reason.test(MatchingFailureMask::incompatible_qos) && R->getListener() != nullptr)
             {
-                if (no_match_reason.test(MatchingFailureMask::incompatible_qos) && R->getListener() != nullptr)
-                {
-                    R->getListener()->on_requested_incompatible_qos(R, incompatible_qos);
-                }
+                R->getListener()->on_requested_incompatible_qos(R, incompatible_qos);
+            }
 
-                //logInfo(RTPS_EDP,RTPS_CYAN<<"Valid Matching to writerProxy: "<<wdatait->m_guid<<RTPS_DEF<<endl);
-                if (R->matched_writer_is_matched(wdatait->guid())
-                        && R->matched_writer_remove(wdatait->guid()))
-                {
+            //logInfo(RTPS_EDP,RTPS_CYAN<<"Valid Matching to writerProxy: "<<wdatait->m_guid<<RTPS_DEF<<endl);
+            if (R->matched_writer_is_matched(wdatait->guid())
+                    && R->matched_writer_remove(wdatait->guid()))
+            {
 #if HAVE_SECURITY
-                    mp_RTPSParticipant->security_manager().remove_writer(reader_guid, participant_guid,
-                            wdatait->guid());
+                mp_RTPSParticipant->security_manager().remove_writer(reader_guid, participant_guid,
+                        wdatait->guid());
 #endif // if HAVE_SECURITY
 
-                    //MATCHED AND ADDED CORRECTLY:
-                    if (R->getListener() != nullptr)
-                    {
-                        MatchingInfo info;
-                        info.status = REMOVED_MATCHING;
-                        info.remoteEndpointGuid = writer_guid;
-                        R->getListener()->onReaderMatched(R, info);
+                //MATCHED AND ADDED CORRECTLY:
+                if (R->getListener() != nullptr)
+                {
+                    MatchingInfo info;
+                    info.status = REMOVED_MATCHING;
+                    info.remoteEndpointGuid = writer_guid;
+                    R->getListener()->onReaderMatched(R, info);
 
-                        const SubscriptionMatchedStatus& sub_info =
-                                update_subscription_matched_status(reader_guid, writer_guid, -1);
-                        R->getListener()->onReaderMatched(R, sub_info);
-                    }
+                    const SubscriptionMatchedStatus& sub_info =
+                            update_subscription_matched_status(reader_guid, writer_guid, -1);
+                    R->getListener()->onReaderMatched(R, sub_info);
                 }
             }
         }
@@ -1042,80 +1043,81 @@ bool EDP::pairingWriter(
     logInfo(RTPS_EDP, W->getGuid() << " in topic: \"" << wdata.topicName() << "\"");
     std::lock_guard<std::recursive_mutex> pguard(*mp_PDP->getMutex());
 
-    for (ResourceLimitedVector<ParticipantProxyData*>::const_iterator pit = mp_PDP->ParticipantProxiesBegin();
-            pit != mp_PDP->ParticipantProxiesEnd(); ++pit)
+    // Only readers on the same topic may match. Listeners may add proxies to the collection, so it is accessed by
+    // position.
+    PDP::TopicIteration iteration(*mp_PDP);
+    const std::vector<ReaderProxyData*>& readers = mp_PDP->reader_proxies_on_topic(wdata.topicName());
+    for (size_t n = 0; n < readers.size(); ++n)
     {
-        for (auto& pair : *(*pit)->m_readers)
+        ReaderProxyData* rdatait = readers[n];
+        const GUID_t& reader_guid = rdatait->guid();
+        if (reader_guid == c_Guid_Unknown)
         {
-            ReaderProxyData* rdatait = pair.second;
-            const GUID_t& reader_guid = rdatait->guid();
-            if (reader_guid == c_Guid_Unknown)
-            {
-                continue;
-            }
+            continue;
+        }
 
-            MatchingFailureMask no_match_reason;
-            fastdds::dds::PolicyMask incompatible_qos;
-            bool valid = valid_matching(&wdata, rdatait, no_match_reason, incompatible_qos);
+        MatchingFailureMask no_match_reason;
+        fastdds::dds::PolicyMask incompatible_qos;
+        bool valid = valid_matching(&wdata, rdatait, no_match_reason, incompatible_qos);
 
-            if (valid)
-            {
+        if (valid)
+        {
 #if HAVE_SECURITY
-                if (!mp_RTPSParticipant->security_manager().discovered_reader(W->getGuid(), (*pit)->m_guid,
-                        *rdatait, W->getAttributes().security_attributes()))
-                {
-                    logError(RTPS_EDP, "Security manager returns an error for writer " << W->getGuid());
-                }
+            GUID_t remote_participant_guid(reader_guid.guidPrefix, c_EntityId_RTPSParticipant);
+            if (!mp_RTPSParticipant->security_manager().discovered_reader(W->getGuid(), remote_participant_guid,
+                    *rdatait, W->getAttributes().security_attributes()))
+            {
+                logError(RTPS_EDP, "Security manager returns an error for writer " << W->getGuid());
+            }
 #else
-                if (W->matched_reader_add(*rdatait))
+            if (W->matched_reader_add(*rdatait))
+            {
+                logInfo(RTPS_EDP_MATCH,
+                        "RP:" << rdatait->guid() << " match W:" << W->getGuid() << ". WLoc:" <<
+                        rdatait->remote_locators());
+                //MATCHED AND ADDED CORRECTLY:
+                if (W->getListener() != nullptr)
                 {
-                    logInfo(RTPS_EDP_MATCH,
-                            "RP:" << rdatait->guid() << " match W:" << W->getGuid() << ". WLoc:" <<
-                            rdatait->remote_locators());
-                    //MATCHED AND ADDED CORRECTLY:
-                    if (W->getListener() != nullptr)
-                    {
-                        MatchingInfo info;
-                        info.status = MATCHED_MATCHING;
-                        info.remoteEndpointGuid = reader_guid;
-                        W->getListener()->onWriterMatched(W, info);
+                    MatchingInfo info;
+                    info.status = MATCHED_MATCHING;
+                    info.remoteEndpointGuid = reader_guid;
+                    W->getListener()->onWriterMatched(W, info);
 
-                        const GUID_t& writer_guid = W->getGuid();
-                        const PublicationMatchedStatus& pub_info =
-                                update_publication_matched_status(reader_guid, writer_guid, 1);
-                        W->getListener()->onWriterMatched(W, pub_info);
-                    }
+                    const GUID_t& writer_guid = W->getGuid();
+                    const PublicationMatchedStatus& pub_info =
+                            update_publication_matched_status(reader_guid, writer_guid, 1);
+                    W->getListener()->onWriterMatched(W, pub_info);
                 }
-#endif // if HAVE_SECURITY
             }
-            else
+#endif // if HAVE_SECURITY
+        }
+        else
+        {
+            if (no_match_reason.test(MatchingFailureMask::incompatible_qos) && W->getListener() != nullptr)
             {
-                if (no_match_reason.test(MatchingFailureMask::incompatible_qos) && W->getListener() != nullptr)
-                {
-                    W->getListener()->on_offered_incompatible_qos(W, incompatible_qos);
-                }
+                W->getListener()->on_offered_incompatible_qos(W, incompatible_qos);
+            }
 
-                //logInfo(RTPS_EDP,RTPS_CYAN<<"Valid Matching to writerProxy: "<<wdatait->m_guid<<RTPS_DEF<<endl);
-                if (W->matched_reader_is_matched(reader_guid) && W->matched_reader_remove(reader_guid))
-                {
+            //logInfo(RTPS_EDP,RTPS_CYAN<<"Valid Matching to writerProxy: "<<wdatait->m_guid<<RTPS_DEF<<endl);
+            if (W->matched_reader_is_matched(reader_guid) && W->matched_reader_remove(reader_guid))
+            {
 #if HAVE_SECURITY
-                    mp_RTPSParticipant->security_manager().remove_reader(W->getGuid(), participant_guid, reader_guid);
+                mp_RTPSParticipant->security_manager().remove_reader(W->getGuid(), participant_guid, reader_guid);
 #endif // if HAVE_SECURITY
-                    //MATCHED AND ADDED CORRECTLY:
-                    if (W->getListener() != nullptr)
-                    {
-                        MatchingInfo info;
-                        info.status = REMOVED_MATCHING;
-                        info.remoteEndpointGuid = reader_guid;
-                        W->getListener()->onWriterMatched(W, info);
+                //MATCHED AND ADDED CORRECTLY:
+                if (W->getListener() != nullptr)
+                {
+                    MatchingInfo info;
+                    info.status = REMOVED_MATCHING;
+                    info.remoteEndpointGuid = reader_guid;
+                    W->getListener()->onWriterMatched(W, info);
 
-                        const GUID_t& writer_guid = W->getGuid();
-                        const PublicationMatchedStatus& pub_info =
-                                update_publication_matched_status(reader_guid, writer_guid, -1);
-                        W->getListener()->onWriterMatched(W, pub_info);
+                    const GUID_t& writer_guid = W->getGuid();
+                    const PublicationMatchedStatus& pub_info =
+                            update_publication_matched_status(reader_guid, writer_guid, -1);
+                    W->getListener()->onWriterMatched(W, pub_info);
 
 
-                    }
                 }
             }
         }
@@ -1132,73 +1134,77 @@ bool EDP::pairing_reader_proxy_with_any_local_writer(
     logInfo(RTPS_EDP, rdata->guid() << " in topic: \"" << rdata->topicName() << "\"");
     std::lock_guard<std::recursive_mutex> pguard(*mp_PDP->getMutex());
     std::lock_guard<std::recursive_mutex> guard(*mp_RTPSParticipant->getParticipantMutex());
-    for (std::vector<RTPSWriter*>::iterator wit = mp_RTPSParticipant->userWritersListBegin();
-            wit != mp_RTPSParticipant->userWritersListEnd(); ++wit)
+
+    // Only local writers on the same topic may match
+    const GuidPrefix_t& local_prefix = mp_RTPSParticipant->getGuid().guidPrefix;
+    PDP::TopicIteration iteration(*mp_PDP);
+    const std::vector<WriterProxyData*>& writers = mp_PDP->writer_proxies_on_topic(rdata->topicName());
+    for (size_t n = 0; n < writers.size(); ++n)
     {
-        (*wit)->getMutex().lock();
-        GUID_t writerGUID = (*wit)->getGuid();
-        (*wit)->getMutex().unlock();
-        if (mp_PDP->lookupWriterProxyData(writerGUID, temp_writer_proxy_data_))
+        GUID_t writerGUID = writers[n]->guid();
+        RTPSWriter* writer = writerGUID.guidPrefix == local_prefix ?
+                mp_RTPSParticipant->find_local_writer(writerGUID) : nullptr;
+        if (writer != nullptr)
         {
             MatchingFailureMask no_match_reason;
             fastdds::dds::PolicyMask incompatible_qos;
-            bool valid = valid_matching(&temp_writer_proxy_data_, rdata, no_match_reason, incompatible_qos);
+            bool valid = valid_matching(writers[n], rdata, no_match_reason, incompatible_qos);
             const GUID_t& reader_guid = rdata->guid();
 
             if (valid)
             {
 #if HAVE_SECURITY
                 if (!mp_RTPSParticipant->security_manager().discovered_reader(writerGUID, participant_guid,
-                        *rdata, (*wit)->getAttributes().security_attributes()))
+                        *rdata, writer->getAttributes().security_attributes()))
                 {
                     logError(RTPS_EDP, "Security manager returns an error for writer " << writerGUID);
                 }
 #else
-                if ((*wit)->matched_reader_add(*rdata))
+                if (writer->matched_reader_add(*rdata))
                 {
                     logInfo(RTPS_EDP_MATCH,
-                            "RP:" << rdata->guid() << " match W:" << (*wit)->getGuid() << ". RLoc:" <<
+                            "RP:" << rdata->guid() << " match W:" << writer->getGuid() << ". RLoc:" <<
                             rdata->remote_locators());
                     //MATCHED AND ADDED CORRECTLY:
-                    if ((*wit)->getListener() != nullptr)
+                    if (writer->getListener() != nullptr)
                     {
                         MatchingInfo info;
                         info.status = MATCHED_MATCHING;
                         info.remoteEndpointGuid = reader_guid;
-                        (*wit)->getListener()->onWriterMatched((*wit), info);
+                        writer->getListener()->onWriterMatched(writer, info);
 
                         const PublicationMatchedStatus& pub_info =
                                 update_publication_matched_status(reader_guid, writerGUID, 1);
-                        (*wit)->getListener()->onWriterMatched((*wit), pub_info);
+                        writer->getListener()->onWriterMatched(writer, pub_info);
                     }
                 }
 #endif // if HAVE_SECURITY
             }
             else
             {
-                if (no_match_reason.test(MatchingFailureMask::incompatible_qos) && (*wit)->getListener() != nullptr)
+                if (no_match_reason.test(MatchingFailureMask::incompatible_qos) && writer->getListener() != nullptr)
                 {
-                    (*wit)->getListener()->on_offered_incompatible_qos((*wit), incompatible_qos);
+                    writer->getListener()->on_offered_incompatible_qos(writer, incompatible_qos);
                 }
 
-                if ((*wit)->matched_reader_is_matched(reader_guid)
-                        && (*wit)->matched_reader_remove(reader_guid))
+                if (writer->matched_reader_is_matched(reader_guid)
+                        && writer->matched_reader_remove(reader_guid))
                 {
 #if HAVE_SECURITY
                     mp_RTPSParticipant->security_manager().remove_reader(
-                        (*wit)->getGuid(), participant_guid, reader_guid);
+                        writer->getGuid(), participant_guid, reader_guid);
 #endif // if HAVE_SECURITY
                     //MATCHED AND ADDED CORRECTLY:
-                    if ((*wit)->getListener() != nullptr)
+                    if (writer->getListener() != nullptr)
                     {
                         MatchingInfo info;
                         info.status = REMOVED_MATCHING;
                         info.remoteEndpointGuid = reader_guid;
-                        (*wit)->getListener()->onWriterMatched((*wit), info);
+                        writer->getListener()->onWriterMatched(writer, info);
 
                         const PublicationMatchedStatus& pub_info =
                                 update_publication_matched_status(reader_guid, writerGUID, -1);
-                        (*wit)->getListener()->onWriterMatched((*wit), pub_info);
+                        writer->getListener()->onWriterMatched(writer, pub_info);
                     }
                 }
             }
@@ -1327,74 +1333,77 @@ bool EDP::pairing_writer_proxy_with_any_local_reader(
     logInfo(RTPS_EDP, wdata->guid() << " in topic: \"" << wdata->topicName() << "\"");
     std::lock_guard<std::recursive_mutex> pguard(*mp_PDP->getMutex());
     std::lock_guard<std::recursive_mutex> guard(*mp_RTPSParticipant->getParticipantMutex());
-    for (std::vector<RTPSReader*>::iterator rit = mp_RTPSParticipant->userReadersListBegin();
-            rit != mp_RTPSParticipant->userReadersListEnd(); ++rit)
+
+    // Only local readers on the same topic may match
+    const GuidPrefix_t& local_prefix = mp_RTPSParticipant->getGuid().guidPrefix;
+    PDP::TopicIteration iteration(*mp_PDP);
+    const std::vector<ReaderProxyData*>& readers = mp_PDP->reader_proxies_on_topic(wdata->topicName());
+    for (size_t n = 0; n < readers.size(); ++n)
     {
-        GUID_t readerGUID;
-        (*rit)->getMutex().lock();
-        readerGUID = (*rit)->getGuid();
-        (*rit)->getMutex().unlock();
-        if (mp_PDP->lookupReaderProxyData(readerGUID, temp_reader_proxy_data_))
+        GUID_t readerGUID = readers[n]->guid();
+        RTPSReader* reader = readerGUID.guidPrefix == local_prefix ?
+                mp_RTPSParticipant->find_local_reader(readerGUID) : nullptr;
+        if (reader != nullptr)
         {
             MatchingFailureMask no_match_reason;
             fastdds::dds::PolicyMask incompatible_qos;
-            bool valid = valid_matching(&temp_reader_proxy_data_, wdata, no_match_reason, incompatible_qos);
+            bool valid = valid_matching(readers[n], wdata, no_match_reason, incompatible_qos);
             const GUID_t& writer_guid = wdata->guid();
 
             if (valid)
             {
 #if HAVE_SECURITY
                 if (!mp_RTPSParticipant->security_manager().discovered_writer(readerGUID, participant_guid,
-                        *wdata, (*rit)->getAttributes().security_attributes()))
+                        *wdata, reader->getAttributes().security_attributes()))
                 {
                     logError(RTPS_EDP, "Security manager returns an error for reader " << readerGUID);
                 }
 #else
-                if ((*rit)->matched_writer_add(*wdata))
+                if (reader->matched_writer_add(*wdata))
                 {
                     logInfo(RTPS_EDP_MATCH,
-                            "WP:" << wdata->guid() << " match R:" << (*rit)->getGuid() << ". WLoc:" <<
+                            "WP:" << wdata->guid() << " match R:" << reader->getGuid() << ". WLoc:" <<
                             wdata->remote_locators());
                     //MATCHED AND ADDED CORRECTLY:
-                    if ((*rit)->getListener() != nullptr)
+                    if (reader->getListener() != nullptr)
                     {
                         MatchingInfo info;
                         info.status = MATCHED_MATCHING;
                         info.remoteEndpointGuid = writer_guid;
-                        (*rit)->getListener()->onReaderMatched((*rit), info);
+                        reader->getListener()->onReaderMatched(reader, info);
 
 
                         const SubscriptionMatchedStatus& sub_info =
                                 update_subscription_matched_status(readerGUID, writer_guid, 1);
-                        (*rit)->getListener()->onReaderMatched((*rit), sub_info);
+                        reader->getListener()->onReaderMatched(reader, sub_info);
                     }
                 }
 #endif // if HAVE_SECURITY
             }
             else
             {
-                if (no_match_reason.test(MatchingFailureMask::incompatible_qos) && (*rit)->getListener() != nullptr)
+                if (no_match_reason.test(MatchingFailureMask::incompatible_qos) && reader->getListener() != nullptr)
                 {
-                    (*rit)->getListener()->on_requested_incompatible_qos((*rit), incompatible_qos);
+                    reader->getListener()->on_requested_incompatible_qos(reader, incompatible_qos);
                 }
 
-                if ((*rit)->matched_writer_is_matched(writer_guid)
-                        && (*rit)->matched_writer_remove(writer_guid))
+                if (reader->matched_writer_is_matched(writer_guid)
+                        && reader->matched_writer_remove(writer_guid))
                 {
 #if HAVE_SECURITY
                     mp_RTPSParticipant->security_manager().remove_writer(readerGUID, participant_guid, writer_guid);
 #endif // if HAVE_SECURITY
                     //MATCHED AND ADDED CORRECTLY:
-                    if ((*rit)->getListener() != nullptr)
+                    if (reader->getListener() != nullptr)
                     {
                         MatchingInfo info;
                         info.status = REMOVED_MATCHING;
                         info.remoteEndpointGuid = writer_guid;
-                        (*rit)->getListener()->onReaderMatched((*rit), info);
+                        reader->getListener()->onReaderMatched(reader, info);
 
                         const SubscriptionMatchedStatus& sub_info =
                                 update_subscription_matched_status(readerGUID, writer_guid, -1);
-                        (*rit)->getListener()->onReaderMatched((*rit), sub_info);
+                        reader->getListener()->onReaderMatched(reader, sub_info);
                     }
                 }
             }
@@ -55,6 +55,7 @@
 
 #include <fastdds/dds/builtin/typelookup/TypeLookupManager.hpp>
 #include <rtps/builtin/data/ProxyHashTables.hpp>
+#include <rtps/builtin/data/ProxyTopicIndex.hpp>
 
 #include <fastdds/dds/log/Log.hpp>
 
@@ -91,6 +92,8 @@ PDP::PDP (
     , reader_proxies_pool_(allocation.total_readers())
     , writer_proxies_number_(allocation.total_writers().initial)
     , writer_proxies_pool_(allocation.total_writers())
+    , reader_topic_index_(new ProxyTopicIndex<ReaderProxyData>())
+    , writer_topic_index_(new ProxyTopicIndex<WriterProxyData>())
     , m_hasChangedLocalPDP(true)
     , mp_listener(nullptr)
     , mp_PDPWriterHistory(nullptr)
@@ -154,6 +157,8 @@ PDP::~PDP()
         delete it;
     }
 
+    delete reader_topic_index_;
+    delete writer_topic_index_;
     delete mp_mutex;
 }
 
@@ -546,6 +551,32 @@ bool PDP::lookupWriterProxyData(
     return false;
 }
 
+PDP::TopicIteration::TopicIteration(
+        const PDP& pdp)
+    : pdp_(pdp)
+{
+    pdp_.reader_topic_index_->begin_iteration();
+    pdp_.writer_topic_index_->begin_iteration();
+}
+
+PDP::TopicIteration::~TopicIteration()
+{
+    pdp_.reader_topic_index_->end_iteration();
+    pdp_.writer_topic_index_->end_iteration();
+}
+
+const std::vector<ReaderProxyData*>& PDP::reader_proxies_on_topic(
+        const string_255& topic_name) const
+{
+    return reader_topic_index_->find(topic_name);
+}
+
+const std::vector<WriterProxyData*>& PDP::writer_proxies_on_topic(
+        const string_255& topic_name) const
+{
+    return writer_topic_index_->find(topic_name);
+}
+
 bool PDP::removeReaderProxyData(
         const GUID_t& reader_guid)
 {
@@ -561,6 +592,7 @@ bool PDP::removeReaderProxyData(
             if (rit != pit->m_readers->end())
             {
                 ReaderProxyData* pR = rit->second;
+                reader_topic_index_->remove(pR);
                 mp_EDP->unpairReaderProxy(pit->m_guid, reader_guid);
 
                 RTPSParticipantListener* listener = mp_RTPSParticipant->getListener();
@@ -598,6 +630,7 @@ bool PDP::removeWriterProxyData(
             if (wit != pit->m_writers->end())
             {
                 WriterProxyData* pW = wit->second;
+                writer_topic_index_->remove(pW);
                 mp_EDP->unpairWriterProxy(pit->m_guid, writer_guid);
 
                 RTPSParticipantListener* listener = mp_RTPSParticipant->getListener();
@@ -677,7 +710,11 @@ ReaderProxyData* PDP::addReaderProxyData(
             {
                 ret_val = rpi->second;
 
-                if (!initializer_func(ret_val, true, *pit))
+                // Topic name may be updated by the initializer
+                reader_topic_index_->remove(ret_val);
+                bool updated = initializer_func(ret_val, true, *pit);
+                reader_topic_index_->add(ret_val);
+                if (!updated)
                 {
                     return nullptr;
                 }
@@ -724,7 +761,9 @@ ReaderProxyData* PDP::addReaderProxyData(
             // Add to ParticipantProxyData
             (*pit->m_readers)[reader_guid.entityId] = ret_val;
 
-            if (!initializer_func(ret_val, false, *pit))
+            bool initialized = initializer_func(ret_val, false, *pit);
+            reader_topic_index_->add(ret_val);
+            if (!initialized)
             {
                 return nullptr;
             }
@@ -769,7 +808,11 @@ WriterProxyData* PDP::addWriterProxyData(
             {
                 ret_val = wpi->second;
 
-                if (!initializer_func(ret_val, true, *pit))
+                // Topic name may be updated by the initializer
+                writer_topic_index_->remove(ret_val);
+                bool updated = initializer_func(ret_val, true, *pit);
+                writer_topic_index_->add(ret_val);
+                if (!updated)
                 {
                     return nullptr;
                 }
@@ -816,7 +859,9 @@ WriterProxyData* PDP::addWriterProxyData(
             // Add to ParticipantProxyData
             (*pit->m_writers)[writer_guid.entityId] = ret_val;
 
-            if (!initializer_func(ret_val, false, *pit))
+            bool initialized = initializer_func(ret_val, false, *pit);
+            writer_topic_index_->add(ret_val);
+            if (!initialized)
             {
                 return nullptr;
             }
@@ -859,6 +904,16 @@ bool PDP::remove_remote_participant(
         {
             pdata = *pit;
             participant_proxies_.erase(pit);
+
+            // Endpoints of the participant should not be matched anymore
+            for (auto rit : *pdata->m_readers)
+            {
+                reader_topic_index_->remove(rit.second);
+            }
+            for (auto wit : *pdata->m_writers)
+            {
+                writer_topic_index_->remove(wit.second);
+            }
             break;
         }
     }
@@ -0,0 +1,380 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file SchedulingFlowController.cpp
+ */
+
+#include <rtps/flowcontrol/SchedulingFlowController.h>
+
+#include <fastdds/dds/log/Log.hpp>
+#include <fastdds/rtps/attributes/PropertyPolicy.h>
+#include <fastdds/rtps/writer/RTPSWriter.h>
+
+#include <algorithm>
+#include <string>
+
+namespace eprosima {
+namespace fastrtps {
+namespace rtps {
+
+constexpr uint32_t SchedulingFlowController::turn_quantum;
+
+//! Size of the payload sent on the submessage of a collector item.
+template<typename Item>
+static uint32_t item_size(
+        const Item& item)
+{
+    const CacheChange_t* change = item.cacheChange;
+    if (0 == item.fragmentNumber)
+    {
+        return change->serializedPayload.length;
+    }
+
+    // Fragment numbers are 1-based
+    uint32_t offset = (item.fragmentNumber - 1) * change->getFragmentSize();
+    return (std::min)(static_cast<uint32_t>(change->getFragmentSize()), change->serializedPayload.length - offset);
+}
+
+SchedulingFlowController::SchedulingFlowController(
+        const FlowControllerDescriptor& descriptor)
+    : descriptor_(descriptor)
+    , tokens_(descriptor.max_bytes_per_period)
+    , last_refill_(clock::now())
+{
+    if (is_limited() && 0 == descriptor_.period_ms)
+    {
+        descriptor_.period_ms = 1;
+    }
+}
+
+SchedulingFlowController::~SchedulingFlowController()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    running_ = false;
+    cv_.notify_all();
+    if (thread_.joinable())
+    {
+        lock.unlock();
+        thread_.join();
+    }
+}
+
+void SchedulingFlowController::register_writer(
+        RTPSWriter* writer,
+        const PropertyPolicy& properties)
+{
+    int32_t priority = 0;
+    const std::string* property = PropertyPolicyHelper::find_property(properties, "fastdds.sfc.priority");
+    if (property != nullptr)
+    {
+        try
+        {
+            priority = std::stoi(*property);
+        }
+        catch (std::exception&)
+        {
+            logError(RTPS_WRITER, "Wrong value '" << *property << "' for property fastdds.sfc.priority");
+        }
+    }
+
+    std::lock_guard<std::mutex> guard(mutex_);
+    WriterState& state = writers_[writer];
+    state.writer = writer;
+    state.statistics.writer_guid = writer->getGuid();
+    state.statistics.priority = priority;
+    state.window_start = clock::now();
+
+    // The thread lives as long as the controller, so writers coming and going do not create threads
+    if (!running_)
+    {
+        running_ = true;
+        thread_ = std::thread(&SchedulingFlowController::run, this);
+    }
+
+    logInfo(RTPS_WRITER, "Writer " << writer->getGuid() << " attached to flow controller " << descriptor_.name);
+}
+
+void SchedulingFlowController::unregister_writer(
+        RTPSWriter* writer)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    auto it = writers_.find(writer);
+    if (it == writers_.end())
+    {
+        return;
+    }
+
+    WriterState* state = &it->second;
+    cv_.wait(lock, [this, state]()
+            {
+                return current_ != state;
+            });
+
+    queue_.erase(std::remove(queue_.begin(), queue_.end(), state), queue_.end());
+    writers_.erase(it);
+}
+
+void SchedulingFlowController::wake_up(
+        RTPSWriter* writer)
+{
+    std::lock_guard<std::mutex> guard(mutex_);
+    auto it = writers_.find(writer);
+    if (it != writers_.end())
+    {
+        enqueue_nts(it->second, false);
+    }
+}
+
+void SchedulingFlowController::filter(
+        RTPSWriter* writer,
+        RTPSWriterCollector<ReaderLocator*>& changes)
+{
+    std::lock_guard<std::mutex> guard(mutex_);
+    auto it = writers_.find(writer);
+    if (it != writers_.end())
+    {
+        filter_nts(it->second, changes);
+    }
+}
+
+void SchedulingFlowController::filter(
+        RTPSWriter* writer,
+        RTPSWriterCollector<ReaderProxy*>& changes)
+{
+    std::lock_guard<std::mutex> guard(mutex_);
+    auto it = writers_.find(writer);
+    if (it != writers_.end())
+    {
+        filter_nts(it->second, changes);
+    }
+}
+
+void SchedulingFlowController::get_statistics(
+        std::vector<FlowControllerWriterStatistics>& statistics) const
+{
+    std::lock_guard<std::mutex> guard(mutex_);
+    auto now = clock::now();
+    for (const auto& it : writers_)
+    {
+        statistics.push_back(it.second.statistics);
+
+        // The current window is already complete when the writer has not sent anything for a while
+        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - it.second.window_start).count();
+        if (1000 <= elapsed)
+        {
+            statistics.back().bytes_per_second = it.second.window_bytes * 1000 / static_cast<uint64_t>(elapsed);
+        }
+    }
+}
+
+template<typename Collector>
+void SchedulingFlowController::filter_nts(
+        WriterState& state,
+        Collector& changes)
+{
+    auto& items = changes.items();
+    auto it = items.begin();
+
+    // Changes are only sent on the turns of the writer
+    if (&state == current_)
+    {
+        auto now = clock::now();
+        bool share_turns = FIFO_SCHEDULER != descriptor_.scheduler;
+        if (is_limited())
+        {
+            refill_nts(now);
+        }
+
+        for (; it != items.end(); ++it)
+        {
+            uint32_t size = item_size(*it);
+
+            // A change bigger than the bucket is sent when the bucket is full
+            if (is_limited() && tokens_ < size && tokens_ < descriptor_.max_bytes_per_period)
+            {
+                break;
+            }
+
+            if (share_turns && 0 < turn_bytes_ && turn_quantum < turn_bytes_ + size)
+            {
+                break;
+            }
+
+            if (is_limited())
+            {
+                tokens_ -= size;
+            }
+            turn_bytes_ += size;
+            account_sent_nts(state, size, now);
+        }
+    }
+
+    uint64_t queued_bytes = 0;
+    state.next_change_size = (it != items.end()) ? item_size(*it) : 0;
+    for (auto deferred = it; deferred != items.end(); ++deferred)
+    {
+        queued_bytes += item_size(*deferred);
+        ++state.statistics.submessages_deferred;
+    }
+    state.statistics.queued_bytes = queued_bytes;
+    state.statistics.max_queued_bytes = (std::max)(state.statistics.max_queued_bytes, queued_bytes);
+
+    if (it != items.end())
+    {
+        items.erase(it, items.end());
+        if (&state == current_)
+        {
+            turn_limited_ = true;
+        }
+        else
+        {
+            enqueue_nts(state, false);
+        }
+    }
+}
+
+void SchedulingFlowController::account_sent_nts(
+        WriterState& state,
+        uint32_t size,
+        const clock::time_point& now)
+{
+    FlowControllerWriterStatistics& statistics = state.statistics;
+    statistics.bytes_sent += size;
+    ++statistics.submessages_sent;
+
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - state.window_start).count();
+    if (1000 <= elapsed)
+    {
+        statistics.bytes_per_second = state.window_bytes * 1000 / static_cast<uint64_t>(elapsed);
+        state.window_start = now;
+        state.window_bytes = 0;
+    }
+    state.window_bytes += size;
+}
+
+void SchedulingFlowController::enqueue_nts(
+        WriterState& state,
+        bool keep_place)
+{
+    if (&state == current_)
+    {
+        state.turn_requested = true;
+    }
+    else if (!state.queued)
+    {
+        state.queued = true;
+        if (keep_place)
+        {
+            queue_.push_front(&state);
+        }
+        else
+        {
+            queue_.push_back(&state);
+        }
+        cv_.notify_all();
+    }
+}
+
+std::deque<SchedulingFlowController::WriterState*>::iterator SchedulingFlowController::select_nts()
+{
+    if (HIGH_PRIORITY_SCHEDULER != descriptor_.scheduler)
+    {
+        return queue_.begin();
+    }
+
+    // First writer of the highest priority, so writers with the same priority take turns
+    return std::min_element(queue_.begin(), queue_.end(),
+                   [](const WriterState* a, const WriterState* b)
+                   {
+                       return a->statistics.priority < b->statistics.priority;
+                   });
+}
+
+void SchedulingFlowController::refill_nts(
+        const clock::time_point& now)
+{
+    int64_t capacity = descriptor_.max_bytes_per_period;
+    if (tokens_ >= capacity)
+    {
+        last_refill_ = now;
+        return;
+    }
+
+    int64_t period_us = static_cast<int64_t>(descriptor_.period_ms) * 1000;
+    int64_t elapsed_us = std::chrono::duration_cast<std::chrono::microseconds>(now - last_refill_).count();
+    int64_t refilled = elapsed_us * capacity / period_us;
+    if (0 < refilled)
+    {
+        tokens_ = (std::min)(capacity, tokens_ + refilled);
+        last_refill_ = now;
+    }
+}
+
+void SchedulingFlowController::run()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (running_)
+    {
+        if (queue_.empty())
+        {
+            cv_.wait(lock);
+            continue;
+        }
+
+        auto next = select_nts();
+        WriterState* state = *next;
+
+        // Wait until the bucket has enough tokens for the first change the writer could not send
+        if (is_limited())
+        {
+            auto now = clock::now();
+            refill_nts(now);
+            int64_t needed = (std::min)(static_cast<int64_t>(state->next_change_size),
+                            static_cast<int64_t>(descriptor_.max_bytes_per_period));
+            if (tokens_ < (std::max)(needed, int64_t(1)))
+            {
+                int64_t missing = (std::max)(needed, int64_t(1)) - tokens_;
+                int64_t wait_us = missing * descriptor_.period_ms * 1000 / descriptor_.max_bytes_per_period + 1;
+                cv_.wait_until(lock, now + std::chrono::microseconds(wait_us));
+                continue;
+            }
+        }
+
+        queue_.erase(next);
+        state->queued = false;
+        state->turn_requested = false;
+        current_ = state;
+        turn_bytes_ = 0;
+        turn_limited_ = false;
+
+        lock.unlock();
+        state->writer->send_any_unsent_changes();
+        lock.lock();
+
+        current_ = nullptr;
+        if (turn_limited_ || state->turn_requested)
+        {
+            // On FIFO, a writer keeps its place until it has sent everything
+            enqueue_nts(*state, FIFO_SCHEDULER == descriptor_.scheduler && turn_limited_);
+        }
+
+        // Writers being unregistered wait for the turn to finish
+        cv_.notify_all();
+    }
+}
+
+} // namespace rtps
+} // namespace fastrtps
+} // namespace eprosima
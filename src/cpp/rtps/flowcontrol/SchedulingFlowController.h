@@ -0,0 +1,203 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file SchedulingFlowController.h
+ */
+
+#ifndef _RTPS_FLOWCONTROL_SCHEDULINGFLOWCONTROLLER_H_
+#define _RTPS_FLOWCONTROL_SCHEDULINGFLOWCONTROLLER_H_
+
+#include <fastdds/rtps/flowcontrol/FlowControllerDescriptor.h>
+#include <fastdds/rtps/flowcontrol/FlowControllerStatistics.h>
+#include <rtps/writer/RTPSWriterCollector.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace eprosima {
+namespace fastrtps {
+namespace rtps {
+
+class PropertyPolicy;
+class ReaderLocator;
+class ReaderProxy;
+class RTPSWriter;
+
+/**
+ * Flow controller registered on a participant, shared by the writers referencing it by name.
+ *
+ * The controller has its own thread, which gives turns to its writers to send their unsent changes. The writer
+ * getting the next turn is chosen by the scheduler policy of the controller, and the data sent on each turn is
+ * limited by a token bucket shared by all the writers. While sending, writers call filter() to know which of their
+ * changes they can send on the current turn.
+ *
+ * Unlike FlowController filters, it does not use timers, and a writer blocked by it does not delay other writers.
+ */
+class SchedulingFlowController
+{
+public:
+
+    //! Bytes a writer may send on a turn, when the policy shares the controller between writers.
+    static constexpr uint32_t turn_quantum = 65536;
+
+    explicit SchedulingFlowController(
+            const FlowControllerDescriptor& descriptor);
+
+    ~SchedulingFlowController();
+
+    SchedulingFlowController(
+            const SchedulingFlowController&) = delete;
+
+    SchedulingFlowController& operator =(
+            const SchedulingFlowController&) = delete;
+
+    const FlowControllerDescriptor& descriptor() const
+    {
+        return descriptor_;
+    }
+
+    /**
+     * Attach a writer to this controller.
+     * @param writer      Writer to attach.
+     * @param properties  Properties of the writer, where its priority is read from.
+     */
+    void register_writer(
+            RTPSWriter* writer,
+            const PropertyPolicy& properties);
+
+    /**
+     * Detach a writer from this controller, waiting for its current turn to finish.
+     * It should not be called with the mutex of the writer taken.
+     * @param writer  Writer to detach.
+     */
+    void unregister_writer(
+            RTPSWriter* writer);
+
+    /**
+     * Request a turn for a writer which has changes to send.
+     * @param writer  Writer requesting the turn.
+     */
+    void wake_up(
+            RTPSWriter* writer);
+
+    /**
+     * Remove from a collection the changes a writer cannot send on the current turn.
+     * Changes removed are kept by the writer as unsent, and a following turn is scheduled for them.
+     * @param writer   Writer sending the changes.
+     * @param changes  Changes the writer wants to send, in sending order.
+     */
+    void filter(
+            RTPSWriter* writer,
+            RTPSWriterCollector<ReaderLocator*>& changes);
+
+    //! @copydoc filter
+    void filter(
+            RTPSWriter* writer,
+            RTPSWriterCollector<ReaderProxy*>& changes);
+
+    /**
+     * Get the statistics of the writers attached to this controller.
+     * @param [out] statistics  Where the statistics of each writer are appended to.
+     */
+    void get_statistics(
+            std::vector<FlowControllerWriterStatistics>& statistics) const;
+
+private:
+
+    using clock = std::chrono::steady_clock;
+
+    struct WriterState
+    {
+        RTPSWriter* writer = nullptr;
+        FlowControllerWriterStatistics statistics;
+        //! Waiting on the queue for a turn.
+        bool queued = false;
+        //! Should be queued again at the end of its current turn.
+        bool turn_requested = false;
+        //! Size of the first change it could not send. Zero when unknown.
+        uint32_t next_change_size = 0;
+        //! Beginning of the window where bytes_per_second is measured.
+        clock::time_point window_start;
+        //! Bytes sent since window_start.
+        uint64_t window_bytes = 0;
+    };
+
+    template<typename Collector>
+    void filter_nts(
+            WriterState& state,
+            Collector& changes);
+
+    void account_sent_nts(
+            WriterState& state,
+            uint32_t size,
+            const clock::time_point& now);
+
+    void enqueue_nts(
+            WriterState& state,
+            bool keep_place);
+
+    std::deque<WriterState*>::iterator select_nts();
+
+    void refill_nts(
+            const clock::time_point& now);
+
+    bool is_limited() const
+    {
+        return 0 < descriptor_.max_bytes_per_period;
+    }
+
+    void run();
+
+    FlowControllerDescriptor descriptor_;
+
+    mutable std::mutex mutex_;
+
+    std::condition_variable cv_;
+
+    std::map<RTPSWriter*, WriterState> writers_;
+
+    //! Writers waiting for a turn, in arrival order.
+    std::deque<WriterState*> queue_;
+
+    //! Writer having the turn.
+    WriterState* current_ = nullptr;
+
+    //! Bytes sent on the current turn.
+    uint64_t turn_bytes_ = 0;
+
+    //! Whether some change was deferred on the current turn.
+    bool turn_limited_ = false;
+
+    //! Bytes available on the token bucket. May be negative after sending a change bigger than the bucket.
+    int64_t tokens_ = 0;
+
+    clock::time_point last_refill_;
+
+    bool running_ = false;
+
+    std::thread thread_;
+};
+
+} // namespace rtps
+} // namespace fastrtps
+} // namespace eprosima
+
+#endif // _RTPS_FLOWCONTROL_SCHEDULINGFLOWCONTROLLER_H_
@@ -133,7 +133,7 @@ void ThroughputController::ScheduleRefresh(
 
                     if (mAssociatedWriter)
                     {
-                        mAssociatedWriter->getRTPSParticipant()->async_thread().wake_up(mAssociatedWriter);
+                        mAssociatedWriter->wake_up_async_thread();
                     }
                     else if (mAssociatedParticipant)
                     {
@@ -141,7 +141,7 @@ void ThroughputController::ScheduleRefresh(
                         for (auto it = mAssociatedParticipant->userWritersListBegin();
                                 it != mAssociatedParticipant->userWritersListEnd(); ++it)
                         {
-                            mAssociatedParticipant->async_thread().wake_up(*it);
+                            (*it)->wake_up_async_thread();
                         }
                     }
                 }
@@ -25,6 +25,7 @@
 
 #include <rtps/history/BasicPayloadPool.hpp>
 #include <rtps/history/CacheChangePool.h>
+#include <rtps/history/SharedPayloadPool.hpp>
 
 #include <mutex>
 
@@ -52,7 +53,14 @@ History::History(
         static_cast<uint32_t>(max_caches)
     };
 
-    payload_pool_ = BasicPayloadPool::get(pool_config);
+    if (att.sharedPayloads)
+    {
+        payload_pool_ = std::make_shared<SharedPayloadPool>(pool_config);
+    }
+    else
+    {
+        payload_pool_ = BasicPayloadPool::get(pool_config);
+    }
 
     if ((att.memoryPolicy == PREALLOCATED_MEMORY_MODE) || (att.memoryPolicy == PREALLOCATED_WITH_REALLOC_MEMORY_MODE))
     {
@@ -89,6 +97,31 @@ History::~History()
     payload_pool_.reset();
 }
 
+bool History::reserve_Cache(
+        CacheChange_t** change,
+        CacheChange_t* received)
+{
+    std::lock_guard<RecursiveTimedMutex> guard(*mp_mutex);
+    CacheChange_t* reserved_change = nullptr;
+    if (change_pool_->reserve_cache(reserved_change))
+    {
+        reserved_change->copy_not_memcpy(received);
+
+        IPayloadPool* payload_owner = received->payload_owner();
+        if (payload_pool_->get_payload(received->serializedPayload, payload_owner, *reserved_change))
+        {
+            // Fragment count depends on the payload length, so it is calculated again
+            reserved_change->setFragmentSize(received->getFragmentSize(), false);
+            *change = reserved_change;
+            return true;
+        }
+
+        change_pool_->release_cache(reserved_change);
+    }
+
+    return false;
+}
+
 void History::do_release_cache(
         CacheChange_t* ch)
 {
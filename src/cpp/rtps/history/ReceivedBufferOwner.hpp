@@ -0,0 +1,261 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file ReceivedBufferOwner.hpp
+ */
+
+#ifndef RTPS_HISTORY_RECEIVEDBUFFEROWNER_HPP
+#define RTPS_HISTORY_RECEIVEDBUFFEROWNER_HPP
+
+#include <fastdds/rtps/common/CacheChange.h>
+#include <fastdds/rtps/history/IPayloadPool.h>
+
+#include <atomic>
+#include <cassert>
+#include <memory>
+
+namespace eprosima {
+namespace fastrtps {
+namespace rtps {
+
+/**
+ * Payload owner of the changes pointing to a reception buffer they keep alive.
+ *
+ * It is reference counted by the changes it owns, and destroys itself, releasing the buffer, when the last of them
+ * is released. Releasing a payload does not need any lock or lookup.
+ */
+class ReceivedBuffer : public IPayloadPool
+{
+public:
+
+    /**
+     * @param holder  Object keeping the buffer alive.
+     *
+     * The caller gets the first reference, which should be given back with @ref release_reference.
+     */
+    explicit ReceivedBuffer(
+            const std::shared_ptr<void>& holder)
+        : IPayloadPool(OwnerKind::RECEIVED_BUFFER)
+        , ref_count_(1u)
+        , holder_(holder)
+    {
+    }
+
+    //! Give back a reference not associated to a change.
+    void release_reference()
+    {
+        if (1u == ref_count_.fetch_sub(1u, std::memory_order_acq_rel))
+        {
+            delete this;
+        }
+    }
+
+    bool get_payload(
+            uint32_t /* size */,
+            CacheChange_t& /* cache_change */) override
+    {
+        return false;
+    }
+
+    bool get_payload(
+            SerializedPayload_t& data,
+            IPayloadPool*& data_owner,
+            CacheChange_t& cache_change) override
+    {
+        if (data_owner != this)
+        {
+            return false;
+        }
+
+        keep(data, cache_change);
+        return true;
+    }
+
+    bool release_payload(
+            CacheChange_t& cache_change) override
+    {
+        assert(cache_change.payload_owner() == this);
+
+        // Data belongs to the reception buffer
+        SerializedPayload_t& payload = cache_change.serializedPayload;
+        payload.data = nullptr;
+        payload.max_size = 0;
+        payload.length = 0;
+        payload.pos = 0;
+        cache_change.payload_owner(nullptr);
+
+        release_reference();
+        return true;
+    }
+
+    /**
+     * Point a change to some data of the buffer, taking a new reference to it.
+     *
+     * @param data          Data living on the buffer.
+     * @param cache_change  Change that will keep the buffer alive until it is released.
+     */
+    void keep(
+            const SerializedPayload_t& data,
+            CacheChange_t& cache_change)
+    {
+        ref_count_.fetch_add(1u, std::memory_order_relaxed);
+
+        SerializedPayload_t& payload = cache_change.serializedPayload;
+        if (nullptr != payload.data)
+        {
+            payload.empty();
+        }
+
+        payload.data = data.data;
+        payload.max_size = data.length;
+        payload.pos = 0;
+        cache_change.payload_owner(this);
+    }
+
+private:
+
+    ~ReceivedBuffer() = default;
+
+    std::atomic<uint32_t> ref_count_;
+    std::shared_ptr<void> holder_;
+};
+
+/**
+ * Payload owner of the changes built by a reception thread on a buffer that can be kept alive after its
+ * processing (i.e. a shared-memory transport buffer).
+ *
+ * It does not manage any memory. Payload pools receiving a change owned by it may call its
+ * @ref get_payload(SerializedPayload_t&, IPayloadPool*&, CacheChange_t&) to point their change to the received data
+ * instead of copying it. Their change is then owned by a @ref ReceivedBuffer keeping the buffer alive.
+ */
+class ReceivedBufferOwner : public IPayloadPool
+{
+public:
+
+    ReceivedBufferOwner()
+        : IPayloadPool(OwnerKind::RECEIVED_BUFFER)
+    {
+    }
+
+    ~ReceivedBufferOwner()
+    {
+        clear();
+    }
+
+    /**
+     * Set the buffer being processed.
+     *
+     * @param holder  Object keeping the buffer alive.
+     * @param data    Pointer to the beginning of the buffer.
+     * @param size    Number of bytes on the buffer.
+     */
+    void set_buffer(
+            const std::shared_ptr<void>& holder,
+            const octet* data,
+            uint32_t size)
+    {
+        clear();
+        holder_ = holder;
+        begin_ = data;
+        end_ = data + size;
+    }
+
+    //! Forget the buffer being processed.
+    void clear()
+    {
+        if (nullptr != kept_buffer_)
+        {
+            kept_buffer_->release_reference();
+            kept_buffer_ = nullptr;
+        }
+
+        holder_.reset();
+        begin_ = nullptr;
+        end_ = nullptr;
+    }
+
+    /**
+     * Check whether some data lives on the buffer being processed.
+     *
+     * @param data    Pointer to the data.
+     * @param length  Number of bytes of the data.
+     *
+     * @return true when all the data is inside the buffer being processed.
+     */
+    bool contains(
+            const octet* data,
+            uint32_t length) const
+    {
+        return holder_ && (data >= begin_) && (data <= end_) && (length <= static_cast<size_t>(end_ - data));
+    }
+
+    bool get_payload(
+            uint32_t /* size */,
+            CacheChange_t& /* cache_change */) override
+    {
+        return false;
+    }
+
+    /**
+     * Point a change to the received data, keeping the buffer being processed alive while the change uses it.
+     *
+     * @return false when the data does not live on the buffer being processed, so it should be copied.
+     */
+    bool get_payload(
+            SerializedPayload_t& data,
+            IPayloadPool*& /* data_owner */,
+            CacheChange_t& cache_change) override
+    {
+        if (!contains(data.data, data.length))
+        {
+            return false;
+        }
+
+        // All the changes pointing to the same buffer share its owner
+        if (nullptr == kept_buffer_)
+        {
+            kept_buffer_ = new ReceivedBuffer(holder_);
+        }
+
+        kept_buffer_->keep(data, cache_change);
+        return true;
+    }
+
+    bool release_payload(
+            CacheChange_t& cache_change) override
+    {
+        assert(cache_change.payload_owner() == this);
+
+        // Data belongs to the reception buffer
+        cache_change.serializedPayload.data = nullptr;
+        cache_change.payload_owner(nullptr);
+        return true;
+    }
+
+private:
+
+    std::shared_ptr<void> holder_;
+    const octet* begin_ = nullptr;
+    const octet* end_ = nullptr;
+
+    //! Owner of the changes keeping the buffer being processed, created when the first one keeps it.
+    ReceivedBuffer* kept_buffer_ = nullptr;
+};
+
+}  // namespace rtps
+}  // namespace fastrtps
+}  // namespace eprosima
+
+#endif  // RTPS_HISTORY_RECEIVEDBUFFEROWNER_HPP
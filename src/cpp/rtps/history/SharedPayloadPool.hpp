@@ -0,0 +1,330 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file SharedPayloadPool.hpp
+ */
+
+#ifndef RTPS_HISTORY_SHAREDPAYLOADPOOL_HPP
+#define RTPS_HISTORY_SHAREDPAYLOADPOOL_HPP
+
+#include <fastdds/rtps/common/CacheChange.h>
+#include <fastdds/rtps/history/IPayloadPool.h>
+
+#include <rtps/history/PoolConfig.h>
+#include <rtps/history/ReceivedBufferOwner.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace eprosima {
+namespace fastrtps {
+namespace rtps {
+
+/**
+ * A payload pool whose buffers can be shared between several cache changes.
+ *
+ * Every buffer is preceded by a small header holding a reference counter. When a change owned by another
+ * SharedPayloadPool is received (i.e. on intraprocess delivery), the reader's change is pointed to the same buffer
+ * instead of copying it. The buffer is given back to the pool that allocated it when its last holder releases it.
+ *
+ * Changes received on a buffer that can be kept alive (see @ref ReceivedBufferOwner) are not copied either: they are
+ * pointed to the received data, and owned by a @ref ReceivedBuffer keeping the buffer alive until they are released.
+ */
+class SharedPayloadPool : public IPayloadPool
+{
+    class FreeList;
+
+    struct PayloadNode
+    {
+        //! Number of cache changes pointing to this buffer.
+        std::atomic<uint32_t> ref_count;
+
+        //! Number of bytes available on the buffer.
+        uint32_t data_size;
+
+        //! Free list of the pool that allocated the buffer.
+        std::shared_ptr<FreeList> origin;
+    };
+
+    //! Offset from the beginning of a node to its data, keeping the data suitably aligned.
+    static constexpr size_t header_size =
+            (sizeof(PayloadNode) + alignof(std::max_align_t) - 1) / alignof(std::max_align_t) *
+            alignof(std::max_align_t);
+
+    /**
+     * Buffers returned to a pool.
+     *
+     * It is kept alive by the buffers it allocated, so they can be released after the pool is destroyed.
+     */
+    class FreeList
+    {
+    public:
+
+        explicit FreeList(
+                bool recycle)
+            : recycle_(recycle)
+        {
+        }
+
+        ~FreeList()
+        {
+            assert(free_nodes_.empty());
+        }
+
+        PayloadNode* pop(
+                uint32_t size)
+        {
+            std::lock_guard<std::mutex> guard(mutex_);
+            if (free_nodes_.empty())
+            {
+                return nullptr;
+            }
+
+            // Buffers that are too small are discarded, as a bigger one will be allocated instead
+            PayloadNode* node = free_nodes_.back();
+            free_nodes_.pop_back();
+            if (node->data_size < size)
+            {
+                destroy_node(node);
+                return nullptr;
+            }
+
+            return node;
+        }
+
+        void push(
+                PayloadNode* node)
+        {
+            std::unique_lock<std::mutex> guard(mutex_);
+            if (recycle_)
+            {
+                free_nodes_.push_back(node);
+                return;
+            }
+            guard.unlock();
+
+            destroy_node(node);
+        }
+
+        void close()
+        {
+            std::vector<PayloadNode*> nodes;
+            {
+                std::lock_guard<std::mutex> guard(mutex_);
+                recycle_ = false;
+                nodes.swap(free_nodes_);
+            }
+
+            for (PayloadNode* node : nodes)
+            {
+                destroy_node(node);
+            }
+        }
+
+    private:
+
+        std::mutex mutex_;
+        bool recycle_;
+        std::vector<PayloadNode*> free_nodes_;
+    };
+
+public:
+
+    explicit SharedPayloadPool(
+            const PoolConfig& config)
+        : IPayloadPool(OwnerKind::SHARED_POOL)
+        , memory_policy_(config.memory_policy)
+        , payload_size_(config.payload_initial_size)
+        , free_list_(std::make_shared<FreeList>(DYNAMIC_RESERVE_MEMORY_MODE != config.memory_policy))
+    {
+    }
+
+    ~SharedPayloadPool()
+    {
+        // Buffers still held by other pools will be freed when their last holder releases them
+        free_list_->close();
+    }
+
+    bool get_payload(
+            uint32_t size,
+            CacheChange_t& cache_change) override
+    {
+        switch (memory_policy_)
+        {
+            case PREALLOCATED_MEMORY_MODE:
+                size = payload_size_;
+                break;
+            case PREALLOCATED_WITH_REALLOC_MEMORY_MODE:
+                size = std::max(size, payload_size_);
+                break;
+            default:
+                break;
+        }
+
+        PayloadNode* node = free_list_->pop(size);
+        if (nullptr == node)
+        {
+            node = allocate_node(size);
+            if (nullptr == node)
+            {
+                return false;
+            }
+        }
+
+        node->ref_count.store(1u, std::memory_order_relaxed);
+        attach(node, cache_change);
+        cache_change.serializedPayload.length = 0;
+        return true;
+    }
+
+    bool get_payload(
+            SerializedPayload_t& data,
+            IPayloadPool*& data_owner,
+            CacheChange_t& cache_change) override
+    {
+        assert(cache_change.writerGUID != GUID_t::unknown());
+        assert(cache_change.sequenceNumber != SequenceNumber_t::unknown());
+
+        if ((PREALLOCATED_MEMORY_MODE == memory_policy_) && (data.length > payload_size_))
+        {
+            return false;
+        }
+
+        if (nullptr != data.data && nullptr != data_owner && OwnerKind::SHARED_POOL == data_owner->owner_kind())
+        {
+            // Incoming data lives on a shared buffer: just take a new reference to it
+            PayloadNode* node = node_from_data(data.data);
+            node->ref_count.fetch_add(1u, std::memory_order_relaxed);
+            attach(node, cache_change);
+        }
+        else if (keeps_received_buffer(data_owner) && data_owner->get_payload(data, data_owner, cache_change))
+        {
+            // Incoming data lives on a reception buffer, which the change keeps alive
+        }
+        else if (get_payload(data.length, cache_change))
+        {
+            if (data.length > 0)
+            {
+                memcpy(cache_change.serializedPayload.data, data.data, data.length);
+            }
+        }
+        else
+        {
+            return false;
+        }
+
+        cache_change.serializedPayload.length = data.length;
+        cache_change.serializedPayload.encapsulation = data.encapsulation;
+        return true;
+    }
+
+    bool release_payload(
+            CacheChange_t& cache_change) override
+    {
+        assert(cache_change.payload_owner() == this);
+
+        SerializedPayload_t& payload = cache_change.serializedPayload;
+        if (nullptr != payload.data)
+        {
+            PayloadNode* node = node_from_data(payload.data);
+            if (1u == node->ref_count.fetch_sub(1u, std::memory_order_acq_rel))
+            {
+                // Keep a reference to the free list, as pushing the node may destroy it
+                std::shared_ptr<FreeList> origin = node->origin;
+                origin->push(node);
+            }
+        }
+
+        // The buffer is not ours anymore, so the payload should not try to free it
+        payload.data = nullptr;
+        payload.max_size = 0;
+        payload.length = 0;
+        payload.pos = 0;
+        cache_change.payload_owner(nullptr);
+
+        return true;
+    }
+
+private:
+
+    static bool keeps_received_buffer(
+            IPayloadPool* data_owner)
+    {
+        return nullptr != data_owner && OwnerKind::RECEIVED_BUFFER == data_owner->owner_kind();
+    }
+
+    PayloadNode* allocate_node(
+            uint32_t size)
+    {
+        void* buffer = calloc(header_size + size, 1);
+        if (nullptr == buffer)
+        {
+            return nullptr;
+        }
+
+        PayloadNode* node = new (buffer) PayloadNode();
+        node->data_size = size;
+        node->origin = free_list_;
+        return node;
+    }
+
+    static void destroy_node(
+            PayloadNode* node)
+    {
+        node->~PayloadNode();
+        free(node);
+    }
+
+    static PayloadNode* node_from_data(
+            octet* data)
+    {
+        return reinterpret_cast<PayloadNode*>(data - header_size);
+    }
+
+    void attach(
+            PayloadNode* node,
+            CacheChange_t& cache_change)
+    {
+        SerializedPayload_t& payload = cache_change.serializedPayload;
+        if (nullptr != payload.data)
+        {
+            // Payloads preallocated outside a shared pool are not reference counted
+            payload.empty();
+        }
+
+        payload.data = reinterpret_cast<octet*>(node) + header_size;
+        payload.max_size = node->data_size;
+        payload.pos = 0;
+        cache_change.payload_owner(this);
+    }
+
+    MemoryManagementPolicy_t memory_policy_;
+    uint32_t payload_size_;
+    std::shared_ptr<FreeList> free_list_;
+};
+
+}  // namespace rtps
+}  // namespace fastrtps
+}  // namespace eprosima
+
+#endif  // RTPS_HISTORY_SHAREDPAYLOADPOOL_HPP
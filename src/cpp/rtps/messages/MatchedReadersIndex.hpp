@@ -0,0 +1,188 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file MatchedReadersIndex.hpp
+ */
+
+#ifndef _RTPS_MESSAGES_MATCHEDREADERSINDEX_HPP_
+#define _RTPS_MESSAGES_MATCHEDREADERSINDEX_HPP_
+
+#include <fastdds/rtps/common/Guid.h>
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace eprosima {
+namespace fastrtps {
+namespace rtps {
+
+class RTPSReader;
+
+/**
+ * Index from the GUID of a remote writer to the local readers matched with it.
+ *
+ * It is kept by the participant and updated by its readers when they are matched and unmatched with writers, so
+ * messages not directed to a specific reader are only dispatched to the readers interested on them.
+ * It has its own mutex, which is never held while calling other objects, so it can be used with any other lock
+ * taken.
+ */
+class MatchedReadersIndex
+{
+public:
+
+    /**
+     * Add a reader to the readers matched with a writer.
+     * @param writer_guid  GUID of the remote writer.
+     * @param reader       Local reader matched with the writer.
+     * @param reader_id    Entity id of the local reader.
+     */
+    void add(
+            const GUID_t& writer_guid,
+            RTPSReader* reader,
+            const EntityId_t& reader_id)
+    {
+        std::lock_guard<std::mutex> guard(mtx_);
+        std::vector<MatchedReader>& readers = readers_[writer_guid];
+        auto it = find(readers, reader);
+        if (it == readers.end())
+        {
+            readers.push_back({reader, reader_id});
+        }
+    }
+
+    /**
+     * Remove a reader from the readers matched with a writer.
+     * @param writer_guid  GUID of the remote writer.
+     * @param reader       Local reader no longer matched with the writer.
+     */
+    void remove(
+            const GUID_t& writer_guid,
+            RTPSReader* reader)
+    {
+        std::lock_guard<std::mutex> guard(mtx_);
+        auto readers = readers_.find(writer_guid);
+        if (readers != readers_.end())
+        {
+            erase(readers, reader);
+        }
+    }
+
+    /**
+     * Remove a reader from the readers matched with any writer.
+     * @param reader  Local reader being destroyed.
+     */
+    void remove_reader(
+            RTPSReader* reader)
+    {
+        std::lock_guard<std::mutex> guard(mtx_);
+        for (auto readers = readers_.begin(); readers != readers_.end();)
+        {
+            readers = erase(readers, reader);
+        }
+    }
+
+    /**
+     * Get the readers matched with a writer.
+     * @param writer_guid    GUID of the remote writer.
+     * @param filter         Called with each reader and its entity id, returning whether the reader should be added.
+     *                       It should not access the reader, nor take any lock.
+     * @param [out] readers  Where the matched readers are appended to.
+     */
+    template<typename Predicate>
+    void get(
+            const GUID_t& writer_guid,
+            const Predicate& filter,
+            std::vector<RTPSReader*>& readers) const
+    {
+        std::lock_guard<std::mutex> guard(mtx_);
+        auto it = readers_.find(writer_guid);
+        if (it != readers_.end())
+        {
+            for (const MatchedReader& item : it->second)
+            {
+                if (filter(item.reader, item.entity_id))
+                {
+                    readers.push_back(item.reader);
+                }
+            }
+        }
+    }
+
+private:
+
+    //! Local reader matched with a remote writer. The entity id allows looking it up without accessing it.
+    struct MatchedReader
+    {
+        RTPSReader* reader;
+        EntityId_t entity_id;
+    };
+
+    struct GuidHash
+    {
+        std::size_t operator ()(
+                const GUID_t& guid) const
+        {
+            // Last bytes of the prefix distinguish participants of the same host and process
+            uint64_t prefix;
+            memcpy(&prefix, &guid.guidPrefix.value[4], sizeof(prefix));
+            return std::hash<uint64_t>()(prefix) ^ std::hash<EntityId_t>()(guid.entityId);
+        }
+
+    };
+
+    using map_type = std::unordered_map<GUID_t, std::vector<MatchedReader>, GuidHash>;
+
+    static std::vector<MatchedReader>::iterator find(
+            std::vector<MatchedReader>& readers,
+            RTPSReader* reader)
+    {
+        return std::find_if(readers.begin(), readers.end(),
+                       [reader](const MatchedReader& item)
+                       {
+                           return item.reader == reader;
+                       });
+    }
+
+    //! Removes a reader from an entry, removing the entry when it becomes empty. Returns the next entry.
+    map_type::iterator erase(
+            map_type::iterator readers,
+            RTPSReader* reader)
+    {
+        auto it = find(readers->second, reader);
+        if (it != readers->second.end())
+        {
+            readers->second.erase(it);
+            if (readers->second.empty())
+            {
+                return readers_.erase(readers);
+            }
+        }
+        return ++readers;
+    }
+
+    mutable std::mutex mtx_;
+
+    map_type readers_;
+};
+
+} // namespace rtps
+} // namespace fastrtps
+} // namespace eprosima
+
+#endif // _RTPS_MESSAGES_MATCHEDREADERSINDEX_HPP_
@@ -25,11 +25,12 @@
 #include <fastdds/rtps/writer/RTPSWriter.h>
 
 #include <fastdds/core/policy/ParameterList.hpp>
+#include <rtps/history/ReceivedBufferOwner.hpp>
 #include <rtps/participant/RTPSParticipantImpl.h>
 
+#include <algorithm>
 #include <cassert>
 #include <limits>
-#include <mutex>
 
 #define INFO_SRC_SUBMSG_LENGTH 20
 
@@ -51,6 +52,7 @@ MessageReceiver::MessageReceiver(
     , dest_guid_prefix_(c_GuidPrefix_Unknown)
     , have_timestamp_(false)
     , timestamp_(c_TimeInvalid)
+    , received_buffer_owner_(new ReceivedBufferOwner())
 #if HAVE_SECURITY
     , crypto_msg_(participant->is_secure() ? rec_buffer_size : 0)
     , crypto_payload_(participant->is_secure() ? rec_buffer_size : 0)
@@ -63,91 +65,111 @@ MessageReceiver::MessageReceiver(
 MessageReceiver::~MessageReceiver()
 {
     logInfo(RTPS_MSG_IN, "");
-    assert(associated_writers_.empty());
-    assert(associated_readers_.empty());
+    assert(endpoints_.load()->writers.empty());
+    assert(endpoints_.load()->readers.empty());
 }
 
 void MessageReceiver::associateEndpoint(
         Endpoint* to_add)
 {
-    std::lock_guard<std::mutex> guard(mtx_);
-    if (to_add->getAttributes().endpointKind == WRITER)
-    {
-        const auto writer = dynamic_cast<RTPSWriter*>(to_add);
-        for (const auto& it : associated_writers_)
-        {
-            if (it == writer)
+    endpoints_.update([to_add](AssociatedEndpoints& endpoints)
             {
-                return;
-            }
-        }
+                if (to_add->getAttributes().endpointKind == WRITER)
+                {
+                    const auto writer = dynamic_cast<RTPSWriter*>(to_add);
+                    for (const auto& it : endpoints.writers)
+                    {
+                        if (it == writer)
+                        {
+                            return false;
+                        }
+                    }
 
-        associated_writers_.push_back(writer);
-    }
-    else
-    {
-        const auto reader = dynamic_cast<RTPSReader*>(to_add);
-        const auto entityId = reader->getGuid().entityId;
-        // search for set of readers by entity ID
-        const auto readers = associated_readers_.find(entityId);
-        if (readers == associated_readers_.end())
-        {
-            auto vec = std::vector<RTPSReader*>();
-            vec.push_back(reader);
-            associated_readers_.emplace(entityId, vec);
-        }
-        else
-        {
-            for (const auto& it : readers->second)
-            {
-                if (it == reader)
+                    endpoints.writers.push_back(writer);
+                }
+                else
                 {
-                    return;
+                    const auto reader = dynamic_cast<RTPSReader*>(to_add);
+                    const auto entityId = reader->getGuid().entityId;
+                    // search for set of readers by entity ID
+                    std::vector<RTPSReader*>& readers = endpoints.readers[entityId];
+                    for (const auto& it : readers)
+                    {
+                        if (it == reader)
+                        {
+                            return false;
+                        }
+                    }
+
+                    readers.push_back(reader);
+
+                    if (reader->getGuid().is_builtin())
+                    {
+                        endpoints.builtin_readers.push_back(reader);
+                    }
+                    else
+                    {
+                        endpoints.user_readers.push_back(reader);
+                    }
                 }
-            }
 
-            readers->second.push_back(reader);
-        }
-    }
+                return true;
+            });
 }
 
 void MessageReceiver::removeEndpoint(
         Endpoint* to_remove)
 {
-    std::lock_guard<std::mutex> guard(mtx_);
-
-    if (to_remove->getAttributes().endpointKind == WRITER)
-    {
-        auto* var = dynamic_cast<RTPSWriter*>(to_remove);
-        for (auto it = associated_writers_.begin(); it != associated_writers_.end(); ++it)
-        {
-            if (*it == var)
-            {
-                associated_writers_.erase(it);
-                break;
-            }
-        }
-    }
-    else
-    {
-        auto readers = associated_readers_.find(to_remove->getGuid().entityId);
-        if (readers != associated_readers_.end())
-        {
-            auto* var = dynamic_cast<RTPSReader*>(to_remove);
-            for (auto it = readers->second.begin(); it != readers->second.end(); ++it)
+    // The endpoint may be destroyed on return, so submessages being processed with it should finish first
+    endpoints_.update_and_synchronize([to_remove](AssociatedEndpoints& endpoints)
             {
-                if (*it == var)
+                if (to_remove->getAttributes().endpointKind == WRITER)
+                {
+                    auto* var = dynamic_cast<RTPSWriter*>(to_remove);
+                    auto it = std::find(endpoints.writers.begin(), endpoints.writers.end(), var);
+                    if (it == endpoints.writers.end())
+                    {
+                        return false;
+                    }
+
+                    endpoints.writers.erase(it);
+                }
+                else
                 {
+                    auto readers = endpoints.readers.find(to_remove->getGuid().entityId);
+                    if (readers == endpoints.readers.end())
+                    {
+                        return false;
+                    }
+
+                    auto* var = dynamic_cast<RTPSReader*>(to_remove);
+                    auto it = std::find(readers->second.begin(), readers->second.end(), var);
+                    if (it == readers->second.end())
+                    {
+                        return false;
+                    }
+
                     readers->second.erase(it);
                     if (readers->second.empty())
                     {
-                        associated_readers_.erase(readers);
+                        endpoints.readers.erase(readers);
+                    }
+
+                    auto builtin = std::find(endpoints.builtin_readers.begin(), endpoints.builtin_readers.end(), var);
+                    if (builtin != endpoints.builtin_readers.end())
+                    {
+                        endpoints.builtin_readers.erase(builtin);
+                    }
+
+                    auto user = std::find(endpoints.user_readers.begin(), endpoints.user_readers.end(), var);
+                    if (user != endpoints.user_readers.end())
+                    {
+                        endpoints.user_readers.erase(user);
                     }
-                    break;
                 }
-            }
-        }
-    }
+
+                return true;
+            });
 }
 
 void MessageReceiver::reset()
@@ -160,6 +182,16 @@ void MessageReceiver::reset()
     timestamp_ = c_TimeInvalid;
 }
 
+void MessageReceiver::processCDRMsg(
+        const Locator_t& loc,
+        CDRMessage_t* msg,
+        const std::shared_ptr<void>& buffer)
+{
+    received_buffer_owner_->set_buffer(buffer, msg->buffer, msg->length);
+    processCDRMsg(loc, msg);
+    received_buffer_owner_->clear();
+}
+
 void MessageReceiver::processCDRMsg(
         const Locator_t& loc,
         CDRMessage_t* msg)
@@ -443,11 +475,13 @@ bool MessageReceiver::readSubmessageHeader(
 }
 
 bool MessageReceiver::willAReaderAcceptMsgDirectedTo(
+        const AssociatedEndpoints& endpoints,
         const EntityId_t& readerID,
+        const GUID_t& writerGUID,
         RTPSReader*& first_reader)
 {
     first_reader = nullptr;
-    if (associated_readers_.empty())
+    if (endpoints.readers.empty())
     {
         logWarning(RTPS_MSG_IN, IDSTRING "Data received when NO readers are listening");
         return false;
@@ -455,8 +489,8 @@ bool MessageReceiver::willAReaderAcceptMsgDirectedTo(
 
     if (readerID != c_EntityId_Unknown)
     {
-        const auto readers = associated_readers_.find(readerID);
-        if (readers != associated_readers_.end())
+        const auto readers = endpoints.readers.find(readerID);
+        if (readers != endpoints.readers.end())
         {
             first_reader = readers->second.front();
             return true;
@@ -464,21 +498,20 @@ bool MessageReceiver::willAReaderAcceptMsgDirectedTo(
     }
     else
     {
-        for (const auto& readers : associated_readers_)
+        for (RTPSReader* it : endpoints.builtin_readers)
         {
-            if (readers.second.empty())
+            if (it->m_acceptMessagesToUnknownReaders)
             {
-                continue;
+                first_reader = it;
+                return true;
             }
+        }
 
-            for (const auto& it : readers.second)
-            {
-                if (it->m_acceptMessagesToUnknownReaders)
-                {
-                    first_reader = it;
-                    return true;
-                }
-            }
+        find_matched_readers(endpoints, writerGUID);
+        if (!matched_readers_.empty())
+        {
+            first_reader = matched_readers_.front();
+            return true;
         }
     }
 
@@ -488,13 +521,15 @@ bool MessageReceiver::willAReaderAcceptMsgDirectedTo(
 
 template<typename Functor>
 void MessageReceiver::findAllReaders(
+        const AssociatedEndpoints& endpoints,
         const EntityId_t& readerID,
+        const GUID_t& writerGUID,
         const Functor& callback)
 {
     if (readerID != c_EntityId_Unknown)
     {
-        const auto readers = associated_readers_.find(readerID);
-        if (readers != associated_readers_.end())
+        const auto readers = endpoints.readers.find(readerID);
+        if (readers != endpoints.readers.end())
         {
             for (const auto& it : readers->second)
             {
@@ -504,24 +539,64 @@ void MessageReceiver::findAllReaders(
     }
     else
     {
-        for (const auto& readers : associated_readers_)
+        for (RTPSReader* it : endpoints.builtin_readers)
         {
-            for (const auto& it : readers.second)
+            if (it->m_acceptMessagesToUnknownReaders)
             {
-                if (it->m_acceptMessagesToUnknownReaders)
-                {
-                    callback(it);
-                }
+                callback(it);
             }
         }
+
+        find_matched_readers(endpoints, writerGUID);
+        for (RTPSReader* it : matched_readers_)
+        {
+            callback(it);
+        }
+    }
+}
+
+void MessageReceiver::find_matched_readers(
+        const AssociatedEndpoints& endpoints,
+        const GUID_t& writerGUID)
+{
+    matched_readers_.clear();
+
+    // Readers on the index may be being destroyed, so only the associated ones are accessed
+    participant_->matched_readers_index().get(writerGUID,
+            [&endpoints](RTPSReader* reader, const EntityId_t& reader_id)
+            {
+                const auto readers = endpoints.readers.find(reader_id);
+                return readers != endpoints.readers.end() &&
+                std::find(readers->second.begin(), readers->second.end(), reader) != readers->second.end();
+            },
+            matched_readers_);
+
+    // Readers accepting messages from unknown writers are never on the index. The flag may change after the reader
+    // is associated, so it is checked on each message.
+    size_t num_matched = matched_readers_.size();
+    for (RTPSReader* reader : endpoints.user_readers)
+    {
+        if (reader->m_acceptMessagesFromUnkownWriters &&
+                std::find(matched_readers_.begin(), matched_readers_.begin() + num_matched, reader) ==
+                matched_readers_.begin() + num_matched)
+        {
+            matched_readers_.push_back(reader);
+        }
     }
+
+    auto not_accepting = [](const RTPSReader* reader)
+            {
+                return !reader->m_acceptMessagesToUnknownReaders;
+            };
+    matched_readers_.erase(std::remove_if(matched_readers_.begin(), matched_readers_.end(), not_accepting),
+            matched_readers_.end());
 }
 
 bool MessageReceiver::proc_Submsg_Data(
         CDRMessage_t* msg,
         SubmessageHeader_t* smh)
 {
-    std::lock_guard<std::mutex> guard(mtx_);
+    auto endpoints = endpoints_.load();
 
     //READ and PROCESS
     if (smh->submessageLength < RTPSMESSAGE_DATA_MIN_LENGTH)
@@ -562,18 +637,18 @@ bool MessageReceiver::proc_Submsg_Data(
     EntityId_t readerID;
     valid &= CDRMessage::readEntityId(msg, &readerID);
 
+    CacheChange_t ch;
+    ch.kind = ALIVE;
+    ch.writerGUID.guidPrefix = source_guid_prefix_;
+    valid &= CDRMessage::readEntityId(msg, &ch.writerGUID.entityId);
+
     //WE KNOW THE READER THAT THE MESSAGE IS DIRECTED TO SO WE LOOK FOR IT:
-    if (!willAReaderAcceptMsgDirectedTo(readerID, first_reader))
+    if (!willAReaderAcceptMsgDirectedTo(*endpoints, readerID, ch.writerGUID, first_reader))
     {
         return false;
     }
 
     //FOUND THE READER.
-    //We ask the reader for a cachechange to store the information.
-    CacheChange_t ch;
-    ch.kind = ALIVE;
-    ch.writerGUID.guidPrefix = source_guid_prefix_;
-    valid &= CDRMessage::readEntityId(msg, &ch.writerGUID.entityId);
 
     //Get sequence number
     valid &= CDRMessage::readSequenceNumber(msg, &ch.sequenceNumber);
@@ -674,17 +749,24 @@ bool MessageReceiver::proc_Submsg_Data(
     }
 #endif  // HAVE_SECURITY
 
+    if (received_buffer_owner_->contains(ch.serializedPayload.data, ch.serializedPayload.length))
+    {
+        // Payload lives on a buffer that readers can keep alive
+        ch.payload_owner(received_buffer_owner_.get());
+    }
+
     logInfo(RTPS_MSG_IN, IDSTRING "from Writer " << ch.writerGUID << "; possible RTPSReader entities: " <<
-            associated_readers_.size());
+            endpoints->readers.size());
 
     //Look for the correct reader to add the change
-    findAllReaders(readerID,
+    findAllReaders(*endpoints, readerID, ch.writerGUID,
             [&ch](RTPSReader* reader)
             {
                 reader->processDataMsg(&ch);
             });
 
     //TODO(Ricardo) If a exception is thrown (ex, by fastcdr), this line is not executed -> segmentation fault
+    ch.payload_owner(nullptr);
     ch.serializedPayload.data = nullptr;
 
     logInfo(RTPS_MSG_IN, IDSTRING "Sub Message DATA processed");
@@ -695,7 +777,7 @@ bool MessageReceiver::proc_Submsg_DataFrag(
         CDRMessage_t* msg,
         SubmessageHeader_t* smh)
 {
-    std::lock_guard<std::mutex> guard(mtx_);
+    auto endpoints = endpoints_.load();
 
     //READ and PROCESS
     if (smh->submessageLength < RTPSMESSAGE_DATA_MIN_LENGTH)
@@ -731,17 +813,17 @@ bool MessageReceiver::proc_Submsg_DataFrag(
     EntityId_t readerID;
     valid &= CDRMessage::readEntityId(msg, &readerID);
 
+    CacheChange_t ch;
+    ch.writerGUID.guidPrefix = source_guid_prefix_;
+    valid &= CDRMessage::readEntityId(msg, &ch.writerGUID.entityId);
+
     //WE KNOW THE READER THAT THE MESSAGE IS DIRECTED TO SO WE LOOK FOR IT:
-    if (!willAReaderAcceptMsgDirectedTo(readerID, first_reader))
+    if (!willAReaderAcceptMsgDirectedTo(*endpoints, readerID, ch.writerGUID, first_reader))
     {
         return false;
     }
 
     //FOUND THE READER.
-    //We ask the reader for a cachechange to store the information.
-    CacheChange_t ch;
-    ch.writerGUID.guidPrefix = source_guid_prefix_;
-    valid &= CDRMessage::readEntityId(msg, &ch.writerGUID.entityId);
 
     //Get sequence number
     valid &= CDRMessage::readSequenceNumber(msg, &ch.sequenceNumber);
@@ -864,10 +946,10 @@ bool MessageReceiver::proc_Submsg_DataFrag(
 
     //FIXME: DO SOMETHING WITH PARAMETERLIST CREATED.
     logInfo(RTPS_MSG_IN, IDSTRING "from Writer " << ch.writerGUID << "; possible RTPSReader entities: " <<
-            associated_readers_.size());
+            endpoints->readers.size());
 
     //Look for the correct reader to add the change
-    findAllReaders(readerID,
+    findAllReaders(*endpoints, readerID, ch.writerGUID,
             [&ch, sampleSize, fragmentStartingNum, fragmentsInSubmessage](RTPSReader* reader)
             {
                 reader->processDataFragMsg(&ch, sampleSize, fragmentStartingNum, fragmentsInSubmessage);
@@ -916,9 +998,9 @@ bool MessageReceiver::proc_Submsg_Heartbeat(
     uint32_t HBCount;
     CDRMessage::readUInt32(msg, &HBCount);
 
-    std::lock_guard<std::mutex> guard(mtx_);
+    auto endpoints = endpoints_.load();
     //Look for the correct reader and writers:
-    findAllReaders(readerGUID.entityId,
+    findAllReaders(*endpoints, readerGUID.entityId, writerGUID,
             [&writerGUID, &HBCount, &firstSN, &lastSN, finalFlag, livelinessFlag](RTPSReader* reader)
             {
                 reader->processHeartbeatMsg(writerGUID, HBCount, firstSN, lastSN, finalFlag, livelinessFlag);
@@ -954,9 +1036,9 @@ bool MessageReceiver::proc_Submsg_Acknack(
     uint32_t Ackcount;
     CDRMessage::readUInt32(msg, &Ackcount);
 
-    std::lock_guard<std::mutex> guard(mtx_);
+    auto endpoints = endpoints_.load();
     //Look for the correct writer to use the acknack
-    for (RTPSWriter* it : associated_writers_)
+    for (RTPSWriter* it : endpoints->writers)
     {
         bool result;
         if (it->process_acknack(writerGUID, readerGUID, Ackcount, SNSet, finalFlag, result))
@@ -969,7 +1051,7 @@ bool MessageReceiver::proc_Submsg_Acknack(
         }
     }
     logInfo(RTPS_MSG_IN, IDSTRING "Acknack msg to UNKNOWN writer (I loooked through "
-            << associated_writers_.size() << " writers in this ListenResource)");
+            << endpoints->writers.size() << " writers in this ListenResource)");
     return false;
 }
 
@@ -1002,8 +1084,8 @@ bool MessageReceiver::proc_Submsg_Gap(
         return false;
     }
 
-    std::lock_guard<std::mutex> guard(mtx_);
-    findAllReaders(readerGUID.entityId,
+    auto endpoints = endpoints_.load();
+    findAllReaders(*endpoints, readerGUID.entityId, writerGUID,
             [&writerGUID, &gapStart, &gapList](RTPSReader* reader)
             {
                 reader->processGapMsg(writerGUID, gapStart, gapList);
@@ -1125,9 +1207,9 @@ bool MessageReceiver::proc_Submsg_NackFrag(
     uint32_t Ackcount;
     CDRMessage::readUInt32(msg, &Ackcount);
 
-    std::lock_guard<std::mutex> guard(mtx_);
+    auto endpoints = endpoints_.load();
     //Look for the correct writer to use the acknack
-    for (RTPSWriter* it : associated_writers_)
+    for (RTPSWriter* it : endpoints->writers)
     {
         bool result;
         if (it->process_nack_frag(writerGUID, readerGUID, Ackcount, writerSN, fnState, result))
@@ -1140,7 +1222,7 @@ bool MessageReceiver::proc_Submsg_NackFrag(
         }
     }
     logInfo(RTPS_MSG_IN, IDSTRING "Acknack msg to UNKNOWN writer (I looked through "
-            << associated_writers_.size() << " writers in this ListenResource)");
+            << endpoints->writers.size() << " writers in this ListenResource)");
     return false;
 }
 
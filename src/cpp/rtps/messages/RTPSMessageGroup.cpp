@@ -24,6 +24,9 @@
 #include <rtps/flowcontrol/FlowController.h>
 #include "RTPSGapBuilder.hpp"
 #include "RTPSMessageGroup_t.hpp"
+#ifndef FASTDDS_SHM_TRANSPORT_DISABLED
+#include <rtps/transport/shared_mem/SharedMemTransport.h>
+#endif // ifndef FASTDDS_SHM_TRANSPORT_DISABLED
 
 #include <fastdds/dds/log/Log.hpp>
 
@@ -33,6 +36,15 @@ namespace eprosima {
 namespace fastrtps {
 namespace rtps {
 
+#ifndef FASTDDS_SHM_TRANSPORT_DISABLED
+/**
+ * Minimum size of the first submessage of a message for it to be serialized on a buffer loaned by the shared-memory
+ * transport. Copying smaller messages, like HEARTBEAT, GAP or ACKNACK, is cheaper than loaning a buffer for the
+ * biggest message and shrinking it on send.
+ */
+static constexpr uint32_t shm_loan_min_submessage_size = 4096u;
+#endif // ifndef FASTDDS_SHM_TRANSPORT_DISABLED
+
 bool sort_changes_group (
         CacheChange_t* c1,
         CacheChange_t* c2)
@@ -116,6 +128,32 @@ const EntityId_t& get_entity_id(
     return entityid;
 }
 
+#ifndef FASTDDS_SHM_TRANSPORT_DISABLED
+struct RTPSMessageGroup::SharedMemLoan
+{
+    SharedMemLoan(
+            fastdds::rtps::SharedMemTransport* shm_transport,
+            const std::shared_ptr<fastdds::rtps::SharedMemManager::Buffer>& shm_buffer)
+        : transport(shm_transport)
+        , buffer(shm_buffer)
+        , message(0u)
+    {
+        message.init(static_cast<octet*>(buffer->data()), buffer->size());
+    }
+
+    fastdds::rtps::SharedMemTransport* transport;
+
+    std::shared_ptr<fastdds::rtps::SharedMemManager::Buffer> buffer;
+
+    //! Wraps the buffer.
+    CDRMessage_t message;
+};
+#else
+struct RTPSMessageGroup::SharedMemLoan
+{
+};
+#endif // ifndef FASTDDS_SHM_TRANSPORT_DISABLED
+
 RTPSMessageGroup::RTPSMessageGroup(
         RTPSParticipantImpl* participant,
         Endpoint* endpoint,
@@ -164,20 +202,89 @@ RTPSMessageGroup::~RTPSMessageGroup() noexcept(false)
     }
     catch (...)
     {
+        return_shm_loan();
         participant_->return_send_buffer(std::move(send_buffer_));
         throw;
     }
 
+    return_shm_loan();
     participant_->return_send_buffer(std::move(send_buffer_));
 }
 
 void RTPSMessageGroup::reset_to_header()
 {
+    // Each message sent from shared memory needs its own buffer, as readers may still be using the previous one
+    return_shm_loan();
+
     CDRMessage::initCDRMsg(full_msg_);
     full_msg_->pos = RTPSMESSAGE_HEADER_SIZE;
     full_msg_->length = RTPSMESSAGE_HEADER_SIZE;
 }
 
+void RTPSMessageGroup::select_full_msg(
+        uint32_t pending_size)
+{
+    assert(full_msg_->length == RTPSMESSAGE_HEADER_SIZE);
+
+#ifndef FASTDDS_SHM_TRANSPORT_DISABLED
+    // When all the destinations are shared-memory locators, big messages are serialized directly on the segment of
+    // the transport, so the transport does not have to copy them
+    bool use_shm = pending_size >= shm_loan_min_submessage_size && participant_->has_shm_transport() &&
+            sender_.destinations_are_of_kind(LOCATOR_KIND_SHM);
+#if HAVE_SECURITY
+    // Protected messages are sent from encrypt_msg_
+    use_shm = use_shm &&
+            !(participant_->security_attributes().is_rtps_protected && endpoint_->supports_rtps_protection());
+#endif // if HAVE_SECURITY
+
+    if (use_shm == (shm_loan_ != nullptr))
+    {
+        return;
+    }
+
+    if (!use_shm)
+    {
+        reset_to_header();
+        return;
+    }
+
+    fastdds::rtps::SharedMemTransport* transport = participant_->shared_mem_transport();
+    if (transport == nullptr)
+    {
+        return;
+    }
+
+    const CDRMessage_t& own_msg = send_buffer_->rtpsmsg_fullmsg_;
+    std::shared_ptr<fastdds::rtps::SharedMemManager::Buffer> buffer =
+            transport->loan_buffer(own_msg.max_size, max_blocking_time_point_);
+    if (!buffer)
+    {
+        return;
+    }
+
+    shm_loan_.reset(new SharedMemLoan(transport, buffer));
+    full_msg_ = &shm_loan_->message;
+    memcpy(full_msg_->buffer, own_msg.buffer, RTPSMESSAGE_HEADER_SIZE);
+    full_msg_->pos = RTPSMESSAGE_HEADER_SIZE;
+    full_msg_->length = RTPSMESSAGE_HEADER_SIZE;
+#else
+    (void)pending_size;
+#endif // ifndef FASTDDS_SHM_TRANSPORT_DISABLED
+}
+
+void RTPSMessageGroup::return_shm_loan()
+{
+#ifndef FASTDDS_SHM_TRANSPORT_DISABLED
+    if (shm_loan_)
+    {
+        shm_loan_->transport->return_loan(shm_loan_->buffer);
+        shm_loan_.reset();
+    }
+#endif // ifndef FASTDDS_SHM_TRANSPORT_DISABLED
+
+    full_msg_ = &(send_buffer_->rtpsmsg_fullmsg_);
+}
+
 void RTPSMessageGroup::flush()
 {
     send();
@@ -245,12 +352,18 @@ bool RTPSMessageGroup::insert_submessage(
         const GuidPrefix_t& destination_guid_prefix,
         bool is_big_submessage)
 {
+    if (full_msg_->length == RTPSMESSAGE_HEADER_SIZE)
+    {
+        select_full_msg(submessage_msg_->length);
+    }
+
     if (!CDRMessage::appendMsg(full_msg_, submessage_msg_))
     {
         // Retry
         flush();
 
         current_dst_ = c_GuidPrefix_Unknown;
+        select_full_msg(submessage_msg_->length);
 
         if (!add_info_dst_in_buffer(full_msg_, destination_guid_prefix))
         {
@@ -86,6 +86,13 @@ void ReceiverResource::UnregisterReceiver(MessageReceiver* rcv)
 
 void ReceiverResource::OnDataReceived(const octet * data, const uint32_t size,
     const Locator_t & localLocator, const Locator_t & remoteLocator)
+{
+    OnDataReceived(data, size, localLocator, remoteLocator, std::shared_ptr<void>());
+}
+
+void ReceiverResource::OnDataReceived(const octet * data, const uint32_t size,
+    const Locator_t & localLocator, const Locator_t & remoteLocator,
+    const std::shared_ptr<void>& buffer)
 {
     (void)localLocator;
 
@@ -102,9 +109,15 @@ void ReceiverResource::OnDataReceived(const octet * data, const uint32_t size,
         msg.reserved_size = size;
 
         // TODO: Should we unlock in case UnregisterReceiver is called from callback ?
-        rcv->processCDRMsg(remoteLocator, &msg);
+        if (buffer)
+        {
+            rcv->processCDRMsg(remoteLocator, &msg, buffer);
+        }
+        else
+        {
+            rcv->processCDRMsg(remoteLocator, &msg);
+        }
     }
-
 }
 
 void ReceiverResource::disable()
@@ -165,6 +165,13 @@ uint32_t RTPSParticipant::get_domain_id() const
     return mp_impl->get_domain_id();
 }
 
+bool RTPSParticipant::get_flow_controller_statistics(
+        const std::string& flow_controller_name,
+        std::vector<FlowControllerWriterStatistics>& statistics) const
+{
+    return mp_impl->get_flow_controller_statistics(flow_controller_name, statistics);
+}
+
 void RTPSParticipant::enable()
 {
     mp_impl->enable();
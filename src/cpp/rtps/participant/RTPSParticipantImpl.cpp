@@ -20,7 +20,11 @@
 #include <rtps/participant/RTPSParticipantImpl.h>
 
 #include <rtps/flowcontrol/ThroughputController.h>
+#include <rtps/flowcontrol/SchedulingFlowController.h>
 #include <rtps/persistence/PersistenceService.h>
+#ifndef FASTDDS_SHM_TRANSPORT_DISABLED
+#include <rtps/transport/shared_mem/SharedMemSenderResource.hpp>
+#endif // ifndef FASTDDS_SHM_TRANSPORT_DISABLED
 
 #include <fastdds/rtps/messages/MessageReceiver.h>
 
@@ -110,6 +114,7 @@ RTPSParticipantImpl::RTPSParticipantImpl(
     , mp_builtinProtocols(nullptr)
     , mp_ResourceSemaphore(new Semaphore(0))
     , IdCounter(0)
+    , async_thread_(PParam.properties)
     , type_check_fn_(nullptr)
 #if HAVE_SECURITY
     , m_security_manager(this)
@@ -119,6 +124,7 @@ RTPSParticipantImpl::RTPSParticipantImpl(
     , mp_mutex(new std::recursive_mutex())
     , is_intraprocess_only_(should_be_intraprocess_only(PParam))
     , has_shm_transport_(false)
+    , shared_mem_transport_(nullptr)
 {
     // Builtin transports by default
     if (PParam.useBuiltinTransports)
@@ -210,6 +216,19 @@ RTPSParticipantImpl::RTPSParticipantImpl(
         m_controllers.push_back(std::move(controller));
     }
 
+    // Flow controllers the writers reference by name
+    for (const FlowControllerDescriptor& descriptor : PParam.flow_controllers)
+    {
+        if (descriptor.name.empty() || 0 < scheduling_flow_controllers_.count(descriptor.name))
+        {
+            logError(RTPS_PARTICIPANT, "Flow controller names should be unique and not empty. "
+                    << "Ignoring flow controller '" << descriptor.name << "'");
+            continue;
+        }
+
+        scheduling_flow_controllers_[descriptor.name].reset(new SchedulingFlowController(descriptor));
+    }
+
     /* If metatrafficMulticastLocatorList is empty, add mandatory default Locators
        Else -> Take them */
 
@@ -450,6 +469,27 @@ RTPSParticipantImpl::~RTPSParticipantImpl()
  * MAIN RTPSParticipant IMPL API
  *
  */
+SchedulingFlowController* RTPSParticipantImpl::find_flow_controller(
+        const std::string& name) const
+{
+    auto it = scheduling_flow_controllers_.find(name);
+    return it != scheduling_flow_controllers_.end() ? it->second.get() : nullptr;
+}
+
+bool RTPSParticipantImpl::get_flow_controller_statistics(
+        const std::string& name,
+        std::vector<FlowControllerWriterStatistics>& statistics) const
+{
+    SchedulingFlowController* controller = find_flow_controller(name);
+    if (controller == nullptr)
+    {
+        return false;
+    }
+
+    controller->get_statistics(statistics);
+    return true;
+}
+
 bool RTPSParticipantImpl::createWriter(
         RTPSWriter** WriterOut,
         WriterAttributes& param,
@@ -520,6 +560,21 @@ bool RTPSParticipantImpl::createWriter(
                 "Writer has to be configured to publish asynchronously, because a flowcontroller was configured");
         return false;
     }
+    if (!param.flow_controller_name.empty())
+    {
+        if (find_flow_controller(param.flow_controller_name) == nullptr)
+        {
+            logError(RTPS_PARTICIPANT, "Flow controller '" << param.flow_controller_name << "' not registered");
+            return false;
+        }
+        if (param.mode != ASYNCHRONOUS_WRITER)
+        {
+            logError(RTPS_PARTICIPANT,
+                    "Writer has to be configured to publish asynchronously to use flow controller '" <<
+                    param.flow_controller_name << "'");
+            return false;
+        }
+    }
 
     // Update persistence guidPrefix, restore this change later to keep param unblemished
     GUID_t former_persistence_guid = param.endpoint.persistence_guid;
@@ -1098,6 +1153,33 @@ void RTPSParticipantImpl::createReceiverResources(
     }
 }
 
+fastdds::rtps::SharedMemTransport* RTPSParticipantImpl::shared_mem_transport()
+{
+#ifdef FASTDDS_SHM_TRANSPORT_DISABLED
+    return nullptr;
+#else
+    fastdds::rtps::SharedMemTransport* transport = shared_mem_transport_.load(std::memory_order_acquire);
+    if (transport != nullptr || !has_shm_transport_)
+    {
+        return transport;
+    }
+
+    std::lock_guard<std::timed_mutex> guard(m_send_resources_mutex_);
+    for (auto& send_resource : send_resource_list_)
+    {
+        auto shm_resource = dynamic_cast<fastdds::rtps::SharedMemSenderResource*>(send_resource.get());
+        if (shm_resource != nullptr)
+        {
+            transport = &shm_resource->transport();
+            shared_mem_transport_.store(transport, std::memory_order_release);
+            break;
+        }
+    }
+
+    return transport;
+#endif // ifdef FASTDDS_SHM_TRANSPORT_DISABLED
+}
+
 void RTPSParticipantImpl::createSenderResources(
         const LocatorList_t& locator_list)
 {
@@ -1208,6 +1290,8 @@ bool RTPSParticipantImpl::deleteUserEndpoint(
                 m_security_manager.unregister_local_reader(p_endpoint->getGuid());
             }
 #endif // if HAVE_SECURITY
+
+            matched_readers_index_.remove_reader(static_cast<RTPSReader*>(p_endpoint));
         }
     }
     //	std::lock_guard<std::recursive_mutex> guardEndpoint(*p_endpoint->getMutex());
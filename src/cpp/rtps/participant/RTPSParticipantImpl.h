@@ -22,6 +22,9 @@
 #include <cstdio>
 #include <cstdlib>
 #include <list>
+#include <map>
+#include <memory>
+#include <string>
 #include <sys/types.h>
 #include <mutex>
 #include <atomic>
@@ -36,6 +39,7 @@
 
 #include <fastdds/rtps/attributes/RTPSParticipantAttributes.h>
 #include <fastdds/rtps/common/Guid.h>
+#include <fastdds/rtps/flowcontrol/FlowControllerStatistics.h>
 #include <fastdds/rtps/builtin/discovery/endpoint/EDPSimple.h>
 #include <fastdds/rtps/builtin/data/ReaderProxyData.h>
 #include <fastdds/rtps/builtin/data/WriterProxyData.h>
@@ -49,6 +53,7 @@
 
 #include "../messages/RTPSMessageGroup_t.hpp"
 #include "../messages/SendBuffersManager.hpp"
+#include "../messages/MatchedReadersIndex.hpp"
 
 #if HAVE_SECURITY
 #include <fastdds/rtps/Endpoint.h>
@@ -66,6 +71,12 @@ class TypeLookupManager;
 
 } // namespace builtin
 } // namespace dds
+
+namespace rtps {
+
+class SharedMemTransport;
+
+} // namespace rtps
 } // namespace fastdds
 
 namespace fastrtps {
@@ -91,6 +102,7 @@ class ReaderListener;
 class StatefulReader;
 class PDPSimple;
 class FlowController;
+class SchedulingFlowController;
 class IPersistenceService;
 class WLP;
 
@@ -321,6 +333,24 @@ public:
         return m_controllers;
     }
 
+    /**
+     * Get a flow controller the writers can reference by name.
+     * @param name Name of the flow controller.
+     * @return the flow controller, or nullptr if there is no flow controller with that name.
+     */
+    SchedulingFlowController* find_flow_controller(
+            const std::string& name) const;
+
+    /**
+     * Get the statistics of the writers attached to a flow controller.
+     * @param name Name of the flow controller.
+     * @param [out] statistics Where the statistics of each writer are appended to.
+     * @return false if there is no flow controller with that name.
+     */
+    bool get_flow_controller_statistics(
+            const std::string& name,
+            std::vector<FlowControllerWriterStatistics>& statistics) const;
+
     /*!
      * @remarks Non thread-safe.
      */
@@ -373,6 +403,12 @@ public:
 
     WLP* wlp();
 
+    //! Get the index of the local user readers matched with each remote writer.
+    MatchedReadersIndex& matched_readers_index()
+    {
+        return matched_readers_index_;
+    }
+
     fastdds::dds::builtin::TypeLookupManager* typelookup_manager() const;
 
     bool is_intraprocess_only() const
@@ -390,6 +426,12 @@ public:
         return has_shm_transport_;
     }
 
+    /**
+     * Get the shared-memory transport messages are sent through, so they can be serialized directly on its segment.
+     * @return nullptr when the participant does not send through a shared-memory transport.
+     */
+    fastdds::rtps::SharedMemTransport* shared_mem_transport();
+
     uint32_t get_min_network_send_buffer_size()
     {
         return m_network_Factory.get_min_send_buffer_size();
@@ -496,6 +538,8 @@ private:
     std::list<ReceiverControlBlock> m_receiverResourcelist;
     //! Receiver resource list needs its own mutext to avoid a race condition.
     std::mutex m_receiverResourcelistMutex;
+    //! Local user readers matched with each remote writer, used by the MessageReceivers.
+    MatchedReadersIndex matched_readers_index_;
 
     //!SenderResource List
     std::timed_mutex m_send_resources_mutex_;
@@ -578,6 +622,9 @@ private:
      */
     std::vector<std::unique_ptr<FlowController> > m_controllers;
 
+    //! Flow controllers the writers can reference by name.
+    std::map<std::string, std::unique_ptr<SchedulingFlowController> > scheduling_flow_controllers_;
+
 #if HAVE_SECURITY
     security::ParticipantSecurityAttributes security_attributes_;
 #endif
@@ -585,6 +632,9 @@ private:
     //! Indicates whether the participant has shared-memory transport
     bool has_shm_transport_;
 
+    //! Shared-memory transport messages are sent through, found on the send resources the first time it is asked.
+    std::atomic<fastdds::rtps::SharedMemTransport*> shared_mem_transport_;
+
     /**
      * Get persistence service from factory, using endpoint attributes (or participant
      * attributes if endpoint does not define a persistence service config)
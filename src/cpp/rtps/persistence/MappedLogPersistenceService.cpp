@@ -0,0 +1,1263 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file MappedLogPersistenceService.cpp
+ *
+ */
+
+#include <rtps/persistence/MappedLogPersistenceService.h>
+#include <fastdds/dds/log/Log.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <map>
+#include <mutex>
+
+#ifdef _WIN32
+#include <io.h>
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif // ifdef _WIN32
+
+namespace eprosima {
+namespace fastrtps {
+namespace rtps {
+
+/*
+ * Layout of a segment file:
+ *
+ * +----------------+---------+---------+-----+----------------------+---------+
+ * | SegmentHeader  | Record  | Record  | ... | Footer (offsets)     | Trailer |
+ * +----------------+---------+---------+-----+----------------------+---------+
+ *
+ * Every record starts with a RecordHeader, followed by the persistence GUID and a body depending on its type.
+ * Records are aligned to 8 bytes, and their length is written last, so a record with zero length marks the end of
+ * the segment. The footer and the trailer are only written when the segment is full. Integers are stored with the
+ * byte order of the host.
+ */
+
+static constexpr char segment_magic[8] = {'F', 'D', 'D', 'S', 'L', 'O', 'G', '1'};
+static constexpr uint32_t seal_magic = 0x4C414553u;
+
+static constexpr uint16_t ADD_WRITER_CHANGE = 1;
+static constexpr uint16_t REMOVE_WRITER_CHANGE = 2;
+static constexpr uint16_t UPDATE_WRITER_SEQ = 3;
+
+struct SegmentHeader
+{
+    char magic[8];
+    uint64_t index;
+    uint64_t reserved[2];
+};
+
+struct RecordHeader
+{
+    //! Size of the record, including this header and padding.
+    uint32_t length;
+    uint16_t type;
+    uint16_t guid_length;
+    uint32_t checksum;
+    uint32_t reserved;
+};
+
+struct SegmentTrailer
+{
+    uint32_t footer_offset;
+    uint32_t footer_count;
+    uint32_t checksum;
+    uint32_t magic;
+};
+
+static constexpr uint32_t header_size = static_cast<uint32_t>(sizeof(SegmentHeader));
+static constexpr uint32_t record_header_size = static_cast<uint32_t>(sizeof(RecordHeader));
+static constexpr uint32_t trailer_size = static_cast<uint32_t>(sizeof(SegmentTrailer));
+
+//! Size of the fixed part of the body of each record type.
+static constexpr uint32_t add_fixed_size = 8 + 16;
+static constexpr uint32_t remove_fixed_size = 8;
+static constexpr uint32_t update_fixed_size = GuidPrefix_t::size + EntityId_t::size + 8;
+
+static uint32_t align_record(
+        uint32_t size)
+{
+    return (size + 7u) & ~7u;
+}
+
+//! FNV-1a hash, used to detect records that were not completely written.
+static uint32_t checksum(
+        const octet* data,
+        size_t size,
+        uint32_t hash = 2166136261u)
+{
+    for (size_t i = 0; i < size; ++i)
+    {
+        hash = (hash ^ data[i]) * 16777619u;
+    }
+    return hash;
+}
+
+/**
+ * File mapped on memory, that can be grown when opened.
+ */
+class MappedFile
+{
+public:
+
+    MappedFile() = default;
+
+    MappedFile(
+            const MappedFile&) = delete;
+
+    MappedFile& operator =(
+            const MappedFile&) = delete;
+
+    ~MappedFile()
+    {
+        close();
+    }
+
+    static bool exists(
+            const std::string& name)
+    {
+        FILE* f = std::fopen(name.c_str(), "rb");
+        if (f != nullptr)
+        {
+            std::fclose(f);
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * Open a file, creating it if it does not exist, and map it.
+     * @param name Name of the file.
+     * @param min_size Minimum size of the file. It is grown with zeros when smaller.
+     * @return true on success.
+     */
+    bool open(
+            const std::string& name,
+            size_t min_size)
+    {
+#ifdef _WIN32
+        file_ = CreateFileA(name.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, NULL, OPEN_ALWAYS,
+                        FILE_ATTRIBUTE_NORMAL, NULL);
+        if (file_ == INVALID_HANDLE_VALUE)
+        {
+            return false;
+        }
+
+        LARGE_INTEGER file_size;
+        if (!GetFileSizeEx(file_, &file_size))
+        {
+            close();
+            return false;
+        }
+        size_ = (std::max)(static_cast<size_t>(file_size.QuadPart), min_size);
+
+        uint64_t map_size = size_;
+        mapping_ = CreateFileMappingA(file_, NULL, PAGE_READWRITE, static_cast<DWORD>(map_size >> 32),
+                        static_cast<DWORD>(map_size & 0xFFFFFFFF), NULL);
+        if (mapping_ == NULL)
+        {
+            close();
+            return false;
+        }
+
+        data_ = static_cast<octet*>(MapViewOfFile(mapping_, FILE_MAP_ALL_ACCESS, 0, 0, size_));
+        if (data_ == nullptr)
+        {
+            close();
+            return false;
+        }
+#else
+        fd_ = ::open(name.c_str(), O_RDWR | O_CREAT, 0644);
+        if (fd_ < 0)
+        {
+            return false;
+        }
+
+        struct stat st;
+        if (fstat(fd_, &st) != 0)
+        {
+            close();
+            return false;
+        }
+        size_ = (std::max)(static_cast<size_t>(st.st_size), min_size);
+
+        if (static_cast<size_t>(st.st_size) < size_ && ftruncate(fd_, static_cast<off_t>(size_)) != 0)
+        {
+            close();
+            return false;
+        }
+
+        void* addr = mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+        if (addr == MAP_FAILED)
+        {
+            close();
+            return false;
+        }
+        data_ = static_cast<octet*>(addr);
+#endif // ifdef _WIN32
+
+        return true;
+    }
+
+    void close()
+    {
+#ifdef _WIN32
+        if (data_ != nullptr)
+        {
+            UnmapViewOfFile(data_);
+        }
+        if (mapping_ != NULL)
+        {
+            CloseHandle(mapping_);
+            mapping_ = NULL;
+        }
+        if (file_ != INVALID_HANDLE_VALUE)
+        {
+            CloseHandle(file_);
+            file_ = INVALID_HANDLE_VALUE;
+        }
+#else
+        if (data_ != nullptr)
+        {
+            munmap(data_, size_);
+        }
+        if (fd_ >= 0)
+        {
+            ::close(fd_);
+            fd_ = -1;
+        }
+#endif // ifdef _WIN32
+        data_ = nullptr;
+        size_ = 0;
+    }
+
+    octet* data() const
+    {
+        return data_;
+    }
+
+    size_t size() const
+    {
+        return size_;
+    }
+
+    //! Write a range of the mapping to disk.
+    void flush(
+            size_t offset,
+            size_t length)
+    {
+#ifdef _WIN32
+        FlushViewOfFile(data_ + offset, length);
+        FlushFileBuffers(file_);
+#else
+        // msync requires an address aligned to the page size
+        static const size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        size_t start = offset - (offset % page_size);
+        msync(data_ + start, length + (offset - start), MS_SYNC);
+#endif // ifdef _WIN32
+    }
+
+private:
+
+#ifdef _WIN32
+    HANDLE file_ = INVALID_HANDLE_VALUE;
+    HANDLE mapping_ = NULL;
+#else
+    int fd_ = -1;
+#endif // ifdef _WIN32
+
+    octet* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+/**
+ * Log shared by all the services using the same files.
+ */
+class MappedLog
+{
+    struct Segment
+    {
+        uint64_t index = 0;
+
+        MappedFile file;
+
+        //! Offset where the next record will be written.
+        uint32_t write_pos = header_size;
+
+        //! Bytes taken by records still needed.
+        uint32_t live_bytes = 0;
+
+        //! Whether the footer has been written, so no more records can be added.
+        bool sealed = false;
+
+        //! Offsets of the records on the segment. Only kept until it is sealed.
+        std::vector<uint32_t> records;
+    };
+
+    struct Location
+    {
+        uint64_t segment;
+        uint32_t offset;
+        uint32_t length;
+    };
+
+    struct ReaderEntry
+    {
+        int64_t seq_num;
+        Location location;
+    };
+
+    //! Record read from a segment.
+    struct Record
+    {
+        uint32_t length;
+        uint16_t type;
+        std::string guid;
+        const octet* fixed;
+        const octet* payload;
+        uint32_t payload_length;
+    };
+
+public:
+
+    MappedLog(
+            const std::string& filename,
+            uint32_t segment_size,
+            bool flush)
+        : filename_(filename)
+        , segment_size_(segment_size)
+        , flush_(flush)
+    {
+    }
+
+    //! Open the existing segments, or create the first one.
+    bool open()
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+
+        head_index_ = 0;
+        FILE* f = std::fopen(filename_.c_str(), "rb");
+        if (f != nullptr)
+        {
+            // The index is always replaced as a whole, so it can only be short when something else broke it
+            bool read_ok = (1 == std::fread(&head_index_, sizeof(head_index_), 1, f));
+            std::fclose(f);
+            if (!read_ok)
+            {
+                logError(RTPS_PERSISTENCE, "Could not read the head of the log from " << filename_);
+                return false;
+            }
+        }
+        else if (!write_head_index())
+        {
+            logError(RTPS_PERSISTENCE, "Could not create " << filename_);
+            return false;
+        }
+
+        for (uint64_t index = head_index_; MappedFile::exists(segment_name(index)); ++index)
+        {
+            segments_.emplace_back();
+            Segment& segment = segments_.back();
+            segment.index = index;
+            if (!segment.file.open(segment_name(index), 0) || !load_segment(segment))
+            {
+                std::string name = segment_name(index);
+                if (MappedFile::exists(segment_name(index + 1)))
+                {
+                    logError(RTPS_PERSISTENCE, "Could not load segment " << name);
+                    return false;
+                }
+
+                // Last segment was being created when the process stopped, so it has no records yet
+                logWarning(RTPS_PERSISTENCE, "Discarding incomplete segment " << name);
+                segment.file.close();
+                segments_.pop_back();
+                std::remove(name.c_str());
+                break;
+            }
+        }
+
+        // Records are only added to the last segment, which should not have a footer
+        if (segments_.empty() || segments_.back().sealed)
+        {
+            uint64_t index = segments_.empty() ? head_index_ : segments_.back().index + 1;
+            if (!add_segment(index, segment_size_))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    bool load_writer(
+            const std::string& persistence_guid,
+            const GUID_t& writer_guid,
+            std::vector<CacheChange_t*>& changes,
+            const std::shared_ptr<IChangePool>& change_pool,
+            const std::shared_ptr<IPayloadPool>& payload_pool,
+            SequenceNumber_t& next_sequence)
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+
+        bool ret = true;
+        int64_t max_sn = 0;
+        auto writer = writers_.find(persistence_guid);
+        if (writer != writers_.end())
+        {
+            for (const auto& entry : writer->second)
+            {
+                max_sn = entry.first;
+
+                Record record;
+                if (!read_record(entry.second, record))
+                {
+                    logError(RTPS_PERSISTENCE, "Could not read change " << entry.first << " of " << persistence_guid);
+                    ret = false;
+                    continue;
+                }
+
+                CacheChange_t* change = nullptr;
+                if (!change_pool->reserve_cache(change))
+                {
+                    continue;
+                }
+
+                if (!payload_pool->get_payload(record.payload_length, *change))
+                {
+                    change_pool->release_cache(change);
+                    continue;
+                }
+
+                change->kind = ALIVE;
+                change->writerGUID = writer_guid;
+                memcpy(change->instanceHandle.value, record.fixed + 8, 16);
+                change->sequenceNumber.high = static_cast<int32_t>((entry.first >> 32) & 0xFFFFFFFF);
+                change->sequenceNumber.low = static_cast<uint32_t>(entry.first & 0xFFFFFFFF);
+                change->serializedPayload.length = record.payload_length;
+                memcpy(change->serializedPayload.data, record.payload, record.payload_length);
+
+                changes.push_back(change);
+            }
+        }
+
+        next_sequence.high = static_cast<int32_t>((max_sn >> 32) & 0xFFFFFFFF);
+        next_sequence.low = static_cast<uint32_t>(max_sn & 0xFFFFFFFF);
+        return ret;
+    }
+
+    bool add_writer_change(
+            const std::string& persistence_guid,
+            const CacheChange_t& change)
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+
+        int64_t seq_num = change.sequenceNumber.to64long();
+        auto& changes = writers_[persistence_guid];
+        if (changes.find(seq_num) != changes.end())
+        {
+            return false;
+        }
+
+        octet fixed[add_fixed_size];
+        memcpy(fixed, &seq_num, 8);
+        memcpy(fixed + 8, change.instanceHandle.value, 16);
+
+        Location location;
+        if (!append(ADD_WRITER_CHANGE, persistence_guid, fixed, add_fixed_size, change.serializedPayload.data,
+                change.serializedPayload.length, location))
+        {
+            return false;
+        }
+
+        changes[seq_num] = location;
+        segment(location.segment).live_bytes += location.length;
+        return true;
+    }
+
+    bool remove_writer_change(
+            const std::string& persistence_guid,
+            const CacheChange_t& change)
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+
+        int64_t seq_num = change.sequenceNumber.to64long();
+        auto writer = writers_.find(persistence_guid);
+        if (writer == writers_.end())
+        {
+            return true;
+        }
+        auto it = writer->second.find(seq_num);
+        if (it == writer->second.end())
+        {
+            return true;
+        }
+
+        Location location;
+        if (!append(REMOVE_WRITER_CHANGE, persistence_guid, reinterpret_cast<const octet*>(&seq_num),
+                remove_fixed_size, nullptr, 0, location))
+        {
+            return false;
+        }
+
+        segment(it->second.segment).live_bytes -= it->second.length;
+        writer->second.erase(it);
+        compact();
+        return true;
+    }
+
+    bool load_reader(
+            const std::string& reader_guid,
+            foonathan::memory::map<GUID_t, SequenceNumber_t, IPersistenceService::map_allocator_t>& seq_map)
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+
+        auto reader = readers_.find(reader_guid);
+        if (reader != readers_.end())
+        {
+            for (const auto& entry : reader->second)
+            {
+                int64_t sn = entry.second.seq_num;
+                seq_map[entry.first] =
+                        SequenceNumber_t(static_cast<int32_t>((sn >> 32) & 0xFFFFFFFF),
+                                static_cast<uint32_t>(sn & 0xFFFFFFFF));
+            }
+        }
+
+        return true;
+    }
+
+    bool update_writer_seq(
+            const std::string& reader_guid,
+            const GUID_t& writer_guid,
+            const SequenceNumber_t& seq_number)
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+
+        int64_t seq_num = seq_number.to64long();
+        octet fixed[update_fixed_size];
+        memcpy(fixed, writer_guid.guidPrefix.value, GuidPrefix_t::size);
+        memcpy(fixed + GuidPrefix_t::size, writer_guid.entityId.value, EntityId_t::size);
+        memcpy(fixed + GuidPrefix_t::size + EntityId_t::size, &seq_num, 8);
+
+        Location location;
+        if (!append(UPDATE_WRITER_SEQ, reader_guid, fixed, update_fixed_size, nullptr, 0, location))
+        {
+            return false;
+        }
+
+        auto& entries = readers_[reader_guid];
+        auto it = entries.find(writer_guid);
+        if (it != entries.end())
+        {
+            segment(it->second.location.segment).live_bytes -= it->second.location.length;
+        }
+        entries[writer_guid] = ReaderEntry{ seq_num, location };
+        segment(location.segment).live_bytes += location.length;
+        compact();
+        return true;
+    }
+
+private:
+
+    std::string segment_name(
+            uint64_t index) const
+    {
+        char suffix[24];
+        snprintf(suffix, sizeof(suffix), ".%08llu", static_cast<unsigned long long>(index));
+        return filename_ + suffix;
+    }
+
+    Segment& segment(
+            uint64_t index)
+    {
+        return segments_[static_cast<size_t>(index - segments_.front().index)];
+    }
+
+    /**
+     * Store the number of the oldest segment.
+     * It is written to a temporary file which then replaces the index, so a crash leaves either the old or the
+     * new one.
+     */
+    bool write_head_index()
+    {
+        std::string tmp_name = filename_ + ".tmp";
+        FILE* f = std::fopen(tmp_name.c_str(), "wb");
+        if (f == nullptr)
+        {
+            return false;
+        }
+        bool ret = (1 == std::fwrite(&head_index_, sizeof(head_index_), 1, f)) && (0 == std::fflush(f));
+        if (ret && flush_)
+        {
+#ifdef _WIN32
+            ret = (0 == _commit(_fileno(f)));
+#else
+            ret = (0 == fsync(fileno(f)));
+#endif // ifdef _WIN32
+        }
+        ret = (0 == std::fclose(f)) && ret;
+
+        if (ret)
+        {
+#ifdef _WIN32
+            ret = (0 != MoveFileExA(tmp_name.c_str(), filename_.c_str(),
+                    MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH));
+#else
+            ret = (0 == std::rename(tmp_name.c_str(), filename_.c_str()));
+#endif // ifdef _WIN32
+        }
+
+        if (!ret)
+        {
+            std::remove(tmp_name.c_str());
+        }
+        return ret;
+    }
+
+    bool add_segment(
+            uint64_t index,
+            uint32_t size)
+    {
+        segments_.emplace_back();
+        Segment& segment = segments_.back();
+        segment.index = index;
+        if (!segment.file.open(segment_name(index), size))
+        {
+            logError(RTPS_PERSISTENCE, "Could not create segment " << segment_name(index));
+            segments_.pop_back();
+            return false;
+        }
+
+        SegmentHeader header{};
+        memcpy(header.magic, segment_magic, sizeof(segment_magic));
+        header.index = index;
+        memcpy(segment.file.data(), &header, header_size);
+        if (flush_)
+        {
+            segment.file.flush(0, header_size);
+        }
+        return true;
+    }
+
+    /**
+     * Read a record from a segment.
+     * @return false when there is no valid record at the given offset.
+     */
+    static bool parse_record(
+            const Segment& segment,
+            uint32_t offset,
+            uint32_t limit,
+            Record& record)
+    {
+        if (offset < header_size || offset % 8 != 0 || limit < offset || limit - offset < record_header_size)
+        {
+            return false;
+        }
+
+        const octet* base = segment.file.data() + offset;
+        RecordHeader header;
+        memcpy(&header, base, record_header_size);
+        if (header.length < record_header_size || header.length > limit - offset)
+        {
+            return false;
+        }
+
+        uint32_t fixed_size = 0;
+        switch (header.type)
+        {
+            case ADD_WRITER_CHANGE:
+                fixed_size = add_fixed_size;
+                break;
+            case REMOVE_WRITER_CHANGE:
+                fixed_size = remove_fixed_size;
+                break;
+            case UPDATE_WRITER_SEQ:
+                fixed_size = update_fixed_size;
+                break;
+            default:
+                return false;
+        }
+
+        uint32_t body_length = header.length - record_header_size;
+        if (header.guid_length + fixed_size > body_length)
+        {
+            return false;
+        }
+
+        // Padding is included on the checksum, as it is written with zeros
+        uint32_t hash = checksum(reinterpret_cast<const octet*>(&header.type), 4);
+        if (checksum(base + record_header_size, body_length, hash) != header.checksum)
+        {
+            return false;
+        }
+
+        const octet* body = base + record_header_size;
+        record.length = header.length;
+        record.type = header.type;
+        record.guid.assign(reinterpret_cast<const char*>(body), header.guid_length);
+        record.fixed = body + header.guid_length;
+        record.payload = record.fixed + fixed_size;
+        record.payload_length = 0;
+        if (header.type == ADD_WRITER_CHANGE)
+        {
+            memcpy(&record.payload_length, body + body_length - 4, 4);
+            if (record.payload_length > body_length - 4 - header.guid_length - fixed_size)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * Read the record of a change kept on the index.
+     * @return false when the record is not a valid change.
+     */
+    bool read_record(
+            const Location& location,
+            Record& record)
+    {
+        Segment& s = segment(location.segment);
+        return parse_record(s, location.offset, location.offset + location.length, record) &&
+               record.type == ADD_WRITER_CHANGE;
+    }
+
+    /**
+     * Get the offsets of the records on a segment, from its footer when it has one.
+     * @return Whether the segment has a valid footer.
+     */
+    static bool collect_records(
+            const Segment& segment,
+            std::vector<uint32_t>& offsets,
+            uint32_t& write_pos)
+    {
+        const octet* data = segment.file.data();
+        size_t size = segment.file.size();
+
+        SegmentTrailer trailer;
+        memcpy(&trailer, data + size - trailer_size, trailer_size);
+        if (trailer.magic == seal_magic &&
+                trailer.footer_offset >= header_size &&
+                trailer.footer_count <= (size - trailer_size - trailer.footer_offset) / 4 &&
+                checksum(data + trailer.footer_offset, trailer.footer_count * 4u) == trailer.checksum)
+        {
+            offsets.resize(trailer.footer_count);
+            memcpy(offsets.data(), data + trailer.footer_offset, trailer.footer_count * 4u);
+            write_pos = trailer.footer_offset;
+            return true;
+        }
+
+        // No footer: scan the records until the first one that was not completely written
+        uint32_t limit = static_cast<uint32_t>(size - trailer_size);
+        uint32_t offset = header_size;
+        Record record;
+        while (parse_record(segment, offset, limit, record))
+        {
+            offsets.push_back(offset);
+            offset += record.length;
+        }
+        write_pos = offset;
+        return false;
+    }
+
+    bool load_segment(
+            Segment& segment)
+    {
+        SegmentHeader header;
+        if (segment.file.size() < header_size + trailer_size)
+        {
+            return false;
+        }
+        memcpy(&header, segment.file.data(), header_size);
+        if (memcmp(header.magic, segment_magic, sizeof(segment_magic)) != 0 || header.index != segment.index)
+        {
+            return false;
+        }
+
+        std::vector<uint32_t> offsets;
+        segment.sealed = collect_records(segment, offsets, segment.write_pos);
+
+        uint32_t limit = static_cast<uint32_t>(segment.file.size() - trailer_size);
+        for (uint32_t offset : offsets)
+        {
+            Record record;
+            if (parse_record(segment, offset, limit, record))
+            {
+                apply(segment, offset, record);
+            }
+        }
+
+        if (!segment.sealed)
+        {
+            // Remove what is left of a record that was not completely written
+            memset(segment.file.data() + segment.write_pos, 0, segment.file.size() - segment.write_pos);
+            segment.records = std::move(offsets);
+        }
+
+        return true;
+    }
+
+    //! Update the index with a record read from a segment.
+    void apply(
+            Segment& seg,
+            uint32_t offset,
+            const Record& record)
+    {
+        Location location{ seg.index, offset, record.length };
+
+        switch (record.type)
+        {
+            case ADD_WRITER_CHANGE:
+            {
+                int64_t seq_num;
+                memcpy(&seq_num, record.fixed, 8);
+                auto& changes = writers_[record.guid];
+                auto it = changes.find(seq_num);
+                if (it != changes.end())
+                {
+                    // Copy made by a compaction that was not completed
+                    segment(it->second.segment).live_bytes -= it->second.length;
+                }
+                changes[seq_num] = location;
+                seg.live_bytes += record.length;
+                break;
+            }
+
+            case REMOVE_WRITER_CHANGE:
+            {
+                int64_t seq_num;
+                memcpy(&seq_num, record.fixed, 8);
+                auto writer = writers_.find(record.guid);
+                if (writer != writers_.end())
+                {
+                    auto it = writer->second.find(seq_num);
+                    if (it != writer->second.end())
+                    {
+                        segment(it->second.segment).live_bytes -= it->second.length;
+                        writer->second.erase(it);
+                    }
+                }
+                break;
+            }
+
+            case UPDATE_WRITER_SEQ:
+            {
+                GUID_t writer_guid;
+                int64_t seq_num;
+                memcpy(writer_guid.guidPrefix.value, record.fixed, GuidPrefix_t::size);
+                memcpy(writer_guid.entityId.value, record.fixed + GuidPrefix_t::size, EntityId_t::size);
+                memcpy(&seq_num, record.fixed + GuidPrefix_t::size + EntityId_t::size, 8);
+                auto& entries = readers_[record.guid];
+                auto it = entries.find(writer_guid);
+                if (it != entries.end())
+                {
+                    segment(it->second.location.segment).live_bytes -= it->second.location.length;
+                }
+                entries[writer_guid] = ReaderEntry{ seq_num, location };
+                seg.live_bytes += record.length;
+                break;
+            }
+        }
+    }
+
+    //! Whether a record is still referenced by the index.
+    bool is_live(
+            uint64_t segment_index,
+            uint32_t offset,
+            const Record& record)
+    {
+        if (record.type == ADD_WRITER_CHANGE)
+        {
+            int64_t seq_num;
+            memcpy(&seq_num, record.fixed, 8);
+            auto writer = writers_.find(record.guid);
+            if (writer != writers_.end())
+            {
+                auto it = writer->second.find(seq_num);
+                return it != writer->second.end() && it->second.segment == segment_index &&
+                       it->second.offset == offset;
+            }
+        }
+        else if (record.type == UPDATE_WRITER_SEQ)
+        {
+            GUID_t writer_guid;
+            memcpy(writer_guid.guidPrefix.value, record.fixed, GuidPrefix_t::size);
+            memcpy(writer_guid.entityId.value, record.fixed + GuidPrefix_t::size, EntityId_t::size);
+            auto reader = readers_.find(record.guid);
+            if (reader != readers_.end())
+            {
+                auto it = reader->second.find(writer_guid);
+                return it != reader->second.end() && it->second.location.segment == segment_index &&
+                       it->second.location.offset == offset;
+            }
+        }
+        return false;
+    }
+
+    //! Write the footer of the last segment, so no more records are added to it.
+    void seal()
+    {
+        Segment& seg = segments_.back();
+        uint32_t limit = static_cast<uint32_t>(seg.file.size() - trailer_size);
+
+        // Removals are kept, as they may refer to changes on previous segments
+        std::vector<uint32_t> footer;
+        for (uint32_t offset : seg.records)
+        {
+            Record record;
+            if (parse_record(seg, offset, limit, record) &&
+                    (record.type == REMOVE_WRITER_CHANGE || is_live(seg.index, offset, record)))
+            {
+                footer.push_back(offset);
+            }
+        }
+
+        SegmentTrailer trailer;
+        trailer.footer_offset = seg.write_pos;
+        trailer.footer_count = static_cast<uint32_t>(footer.size());
+        trailer.checksum = checksum(reinterpret_cast<const octet*>(footer.data()), footer.size() * 4u);
+        trailer.magic = seal_magic;
+
+        octet* data = seg.file.data();
+        memcpy(data + seg.write_pos, footer.data(), footer.size() * 4u);
+        memcpy(data + limit, &trailer, trailer_size);
+        if (flush_)
+        {
+            seg.file.flush(seg.write_pos, seg.file.size() - seg.write_pos);
+        }
+
+        seg.sealed = true;
+        seg.records.clear();
+        seg.records.shrink_to_fit();
+    }
+
+    /**
+     * Add a record at the end of the log.
+     * @param type Type of the record.
+     * @param guid Persistence GUID of the endpoint.
+     * @param fixed Fixed part of the body of the record.
+     * @param fixed_size Size of the fixed part of the body.
+     * @param payload Serialized payload, only for changes.
+     * @param payload_length Size of the serialized payload.
+     * @param [out] location Where the record was written.
+     * @return true on success.
+     */
+    bool append(
+            uint16_t type,
+            const std::string& guid,
+            const octet* fixed,
+            uint32_t fixed_size,
+            const octet* payload,
+            uint32_t payload_length,
+            Location& location)
+    {
+        if (guid.size() > UINT16_MAX)
+        {
+            return false;
+        }
+
+        // Changes end with their payload length, so padding can be told apart from it
+        uint32_t body_length = static_cast<uint32_t>(guid.size()) + fixed_size + payload_length +
+                (type == ADD_WRITER_CHANGE ? 4u : 0u);
+        uint32_t length = align_record(record_header_size + body_length);
+
+        if (!reserve(length))
+        {
+            return false;
+        }
+
+        Segment& seg = segments_.back();
+        octet* base = seg.file.data() + seg.write_pos;
+        octet* body = base + record_header_size;
+        octet* ptr = body;
+        memcpy(ptr, guid.data(), guid.size());
+        ptr += guid.size();
+        memcpy(ptr, fixed, fixed_size);
+        ptr += fixed_size;
+        if (type == ADD_WRITER_CHANGE)
+        {
+            if (payload_length > 0)
+            {
+                memcpy(ptr, payload, payload_length);
+            }
+            memcpy(body + length - record_header_size - 4, &payload_length, 4);
+        }
+
+        RecordHeader header;
+        header.length = 0;
+        header.type = type;
+        header.guid_length = static_cast<uint16_t>(guid.size());
+        header.reserved = 0;
+        header.checksum = checksum(body, length - record_header_size,
+                        checksum(reinterpret_cast<const octet*>(&header.type), 4));
+        memcpy(base, &header, record_header_size);
+
+        // The record is only valid once its length is written
+        std::atomic_thread_fence(std::memory_order_release);
+        memcpy(base, &length, sizeof(length));
+
+        if (flush_)
+        {
+            seg.file.flush(seg.write_pos, length);
+        }
+
+        location = Location{ seg.index, seg.write_pos, length };
+        seg.records.push_back(seg.write_pos);
+        seg.write_pos += length;
+        return true;
+    }
+
+    //! Make room for a record on the last segment, starting a new one if necessary.
+    bool reserve(
+            uint32_t length)
+    {
+        Segment& seg = segments_.back();
+        uint64_t footer_size = 4u * (seg.records.size() + 1u);
+        if (seg.write_pos + length + footer_size + trailer_size <= seg.file.size())
+        {
+            return true;
+        }
+
+        // Records bigger than a segment get a segment of their own
+        uint64_t needed = uint64_t(header_size) + length + 4u + trailer_size;
+        if (needed > UINT32_MAX)
+        {
+            logError(RTPS_PERSISTENCE, "Record of " << length << " bytes is too big");
+            return false;
+        }
+
+        uint64_t index = seg.index + 1;
+        seal();
+        return add_segment(index, (std::max)(segment_size_, static_cast<uint32_t>(needed)));
+    }
+
+    /**
+     * Remove the oldest segments when most of their records are not needed anymore.
+     * The records still needed are copied to the last segment before.
+     */
+    void compact()
+    {
+        while (segments_.size() > 1)
+        {
+            Segment& head = segments_.front();
+            uint32_t used = head.write_pos - header_size;
+            if (uint64_t(head.live_bytes) * 4u > used)
+            {
+                break;
+            }
+
+            std::vector<uint32_t> offsets;
+            uint32_t write_pos;
+            collect_records(head, offsets, write_pos);
+            uint32_t limit = static_cast<uint32_t>(head.file.size() - trailer_size);
+            for (uint32_t offset : offsets)
+            {
+                Record record;
+                if (parse_record(head, offset, limit, record) && is_live(head.index, offset, record) &&
+                        !move_record(head, record))
+                {
+                    return;
+                }
+            }
+
+            // Once the head is updated, the segment is not needed anymore even if it is not removed
+            ++head_index_;
+            if (!write_head_index())
+            {
+                --head_index_;
+                return;
+            }
+
+            std::string name = segment_name(head.index);
+            head.file.close();
+            segments_.pop_front();
+            std::remove(name.c_str());
+        }
+    }
+
+    bool move_record(
+            Segment& from,
+            const Record& record)
+    {
+        Location location;
+        uint32_t fixed_size = (record.type == ADD_WRITER_CHANGE) ? add_fixed_size : update_fixed_size;
+        if (!append(record.type, record.guid, record.fixed, fixed_size, record.payload, record.payload_length,
+                location))
+        {
+            return false;
+        }
+
+        // Segments may have been added, but the head is still on the same place
+        if (record.type == ADD_WRITER_CHANGE)
+        {
+            int64_t seq_num;
+            memcpy(&seq_num, record.fixed, 8);
+            writers_[record.guid][seq_num] = location;
+        }
+        else
+        {
+            GUID_t writer_guid;
+            memcpy(writer_guid.guidPrefix.value, record.fixed, GuidPrefix_t::size);
+            memcpy(writer_guid.entityId.value, record.fixed + GuidPrefix_t::size, EntityId_t::size);
+            readers_[record.guid][writer_guid].location = location;
+        }
+        from.live_bytes -= record.length;
+        segment(location.segment).live_bytes += location.length;
+        return true;
+    }
+
+    std::mutex mutex_;
+
+    std::string filename_;
+
+    uint32_t segment_size_;
+
+    bool flush_;
+
+    //! Number of the oldest segment.
+    uint64_t head_index_ = 0;
+
+    //! Segments, from the oldest to the one where records are added.
+    std::deque<Segment> segments_;
+
+    //! Location of the changes of each writer, by sequence number.
+    std::map<std::string, std::map<int64_t, Location> > writers_;
+
+    //! Last sequence number of each writer for each reader.
+    std::map<std::string, std::map<GUID_t, ReaderEntry> > readers_;
+};
+
+IPersistenceService* create_mapped_log_persistence_service(
+        const PropertyPolicy& property_policy)
+{
+    const std::string* filename_property =
+            PropertyPolicyHelper::find_property(property_policy, "dds.persistence.mapped_log.filename");
+    std::string filename = (filename_property == nullptr) ? "persistence.log" : *filename_property;
+
+    uint32_t segment_size = 4u * 1024u * 1024u;
+    const std::string* size_property =
+            PropertyPolicyHelper::find_property(property_policy, "dds.persistence.mapped_log.segment_size");
+    if (size_property != nullptr)
+    {
+        try
+        {
+            unsigned long value = std::stoul(*size_property);
+            segment_size = static_cast<uint32_t>((std::min)((std::max)(value, 4096ul), 1ul << 30));
+        }
+        catch (std::exception&)
+        {
+            logWarning(RTPS_PERSISTENCE, "Wrong value '" << *size_property <<
+                    "' for property dds.persistence.mapped_log.segment_size, using " << segment_size);
+        }
+    }
+
+    bool flush = false;
+    const std::string* flush_property =
+            PropertyPolicyHelper::find_property(property_policy, "dds.persistence.mapped_log.flush");
+    if (flush_property != nullptr)
+    {
+        flush = (flush_property->compare("true") == 0 || flush_property->compare("1") == 0);
+    }
+
+    // Endpoints on the same process using the same files share the log
+    static std::mutex logs_mutex;
+    static std::map<std::string, std::weak_ptr<MappedLog> > logs;
+
+    std::lock_guard<std::mutex> guard(logs_mutex);
+    std::shared_ptr<MappedLog> log = logs[filename].lock();
+    if (!log)
+    {
+        log = std::make_shared<MappedLog>(filename, segment_size, flush);
+        if (!log->open())
+        {
+            logs.erase(filename);
+            return nullptr;
+        }
+        logs[filename] = log;
+    }
+
+    return new MappedLogPersistenceService(log);
+}
+
+MappedLogPersistenceService::MappedLogPersistenceService(
+        std::shared_ptr<MappedLog> log)
+    : log_(std::move(log))
+{
+}
+
+MappedLogPersistenceService::~MappedLogPersistenceService()
+{
+}
+
+bool MappedLogPersistenceService::load_writer_from_storage(
+        const std::string& persistence_guid,
+        const GUID_t& writer_guid,
+        std::vector<CacheChange_t*>& changes,
+        const std::shared_ptr<IChangePool>& change_pool,
+        const std::shared_ptr<IPayloadPool>& payload_pool,
+        SequenceNumber_t& next_sequence)
+{
+    logInfo(RTPS_PERSISTENCE, "Loading writer " << writer_guid);
+    return log_->load_writer(persistence_guid, writer_guid, changes, change_pool, payload_pool, next_sequence);
+}
+
+bool MappedLogPersistenceService::add_writer_change_to_storage(
+        const std::string& persistence_guid,
+        const CacheChange_t& change)
+{
+    logInfo(RTPS_PERSISTENCE, "Writer " << change.writerGUID << " storing change for seq " << change.sequenceNumber);
+    return log_->add_writer_change(persistence_guid, change);
+}
+
+bool MappedLogPersistenceService::remove_writer_change_from_storage(
+        const std::string& persistence_guid,
+        const CacheChange_t& change)
+{
+    logInfo(RTPS_PERSISTENCE, "Writer " << change.writerGUID << " removing change for seq " << change.sequenceNumber);
+    return log_->remove_writer_change(persistence_guid, change);
+}
+
+bool MappedLogPersistenceService::load_reader_from_storage(
+        const std::string& reader_guid,
+        foonathan::memory::map<GUID_t, SequenceNumber_t, IPersistenceService::map_allocator_t>& seq_map)
+{
+    logInfo(RTPS_PERSISTENCE, "Loading reader " << reader_guid);
+    return log_->load_reader(reader_guid, seq_map);
+}
+
+bool MappedLogPersistenceService::update_writer_seq_on_storage(
+        const std::string& reader_guid,
+        const GUID_t& writer_guid,
+        const SequenceNumber_t& seq_number)
+{
+    logInfo(RTPS_PERSISTENCE,
+            "Reader " << reader_guid << " setting seq for writer " << writer_guid << " to " << seq_number);
+    return log_->update_writer_seq(reader_guid, writer_guid, seq_number);
+}
+
+} /* namespace rtps */
+} /* namespace fastrtps */
+} /* namespace eprosima */
@@ -0,0 +1,129 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file MappedLogPersistenceService.h
+ */
+
+#ifndef MAPPEDLOGPERSISTENCESERVICE_H_
+#define MAPPEDLOGPERSISTENCESERVICE_H_
+
+#include <rtps/persistence/PersistenceService.h>
+
+#include <memory>
+#include <string>
+
+namespace eprosima {
+namespace fastrtps {
+namespace rtps {
+
+class MappedLog;
+
+/**
+ * Create a new memory-mapped log implementation of persistence service, configured from a property policy.
+ *
+ * The following properties are taken into account:
+ * - @c dds.persistence.mapped_log.filename: name of the file holding the first segment number. Segments are
+ *   stored on files with the same name followed by their number. Defaults to @c persistence.log.
+ * - @c dds.persistence.mapped_log.segment_size: size in bytes of each segment file. Defaults to 4 MiB.
+ * - @c dds.persistence.mapped_log.flush: when @c true, every record is flushed to disk before returning.
+ *   Defaults to @c false, which only protects against a crash of the process.
+ *
+ * Services created with the same filename on the same process share the log.
+ * @param property_policy PropertyPolicy where the configuration will be searched.
+ * @ingroup RTPS_PERSISTENCE_MODULE
+ */
+IPersistenceService* create_mapped_log_persistence_service(
+        const PropertyPolicy& property_policy);
+
+/**
+ * Persistence service implementation over segmented, append-only, memory-mapped files.
+ *
+ * Every operation appends a record to the last segment. An index of the records still needed is kept on memory,
+ * so loading does not need to read the files. When a segment is full, a footer with the offsets of its needed
+ * records is written, so it can be indexed on restart without reading all its records. The oldest segment is
+ * compacted, moving its needed records to the last segment, when most of its contents are not needed anymore.
+ * @ingroup RTPS_PERSISTENCE_MODULE
+ */
+class MappedLogPersistenceService : public IPersistenceService
+{
+public:
+
+    MappedLogPersistenceService(
+            std::shared_ptr<MappedLog> log);
+
+    virtual ~MappedLogPersistenceService() override;
+
+    /**
+     * Get all data stored for a writer.
+     * @param writer_guid GUID of the writer to load.
+     * @return True if operation was successful.
+     */
+    bool load_writer_from_storage(
+            const std::string& persistence_guid,
+            const GUID_t& writer_guid,
+            std::vector<CacheChange_t*>& changes,
+            const std::shared_ptr<IChangePool>& change_pool,
+            const std::shared_ptr<IPayloadPool>& payload_pool,
+            SequenceNumber_t& next_sequence) final;
+
+    /**
+     * Add a change to storage.
+     * @param change The cache change to add.
+     * @return True if operation was successful.
+     */
+    virtual bool add_writer_change_to_storage(
+            const std::string& persistence_guid,
+            const CacheChange_t& change) final;
+
+    /**
+     * Remove a change from storage.
+     * @param change The cache change to remove.
+     * @return True if operation was successful.
+     */
+    virtual bool remove_writer_change_from_storage(
+            const std::string& persistence_guid,
+            const CacheChange_t& change) final;
+
+    /**
+     * Get all data stored for a reader.
+     * @param reader_guid GUID of the reader to load.
+     * @return True if operation was successful.
+     */
+    virtual bool load_reader_from_storage(
+            const std::string& reader_guid,
+            foonathan::memory::map<GUID_t, SequenceNumber_t, map_allocator_t>& seq_map) final;
+
+    /**
+     * Update the sequence number associated to a writer on a reader.
+     * @param reader_guid GUID of the reader to update.
+     * @param writer_guid GUID of the associated writer to update.
+     * @param seq_number New sequence number value to set for the associated writer.
+     * @return True if operation was successful.
+     */
+    virtual bool update_writer_seq_on_storage(
+            const std::string& reader_guid,
+            const GUID_t& writer_guid,
+            const SequenceNumber_t& seq_number) final;
+
+private:
+
+    std::shared_ptr<MappedLog> log_;
+};
+
+} /* namespace rtps */
+} /* namespace fastrtps */
+} /* namespace eprosima */
+
+#endif /* MAPPEDLOGPERSISTENCESERVICE_H_ */
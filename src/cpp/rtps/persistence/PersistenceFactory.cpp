@@ -18,6 +18,7 @@
  */
 
 #include <rtps/persistence/PersistenceService.h>
+#include <rtps/persistence/MappedLogPersistenceService.h>
 
 #if HAVE_SQLITE3
 #include <rtps/persistence/SQLite3PersistenceService.h>
@@ -36,13 +37,17 @@ IPersistenceService* PersistenceFactory::create_persistence_service(const Proper
 
     if (plugin_property != nullptr)
     {
+        if (plugin_property->compare("builtin.MAPPED_LOG") == 0)
+        {
+            ret_val = create_mapped_log_persistence_service(property_policy);
+        }
 #if HAVE_SQLITE3
         if (plugin_property->compare("builtin.SQLITE3") == 0)
         {
             const std::string* filename_property = PropertyPolicyHelper::find_property(property_policy, "dds.persistence.sqlite3.filename");
             const char* filename = (filename_property == nullptr) ?
                 "persistence.db" : filename_property->c_str();
-            ret_val = create_SQLite3_persistence_service(filename);
+            ret_val = create_SQLite3_persistence_service(filename, property_policy);
         }
 #endif
     }
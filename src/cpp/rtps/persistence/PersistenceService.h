@@ -28,6 +28,7 @@
 #include <foonathan/memory/container.hpp>
 #include <foonathan/memory/memory_pool.hpp>
 
+#include <chrono>
 #include <map>
 
 namespace eprosima {
@@ -107,6 +108,18 @@ public:
             const GUID_t& writer_guid,
             const SequenceNumber_t& seq_number) = 0;
 
+    /**
+     * Wait until all the operations requested so far have been stored.
+     * Implementations that store synchronously have nothing to wait for.
+     * @param max_blocking_time Maximum time to wait.
+     * @return True if all operations were stored.
+     */
+    virtual bool wait_for_all_stored(
+            const std::chrono::steady_clock::time_point& /*max_blocking_time*/)
+    {
+        return true;
+    }
+
 };
 
 /**
@@ -25,6 +25,10 @@
 
 #include <string.h>
 
+#include <algorithm>
+#include <initializer_list>
+#include <string>
+
 namespace eprosima {
 namespace fastrtps {
 namespace rtps {
@@ -85,6 +89,26 @@ static void finalize_statement(
     }
 }
 
+static bool is_one_of(
+        const std::string& value,
+        std::initializer_list<const char*> allowed)
+{
+    return std::any_of(allowed.begin(), allowed.end(), [&value](const char* v)
+                   {
+                       return value == v;
+                   });
+}
+
+static bool set_pragma(
+        sqlite3* db,
+        const char* name,
+        const std::string& value)
+{
+    // Values have been checked against a list of known ones, so they can be safely added to the statement
+    std::string statement = std::string("PRAGMA ") + name + "=" + value + ";";
+    return sqlite3_exec(db, statement.c_str(), 0, 0, 0) == SQLITE_OK;
+}
+
 IPersistenceService* create_SQLite3_persistence_service(
         const char* filename)
 {
@@ -92,6 +116,83 @@ IPersistenceService* create_SQLite3_persistence_service(
     return (db == NULL) ? nullptr : new SQLite3PersistenceService(db);
 }
 
+IPersistenceService* create_SQLite3_persistence_service(
+        const char* filename,
+        const PropertyPolicy& property_policy)
+{
+    bool async = false;
+    const std::string* async_property =
+            PropertyPolicyHelper::find_property(property_policy, "dds.persistence.sqlite3.async");
+    if (async_property != nullptr)
+    {
+        async = (async_property->compare("true") == 0 || async_property->compare("1") == 0);
+    }
+
+    std::string journal_mode = async ? "WAL" : "";
+    const std::string* journal_property =
+            PropertyPolicyHelper::find_property(property_policy, "dds.persistence.sqlite3.journal_mode");
+    if (journal_property != nullptr)
+    {
+        if (!is_one_of(*journal_property, {"DELETE", "TRUNCATE", "PERSIST", "MEMORY", "WAL", "OFF"}))
+        {
+            logError(RTPS_PERSISTENCE, "Unknown journal mode " << *journal_property);
+            return nullptr;
+        }
+        journal_mode = *journal_property;
+    }
+
+    std::string synchronous;
+    const std::string* synchronous_property =
+            PropertyPolicyHelper::find_property(property_policy, "dds.persistence.sqlite3.synchronous");
+    if (synchronous_property != nullptr)
+    {
+        if (!is_one_of(*synchronous_property, {"OFF", "NORMAL", "FULL", "EXTRA"}))
+        {
+            logError(RTPS_PERSISTENCE, "Unknown synchronous level " << *synchronous_property);
+            return nullptr;
+        }
+        synchronous = *synchronous_property;
+    }
+
+    size_t queue_size = 1024;
+    const std::string* queue_property =
+            PropertyPolicyHelper::find_property(property_policy, "dds.persistence.sqlite3.queue_size");
+    if (queue_property != nullptr)
+    {
+        try
+        {
+            queue_size = static_cast<size_t>(std::stoul(*queue_property));
+        }
+        catch (std::exception&)
+        {
+            logWarning(RTPS_PERSISTENCE, "Wrong value '" << *queue_property <<
+                    "' for property dds.persistence.sqlite3.queue_size, using " << queue_size);
+        }
+        queue_size = (queue_size == 0) ? 1 : queue_size;
+    }
+
+    sqlite3* db = open_or_create_database(filename);
+    if (db == NULL)
+    {
+        return nullptr;
+    }
+
+    if ((!journal_mode.empty() && !set_pragma(db, "journal_mode", journal_mode)) ||
+            (!synchronous.empty() && !set_pragma(db, "synchronous", synchronous)))
+    {
+        logError(RTPS_PERSISTENCE, "Could not configure database " << filename);
+        sqlite3_close(db);
+        return nullptr;
+    }
+
+    if (async)
+    {
+        return new SQLite3PersistenceService(db, queue_size);
+    }
+
+    return new SQLite3PersistenceService(db);
+}
+
 SQLite3PersistenceService::SQLite3PersistenceService(
         sqlite3* db)
     : db_(db)
@@ -101,23 +202,34 @@ SQLite3PersistenceService::SQLite3PersistenceService(
     , load_reader_stmt_(NULL)
     , update_reader_stmt_(NULL)
 {
-    // Prepare writer statements
-    sqlite3_prepare_v3(db_, "SELECT seq_num,instance,payload FROM writers WHERE guid=?;", -1, SQLITE_PREPARE_PERSISTENT,
-            &load_writer_stmt_, NULL);
-    sqlite3_prepare_v3(db_, "INSERT INTO writers VALUES(?,?,?,?);", -1, SQLITE_PREPARE_PERSISTENT,
-            &add_writer_change_stmt_, NULL);
-    sqlite3_prepare_v3(db_, "DELETE FROM writers WHERE guid=? AND seq_num=?;", -1, SQLITE_PREPARE_PERSISTENT,
-            &remove_writer_change_stmt_, NULL);
+    prepare_statements();
+}
 
-    // Prepare reader statements
-    sqlite3_prepare_v3(db_, "SELECT writer_guid_prefix,writer_guid_entity,seq_num FROM readers WHERE guid=?;", -1,
-            SQLITE_PREPARE_PERSISTENT, &load_reader_stmt_, NULL);
-    sqlite3_prepare_v3(db_, "INSERT OR REPLACE INTO readers VALUES(?,?,?,?);", -1, SQLITE_PREPARE_PERSISTENT,
-            &update_reader_stmt_, NULL);
+SQLite3PersistenceService::SQLite3PersistenceService(
+        sqlite3* db,
+        size_t queue_size)
+    : SQLite3PersistenceService(db)
+{
+    async_ = true;
+    queue_size_ = queue_size;
+    queue_.reserve(queue_size_);
+    running_ = true;
+    thread_ = std::thread(&SQLite3PersistenceService::run, this);
 }
 
 SQLite3PersistenceService::~SQLite3PersistenceService()
 {
+    if (async_)
+    {
+        // Pending operations are stored before the thread finishes
+        {
+            std::lock_guard<std::mutex> lock(queue_mutex_);
+            running_ = false;
+        }
+        queue_cv_.notify_one();
+        thread_.join();
+    }
+
     // Finalize writer statements
     finalize_statement(load_writer_stmt_);
     finalize_statement(add_writer_change_stmt_);
@@ -131,6 +243,23 @@ SQLite3PersistenceService::~SQLite3PersistenceService()
     db_ = NULL;
 }
 
+void SQLite3PersistenceService::prepare_statements()
+{
+    // Prepare writer statements
+    sqlite3_prepare_v3(db_, "SELECT seq_num,instance,payload FROM writers WHERE guid=?;", -1, SQLITE_PREPARE_PERSISTENT,
+            &load_writer_stmt_, NULL);
+    sqlite3_prepare_v3(db_, "INSERT INTO writers VALUES(?,?,?,?);", -1, SQLITE_PREPARE_PERSISTENT,
+            &add_writer_change_stmt_, NULL);
+    sqlite3_prepare_v3(db_, "DELETE FROM writers WHERE guid=? AND seq_num=?;", -1, SQLITE_PREPARE_PERSISTENT,
+            &remove_writer_change_stmt_, NULL);
+
+    // Prepare reader statements
+    sqlite3_prepare_v3(db_, "SELECT writer_guid_prefix,writer_guid_entity,seq_num FROM readers WHERE guid=?;", -1,
+            SQLITE_PREPARE_PERSISTENT, &load_reader_stmt_, NULL);
+    sqlite3_prepare_v3(db_, "INSERT OR REPLACE INTO readers VALUES(?,?,?,?);", -1, SQLITE_PREPARE_PERSISTENT,
+            &update_reader_stmt_, NULL);
+}
+
 /**
  * Get all data stored for a writer.
  * @param writer_guid GUID of the writer to load.
@@ -146,6 +275,8 @@ bool SQLite3PersistenceService::load_writer_from_storage(
 {
     logInfo(RTPS_PERSISTENCE, "Loading writer " << writer_guid);
 
+    flush();
+
     if (load_writer_stmt_ != NULL)
     {
         sqlite3_reset(load_writer_stmt_);
@@ -209,25 +340,21 @@ bool SQLite3PersistenceService::add_writer_change_to_storage(
 {
     logInfo(RTPS_PERSISTENCE, "Writer " << change.writerGUID << " storing change for seq " << change.sequenceNumber);
 
-    if (add_writer_change_stmt_ != NULL)
+    if (async_)
     {
-        sqlite3_reset(add_writer_change_stmt_);
-        sqlite3_bind_text(add_writer_change_stmt_, 1, persistence_guid.c_str(), -1, SQLITE_STATIC);
-        sqlite3_bind_int64(add_writer_change_stmt_, 2, change.sequenceNumber.to64long());
-        if (change.instanceHandle.isDefined())
-        {
-            sqlite3_bind_blob(add_writer_change_stmt_, 3, change.instanceHandle.value, 16, SQLITE_STATIC);
-        }
-        else
-        {
-            sqlite3_bind_zeroblob(add_writer_change_stmt_, 3, 16);
-        }
-        sqlite3_bind_blob(add_writer_change_stmt_, 4, change.serializedPayload.data, change.serializedPayload.length,
-                SQLITE_STATIC);
-        return sqlite3_step(add_writer_change_stmt_) == SQLITE_DONE;
+        Operation op;
+        op.kind = Operation::ADD_WRITER_CHANGE;
+        op.guid = persistence_guid;
+        op.seq_num = change.sequenceNumber.to64long();
+        op.instance = change.instanceHandle;
+        op.payload.assign(change.serializedPayload.data,
+                change.serializedPayload.data + change.serializedPayload.length);
+        enqueue(std::move(op));
+        return true;
     }
 
-    return false;
+    return store_writer_change(persistence_guid, change.sequenceNumber.to64long(), change.instanceHandle,
+                   change.serializedPayload.data, change.serializedPayload.length);
 }
 
 /**
@@ -241,15 +368,17 @@ bool SQLite3PersistenceService::remove_writer_change_from_storage(
 {
     logInfo(RTPS_PERSISTENCE, "Writer " << change.writerGUID << " removing change for seq " << change.sequenceNumber);
 
-    if (remove_writer_change_stmt_ != NULL)
+    if (async_)
     {
-        sqlite3_reset(remove_writer_change_stmt_);
-        sqlite3_bind_text(remove_writer_change_stmt_, 1, persistence_guid.c_str(), -1, SQLITE_STATIC);
-        sqlite3_bind_int64(remove_writer_change_stmt_, 2, change.sequenceNumber.to64long());
-        return sqlite3_step(remove_writer_change_stmt_) == SQLITE_DONE;
+        Operation op;
+        op.kind = Operation::REMOVE_WRITER_CHANGE;
+        op.guid = persistence_guid;
+        op.seq_num = change.sequenceNumber.to64long();
+        enqueue(std::move(op));
+        return true;
     }
 
-    return false;
+    return delete_writer_change(persistence_guid, change.sequenceNumber.to64long());
 }
 
 /**
@@ -263,6 +392,8 @@ bool SQLite3PersistenceService::load_reader_from_storage(
 {
     logInfo(RTPS_PERSISTENCE, "Loading reader " << reader_guid);
 
+    flush();
+
     if (load_reader_stmt_ != NULL)
     {
         sqlite3_reset(load_reader_stmt_);
@@ -297,19 +428,210 @@ bool SQLite3PersistenceService::update_writer_seq_on_storage(
     logInfo(RTPS_PERSISTENCE,
             "Reader " << reader_guid << " setting seq for writer " << writer_guid << " to " << seq_number);
 
+    if (async_)
+    {
+        Operation op;
+        op.kind = Operation::UPDATE_WRITER_SEQ;
+        op.guid = reader_guid;
+        op.writer_guid = writer_guid;
+        op.seq_num = seq_number.to64long();
+        enqueue(std::move(op));
+        return true;
+    }
+
+    return store_writer_seq(reader_guid, writer_guid, seq_number.to64long());
+}
+
+bool SQLite3PersistenceService::wait_for_all_stored(
+        const std::chrono::steady_clock::time_point& max_blocking_time)
+{
+    if (!async_)
+    {
+        return true;
+    }
+
+    std::unique_lock<std::mutex> lock(queue_mutex_);
+    uint64_t target = enqueued_;
+    if (!stored_cv_.wait_until(lock, max_blocking_time, [&]()
+            {
+                return stored_ >= target;
+            }))
+    {
+        return false;
+    }
+
+    bool ret = !store_failed_;
+    store_failed_ = false;
+    return ret;
+}
+
+bool SQLite3PersistenceService::store_writer_change(
+        const std::string& persistence_guid,
+        int64_t seq_num,
+        const InstanceHandle_t& instance,
+        const octet* payload,
+        uint32_t payload_length)
+{
+    if (add_writer_change_stmt_ != NULL)
+    {
+        sqlite3_reset(add_writer_change_stmt_);
+        sqlite3_bind_text(add_writer_change_stmt_, 1, persistence_guid.c_str(), -1, SQLITE_STATIC);
+        sqlite3_bind_int64(add_writer_change_stmt_, 2, seq_num);
+        if (instance.isDefined())
+        {
+            sqlite3_bind_blob(add_writer_change_stmt_, 3, instance.value, 16, SQLITE_STATIC);
+        }
+        else
+        {
+            sqlite3_bind_zeroblob(add_writer_change_stmt_, 3, 16);
+        }
+        sqlite3_bind_blob(add_writer_change_stmt_, 4, payload, payload_length, SQLITE_STATIC);
+        return sqlite3_step(add_writer_change_stmt_) == SQLITE_DONE;
+    }
+
+    return false;
+}
+
+bool SQLite3PersistenceService::delete_writer_change(
+        const std::string& persistence_guid,
+        int64_t seq_num)
+{
+    if (remove_writer_change_stmt_ != NULL)
+    {
+        sqlite3_reset(remove_writer_change_stmt_);
+        sqlite3_bind_text(remove_writer_change_stmt_, 1, persistence_guid.c_str(), -1, SQLITE_STATIC);
+        sqlite3_bind_int64(remove_writer_change_stmt_, 2, seq_num);
+        return sqlite3_step(remove_writer_change_stmt_) == SQLITE_DONE;
+    }
+
+    return false;
+}
+
+bool SQLite3PersistenceService::store_writer_seq(
+        const std::string& reader_guid,
+        const GUID_t& writer_guid,
+        int64_t seq_num)
+{
     if (update_reader_stmt_ != NULL)
     {
         sqlite3_reset(update_reader_stmt_);
         sqlite3_bind_text(update_reader_stmt_, 1, reader_guid.c_str(), -1, SQLITE_STATIC);
         sqlite3_bind_blob(update_reader_stmt_, 2, writer_guid.guidPrefix.value, GuidPrefix_t::size, SQLITE_STATIC);
         sqlite3_bind_blob(update_reader_stmt_, 3, writer_guid.entityId.value, EntityId_t::size, SQLITE_STATIC);
-        sqlite3_bind_int64(update_reader_stmt_, 4, seq_number.to64long());
+        sqlite3_bind_int64(update_reader_stmt_, 4, seq_num);
         return sqlite3_step(update_reader_stmt_) == SQLITE_DONE;
     }
 
     return false;
 }
 
+bool SQLite3PersistenceService::execute(
+        const Operation& op)
+{
+    switch (op.kind)
+    {
+        case Operation::ADD_WRITER_CHANGE:
+            return store_writer_change(op.guid, op.seq_num, op.instance, op.payload.data(),
+                           static_cast<uint32_t>(op.payload.size()));
+
+        case Operation::REMOVE_WRITER_CHANGE:
+            return delete_writer_change(op.guid, op.seq_num);
+
+        case Operation::UPDATE_WRITER_SEQ:
+            return store_writer_seq(op.guid, op.writer_guid, op.seq_num);
+    }
+
+    return false;
+}
+
+void SQLite3PersistenceService::enqueue(
+        Operation&& op)
+{
+    std::unique_lock<std::mutex> lock(queue_mutex_);
+    stored_cv_.wait(lock, [&]()
+            {
+                return queue_.size() < queue_size_;
+            });
+
+    bool was_empty = queue_.empty();
+    queue_.push_back(std::move(op));
+    ++enqueued_;
+    lock.unlock();
+
+    if (was_empty)
+    {
+        queue_cv_.notify_one();
+    }
+}
+
+void SQLite3PersistenceService::flush()
+{
+    if (async_)
+    {
+        std::unique_lock<std::mutex> lock(queue_mutex_);
+        uint64_t target = enqueued_;
+        stored_cv_.wait(lock, [&]()
+                {
+                    return stored_ >= target;
+                });
+    }
+}
+
+void SQLite3PersistenceService::run()
+{
+    std::vector<Operation> batch;
+    batch.reserve(queue_size_);
+
+    std::unique_lock<std::mutex> lock(queue_mutex_);
+    for (;;)
+    {
+        queue_cv_.wait(lock, [&]()
+                {
+                    return !running_ || !queue_.empty();
+                });
+
+        if (queue_.empty())
+        {
+            break;
+        }
+
+        // Take the whole queue, so producers can keep adding operations while the batch is stored
+        batch.swap(queue_);
+        lock.unlock();
+        stored_cv_.notify_all();
+
+        bool ok = sqlite3_exec(db_, "BEGIN;", 0, 0, 0) == SQLITE_OK;
+        bool all_executed = true;
+        for (const Operation& op : batch)
+        {
+            // A failed operation does not affect the rest of the transaction, but it is reported to
+            // wait_for_all_stored
+            if (!execute(op))
+            {
+                logWarning(RTPS_PERSISTENCE, "Could not store operation on " << op.guid << " for seq " << op.seq_num);
+                all_executed = false;
+            }
+        }
+        if (ok && sqlite3_exec(db_, "COMMIT;", 0, 0, 0) != SQLITE_OK)
+        {
+            sqlite3_exec(db_, "ROLLBACK;", 0, 0, 0);
+            ok = false;
+        }
+        if (!ok)
+        {
+            logError(RTPS_PERSISTENCE, "Could not commit " << batch.size() << " operations to storage");
+        }
+
+        lock.lock();
+        stored_ += batch.size();
+        store_failed_ = store_failed_ || !ok || !all_executed;
+        batch.clear();
+        lock.unlock();
+        stored_cv_.notify_all();
+        lock.lock();
+    }
+}
+
 } /* namespace rtps */
 } /* namespace fastrtps */
 } /* namespace eprosima */
@@ -22,6 +22,12 @@
 #include <rtps/persistence/PersistenceService.h>
 #include <rtps/persistence/sqlite3.h>
 
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
 namespace eprosima {
 namespace fastrtps {
 namespace rtps {
@@ -33,6 +39,27 @@ namespace rtps {
 IPersistenceService* create_SQLite3_persistence_service(
         const char* filename);
 
+/**
+ * Create a new SQLite3 implementation of persistence service, configured from a property policy.
+ *
+ * The following properties are taken into account:
+ * - @c dds.persistence.sqlite3.async: when @c true, storage operations are queued and executed on a dedicated
+ *   thread, grouping them into transactions. Defaults to @c false.
+ * - @c dds.persistence.sqlite3.journal_mode: SQLite journal mode (DELETE, TRUNCATE, PERSIST, MEMORY, WAL or OFF).
+ *   Defaults to WAL on asynchronous mode, and to the SQLite default otherwise.
+ * - @c dds.persistence.sqlite3.synchronous: SQLite synchronous level (OFF, NORMAL, FULL or EXTRA).
+ *   Defaults to the SQLite default.
+ * - @c dds.persistence.sqlite3.queue_size: maximum number of operations waiting to be stored on asynchronous mode.
+ *   Defaults to 1024.
+ *
+ * @param filename Name of the database file.
+ * @param property_policy PropertyPolicy where the configuration will be searched.
+ * @ingroup RTPS_PERSISTENCE_MODULE
+ */
+IPersistenceService* create_SQLite3_persistence_service(
+        const char* filename,
+        const PropertyPolicy& property_policy);
+
 
 /**
  * Persistence service implementation over SQLite3
@@ -44,6 +71,16 @@ public:
 
     SQLite3PersistenceService(
             sqlite3* db);
+
+    /**
+     * Constructor for asynchronous mode.
+     * @param db Database connection. Ownership is taken by the service.
+     * @param queue_size Maximum number of operations waiting to be stored. Callers block when it is reached.
+     */
+    SQLite3PersistenceService(
+            sqlite3* db,
+            size_t queue_size);
+
     virtual ~SQLite3PersistenceService() override;
 
     /**
@@ -98,8 +135,64 @@ public:
             const GUID_t& writer_guid,
             const SequenceNumber_t& seq_number) final;
 
+    /**
+     * Wait until all the operations requested so far have been stored.
+     * @param max_blocking_time Maximum time to wait.
+     * @return True if all operations were stored, and no transaction failed since the previous call.
+     */
+    virtual bool wait_for_all_stored(
+            const std::chrono::steady_clock::time_point& max_blocking_time) final;
+
 private:
 
+    //! Storage operation waiting to be executed on asynchronous mode.
+    struct Operation
+    {
+        enum Kind
+        {
+            ADD_WRITER_CHANGE,
+            REMOVE_WRITER_CHANGE,
+            UPDATE_WRITER_SEQ
+        };
+
+        Kind kind;
+        std::string guid;
+        GUID_t writer_guid;
+        int64_t seq_num;
+        InstanceHandle_t instance;
+        std::vector<octet> payload;
+    };
+
+    void prepare_statements();
+
+    bool store_writer_change(
+            const std::string& persistence_guid,
+            int64_t seq_num,
+            const InstanceHandle_t& instance,
+            const octet* payload,
+            uint32_t payload_length);
+
+    bool delete_writer_change(
+            const std::string& persistence_guid,
+            int64_t seq_num);
+
+    bool store_writer_seq(
+            const std::string& reader_guid,
+            const GUID_t& writer_guid,
+            int64_t seq_num);
+
+    bool execute(
+            const Operation& op);
+
+    void enqueue(
+            Operation&& op);
+
+    //! Wait until all the operations requested so far have been stored, without timeout.
+    void flush();
+
+    //! Body of the thread storing the queued operations, each batch on a single transaction.
+    void run();
+
     sqlite3* db_;
 
     sqlite3_stmt* load_writer_stmt_;
@@ -108,6 +201,35 @@ private:
 
     sqlite3_stmt* load_reader_stmt_;
     sqlite3_stmt* update_reader_stmt_;
+
+    //! Whether operations are stored on a dedicated thread.
+    bool async_ = false;
+
+    //! Maximum number of operations on the queue.
+    size_t queue_size_ = 0;
+
+    std::mutex queue_mutex_;
+
+    //! Notified when operations are queued or the service is stopping.
+    std::condition_variable queue_cv_;
+
+    //! Notified when a batch is taken from the queue or has been stored.
+    std::condition_variable stored_cv_;
+
+    std::vector<Operation> queue_;
+
+    //! Number of operations queued since creation.
+    uint64_t enqueued_ = 0;
+
+    //! Number of operations executed since creation.
+    uint64_t stored_ = 0;
+
+    //! Whether an operation or a transaction failed since the last call to wait_for_all_stored.
+    bool store_failed_ = false;
+
+    bool running_ = false;
+
+    std::thread thread_;
 };
 
 } /* namespace rtps */
@@ -0,0 +1,469 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file FragmentAssembler.cpp
+ */
+
+#include <rtps/reader/FragmentAssembler.hpp>
+
+#include <fastdds/dds/log/Log.hpp>
+#include <fastdds/rtps/attributes/HistoryAttributes.h>
+#include <fastdds/rtps/attributes/PropertyPolicy.h>
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <tuple>
+
+namespace eprosima {
+namespace fastrtps {
+namespace rtps {
+
+static bool read_property(
+        const PropertyPolicy& properties,
+        const std::string& name,
+        uint64_t& value)
+{
+    const std::string* property = PropertyPolicyHelper::find_property(properties, name);
+    if (property != nullptr)
+    {
+        try
+        {
+            value = std::stoull(*property);
+            return true;
+        }
+        catch (std::exception&)
+        {
+            logError(RTPS_READER, "Wrong value '" << *property << "' for property " << name);
+        }
+    }
+
+    return false;
+}
+
+constexpr uint64_t FragmentAssemblerConfig::default_max_memory;
+
+void FragmentAssemblerConfig::set_history_limits(
+        const HistoryAttributes& attributes)
+{
+    // Changes of the history cannot hold bigger samples
+    if (PREALLOCATED_MEMORY_MODE == attributes.memoryPolicy)
+    {
+        max_sample_size = attributes.payloadMaxSize;
+    }
+
+    uint64_t chunks_per_sample = (uint64_t(attributes.payloadMaxSize) + chunk_size - 1) / chunk_size;
+    max_memory = (std::max)(max_memory, chunks_per_sample * chunk_size * max_samples_per_writer);
+}
+
+void FragmentAssemblerConfig::load(
+        const PropertyPolicy& properties)
+{
+    uint64_t value = 0;
+    if (read_property(properties, "fastdds.reassembly.chunk_size", value))
+    {
+        chunk_size = static_cast<uint32_t>((std::min)((std::max)(value, uint64_t(1024)), uint64_t(1) << 30));
+    }
+
+    if (read_property(properties, "fastdds.reassembly.max_memory", value))
+    {
+        max_memory = value;
+    }
+
+    if (read_property(properties, "fastdds.reassembly.max_samples_per_writer", value))
+    {
+        max_samples_per_writer = static_cast<uint32_t>((std::min)((std::max)(value, uint64_t(1)), uint64_t(1024)));
+    }
+}
+
+FragmentAssembler::FragmentAssembler(
+        const FragmentAssemblerConfig& config)
+    : config_(config)
+{
+    if (0 == config_.max_samples_per_writer)
+    {
+        config_.max_samples_per_writer = 1;
+    }
+}
+
+FragmentAssembler::~FragmentAssembler()
+{
+    while (!samples_.empty())
+    {
+        erase(samples_.begin());
+    }
+
+    for (octet* chunk : free_chunks_)
+    {
+        delete[] chunk;
+    }
+}
+
+bool FragmentAssembler::add_fragments(
+        const CacheChange_t& incoming,
+        uint32_t sample_size,
+        uint32_t fragment_starting_num,
+        uint32_t fragments_in_submessage)
+{
+    uint32_t fragment_size = incoming.getFragmentSize();
+    if (0 == sample_size || 0 == fragment_size || 0 == fragment_starting_num || 0 == fragments_in_submessage)
+    {
+        return false;
+    }
+
+    if (0 != config_.max_sample_size && sample_size > config_.max_sample_size)
+    {
+        logWarning(RTPS_READER, "Discarding sample " << incoming.sequenceNumber << " of writer " <<
+                incoming.writerGUID << ": " << sample_size << " bytes exceed the maximum of " <<
+                config_.max_sample_size);
+        return false;
+    }
+
+    auto sample = find_or_create(incoming, sample_size);
+    if (sample == samples_.end())
+    {
+        return false;
+    }
+
+    Sample& s = sample->second;
+    if (s.sample_size != sample_size || s.fragment_size != fragment_size)
+    {
+        logWarning(RTPS_READER, "Inconsistent fragmentation received for sample " << incoming.sequenceNumber <<
+                " of writer " << incoming.writerGUID);
+        return false;
+    }
+
+    // Validate fragment indexes and lengths
+    uint32_t first = fragment_starting_num - 1;
+    if (first >= s.fragment_count || fragments_in_submessage > s.fragment_count - first)
+    {
+        return false;
+    }
+
+    uint32_t last = first + fragments_in_submessage;
+    uint32_t offset = first * fragment_size;
+    uint32_t length = (last == s.fragment_count) ? sample_size - offset : fragments_in_submessage * fragment_size;
+    if (incoming.serializedPayload.length < length)
+    {
+        return false;
+    }
+
+    s.last_update = ++update_counter_;
+
+    for (uint32_t fragment = first; fragment < last; ++fragment)
+    {
+        if (is_received(s, fragment))
+        {
+            continue;
+        }
+
+        uint32_t fragment_offset = fragment * fragment_size;
+        uint32_t fragment_length = (std::min)(fragment_size, sample_size - fragment_offset);
+        if (!store(sample, fragment_offset, &incoming.serializedPayload.data[fragment_offset - offset],
+                fragment_length))
+        {
+            logWarning(RTPS_READER, "Not enough memory to reassemble sample " << incoming.sequenceNumber <<
+                    " of writer " << incoming.writerGUID << " (" << sample_size << " bytes)");
+            erase(sample);
+            return false;
+        }
+
+        s.received[fragment / 64] |= uint64_t(1) << (fragment % 64);
+        ++s.received_count;
+    }
+
+    return s.received_count == s.fragment_count;
+}
+
+bool FragmentAssembler::take(
+        const GUID_t& writer_guid,
+        const SequenceNumber_t& sequence_number,
+        CacheChange_t& change)
+{
+    auto sample = samples_.find(Key(writer_guid, sequence_number));
+    if (sample == samples_.end())
+    {
+        return false;
+    }
+
+    Sample& s = sample->second;
+    if (s.received_count != s.fragment_count || change.serializedPayload.max_size < s.sample_size)
+    {
+        return false;
+    }
+
+    uint32_t offset = 0;
+    for (octet* chunk : s.chunks)
+    {
+        uint32_t length = (std::min)(config_.chunk_size, s.sample_size - offset);
+        memcpy(&change.serializedPayload.data[offset], chunk, length);
+        offset += length;
+    }
+
+    // Payload length should be set before copying the fragment size, so the change is seen as complete
+    change.serializedPayload.length = s.sample_size;
+    change.copy_not_memcpy(&s.info);
+
+    erase(sample);
+    return true;
+}
+
+bool FragmentAssembler::get_missing_fragments(
+        const GUID_t& writer_guid,
+        const SequenceNumber_t& sequence_number,
+        FragmentNumberSet_t& missing) const
+{
+    auto sample = samples_.find(Key(writer_guid, sequence_number));
+    if (sample == samples_.end())
+    {
+        return false;
+    }
+
+    // Fragment numbers are 1-based but we keep them 0 based.
+    const Sample& s = sample->second;
+    uint32_t fragment = 0;
+    while (fragment < s.fragment_count && is_received(s, fragment))
+    {
+        ++fragment;
+    }
+
+    missing.base(fragment + 1);
+    for (; fragment < s.fragment_count; ++fragment)
+    {
+        if (!is_received(s, fragment) && !missing.add(fragment + 1))
+        {
+            break;
+        }
+    }
+
+    return true;
+}
+
+void FragmentAssembler::remove(
+        const GUID_t& writer_guid,
+        const SequenceNumber_t& sequence_number)
+{
+    auto sample = samples_.find(Key(writer_guid, sequence_number));
+    if (sample != samples_.end())
+    {
+        erase(sample);
+    }
+}
+
+void FragmentAssembler::remove_until(
+        const GUID_t& writer_guid,
+        const SequenceNumber_t& sequence_number)
+{
+    auto sample = samples_.lower_bound(Key(writer_guid, SequenceNumber_t()));
+    while (sample != samples_.end() && sample->first.first == writer_guid && sample->first.second < sequence_number)
+    {
+        sample = erase(sample);
+    }
+}
+
+void FragmentAssembler::remove_writer(
+        const GUID_t& writer_guid)
+{
+    auto sample = samples_.lower_bound(Key(writer_guid, SequenceNumber_t()));
+    while (sample != samples_.end() && sample->first.first == writer_guid)
+    {
+        sample = erase(sample);
+    }
+}
+
+FragmentAssembler::SampleMap::iterator FragmentAssembler::find_or_create(
+        const CacheChange_t& incoming,
+        uint32_t sample_size)
+{
+    Key key(incoming.writerGUID, incoming.sequenceNumber);
+    auto sample = samples_.find(key);
+    if (sample != samples_.end())
+    {
+        return sample;
+    }
+
+    // Samples of the same writer are consecutive, ordered by sequence number
+    auto oldest = samples_.lower_bound(Key(incoming.writerGUID, SequenceNumber_t()));
+    uint32_t writer_samples = 0;
+    for (auto it = oldest; it != samples_.end() && it->first.first == incoming.writerGUID; ++it)
+    {
+        ++writer_samples;
+    }
+
+    if (writer_samples >= config_.max_samples_per_writer)
+    {
+        // The oldest sample is discarded, unless the new one is older than all of them
+        if (key.second < oldest->first.second)
+        {
+            return samples_.end();
+        }
+
+        logInfo(RTPS_READER, "Discarding fragmented sample " << oldest->first.second << " of writer " <<
+                incoming.writerGUID);
+        erase(oldest);
+    }
+
+    // Sizes come from the wire, so the index is checked against the budget before being allocated
+    uint32_t fragment_size = incoming.getFragmentSize();
+    uint64_t fragment_count = (uint64_t(sample_size) + fragment_size - 1) / fragment_size;
+    uint64_t bitmap_words = (fragment_count + 63) / 64;
+    uint64_t chunk_count = (uint64_t(sample_size) + config_.chunk_size - 1) / config_.chunk_size;
+    uint64_t index_bytes = bitmap_words * sizeof(uint64_t) + chunk_count * sizeof(octet*);
+    if (0 != config_.max_memory && chunk_count * config_.chunk_size + index_bytes > config_.max_memory)
+    {
+        logWarning(RTPS_READER, "Discarding sample " << incoming.sequenceNumber << " of writer " <<
+                incoming.writerGUID << ": reassembling " << sample_size << " bytes in fragments of " <<
+                fragment_size << " would exceed the memory budget");
+        return samples_.end();
+    }
+
+    if (!reserve_index(index_bytes))
+    {
+        return samples_.end();
+    }
+
+    sample = samples_.emplace(std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple()).first;
+    Sample& s = sample->second;
+    s.info.copy_not_memcpy(&incoming);
+    s.sample_size = sample_size;
+    s.fragment_size = fragment_size;
+    s.fragment_count = static_cast<uint32_t>(fragment_count);
+    s.received.assign(static_cast<size_t>(bitmap_words), 0);
+    s.chunks.assign(static_cast<size_t>(chunk_count), nullptr);
+    index_memory_ += index_bytes;
+    return sample;
+}
+
+bool FragmentAssembler::store(
+        SampleMap::iterator sample,
+        uint32_t offset,
+        const octet* data,
+        uint32_t length)
+{
+    Sample& s = sample->second;
+    while (0 < length)
+    {
+        uint32_t chunk_offset = offset % config_.chunk_size;
+        uint32_t to_copy = (std::min)(length, config_.chunk_size - chunk_offset);
+
+        octet*& chunk = s.chunks[offset / config_.chunk_size];
+        if (nullptr == chunk)
+        {
+            chunk = get_chunk(sample);
+            if (nullptr == chunk)
+            {
+                return false;
+            }
+        }
+
+        memcpy(&chunk[chunk_offset], data, to_copy);
+        offset += to_copy;
+        data += to_copy;
+        length -= to_copy;
+    }
+
+    return true;
+}
+
+octet* FragmentAssembler::get_chunk(
+        SampleMap::iterator requester)
+{
+    while (free_chunks_.empty())
+    {
+        if (fits(config_.chunk_size))
+        {
+            ++num_chunks_;
+            return new octet[config_.chunk_size];
+        }
+
+        // Memory budget exhausted: the sample least recently updated is discarded
+        auto victim = least_recently_updated(requester);
+        if (victim == samples_.end())
+        {
+            return nullptr;
+        }
+
+        logInfo(RTPS_READER, "Discarding fragmented sample " << victim->first.second << " of writer " <<
+                victim->first.first << " to keep the reassembly memory budget");
+        erase(victim);
+    }
+
+    octet* chunk = free_chunks_.back();
+    free_chunks_.pop_back();
+    return chunk;
+}
+
+bool FragmentAssembler::reserve_index(
+        uint64_t bytes)
+{
+    while (!fits(bytes))
+    {
+        // Chunks not being used are given back first
+        if (!free_chunks_.empty())
+        {
+            delete[] free_chunks_.back();
+            free_chunks_.pop_back();
+            --num_chunks_;
+            continue;
+        }
+
+        auto victim = least_recently_updated(samples_.end());
+        if (victim == samples_.end())
+        {
+            return false;
+        }
+
+        logInfo(RTPS_READER, "Discarding fragmented sample " << victim->first.second << " of writer " <<
+                victim->first.first << " to keep the reassembly memory budget");
+        erase(victim);
+    }
+
+    return true;
+}
+
+FragmentAssembler::SampleMap::iterator FragmentAssembler::least_recently_updated(
+        SampleMap::iterator except)
+{
+    auto victim = samples_.end();
+    for (auto it = samples_.begin(); it != samples_.end(); ++it)
+    {
+        if (it != except && (victim == samples_.end() || it->second.last_update < victim->second.last_update))
+        {
+            victim = it;
+        }
+    }
+
+    return victim;
+}
+
+FragmentAssembler::SampleMap::iterator FragmentAssembler::erase(
+        SampleMap::iterator sample)
+{
+    index_memory_ -= index_size(sample->second);
+
+    for (octet* chunk : sample->second.chunks)
+    {
+        if (nullptr != chunk)
+        {
+            free_chunks_.push_back(chunk);
+        }
+    }
+
+    return samples_.erase(sample);
+}
+
+} // namespace rtps
+} // namespace fastrtps
+} // namespace eprosima
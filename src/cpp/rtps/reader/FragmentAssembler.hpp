@@ -0,0 +1,287 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file FragmentAssembler.hpp
+ */
+
+#ifndef _RTPS_READER_FRAGMENTASSEMBLER_HPP_
+#define _RTPS_READER_FRAGMENTASSEMBLER_HPP_
+
+#include <fastdds/rtps/common/CacheChange.h>
+#include <fastdds/rtps/common/FragmentNumber.h>
+#include <fastdds/rtps/common/Guid.h>
+#include <fastdds/rtps/common/SequenceNumber.h>
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace eprosima {
+namespace fastrtps {
+namespace rtps {
+
+class HistoryAttributes;
+class PropertyPolicy;
+
+/**
+ * Configuration of a FragmentAssembler.
+ */
+struct FragmentAssemblerConfig
+{
+    //! Default value of max_memory.
+    static constexpr uint64_t default_max_memory = 64ull * 1024ull * 1024ull;
+
+    //! Size of the chunks where fragments are stored.
+    uint32_t chunk_size = 64 * 1024;
+
+    //! Maximum memory used by the chunks and the indexes of the samples. Zero means no limit.
+    uint64_t max_memory = default_max_memory;
+
+    //! Maximum number of samples of the same writer being reassembled at the same time.
+    uint32_t max_samples_per_writer = 4;
+
+    //! Samples bigger than this are discarded on their first fragment. Zero means no limit.
+    uint32_t max_sample_size = 0;
+
+    /**
+     * Adapt the configuration to the history where the samples will be stored.
+     *
+     * When the history only has payloads of a fixed size, bigger samples are discarded before reserving anything
+     * for them. The memory budget is raised, when needed, so the samples of a writer can be reassembled at the
+     * same time. It should be called before @ref load, so the properties take precedence.
+     *
+     * @param attributes  Attributes of the history.
+     */
+    void set_history_limits(
+            const HistoryAttributes& attributes);
+
+    /**
+     * Read the configuration from a property policy.
+     *
+     * The following properties are taken into account:
+     * - @c fastdds.reassembly.chunk_size: size in bytes of the chunks where fragments are stored.
+     * - @c fastdds.reassembly.max_memory: maximum bytes used by the chunks and the indexes of the samples.
+     *   Zero means no limit.
+     * - @c fastdds.reassembly.max_samples_per_writer: maximum number of samples of the same writer being
+     *   reassembled at the same time.
+     *
+     * @param properties  Property policy where the configuration will be searched.
+     */
+    void load(
+            const PropertyPolicy& properties);
+};
+
+/**
+ * Reassembles samples received on DATA_FRAG submessages.
+ *
+ * Fragments are stored on chunks, which are only reserved when a fragment on them is received, and kept on a pool
+ * to be reused by following samples. A bitmap keeps track of the fragments received, so they can arrive in any
+ * order, and several samples of the same writer can be reassembled at the same time. The memory budget covers the
+ * chunks and the bitmaps and chunk tables of the samples, which are sized from the sample and fragment sizes on the
+ * wire. When a new sample or the storage of a fragment would exceed it, the sample least recently updated is
+ * discarded. Samples that could never fit on the budget are discarded on their first fragment.
+ *
+ * The payload is only assembled once all fragments have been received, on a change reserved by the reader.
+ * It is not thread safe.
+ */
+class FragmentAssembler
+{
+public:
+
+    explicit FragmentAssembler(
+            const FragmentAssemblerConfig& config);
+
+    ~FragmentAssembler();
+
+    FragmentAssembler(
+            const FragmentAssembler&) = delete;
+
+    FragmentAssembler& operator =(
+            const FragmentAssembler&) = delete;
+
+    /**
+     * Add the fragments received on a DATA_FRAG submessage.
+     * @param incoming                 Change with the information of the submessage. Its payload holds the fragments.
+     * @param sample_size              Size of the complete sample.
+     * @param fragment_starting_num    Number (1-based) of the first fragment on the submessage.
+     * @param fragments_in_submessage  Number of fragments on the submessage.
+     * @return true when all the fragments of the sample have been received.
+     */
+    bool add_fragments(
+            const CacheChange_t& incoming,
+            uint32_t sample_size,
+            uint32_t fragment_starting_num,
+            uint32_t fragments_in_submessage);
+
+    /**
+     * Move a complete sample to a change, and forget about it.
+     * @param writer_guid      GUID of the writer of the sample.
+     * @param sequence_number  Sequence number of the sample.
+     * @param change           Change where the sample is assembled. Its payload should be big enough.
+     * @return false if there is not a complete sample with that identity, or the payload is too small.
+     */
+    bool take(
+            const GUID_t& writer_guid,
+            const SequenceNumber_t& sequence_number,
+            CacheChange_t& change);
+
+    /**
+     * Get the fragments not received yet of a sample.
+     * @param writer_guid      GUID of the writer of the sample.
+     * @param sequence_number  Sequence number of the sample.
+     * @param [out] missing    Set where the missing fragments are returned.
+     * @return false if the sample is not being reassembled.
+     */
+    bool get_missing_fragments(
+            const GUID_t& writer_guid,
+            const SequenceNumber_t& sequence_number,
+            FragmentNumberSet_t& missing) const;
+
+    /**
+     * Discard a sample.
+     * @param writer_guid      GUID of the writer of the sample.
+     * @param sequence_number  Sequence number of the sample.
+     */
+    void remove(
+            const GUID_t& writer_guid,
+            const SequenceNumber_t& sequence_number);
+
+    /**
+     * Discard the samples of a writer with a sequence number lower than a given one.
+     * @param writer_guid      GUID of the writer.
+     * @param sequence_number  First sequence number to keep.
+     */
+    void remove_until(
+            const GUID_t& writer_guid,
+            const SequenceNumber_t& sequence_number);
+
+    /**
+     * Discard all the samples of a writer.
+     * @param writer_guid  GUID of the writer.
+     */
+    void remove_writer(
+            const GUID_t& writer_guid);
+
+    //! @return the number of samples being reassembled.
+    size_t samples() const
+    {
+        return samples_.size();
+    }
+
+    //! @return the memory used by the chunks, including those not being used.
+    uint64_t memory() const
+    {
+        return static_cast<uint64_t>(num_chunks_) * config_.chunk_size;
+    }
+
+    //! @return the memory used by the bitmaps and chunk tables of the samples being reassembled.
+    uint64_t index_memory() const
+    {
+        return index_memory_;
+    }
+
+private:
+
+    using Key = std::pair<GUID_t, SequenceNumber_t>;
+
+    struct Sample
+    {
+        //! Information of the change, without its payload.
+        CacheChange_t info;
+        uint32_t sample_size = 0;
+        uint32_t fragment_size = 0;
+        uint32_t fragment_count = 0;
+        uint32_t received_count = 0;
+        //! One bit for each fragment, set when received.
+        std::vector<uint64_t> received;
+        //! Chunks holding the payload. Null until a fragment on them is received.
+        std::vector<octet*> chunks;
+        //! Value of the update counter when a fragment was last received.
+        uint64_t last_update = 0;
+    };
+
+    using SampleMap = std::map<Key, Sample>;
+
+    SampleMap::iterator find_or_create(
+            const CacheChange_t& incoming,
+            uint32_t sample_size);
+
+    bool is_received(
+            const Sample& sample,
+            uint32_t fragment) const
+    {
+        return 0 != (sample.received[fragment / 64] & (uint64_t(1) << (fragment % 64)));
+    }
+
+    //! Copies a range of bytes to the chunks of a sample, reserving those needed.
+    bool store(
+            SampleMap::iterator sample,
+            uint32_t offset,
+            const octet* data,
+            uint32_t length);
+
+    //! Gets a chunk from the pool, discarding other samples if the memory budget is exhausted.
+    octet* get_chunk(
+            SampleMap::iterator requester);
+
+    //! Makes room on the memory budget for the index of a new sample, discarding other samples if needed.
+    bool reserve_index(
+            uint64_t bytes);
+
+    //! @return whether some bytes more can be used without exceeding the memory budget.
+    bool fits(
+            uint64_t bytes) const
+    {
+        return 0 == config_.max_memory || memory() + index_memory_ + bytes <= config_.max_memory;
+    }
+
+    //! @return the sample least recently updated, apart from the one given.
+    SampleMap::iterator least_recently_updated(
+            SampleMap::iterator except);
+
+    //! @return the bytes used by the index of a sample.
+    static uint64_t index_size(
+            const Sample& sample)
+    {
+        return sample.received.size() * sizeof(uint64_t) + sample.chunks.size() * sizeof(octet*);
+    }
+
+    SampleMap::iterator erase(
+            SampleMap::iterator sample);
+
+    FragmentAssemblerConfig config_;
+
+    SampleMap samples_;
+
+    //! Chunks not being used.
+    std::vector<octet*> free_chunks_;
+
+    //! Number of chunks allocated.
+    uint64_t num_chunks_ = 0;
+
+    //! Bytes used by the indexes of the samples being reassembled.
+    uint64_t index_memory_ = 0;
+
+    //! Incremented each time fragments are received.
+    uint64_t update_counter_ = 0;
+};
+
+} // namespace rtps
+} // namespace fastrtps
+} // namespace eprosima
+
+#endif // _RTPS_READER_FRAGMENTASSEMBLER_HPP_
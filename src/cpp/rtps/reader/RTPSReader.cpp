@@ -21,6 +21,7 @@
 #include <fastdds/rtps/history/ReaderHistory.h>
 #include <fastdds/dds/log/Log.hpp>
 #include <rtps/reader/ReaderHistoryState.hpp>
+#include <rtps/reader/FragmentAssembler.hpp>
 
 #include <fastdds/rtps/reader/ReaderListener.h>
 #include <fastdds/rtps/resources/ResourceEvent.h>
@@ -49,9 +50,15 @@ RTPSReader::RTPSReader(
     , m_acceptMessagesFromUnkownWriters(false)
     , m_expectsInlineQos(att.expectsInlineQos)
     , history_state_(new ReaderHistoryState(att.matched_writers_allocation.initial))
+    , fragment_assembler_(nullptr)
     , liveliness_kind_(att.liveliness_kind_)
     , liveliness_lease_duration_(att.liveliness_lease_duration)
 {
+    FragmentAssemblerConfig reassembly_config;
+    reassembly_config.set_history_limits(hist->m_att);
+    reassembly_config.load(att.endpoint.properties);
+    fragment_assembler_ = new FragmentAssembler(reassembly_config);
+
     mp_history->mp_reader = this;
     mp_history->mp_mutex = &mp_mutex;
 
@@ -61,6 +68,7 @@ RTPSReader::RTPSReader(
 RTPSReader::~RTPSReader()
 {
     logInfo(RTPS_READER, "Removing reader " << this->getGuid().entityId; );
+    delete fragment_assembler_;
     delete history_state_;
     mp_history->mp_reader = nullptr;
     mp_history->mp_mutex = nullptr;
@@ -91,22 +99,6 @@ bool RTPSReader::setListener(
     return true;
 }
 
-History::const_iterator RTPSReader::findCacheInFragmentedProcess(
-        const SequenceNumber_t& sequence_number,
-        const GUID_t& writer_guid,
-        CacheChange_t** change,
-        History::const_iterator hint) const
-{
-    History::const_iterator ret_val = mp_history->get_change_nts(sequence_number, writer_guid, change, hint);
-
-    if (nullptr != *change && (*change)->is_fully_assembled())
-    {
-        *change = nullptr;
-    }
-
-    return ret_val;
-}
-
 void RTPSReader::add_persistence_guid(
         const GUID_t& guid,
         const GUID_t& persistence_guid)
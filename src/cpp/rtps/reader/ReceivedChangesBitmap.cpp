@@ -0,0 +1,314 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file ReceivedChangesBitmap.cpp
+ */
+
+#include <rtps/reader/ReceivedChangesBitmap.hpp>
+
+#include "utils/collections/node_size_helpers.hpp"
+
+#include <algorithm>
+#include <bitset>
+#include <cassert>
+
+#if _MSC_VER
+#include <intrin.h>
+#endif // if _MSC_VER
+
+namespace eprosima {
+namespace fastrtps {
+namespace rtps {
+
+using set_helper = utilities::collections::set_size_helper<SequenceNumber_t>;
+
+//! Number of trailing zero bits of a word which is not zero.
+static inline uint32_t trailing_zeros(
+        uint64_t bits)
+{
+    assert(0 != bits);
+#if _MSC_VER
+    unsigned long bit;
+    uint32_t low = static_cast<uint32_t>(bits);
+    if (_BitScanForward(&bit, low))
+    {
+        return bit;
+    }
+    _BitScanForward(&bit, static_cast<uint32_t>(bits >> 32));
+    return bit + 32;
+#else
+    return static_cast<uint32_t>(__builtin_ctzll(bits));
+#endif // if _MSC_VER
+}
+
+static inline uint32_t ones(
+        uint64_t bits)
+{
+    return static_cast<uint32_t>(std::bitset<64>(bits).count());
+}
+
+//! Mask with the bits [from, to) of a word set.
+static inline uint64_t bit_mask(
+        uint64_t from,
+        uint64_t to)
+{
+    uint64_t mask = ~0ull << from;
+    if (to < 64)
+    {
+        mask &= ~(~0ull << to);
+    }
+    return mask;
+}
+
+static inline SequenceNumber_t from_64(
+        uint64_t value)
+{
+    return { static_cast<int32_t>(value >> 32), static_cast<uint32_t>(value) };
+}
+
+static size_t words_for(
+        size_t bits)
+{
+    size_t words = 1;
+    while ((words << 6) < bits)
+    {
+        words <<= 1;
+    }
+    return words;
+}
+
+ReceivedChangesBitmap::ReceivedChangesBitmap(
+        const ResourceLimitedContainerConfig& changes_allocation)
+    : words_(words_for((std::max)(static_cast<size_t>(256), (std::min)(changes_allocation.initial,
+            static_cast<size_t>(max_window_size)))), 0)
+    , head_(0)
+    , origin_(0)
+    , max_words_(words_for(max_window_size))
+    , overflow_pool_(
+        set_helper::node_size,
+        set_helper::min_pool_size<pool_allocator_t>(changes_allocation.initial))
+    , overflow_(overflow_pool_)
+{
+}
+
+void ReceivedChangesBitmap::clear(
+        const SequenceNumber_t& low_mark)
+{
+    std::fill(words_.begin(), words_.end(), 0);
+    head_ = 0;
+    origin_ = low_mark.to64long() + 1;
+    overflow_.clear();
+}
+
+bool ReceivedChangesBitmap::insert(
+        const SequenceNumber_t& seq_num,
+        const SequenceNumber_t& low_mark)
+{
+    uint64_t position = seq_num.to64long() - origin_;
+    if (position >= capacity())
+    {
+        // The ring is only moved forward when needed, as changes received in order do not use it.
+        slide(low_mark.to64long() + 1);
+        position = seq_num.to64long() - origin_;
+        if (position >= capacity() && !grow(position))
+        {
+            return overflow_.insert(seq_num).second;
+        }
+    }
+
+    uint64_t& bits = word(position);
+    uint64_t mask = 1ull << (position & 63);
+    if (0 != (bits & mask))
+    {
+        return false;
+    }
+    bits |= mask;
+    return true;
+}
+
+bool ReceivedChangesBitmap::contains(
+        const SequenceNumber_t& seq_num) const
+{
+    uint64_t position = seq_num.to64long() - origin_;
+    if (position >= capacity())
+    {
+        return overflow_.find(seq_num) != overflow_.end();
+    }
+
+    return 0 != (word(position) & (1ull << (position & 63)));
+}
+
+SequenceNumber_t ReceivedChangesBitmap::advance(
+        const SequenceNumber_t& low_mark)
+{
+    uint64_t first = low_mark.to64long() + 1;
+
+    while (true)
+    {
+        slide(first);
+
+        // Jump over all consecutive bits set, a word at a time
+        uint64_t position = first - origin_;
+        while (position < capacity())
+        {
+            uint64_t bits_left = 64 - (position & 63);
+            uint64_t bits = ~(word(position) >> (position & 63));
+            uint64_t received = (0 == bits) ? 64 : trailing_zeros(bits);
+            position += received;
+            if (received < bits_left)
+            {
+                break;
+            }
+        }
+
+        if (position == first - origin_)
+        {
+            break;
+        }
+
+        // When the ring was completely received, sliding it may take more changes from overflow_
+        first = origin_ + position;
+    }
+
+    return from_64(first - 1);
+}
+
+uint32_t ReceivedChangesBitmap::count(
+        const SequenceNumber_t& first,
+        const SequenceNumber_t& last) const
+{
+    uint32_t result = 0;
+    uint64_t begin = first.to64long() - origin_;
+    uint64_t end = (std::min)(last.to64long() - origin_, capacity());
+
+    while (begin < end)
+    {
+        uint64_t word_end = (begin | 63) + 1;
+        uint64_t to = (std::min)(word_end, end);
+        result += ones(word(begin) & bit_mask(begin & 63, ((to - 1) & 63) + 1));
+        begin = to;
+    }
+
+    for (auto it = overflow_.lower_bound(first); it != overflow_.end() && *it < last; ++it)
+    {
+        ++result;
+    }
+
+    return result;
+}
+
+void ReceivedChangesBitmap::add_missing(
+        const SequenceNumber_t& first,
+        const SequenceNumber_t& last,
+        SequenceNumberSet_t& missing) const
+{
+    uint64_t begin = first.to64long() - origin_;
+    uint64_t end = (std::min)(last.to64long() - origin_, capacity());
+
+    while (begin < end)
+    {
+        uint64_t word_start = begin & ~63ull;
+        uint64_t to = (std::min)(word_start + 64, end);
+        uint64_t bits = ~word(begin) & bit_mask(begin & 63, ((to - 1) & 63) + 1);
+        while (0 != bits)
+        {
+            missing.add(from_64(origin_ + word_start + trailing_zeros(bits)));
+            bits &= bits - 1;
+        }
+        begin = to;
+    }
+
+    // Part of the range beyond the ring, where the received changes are on overflow_
+    SequenceNumber_t first_missing = from_64(origin_ + (std::max)(first.to64long() - origin_, capacity()));
+    if (first_missing < last)
+    {
+        for (auto it = overflow_.lower_bound(first_missing); it != overflow_.end() && *it < last; ++it)
+        {
+            missing.add_range(first_missing, *it);
+            first_missing = *it + 1;
+        }
+        missing.add_range(first_missing, last);
+    }
+}
+
+void ReceivedChangesBitmap::slide(
+        uint64_t first)
+{
+    assert(first >= origin_);
+
+    uint64_t words_to_release = (first - origin_) >> 6;
+    if (words_to_release >= words_.size())
+    {
+        std::fill(words_.begin(), words_.end(), 0);
+        head_ = 0;
+    }
+    else
+    {
+        for (uint64_t i = 0; i < words_to_release; ++i)
+        {
+            words_[head_] = 0;
+            head_ = (head_ + 1) & (words_.size() - 1);
+        }
+    }
+    origin_ += words_to_release << 6;
+    words_[head_] &= ~bit_mask(0, first - origin_);
+
+    // Remove the changes of overflow_ up to the low mark
+    overflow_.erase(overflow_.begin(), overflow_.lower_bound(from_64(first)));
+    take_from_overflow();
+}
+
+bool ReceivedChangesBitmap::grow(
+        uint64_t position)
+{
+    size_t new_size = words_.size();
+    while ((static_cast<uint64_t>(new_size) << 6) <= position)
+    {
+        if (new_size >= max_words_)
+        {
+            return false;
+        }
+        new_size <<= 1;
+    }
+
+    std::vector<uint64_t> new_words(new_size, 0);
+    for (size_t i = 0; i < words_.size(); ++i)
+    {
+        new_words[i] = words_[(head_ + i) & (words_.size() - 1)];
+    }
+    words_.swap(new_words);
+    head_ = 0;
+    take_from_overflow();
+    return true;
+}
+
+void ReceivedChangesBitmap::take_from_overflow()
+{
+    auto it = overflow_.begin();
+    for (; it != overflow_.end(); ++it)
+    {
+        uint64_t position = it->to64long() - origin_;
+        if (position >= capacity())
+        {
+            break;
+        }
+        word(position) |= 1ull << (position & 63);
+    }
+    overflow_.erase(overflow_.begin(), it);
+}
+
+} // namespace rtps
+} // namespace fastrtps
+} // namespace eprosima
@@ -0,0 +1,170 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file ReceivedChangesBitmap.hpp
+ */
+
+#ifndef _RTPS_READER_RECEIVEDCHANGESBITMAP_HPP_
+#define _RTPS_READER_RECEIVEDCHANGESBITMAP_HPP_
+
+#include <fastdds/rtps/common/SequenceNumber.h>
+#include <fastrtps/utils/collections/ResourceLimitedContainerConfig.hpp>
+
+#include <foonathan/memory/container.hpp>
+#include <foonathan/memory/memory_pool.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace eprosima {
+namespace fastrtps {
+namespace rtps {
+
+/**
+ * Set of the sequence numbers received from a writer above its low mark, i.e. out of order.
+ *
+ * Sequence numbers are kept as bits on a ring of 64-bit words, whose first bit is at most 63 positions before the
+ * first sequence number after the low mark. Advancing the low mark releases whole words from the front of the ring,
+ * and the queries on a range of sequence numbers process 64 of them at a time.
+ * The ring grows up to a maximum number of words when a sequence number does not fit on it. Sequence numbers beyond
+ * the maximum are kept on a set, and moved to the ring when the low mark gets close enough to them.
+ *
+ * The low mark is kept by the owner, and passed to the methods that need it.
+ * It is not thread safe.
+ */
+class ReceivedChangesBitmap
+{
+public:
+
+    //! Maximum number of sequence numbers the ring can span.
+    static constexpr uint32_t max_window_size = 64 * 1024;
+
+    /**
+     * @param changes_allocation  Allocation configuration for the received changes. The initial value is used as the
+     *                            initial number of sequence numbers spanned by the ring, and the initial size of the
+     *                            pool of the set.
+     */
+    explicit ReceivedChangesBitmap(
+            const ResourceLimitedContainerConfig& changes_allocation);
+
+    /**
+     * Removes all the sequence numbers, and anchors the ring on a low mark.
+     * @param low_mark  Sequence number up to which all changes have been received.
+     */
+    void clear(
+            const SequenceNumber_t& low_mark);
+
+    /**
+     * Adds a sequence number.
+     * @param seq_num   Sequence number to add. Should be above low_mark + 1.
+     * @param low_mark  Sequence number up to which all changes have been received.
+     * @return false when the sequence number was already on the set.
+     */
+    bool insert(
+            const SequenceNumber_t& seq_num,
+            const SequenceNumber_t& low_mark);
+
+    /**
+     * Checks a sequence number.
+     * @param seq_num  Sequence number to check. Should be above the low mark.
+     * @return true when the sequence number is on the set.
+     */
+    bool contains(
+            const SequenceNumber_t& seq_num) const;
+
+    /**
+     * Moves the low mark forward, over all the sequence numbers on the set that follow it.
+     * All the sequence numbers up to the resulting low mark are removed.
+     * @param low_mark  New low mark. Should not be lower than the low mark of previous calls.
+     * @return The resulting low mark.
+     */
+    SequenceNumber_t advance(
+            const SequenceNumber_t& low_mark);
+
+    /**
+     * Counts the sequence numbers on a range.
+     * @param first  First sequence number of the range. Should be above the low mark.
+     * @param last   Sequence number after the last one of the range.
+     * @return Number of sequence numbers of [first, last) on the set.
+     */
+    uint32_t count(
+            const SequenceNumber_t& first,
+            const SequenceNumber_t& last) const;
+
+    /**
+     * Adds the sequence numbers of a range not on the set to a SequenceNumberSet_t.
+     * @param first  First sequence number of the range. Should be above the low mark.
+     * @param last   Sequence number after the last one of the range.
+     * @param [out] missing  Set where the sequence numbers of [first, last) not on this set are added.
+     */
+    void add_missing(
+            const SequenceNumber_t& first,
+            const SequenceNumber_t& last,
+            SequenceNumberSet_t& missing) const;
+
+private:
+
+    using pool_allocator_t =
+            foonathan::memory::memory_pool<foonathan::memory::node_pool, foonathan::memory::heap_allocator>;
+
+    uint64_t capacity() const
+    {
+        return static_cast<uint64_t>(words_.size()) << 6;
+    }
+
+    //! Word holding the bit on a position from origin_. The position should be lower than capacity().
+    uint64_t& word(
+            uint64_t position)
+    {
+        return words_[(head_ + static_cast<size_t>(position >> 6)) & (words_.size() - 1)];
+    }
+
+    uint64_t word(
+            uint64_t position) const
+    {
+        return words_[(head_ + static_cast<size_t>(position >> 6)) & (words_.size() - 1)];
+    }
+
+    //! Releases the words of the ring before a sequence number, and clears the bits before it on the first one.
+    void slide(
+            uint64_t first);
+
+    //! Grows the ring so the bit on a position from origin_ fits on it.
+    bool grow(
+            uint64_t position);
+
+    //! Moves to the ring the sequence numbers of overflow_ that fit on it.
+    void take_from_overflow();
+
+    //! Ring of words. Its size is always a power of two.
+    std::vector<uint64_t> words_;
+    //! Index of the first word of the ring.
+    size_t head_;
+    //! Sequence number of the first bit of the first word of the ring.
+    uint64_t origin_;
+    //! Maximum number of words of the ring.
+    size_t max_words_;
+    //! Memory pool allocator for overflow_.
+    pool_allocator_t overflow_pool_;
+    //! Sequence numbers which do not fit on the ring. All of them are beyond its last bit.
+    foonathan::memory::set<SequenceNumber_t, pool_allocator_t> overflow_;
+};
+
+} // namespace rtps
+} // namespace fastrtps
+} // namespace eprosima
+
+#endif // _RTPS_READER_RECEIVEDCHANGESBITMAP_HPP_
@@ -24,6 +24,7 @@
 #include <fastdds/rtps/messages/RTPSMessageCreator.h>
 #include <rtps/participant/RTPSParticipantImpl.h>
 #include <rtps/reader/WriterProxy.h>
+#include <rtps/reader/FragmentAssembler.hpp>
 #include <fastrtps/utils/TimeConversion.h>
 #include <rtps/history/HistoryAttributesExtension.hpp>
 
@@ -173,6 +174,11 @@ bool StatefulReader::matched_writer_add(
         }
     }
 
+    if (!m_guid.is_builtin())
+    {
+        mp_RTPSParticipant->matched_readers_index().add(wdata.guid(), this, m_guid.entityId);
+    }
+
     logInfo(RTPS_READER, "Writer Proxy " << wp->guid() << " added to " << m_guid.entityId);
     return true;
 }
@@ -187,6 +193,7 @@ bool StatefulReader::matched_writer_remove(
 
         //Remove cachechanges belonging to the unmatched writer
         mp_history->remove_changes_with_guid(writer_guid);
+        fragment_assembler_->remove_writer(writer_guid);
 
         for (ResourceLimitedVector<WriterProxy*>::iterator it = matched_writers_.begin(); it != matched_writers_.end();
                 ++it)
@@ -223,6 +230,7 @@ bool StatefulReader::matched_writer_remove(
         {
             wproxy->stop();
             matched_writers_pool_.push_back(wproxy);
+            mp_RTPSParticipant->matched_readers_index().remove(writer_guid, this);
             return true;
         }
 
@@ -332,20 +340,11 @@ bool StatefulReader::processDataMsg(
 
             CacheChange_t* change_to_add;
 
-            if (reserveCache(&change_to_add, change->serializedPayload.length)) //Reserve a new cache from the corresponding cache pool
-            {
-                if (!change_to_add->copy(change))
-                {
-                    logWarning(RTPS_MSG_IN, IDSTRING "Problem copying CacheChange, received data is: " << change->serializedPayload.length
-                                                                                                       << " bytes and max size in reader " << getGuid().entityId << " is " <<
-                            change_to_add->serializedPayload.max_size);
-                    releaseCache(change_to_add);
-                    return false;
-                }
-            }
-            else
+            //Reserve a new cache from the corresponding cache pool, sharing the payload when possible
+            if (!mp_history->reserve_Cache(&change_to_add, change))
             {
-                logError(RTPS_MSG_IN, IDSTRING "Problem reserving CacheChange in reader: " << getGuid().entityId);
+                logWarning(RTPS_MSG_IN, IDSTRING "Problem reserving CacheChange in reader " << getGuid().entityId <<
+                        ", received data is: " << change->serializedPayload.length << " bytes");
                 return false;
             }
 
@@ -403,56 +402,34 @@ bool StatefulReader::processDataFragMsg(
                     IDSTRING "Trying to add fragment " << incomingChange->sequenceNumber.to64long() << " TO reader: " <<
                     getGuid().entityId);
 
-            CacheChange_t* change_to_add = incomingChange;
-
-            CacheChange_t* change_created = nullptr;
-            CacheChange_t* work_change = nullptr;
-            if (!mp_history->get_change(change_to_add->sequenceNumber, change_to_add->writerGUID, &work_change))
+            // Fragments are kept by the assembler until the sample is complete
+            if (fragment_assembler_->add_fragments(*incomingChange, sampleSize, fragmentStartingNum,
+                    fragmentsInSubmessage))
             {
-                // A new change should be reserved
-                if (reserveCache(&work_change, sampleSize))
+                CacheChange_t* change_completed = nullptr;
+                if (!reserveCache(&change_completed, sampleSize) ||
+                        change_completed->serializedPayload.max_size < sampleSize)
                 {
-                    if (work_change->serializedPayload.max_size < sampleSize)
-                    {
-                        releaseCache(work_change);
-                        work_change = nullptr;
-                    }
-                    else
+                    logWarning(RTPS_MSG_IN, IDSTRING "Problem reserving CacheChange in reader: " << m_guid);
+                    if (change_completed != nullptr)
                     {
-                        work_change->copy_not_memcpy(change_to_add);
-                        work_change->serializedPayload.length = sampleSize;
-                        work_change->setFragmentSize(change_to_add->getFragmentSize(), true);
-                        change_created = work_change;
+                        releaseCache(change_completed);
                     }
+                    fragment_assembler_->remove(incomingChange->writerGUID, incomingChange->sequenceNumber);
+                    return false;
                 }
-            }
 
-            if (work_change != nullptr)
-            {
-                work_change->add_fragments(change_to_add->serializedPayload, fragmentStartingNum,
-                        fragmentsInSubmessage);
-            }
+                fragment_assembler_->take(incomingChange->writerGUID, incomingChange->sequenceNumber,
+                        *change_completed);
 
-            // If this is the first time we have received fragments for this change, add it to history
-            if (change_created != nullptr)
-            {
-                if (!change_received(change_created, pWP))
+                if (!change_received(change_completed, pWP))
                 {
-
                     logInfo(RTPS_MSG_IN,
-                            IDSTRING "MessageReceiver not add change " << change_created->sequenceNumber.to64long());
+                            IDSTRING "MessageReceiver not add change " << change_completed->sequenceNumber.to64long());
 
-                    releaseCache(change_created);
-                    work_change = nullptr;
+                    releaseCache(change_completed);
                 }
             }
-
-            // If change has been fully reassembled, mark as received and add notify user
-            if (work_change != nullptr && work_change->is_fully_assembled())
-            {
-                pWP->received_change_set(work_change->sequenceNumber);
-                NotifyChanges(pWP);
-            }
         }
     }
 
@@ -481,7 +458,7 @@ bool StatefulReader::processHeartbeatMsg(
         if (writer->process_heartbeat(
                     hbCount, firstSN, lastSN, finalFlag, livelinessFlag, disable_positive_acks_, assert_liveliness))
         {
-            mp_history->remove_fragmented_changes_until(firstSN, writerGUID);
+            fragment_assembler_->remove_until(writerGUID, firstSN);
 
             // Try to assert liveliness if requested by proxy's logic
             if (assert_liveliness)
@@ -534,21 +511,11 @@ bool StatefulReader::processGapMsg(
         // TODO (Miguel C): Refactor this inside WriterProxy
         SequenceNumber_t auxSN;
         SequenceNumber_t finalSN = gapList.base() - 1;
-        History::const_iterator history_iterator = mp_history->changesBegin();
         for (auxSN = gapStart; auxSN <= finalSN; auxSN++)
         {
             if (pWP->irrelevant_change_set(auxSN))
             {
-                CacheChange_t* to_remove = nullptr;
-                auto ret_iterator = findCacheInFragmentedProcess(auxSN, pWP->guid(), &to_remove, history_iterator);
-                if (to_remove != nullptr)
-                {
-                    history_iterator = mp_history->remove_change_nts(to_remove, ret_iterator);
-                }
-                else if (ret_iterator != mp_history->changesEnd())
-                {
-                    history_iterator = ret_iterator;
-                }
+                fragment_assembler_->remove(pWP->guid(), auxSN);
             }
         }
 
@@ -557,17 +524,7 @@ bool StatefulReader::processGapMsg(
             {
                 if (pWP->irrelevant_change_set(it))
                 {
-                    CacheChange_t* to_remove = nullptr;
-                    auto ret_iterator =
-                    findCacheInFragmentedProcess(auxSN, pWP->guid(), &to_remove, history_iterator);
-                    if (to_remove != nullptr)
-                    {
-                        history_iterator = mp_history->remove_change_nts(to_remove, ret_iterator);
-                    }
-                    else if (ret_iterator != mp_history->changesEnd())
-                    {
-                        history_iterator = ret_iterator;
-                    }
+                    fragment_assembler_->remove(pWP->guid(), it);
                 }
             });
 
@@ -973,19 +930,13 @@ void StatefulReader::send_acknack(
         {
             GUID_t guid = sender.remote_guids().at(0);
             SequenceNumberSet_t sns(writer->available_changes_max() + 1);
-            History::const_iterator history_iterator = mp_history->changesBegin();
 
             missing_changes.for_each(
                 [&](const SequenceNumber_t& seq)
                 {
-                    // Check if the CacheChange_t is uncompleted.
-                    CacheChange_t* uncomplete_change = nullptr;
-                    auto ret_iterator = findCacheInFragmentedProcess(seq, guid, &uncomplete_change, history_iterator);
-                    if (ret_iterator != mp_history->changesEnd())
-                    {
-                        history_iterator = ret_iterator;
-                    }
-                    if (uncomplete_change == nullptr)
+                    // Check if the CacheChange_t is being reassembled.
+                    FragmentNumberSet_t frag_sns;
+                    if (!fragment_assembler_->get_missing_fragments(guid, seq, frag_sns))
                     {
                         if (!sns.add(seq))
                         {
@@ -997,8 +948,6 @@ void StatefulReader::send_acknack(
                     }
                     else
                     {
-                        FragmentNumberSet_t frag_sns;
-                        uncomplete_change->get_missing_fragments(frag_sns);
                         ++nackfrag_count_;
                         logInfo(RTPS_READER, "Sending NACKFRAG for sample" << seq << ": " << frag_sns; );
 
@@ -26,6 +26,7 @@
 #include <fastdds/rtps/builtin/liveliness/WLP.h>
 #include <fastdds/rtps/writer/LivelinessManager.h>
 #include <rtps/participant/RTPSParticipantImpl.h>
+#include <rtps/reader/FragmentAssembler.hpp>
 
 #include <mutex>
 #include <thread>
@@ -77,6 +78,11 @@ bool StatelessReader::matched_writer_add(
         m_acceptMessagesFromUnkownWriters = false;
         logInfo(RTPS_READER, "Writer " << info.guid << " added to reader " << m_guid);
 
+        if (!m_guid.is_builtin())
+        {
+            mp_RTPSParticipant->matched_readers_index().add(info.guid, this, m_guid.entityId);
+        }
+
         if (liveliness_lease_duration_ < c_TimeInfinite)
         {
             auto wlp = mp_RTPSParticipant->wlp();
@@ -130,7 +136,9 @@ bool StatelessReader::matched_writer_remove(
             }
 
             remove_persistence_guid(it->guid, it->persistence_guid);
+            fragment_assembler_->remove_writer(writer_guid);
             matched_writers_.erase(it);
+            mp_RTPSParticipant->matched_readers_index().remove(writer_guid, this);
 
             return true;
         }
@@ -263,21 +271,11 @@ bool StatelessReader::processDataMsg(
 
         CacheChange_t* change_to_add;
 
-        //Reserve a new cache from the corresponding cache pool
-        if (reserveCache(&change_to_add, change->serializedPayload.length))
-        {
-            if (!change_to_add->copy(change))
-            {
-                logWarning(RTPS_MSG_IN, IDSTRING "Problem copying CacheChange, received data is: "
-                        << change->serializedPayload.length << " bytes and max size in reader "
-                        << m_guid << " is " << change_to_add->serializedPayload.max_size);
-                releaseCache(change_to_add);
-                return false;
-            }
-        }
-        else
+        //Reserve a new cache from the corresponding cache pool, sharing the payload when possible
+        if (!mp_history->reserve_Cache(&change_to_add, change))
         {
-            logError(RTPS_MSG_IN, IDSTRING "Problem reserving CacheChange in reader: " << m_guid);
+            logWarning(RTPS_MSG_IN, IDSTRING "Problem reserving CacheChange in reader " << m_guid
+                    << ", received data is: " << change->serializedPayload.length << " bytes");
             return false;
         }
 
@@ -314,74 +312,32 @@ bool StatelessReader::processDataFragMsg(
                 logInfo(RTPS_MSG_IN, IDSTRING "Trying to add fragment " << incomingChange->sequenceNumber.to64long() <<
                         " TO reader: " << m_guid);
 
-                // Early return if we already know abount a greater sequence number
-                CacheChange_t* work_change = writer.fragmented_change;
-                if (work_change != nullptr && work_change->sequenceNumber > incomingChange->sequenceNumber)
+                // Fragments are kept by the assembler until the sample is complete. Several samples of the same
+                // writer may be reassembled at the same time.
+                if (fragment_assembler_->add_fragments(*incomingChange, sampleSize, fragmentStartingNum,
+                        fragmentsInSubmessage))
                 {
-                    return true;
-                }
-
-                CacheChange_t* change_to_add = incomingChange;
-
-                // Check if pending fragmented change should be dropped
-                if (work_change != nullptr)
-                {
-                    if (work_change->sequenceNumber < change_to_add->sequenceNumber)
+                    CacheChange_t* change_completed = nullptr;
+                    if (!reserveCache(&change_completed, sampleSize) ||
+                            change_completed->serializedPayload.max_size < sampleSize)
                     {
-                        // Pending change should be dropped. Check if it can be reused
-                        if (sampleSize <= work_change->serializedPayload.max_size)
-                        {
-                            // Sample fits inside pending change. Reuse it.
-                            work_change->copy_not_memcpy(change_to_add);
-                            work_change->serializedPayload.length = sampleSize;
-                            work_change->setFragmentSize(change_to_add->getFragmentSize(), true);
-                        }
-                        else
+                        logWarning(RTPS_MSG_IN, IDSTRING "Problem reserving CacheChange in reader " << m_guid);
+                        if (change_completed != nullptr)
                         {
-                            // Release change, and let it be reserved later
-                            releaseCache(work_change);
-                            work_change = nullptr;
+                            releaseCache(change_completed);
                         }
+                        fragment_assembler_->remove(writer_guid, incomingChange->sequenceNumber);
+                        return false;
                     }
-                }
 
-                // Check if a new change should be reserved
-                if (work_change == nullptr)
-                {
-                    if (reserveCache(&work_change, sampleSize))
-                    {
-                        if (work_change->serializedPayload.max_size < sampleSize)
-                        {
-                            releaseCache(work_change);
-                            work_change = nullptr;
-                        }
-                        else
-                        {
-                            work_change->copy_not_memcpy(change_to_add);
-                            work_change->serializedPayload.length = sampleSize;
-                            work_change->setFragmentSize(change_to_add->getFragmentSize(), true);
-                        }
-                    }
-                }
+                    fragment_assembler_->take(writer_guid, incomingChange->sequenceNumber, *change_completed);
 
-                // Process fragment and set change_completed if it is fully reassembled
-                CacheChange_t* change_completed = nullptr;
-                if (work_change != nullptr)
-                {
-                    if (work_change->add_fragments(change_to_add->serializedPayload, fragmentStartingNum,
-                            fragmentsInSubmessage))
+                    if (change_received(change_completed))
                     {
-                        change_completed = work_change;
-                        work_change = nullptr;
+                        // Older samples of this writer would not be notified anymore
+                        fragment_assembler_->remove_until(writer_guid, change_completed->sequenceNumber);
                     }
-                }
-
-                writer.fragmented_change = work_change;
-
-                // If the change was completed, process it.
-                if (change_completed != nullptr)
-                {
-                    if (!change_received(change_completed))
+                    else
                     {
                         logInfo(RTPS_MSG_IN,
                                 IDSTRING "MessageReceiver not add change " <<
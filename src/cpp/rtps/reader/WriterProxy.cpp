@@ -31,7 +31,6 @@
 #include <rtps/participant/RTPSParticipantImpl.h>
 
 #include "rtps/RTPSDomainImpl.hpp"
-#include "utils/collections/node_size_helpers.hpp"
 
 #if !defined(NDEBUG) && defined(FASTRTPS_SOURCE) && defined(__linux__)
 #define SHOULD_DEBUG_LINUX
@@ -65,8 +64,6 @@ WriterProxy::~WriterProxy()
     delete(heartbeat_response_);
 }
 
-using set_helper = utilities::collections::set_size_helper<SequenceNumber_t>;
-
 WriterProxy::WriterProxy(
         StatefulReader* reader,
         const RemoteLocatorsAllocationAttributes& loc_alloc,
@@ -77,10 +74,7 @@ WriterProxy::WriterProxy(
     , last_heartbeat_count_(0)
     , heartbeat_final_flag_(false)
     , is_alive_(false)
-    , changes_pool_(
-        set_helper::node_size,
-        set_helper::min_pool_size<pool_allocator_t>(changes_allocation.initial))
-    , changes_received_(changes_pool_)
+    , changes_received_(changes_allocation)
     , guid_as_vector_(ResourceLimitedContainerConfig::fixed_size_configuration(1u))
     , guid_prefix_as_vector_(ResourceLimitedContainerConfig::fixed_size_configuration(1u))
     , is_on_same_process_(false)
@@ -165,7 +159,6 @@ void WriterProxy::clear()
     heartbeat_final_flag_.store(false);
     guid_as_vector_.clear();
     guid_prefix_as_vector_.clear();
-    changes_received_.clear();
     is_on_same_process_ = false;
     loaded_from_storage(SequenceNumber_t());
 }
@@ -176,6 +169,7 @@ void WriterProxy::loaded_from_storage(
     last_notified_ = seq_num;
     changes_from_writer_low_mark_ = seq_num;
     max_sequence_number_ = seq_num;
+    changes_received_.clear(seq_num);
 }
 
 void WriterProxy::missing_changes_update(
@@ -209,19 +203,12 @@ void WriterProxy::lost_changes_update(
     // Check was not removed from container.
     if (seq_num > changes_from_writer_low_mark_)
     {
-        // Remove all received changes with a sequence lower than seq_num
-        ChangeIterator it = std::lower_bound(changes_received_.begin(), changes_received_.end(), seq_num);
-        changes_received_.erase(changes_received_.begin(), it);
-
-        // Update low mark
-        changes_from_writer_low_mark_ = seq_num - 1;
+        // Remove all received changes with a sequence lower than seq_num, and the following ones already received
+        changes_from_writer_low_mark_ = changes_received_.advance(seq_num - 1);
         if (changes_from_writer_low_mark_ > max_sequence_number_)
         {
             max_sequence_number_ = changes_from_writer_low_mark_;
         }
-
-        // Next could need to be removed.
-        cleanup();
     }
 }
 
@@ -264,7 +251,7 @@ bool WriterProxy::received_change_set(
         }
         else
         {
-            changes_received_.insert(changes_received_.end(), seq_num);
+            changes_received_.insert(seq_num, changes_from_writer_low_mark_);
         }
         max_sequence_number_ = seq_num;
     }
@@ -279,12 +266,10 @@ bool WriterProxy::received_change_set(
         else
         {
             // Check if already received
-            if (changes_received_.find(seq_num) != changes_received_.end())
+            if (!changes_received_.insert(seq_num, changes_from_writer_low_mark_))
             {
                 return false;
             }
-
-            changes_received_.insert(seq_num);
         }
     }
 
@@ -301,20 +286,9 @@ SequenceNumberSet_t WriterProxy::missing_changes() const
     SequenceNumber_t max_missing = std::min(first_missing + 256UL, max_sequence_number_ + 1);
     SequenceNumberSet_t sns(first_missing);
 
-    for (SequenceNumber_t seq : changes_received_)
-    {
-        seq = std::min(seq, max_missing);
-        sns.add_range(first_missing, seq);
-        first_missing = seq + 1;
-        if (first_missing >= max_missing)
-        {
-            break;
-        }
-    }
-
     if (first_missing < max_missing)
     {
-        sns.add_range(first_missing, max_missing);
+        changes_received_.add_missing(first_missing, max_missing, sns);
     }
 
     return sns;
@@ -332,8 +306,7 @@ bool WriterProxy::change_was_received(
         return true;
     }
 
-    ChangeIterator chit = changes_received_.find(seq_num);
-    return chit != changes_received_.end();
+    return changes_received_.contains(seq_num);
 }
 
 const SequenceNumber_t WriterProxy::available_changes_max() const
@@ -358,12 +331,8 @@ void WriterProxy::change_removed_from_history(
         return;
     }
 
-    ChangeIterator chit = changes_received_.find(seq_num);
-
-    (void)chit;
-
     // Element must be in the container. In other case, bug.
-    assert(chit != changes_received_.end());
+    assert(changes_received_.contains(seq_num));
 
     // Previously, it was asserted that the change couldn't be the first and should have RECEIVED
     // status. As we only keep received changes now, status is already checked by the previous assert.
@@ -387,17 +356,8 @@ void WriterProxy::change_removed_from_history(
 
 void WriterProxy::cleanup()
 {
-    ChangeIterator chit = changes_received_.begin();
-
-    // Jump over all consecutive received changes starting on the next to low_mark
-    while (chit != changes_received_.end() && *chit == changes_from_writer_low_mark_ + 1)
-    {
-        chit++;
-        changes_from_writer_low_mark_++;
-    }
-
-    // Remove all those changes
-    changes_received_.erase(changes_received_.begin(), chit);
+    // Jump over all consecutive received changes starting on the next to low_mark, and remove them
+    changes_from_writer_low_mark_ = changes_received_.advance(changes_from_writer_low_mark_);
 }
 
 bool WriterProxy::are_there_missing_changes() const
@@ -422,26 +382,11 @@ size_t WriterProxy::unknown_missing_changes_up_to(
     {
         SequenceNumber_t first_missing = changes_from_writer_low_mark_ + 1;
         SequenceNumber_t max_missing = std::min(seq_num, max_sequence_number_ + 1);
-        SequenceNumberSet_t sns(first_missing);
         SequenceNumberDiff d_fun;
 
-        for (SequenceNumber_t seq : changes_received_)
-        {
-            seq = std::min(seq, max_missing);
-            if (first_missing < seq)
-            {
-                returnedValue += d_fun(seq, first_missing);
-            }
-            first_missing = seq + 1;
-            if (first_missing >= max_missing)
-            {
-                break;
-            }
-        }
-
         if (first_missing < max_missing)
         {
-            returnedValue += d_fun(max_missing, first_missing);
+            returnedValue = d_fun(max_missing, first_missing) - changes_received_.count(first_missing, max_missing);
         }
     }
 
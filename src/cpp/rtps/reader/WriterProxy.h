@@ -30,10 +30,7 @@
 #include <fastdds/rtps/builtin/data/WriterProxyData.h>
 #include <fastdds/rtps/common/LocatorSelectorEntry.hpp>
 
-#include <foonathan/memory/container.hpp>
-#include <foonathan/memory/memory_pool.hpp>
-
-#include <set>
+#include <rtps/reader/ReceivedChangesBitmap.hpp>
 
 // Testing purpose
 #ifndef TEST_FRIENDS
@@ -351,13 +348,8 @@ private:
     //!Is the writer alive
     bool is_alive_;
 
-    using pool_allocator_t =
-                    foonathan::memory::memory_pool<foonathan::memory::node_pool, foonathan::memory::heap_allocator>;
-
-    //! Memory pool allocator for changes_received_
-    pool_allocator_t changes_pool_;
-    //! Vector containing the sequence number of the received ChangeFromWriter_t objects.
-    foonathan::memory::set<SequenceNumber_t, pool_allocator_t> changes_received_;
+    //! Sequence numbers of the changes received above changes_from_writer_low_mark_.
+    ReceivedChangesBitmap changes_received_;
     //! Sequence number of the highest available change
     SequenceNumber_t changes_from_writer_low_mark_;
     //! Highest sequence number informed by writer
@@ -379,8 +371,6 @@ private:
     //! Taken from proxy data
     LocatorSelectorEntry locators_entry_;
 
-    using ChangeIterator = decltype(changes_received_)::iterator;
-
 #if !defined(NDEBUG) && defined(FASTRTPS_SOURCE) && defined(__linux__)
     int get_mutex_owner() const;
 
@@ -14,30 +14,156 @@
 
 #include <fastdds/rtps/resources/AsyncWriterThread.h>
 #include <fastdds/rtps/writer/RTPSWriter.h>
+#include <fastdds/rtps/attributes/PropertyPolicy.h>
+#include <fastdds/dds/log/Log.hpp>
 
 #include <mutex>
 #include <algorithm>
 #include <cassert>
+#include <sstream>
 #include <stdexcept>
+#include <string>
+
+#if defined(__linux__)
+#include <sched.h>
+#endif // if defined(__linux__)
+#if !defined(_WIN32)
+#include <pthread.h>
+#endif // if !defined(_WIN32)
 
 using namespace eprosima::fastrtps::rtps;
 
+//! Maximum number of threads accepted on fastdds.async_writer.threads.
+static constexpr uint32_t max_async_writer_threads = 64;
+
+static bool read_property(
+        const PropertyPolicy& properties,
+        const std::string& name,
+        int64_t& value)
+{
+    const std::string* property = PropertyPolicyHelper::find_property(properties, name);
+    if (property != nullptr)
+    {
+        try
+        {
+            value = std::stoll(*property);
+            return true;
+        }
+        catch (std::exception&)
+        {
+            logError(RTPS_WRITER, "Wrong value '" << *property << "' for property " << name);
+        }
+    }
+
+    return false;
+}
+
+AsyncWriterThread::AsyncWriterThread()
+{
+    create_workers(1);
+}
+
+AsyncWriterThread::AsyncWriterThread(
+        const PropertyPolicy& properties)
+{
+    int64_t value = 0;
+    uint32_t thread_count = 1;
+    if (read_property(properties, "fastdds.async_writer.threads", value))
+    {
+        thread_count = static_cast<uint32_t>((std::min)((std::max)(value, int64_t(1)),
+                int64_t(max_async_writer_threads)));
+    }
+
+    if (read_property(properties, "fastdds.async_writer.priority", value))
+    {
+        priority_ = static_cast<int32_t>(value);
+    }
+
+    const std::string* cpus = PropertyPolicyHelper::find_property(properties, "fastdds.async_writer.cpu_affinity");
+    if (cpus != nullptr)
+    {
+        std::istringstream list(*cpus);
+        std::string cpu;
+        while (std::getline(list, cpu, ','))
+        {
+            try
+            {
+                cpu_affinity_.push_back(static_cast<uint32_t>(std::stoul(cpu)));
+            }
+            catch (std::exception&)
+            {
+                logError(RTPS_WRITER, "Wrong CPU '" << cpu << "' on property fastdds.async_writer.cpu_affinity");
+            }
+        }
+    }
+
+    create_workers(thread_count);
+}
+
 AsyncWriterThread::~AsyncWriterThread()
 {
-    std::unique_lock<RecursiveTimedMutex> lock(condition_variable_mutex_);
-    running_ = false;
-    run_scheduled_ = false;
-    cv_.notify_all();
-    if (thread_)
-    {
-        lock.unlock();
-        thread_->join();
-        lock.lock();
-        delete thread_;
-        thread_ = nullptr;
+    for (std::unique_ptr<Worker>& worker : workers_)
+    {
+        std::unique_lock<RecursiveTimedMutex> lock(worker->condition_variable_mutex_);
+        worker->running_ = false;
+        worker->run_scheduled_ = false;
+        worker->cv_.notify_all();
+        if (worker->thread_)
+        {
+            lock.unlock();
+            worker->thread_->join();
+            lock.lock();
+            delete worker->thread_;
+            worker->thread_ = nullptr;
+        }
+    }
+}
+
+void AsyncWriterThread::create_workers(
+        uint32_t thread_count)
+{
+    workers_.reserve(thread_count);
+    for (uint32_t i = 0; i < thread_count; ++i)
+    {
+        workers_.emplace_back(new Worker());
+        workers_.back()->index = i;
     }
 }
 
+void AsyncWriterThread::register_writer(
+        RTPSWriter* writer,
+        const PropertyPolicy& properties)
+{
+    uint32_t thread_count = static_cast<uint32_t>(workers_.size());
+
+    int64_t value = -1;
+    if (read_property(properties, "fastdds.async_writer.thread", value) && (0 > value || value >= thread_count))
+    {
+        logError(RTPS_WRITER, "Writer " << writer->getGuid() << " requested async thread " << value
+                                        << ", but there are only " << thread_count);
+        value = -1;
+    }
+
+    std::lock_guard<std::mutex> guard(writers_mutex_);
+
+    if (0 <= value)
+    {
+        writer->async_thread_index_ = static_cast<uint32_t>(value);
+    }
+    else
+    {
+        // Entity keys are shared with readers, so they do not tell how many writers each thread has
+        auto least_loaded = std::min_element(workers_.begin(), workers_.end(),
+                        [](const std::unique_ptr<Worker>& a, const std::unique_ptr<Worker>& b)
+                        {
+                            return a->writer_count_ < b->writer_count_;
+                        });
+        writer->async_thread_index_ = (*least_loaded)->index;
+    }
+
+    ++workers_[writer->async_thread_index_]->writer_count_;
+}
+
 /*!
  * @brief This function removes a writer.
  * @param writer Asynchronous writer to be removed.
@@ -45,40 +171,24 @@ AsyncWriterThread::~AsyncWriterThread()
  */
 void AsyncWriterThread::unregister_writer(RTPSWriter* writer)
 {
-    if(interestTree_.unregister_interest(writer))
-    {
-        std::unique_lock<RecursiveTimedMutex> lock(condition_variable_mutex_);
-        running_ = false;
-        run_scheduled_ = false;
-        cv_.notify_all();
-        if (thread_)
-        {
-            lock.unlock();
-            thread_->join();
-            lock.lock();
-            delete thread_;
-            thread_ = nullptr;
-        }
-    }
+    // The thread keeps the active queue locked while it processes writers, so this waits for the writer to be
+    // processed. The thread keeps running for the rest of writers.
+    Worker& worker = worker_of(writer);
+    worker.interestTree_.unregister_interest(writer);
+
+    std::lock_guard<std::mutex> guard(writers_mutex_);
+    --worker.writer_count_;
 }
 
 void AsyncWriterThread::wake_up(
         RTPSWriter* interested_writer)
 {
-    if (interestTree_.register_interest(interested_writer))
+    Worker& worker = worker_of(interested_writer);
+    if (worker.interestTree_.register_interest(interested_writer))
     {
-        std::unique_lock<RecursiveTimedMutex> lock(condition_variable_mutex_);
-        run_scheduled_ = true;
-        // If thread not running, start it.
-        if (thread_ == nullptr)
-        {
-            running_ = true;
-            thread_ = new std::thread(&AsyncWriterThread::run, this);
-        }
-        else
-        {
-            cv_.notify_all();
-        }
+        std::unique_lock<RecursiveTimedMutex> lock(worker.condition_variable_mutex_);
+        worker.run_scheduled_ = true;
+        start_nts(worker);
     }
 }
 
@@ -86,53 +196,107 @@ void AsyncWriterThread::wake_up(
         RTPSWriter* interested_writer,
         const std::chrono::time_point<std::chrono::steady_clock>& max_blocking_time)
 {
-    if (interestTree_.register_interest(interested_writer, max_blocking_time))
+    Worker& worker = worker_of(interested_writer);
+    if (worker.interestTree_.register_interest(interested_writer, max_blocking_time))
     {
-        std::unique_lock<RecursiveTimedMutex> lock(condition_variable_mutex_, std::defer_lock);
+        std::unique_lock<RecursiveTimedMutex> lock(worker.condition_variable_mutex_, std::defer_lock);
 
         if (lock.try_lock_until(max_blocking_time))
         {
-            run_scheduled_ = true;
-            // If thread not running, start it.
-            if (thread_ == nullptr)
-            {
-                running_ = true;
-                thread_ = new std::thread(&AsyncWriterThread::run, this);
-            }
-            else
-            {
-                cv_.notify_all();
-            }
+            worker.run_scheduled_ = true;
+            start_nts(worker);
         }
     }
 }
 
-void AsyncWriterThread::run()
+AsyncWriterThread::Worker& AsyncWriterThread::worker_of(
+        const RTPSWriter* writer)
 {
-    std::unique_lock<RecursiveTimedMutex> cond_guard(condition_variable_mutex_);
-    while(running_)
+    assert(writer->async_thread_index_ < workers_.size());
+    return *workers_[writer->async_thread_index_];
+}
+
+void AsyncWriterThread::start_nts(
+        Worker& worker)
+{
+    // If thread not running, start it.
+    if (worker.thread_ == nullptr)
+    {
+        worker.running_ = true;
+        worker.thread_ = new std::thread(&AsyncWriterThread::run, this, std::ref(worker));
+    }
+    else
+    {
+        worker.cv_.notify_all();
+    }
+}
+
+void AsyncWriterThread::configure_current_thread(
+        const Worker& worker) const
+{
+    if (!cpu_affinity_.empty())
+    {
+        uint32_t cpu = cpu_affinity_[worker.index % cpu_affinity_.size()];
+#if defined(__linux__)
+        cpu_set_t cpu_set;
+        CPU_ZERO(&cpu_set);
+        CPU_SET(cpu, &cpu_set);
+        if (0 != pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set))
+        {
+            logWarning(RTPS_WRITER, "Could not pin async writer thread " << worker.index << " to CPU " << cpu);
+        }
+#else
+        logWarning(RTPS_WRITER, "CPU affinity of async writer threads not supported on this platform. CPU "
+                << cpu << " ignored");
+#endif // if defined(__linux__)
+    }
+
+    if (0 != priority_)
+    {
+#if !defined(_WIN32)
+        sched_param param;
+        param.sched_priority = priority_;
+        if (0 != pthread_setschedparam(pthread_self(), SCHED_FIFO, &param))
+        {
+            logWarning(RTPS_WRITER, "Could not set priority " << priority_ << " on async writer thread "
+                                                               << worker.index);
+        }
+#else
+        logWarning(RTPS_WRITER, "Priority of async writer threads not supported on this platform");
+#endif // if !defined(_WIN32)
+    }
+}
+
+void AsyncWriterThread::run(
+        Worker& worker)
+{
+    configure_current_thread(worker);
+
+    AsyncInterestTree& interestTree = worker.interestTree_;
+    std::unique_lock<RecursiveTimedMutex> cond_guard(worker.condition_variable_mutex_);
+    while(worker.running_)
     {
-        if(run_scheduled_)
+        if(worker.run_scheduled_)
         {
-            run_scheduled_ = false;
+            worker.run_scheduled_ = false;
             cond_guard.unlock();
-            interestTree_.swap();
+            interestTree.swap();
 
-            interestTree_.mMutexActive.lock();
-            RTPSWriter* curr = interestTree_.next_active_nts();
+            interestTree.mMutexActive.lock();
+            RTPSWriter* curr = interestTree.next_active_nts();
 
             while (curr)
             {
                 curr->send_any_unsent_changes();
-                curr = interestTree_.next_active_nts();
+                curr = interestTree.next_active_nts();
             }
-            interestTree_.mMutexActive.unlock();
+            interestTree.mMutexActive.unlock();
 
             cond_guard.lock();
         }
         else
         {
-            cv_.wait(cond_guard);
+            worker.cv_.wait(cond_guard);
         }
     }
 }
@@ -21,6 +21,7 @@
 #include <fastdds/dds/log/Log.hpp>
 
 #include "TimedEventImpl.h"
+#include "TimerWheel.hpp"
 
 #include <cassert>
 #include <thread>
@@ -29,11 +30,9 @@ namespace eprosima {
 namespace fastrtps {
 namespace rtps {
 
-static bool event_compare(
-        TimedEventImpl* lhs,
-        TimedEventImpl* rhs)
+ResourceEvent::ResourceEvent()
+    : active_timers_(new TimerWheel())
 {
-    return lhs->next_trigger_time() < rhs->next_trigger_time();
 }
 
 ResourceEvent::~ResourceEvent()
@@ -91,10 +90,9 @@ void ResourceEvent::unregister_timer(
     }
 
     // Remove from active
-    it = std::find(active_timers_.begin(), active_timers_.end(), event);
-    if (it != active_timers_.end())
+    if (nullptr != event->wheel_slot)
     {
-        active_timers_.erase(it);
+        active_timers_->remove(event);
         should_notify = true;
     }
 
@@ -164,9 +162,7 @@ void ResourceEvent::event_service()
 
         // Wait for the first timer to be triggered
         std::chrono::steady_clock::time_point next_trigger =
-                active_timers_.empty() ?
-                current_time_ + std::chrono::seconds(1) :
-                active_timers_[0]->next_trigger_time();
+                active_timers_->next_expiration(current_time_ + std::chrono::seconds(1));
 
         cv_.wait_until(lock, next_trigger);
 
@@ -176,11 +172,6 @@ void ResourceEvent::event_service()
     }
 }
 
-void ResourceEvent::sort_timers()
-{
-    std::sort(active_timers_.begin(), active_timers_.end(), event_compare);
-}
-
 void ResourceEvent::update_current_time()
 {
     current_time_ = std::chrono::steady_clock::now();
@@ -191,65 +182,39 @@ void ResourceEvent::do_timer_actions()
     std::chrono::steady_clock::time_point cancel_time =
             current_time_ + std::chrono::hours(24);
 
-    bool did_something = false;
-
     // Process pending orders
     {
         std::lock_guard<TimedMutex> lock(mutex_);
         for (TimedEventImpl* tp : pending_timers_)
         {
             // Remove item from active timers
-            auto current_pos = std::lower_bound(active_timers_.begin(), active_timers_.end(), tp, event_compare);
-            current_pos = std::find(current_pos, active_timers_.end(), tp);
-            if (current_pos != active_timers_.end())
-            {
-                active_timers_.erase(current_pos);
-            }
+            active_timers_->remove(tp);
 
             // Update timer info
             if (tp->update(current_time_, cancel_time))
             {
                 // Timer has to be activated: add to active timers
-                std::vector<TimedEventImpl*>::iterator low_bound;
-
-                // Insert on correct position
-                low_bound = std::lower_bound(active_timers_.begin(), active_timers_.end(), tp, event_compare);
-                active_timers_.emplace(low_bound, tp);
+                active_timers_->insert(tp, tp->next_trigger_time());
             }
         }
         pending_timers_.clear();
     }
 
     // Trigger active timers
-    for (TimedEventImpl* tp : active_timers_)
+    active_timers_->advance(current_time_, expired_timers_);
+    for (TimerWheelEntry* entry : expired_timers_)
     {
-        if (tp->next_trigger_time() <= current_time_)
-        {
-            did_something = true;
-            tp->trigger(current_time_, cancel_time);
-        }
-        else
+        TimedEventImpl* tp = static_cast<TimedEventImpl*>(entry);
+        tp->trigger(current_time_, cancel_time);
+
+        // Keep restarted timers active
+        std::chrono::steady_clock::time_point next_trigger = tp->next_trigger_time();
+        if (next_trigger < cancel_time)
         {
-            break;
+            active_timers_->insert(tp, next_trigger);
         }
     }
-
-    // If an action was made, keep active_timers_ sorted
-    if (did_something)
-    {
-        sort_timers();
-        active_timers_.erase(
-            std::lower_bound(active_timers_.begin(), active_timers_.end(), nullptr,
-            [cancel_time](
-                TimedEventImpl* a,
-                TimedEventImpl* b)
-                    {
-                        (void)b;
-                        return a->next_trigger_time() < cancel_time;
-                    }),
-            active_timers_.end()
-            );
-    }
+    expired_timers_.clear();
 }
 
 void ResourceEvent::init_thread()
@@ -25,6 +25,8 @@
 #include <fastdds/rtps/common/Time_t.h>
 #include <fastdds/rtps/resources/TimedEvent.h>
 
+#include "TimerWheel.hpp"
+
 #include <atomic>
 #include <thread>
 #include <memory>
@@ -39,9 +41,10 @@ namespace rtps {
 /*!
  * This class encapsulates a timer.
  * It also manages the state of the event (INACTIVE, READY, WAITING..).
+ * ResourceEvent keeps the active timers on a TimerWheel.
  * @ingroup MANAGEMENT_MODULE
  */
-class TimedEventImpl
+class TimedEventImpl : public TimerWheelEntry
 {
     using Callback = std::function<bool ()>;
 
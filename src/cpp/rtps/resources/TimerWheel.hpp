@@ -0,0 +1,346 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file TimerWheel.hpp
+ */
+
+#ifndef _RTPS_RESOURCES_TIMERWHEEL_HPP_
+#define _RTPS_RESOURCES_TIMERWHEEL_HPP_
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace eprosima {
+namespace fastrtps {
+namespace rtps {
+
+/**
+ * Hook for an element stored on a TimerWheel.
+ * Its fields are managed by the wheel, and should not be modified while the element is on it.
+ */
+struct TimerWheelEntry
+{
+    //! Previous element on the same slot.
+    TimerWheelEntry* wheel_prev = nullptr;
+
+    //! Next element on the same slot.
+    TimerWheelEntry* wheel_next = nullptr;
+
+    //! Head of the slot holding the element, or nullptr if it is not on a wheel.
+    TimerWheelEntry** wheel_slot = nullptr;
+
+    //! Level of the slot holding the element.
+    uint32_t wheel_level = 0;
+
+    //! Time when the element expires.
+    std::chrono::steady_clock::time_point wheel_deadline;
+};
+
+/**
+ * Hierarchical timing wheel.
+ *
+ * Time is split in ticks of one millisecond. The first level has a slot for each of the next 256 ticks, and each
+ * of the following levels has slots spanning 256 times the ticks of the previous one. Elements are kept on
+ * intrusive lists, so adding and removing them takes constant time, and elements expiring on the same tick share
+ * their slot. Elements on higher levels are moved down when the first level wraps around.
+ *
+ * Expiration is exact: elements are only returned once their deadline has been reached.
+ * It is not thread safe.
+ */
+class TimerWheel
+{
+    using clock = std::chrono::steady_clock;
+
+    static constexpr uint32_t slot_bits = 8;
+    static constexpr uint32_t num_slots = 1u << slot_bits;
+    static constexpr uint32_t slot_mask = num_slots - 1u;
+    static constexpr uint32_t num_levels = 4;
+
+public:
+
+    explicit TimerWheel(
+            clock::time_point origin = clock::now())
+        : origin_(origin)
+    {
+        for (auto& level : slots_)
+        {
+            level.fill(nullptr);
+        }
+        level_count_.fill(0);
+    }
+
+    TimerWheel(
+            const TimerWheel&) = delete;
+
+    TimerWheel& operator =(
+            const TimerWheel&) = delete;
+
+    //! @return true when there are no elements on the wheel.
+    bool empty() const
+    {
+        return 0 == size_;
+    }
+
+    //! @return the number of elements on the wheel.
+    size_t size() const
+    {
+        return size_;
+    }
+
+    /**
+     * Add an element to the wheel.
+     * @param entry     Element to add. It should not be on a wheel.
+     * @param deadline  Time when the element expires.
+     */
+    void insert(
+            TimerWheelEntry* entry,
+            clock::time_point deadline)
+    {
+        assert(nullptr == entry->wheel_slot);
+        entry->wheel_deadline = deadline;
+        place(entry);
+        ++size_;
+    }
+
+    /**
+     * Remove an element from the wheel.
+     * @param entry  Element to remove. Nothing is done if it is not on the wheel.
+     */
+    void remove(
+            TimerWheelEntry* entry)
+    {
+        if (nullptr != entry->wheel_slot)
+        {
+            unlink(entry);
+            --size_;
+        }
+    }
+
+    /**
+     * Advance the wheel up to a point in time, collecting the elements whose deadline has been reached.
+     * @param now           Current time.
+     * @param [out] expired Where the expired elements are appended to. They are removed from the wheel.
+     */
+    void advance(
+            clock::time_point now,
+            std::vector<TimerWheelEntry*>& expired)
+    {
+        int64_t now_tick = to_tick(now);
+        while (current_tick_ < now_tick)
+        {
+            if (0 == level_count_[0])
+            {
+                // Jump to the next point where higher levels should be moved down
+                current_tick_ = std::min(now_tick, (current_tick_ | slot_mask) + 1);
+            }
+            else
+            {
+                expire_slot(&slots_[0][current_tick_ & slot_mask], now, expired);
+                ++current_tick_;
+            }
+
+            if (0 == (current_tick_ & slot_mask))
+            {
+                cascade();
+            }
+        }
+
+        // Elements on the current tick may have been reached already
+        if (0 < level_count_[0])
+        {
+            expire_slot(&slots_[0][current_tick_ & slot_mask], now, expired);
+        }
+    }
+
+    /**
+     * Get the time when the wheel should be advanced next.
+     * @param limit  Maximum time to return.
+     * @return the deadline of the earliest element, the time when higher levels should be moved down, or
+     * @c limit, whatever happens first.
+     */
+    clock::time_point next_expiration(
+            clock::time_point limit) const
+    {
+        clock::time_point ret = limit;
+
+        if (size_ > level_count_[0])
+        {
+            clock::time_point cascade_time = to_time((current_tick_ | slot_mask) + 1);
+            ret = std::min(ret, cascade_time);
+        }
+
+        if (0 < level_count_[0])
+        {
+            for (uint32_t i = 0; i < num_slots; ++i)
+            {
+                const TimerWheelEntry* entry = slots_[0][(current_tick_ + i) & slot_mask];
+                if (nullptr != entry)
+                {
+                    // All elements on a first level slot expire on the same tick
+                    for (; nullptr != entry; entry = entry->wheel_next)
+                    {
+                        ret = std::min(ret, entry->wheel_deadline);
+                    }
+                    break;
+                }
+            }
+        }
+
+        return ret;
+    }
+
+private:
+
+    int64_t to_tick(
+            clock::time_point time) const
+    {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(time - origin_).count();
+    }
+
+    clock::time_point to_time(
+            int64_t tick) const
+    {
+        return origin_ + std::chrono::milliseconds(tick);
+    }
+
+    void place(
+            TimerWheelEntry* entry)
+    {
+        int64_t tick = to_tick(entry->wheel_deadline);
+        int64_t diff = tick - current_tick_;
+        uint32_t level = 0;
+
+        if (diff < 0)
+        {
+            // Already expired: it will be returned on the next advance
+            tick = current_tick_;
+        }
+        else
+        {
+            while (level < num_levels - 1 && diff >= (int64_t(1) << (slot_bits * (level + 1))))
+            {
+                ++level;
+            }
+
+            int64_t max_diff = (int64_t(1) << (slot_bits * num_levels)) - 1;
+            if (diff > max_diff)
+            {
+                // Too far away: it will be placed again when its slot is moved down
+                tick = current_tick_ + max_diff;
+            }
+        }
+
+        TimerWheelEntry** slot = &slots_[level][(tick >> (slot_bits * level)) & slot_mask];
+        entry->wheel_prev = nullptr;
+        entry->wheel_next = *slot;
+        if (nullptr != *slot)
+        {
+            (*slot)->wheel_prev = entry;
+        }
+        *slot = entry;
+        entry->wheel_slot = slot;
+        entry->wheel_level = level;
+        ++level_count_[level];
+    }
+
+    void unlink(
+            TimerWheelEntry* entry)
+    {
+        if (nullptr != entry->wheel_prev)
+        {
+            entry->wheel_prev->wheel_next = entry->wheel_next;
+        }
+        else
+        {
+            *entry->wheel_slot = entry->wheel_next;
+        }
+
+        if (nullptr != entry->wheel_next)
+        {
+            entry->wheel_next->wheel_prev = entry->wheel_prev;
+        }
+
+        --level_count_[entry->wheel_level];
+        entry->wheel_prev = nullptr;
+        entry->wheel_next = nullptr;
+        entry->wheel_slot = nullptr;
+    }
+
+    void expire_slot(
+            TimerWheelEntry** slot,
+            clock::time_point now,
+            std::vector<TimerWheelEntry*>& expired)
+    {
+        TimerWheelEntry* entry = *slot;
+        while (nullptr != entry)
+        {
+            TimerWheelEntry* next = entry->wheel_next;
+            if (entry->wheel_deadline <= now)
+            {
+                unlink(entry);
+                --size_;
+                expired.push_back(entry);
+            }
+            entry = next;
+        }
+    }
+
+    //! Moves down the elements on the higher level slots that are reached after the first level wraps around.
+    void cascade()
+    {
+        for (uint32_t level = 1; level < num_levels; ++level)
+        {
+            uint32_t index = static_cast<uint32_t>((current_tick_ >> (slot_bits * level)) & slot_mask);
+            TimerWheelEntry* entry = slots_[level][index];
+            while (nullptr != entry)
+            {
+                TimerWheelEntry* next = entry->wheel_next;
+                unlink(entry);
+                place(entry);
+                entry = next;
+            }
+
+            if (0 != index)
+            {
+                break;
+            }
+        }
+    }
+
+    //! Time point of tick 0.
+    clock::time_point origin_;
+
+    //! Next tick to be completely processed.
+    int64_t current_tick_ = 0;
+
+    //! Number of elements on the wheel.
+    size_t size_ = 0;
+
+    //! Number of elements on each level.
+    std::array<size_t, num_levels> level_count_;
+
+    //! Heads of the lists on each slot.
+    std::array<std::array<TimerWheelEntry*, num_slots>, num_levels> slots_;
+};
+
+} // namespace rtps
+} // namespace fastrtps
+} // namespace eprosima
+
+#endif // _RTPS_RESOURCES_TIMERWHEEL_HPP_
@@ -53,6 +53,7 @@ TCPChannelResource::TCPChannelResource(
     , locator_(locator)
     , waiting_for_keep_alive_(false)
     , connection_status_(eConnectionStatus::eDisconnected)
+    , crc32c_(false)
     , tcp_connection_type_(TCPConnectionType::TCP_CONNECT_TYPE)
 {
 }
@@ -65,6 +66,7 @@ TCPChannelResource::TCPChannelResource(
     , locator_()
     , waiting_for_keep_alive_(false)
     , connection_status_(eConnectionStatus::eConnected)
+    , crc32c_(false)
     , tcp_connection_type_(TCPConnectionType::TCP_ACCEPT_TYPE)
 {
 }
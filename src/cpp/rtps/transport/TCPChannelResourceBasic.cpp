@@ -144,6 +144,15 @@ uint32_t TCPChannelResourceBasic::read(
     return 0;
 }
 
+bool TCPChannelResourceBasic::async_read_some(
+        octet* buffer,
+        std::size_t size,
+        const std::function<void(const asio::error_code&, std::size_t)>& handler)
+{
+    socket_->async_read_some(asio::buffer(buffer, size), handler);
+    return true;
+}
+
 size_t TCPChannelResourceBasic::send(
         const octet* header,
         size_t header_size,
@@ -155,6 +164,16 @@ size_t TCPChannelResourceBasic::send(
 
     if (eConnecting < connection_status_)
     {
+        std::lock_guard<std::mutex> send_guard(send_mutex_);
+
+        // Only RTPS messages, sent with a separate TCP header, are discarded
+        if (header_size > 0 && parent_->configuration()->non_blocking_send &&
+                !parent_->check_socket_send_buffer(header_size + size, socket_->native_handle()))
+        {
+            ec = asio::error::would_block;
+            return 0;
+        }
+
         if (header_size > 0)
         {
             std::array<asio::const_buffer, 2> buffers;
@@ -205,6 +205,19 @@ size_t TCPChannelResourceSecure::send(
 
     if (eConnecting < connection_status_)
     {
+        // Only one write may be in progress on the stream
+        std::lock_guard<std::mutex> send_guard(send_mutex_);
+
+        // Only RTPS messages, sent with a separate TCP header, are discarded.
+        // TLS records add some bytes to the message, which are not taken into account
+        if (header_size > 0 && parent_->configuration()->non_blocking_send &&
+                !parent_->check_socket_send_buffer(header_size + size,
+                secure_socket_->lowest_layer().native_handle()))
+        {
+            ec = asio::error::would_block;
+            return 0;
+        }
+
         std::vector<asio::const_buffer> buffers;
         if(header_size > 0)
         {
@@ -15,6 +15,8 @@
 #include <fastdds/rtps/transport/TCPTransportInterface.h>
 #include <fastdds/rtps/transport/tcp/RTCPMessageManager.h>
 #include <rtps/transport/TCPSenderResource.hpp>
+#include <rtps/transport/tcp/TCPChecksum.hpp>
+#include <rtps/transport/tcp/TCPFramingBuffer.hpp>
 //#include "TCPSenderResource.hpp"
 #include <fastdds/dds/log/Log.hpp>
 #include <fastrtps/utils/IPLocator.h>
@@ -34,6 +36,12 @@
 #include <chrono>
 #include <thread>
 
+#if defined(__linux__)
+#include <sys/ioctl.h>
+#elif defined(__APPLE__)
+#include <sys/socket.h>
+#endif // if defined(__linux__)
+
 using namespace std;
 using namespace asio;
 
@@ -66,10 +74,13 @@ TCPTransportDescriptor::TCPTransportDescriptor()
     , logical_port_range(20)
     , logical_port_increment(2)
     , tcp_negotiation_timeout(s_default_tcp_negotitation_timeout)
+    , reactor_threads(0)
     , enable_tcp_nodelay(false)
+    , non_blocking_send(false)
     , wait_for_tcp_negotiation(false)
     , calculate_crc(true)
     , check_crc(true)
+    , use_crc32c(true)
     , apply_security(false)
 {
 }
@@ -83,10 +94,13 @@ TCPTransportDescriptor::TCPTransportDescriptor(const TCPTransportDescriptor& t)
     , logical_port_range(t.logical_port_range)
     , logical_port_increment(t.logical_port_increment)
     , tcp_negotiation_timeout(t.tcp_negotiation_timeout)
+    , reactor_threads(t.reactor_threads)
     , enable_tcp_nodelay(t.enable_tcp_nodelay)
+    , non_blocking_send(t.non_blocking_send)
     , wait_for_tcp_negotiation(t.wait_for_tcp_negotiation)
     , calculate_crc(t.calculate_crc)
     , check_crc(t.check_crc)
+    , use_crc32c(t.use_crc32c)
     , apply_security(t.apply_security)
     , tls_config(t.tls_config)
 {
@@ -107,10 +121,13 @@ TCPTransportDescriptor& TCPTransportDescriptor::operator=(const TCPTransportDesc
     logical_port_range = t.logical_port_range;
     logical_port_increment = t.logical_port_increment;
     tcp_negotiation_timeout = t.tcp_negotiation_timeout;
+    reactor_threads = t.reactor_threads;
     enable_tcp_nodelay = t.enable_tcp_nodelay;
+    non_blocking_send = t.non_blocking_send;
     wait_for_tcp_negotiation = t.wait_for_tcp_negotiation;
     calculate_crc = t.calculate_crc;
     check_crc = t.check_crc;
+    use_crc32c = t.use_crc32c;
     apply_security = t.apply_security;
     tls_config = t.tls_config;
     return *this;
@@ -179,11 +196,14 @@ void TCPTransportInterface::clean()
         }
     }
 
-    if (io_service_thread_)
+    if (!io_service_threads_.empty())
     {
         io_service_.stop();
-        io_service_thread_->join();
-        io_service_thread_ = nullptr;
+        for (auto& io_service_thread : io_service_threads_)
+        {
+            io_service_thread->join();
+        }
+        io_service_threads_.clear();
     }
 }
 
@@ -203,27 +223,20 @@ void TCPTransportInterface::bind_socket(
 bool TCPTransportInterface::check_crc(
         const TCPHeader &header,
         const octet *data,
-        uint32_t size) const
+        uint32_t size,
+        bool crc32c) const
 {
-    uint32_t crc(0);
-    for (uint32_t i = 0; i < size; ++i)
-    {
-        crc = RTCPMessageManager::addToCRC(crc, data[i]);
-    }
+    uint32_t crc = crc32c ? TCPChecksum::crc32c(data, size) : TCPChecksum::additive(data, size);
     return crc == header.crc;
 }
 
 void TCPTransportInterface::calculate_crc(
         TCPHeader &header,
         const octet *data,
-        uint32_t size) const
+        uint32_t size,
+        bool crc32c) const
 {
-    uint32_t crc(0);
-    for (uint32_t i = 0; i < size; ++i)
-    {
-        crc = RTCPMessageManager::addToCRC(crc, data[i]);
-    }
-    header.crc = crc;
+    header.crc = crc32c ? TCPChecksum::crc32c(data, size) : TCPChecksum::additive(data, size);
 }
 
 
@@ -301,13 +314,14 @@ void TCPTransportInterface::fill_rtcp_header(
         TCPHeader& header,
         const octet* send_buffer,
         uint32_t send_buffer_size,
-        uint16_t logical_port) const
+        uint16_t logical_port,
+        bool crc32c) const
 {
     header.length = send_buffer_size + static_cast<uint32_t>(TCPHeader::size());
     header.logical_port = logical_port;
     if (configuration()->calculate_crc)
     {
-        calculate_crc(header, send_buffer, send_buffer_size);
+        calculate_crc(header, send_buffer, send_buffer_size, crc32c);
     }
 }
 
@@ -389,7 +403,13 @@ bool TCPTransportInterface::init()
 #endif
         io_service_.run();
     };
-    io_service_thread_ = std::make_shared<std::thread>(ioServiceFunction);
+    io_service_threads_.push_back(std::make_shared<std::thread>(ioServiceFunction));
+
+    // With the reactor, the io_service also runs the reads of all the connections
+    for (uint32_t i = 1; i < configuration()->reactor_threads; ++i)
+    {
+        io_service_threads_.push_back(std::make_shared<std::thread>(ioServiceFunction));
+    }
 
     if (0 < configuration()->keep_alive_frequency_ms)
     {
@@ -721,14 +741,42 @@ void TCPTransportInterface::keep_alive()
     */
 }
 
-void TCPTransportInterface::perform_listen_operation(
-        std::weak_ptr<TCPChannelResource> channel_weak,
-        std::weak_ptr<RTCPMessageManager> rtcp_manager)
+void TCPTransportInterface::start_receiving(
+        const std::weak_ptr<TCPChannelResource>& channel_weak)
 {
-    Locator_t remote_locator;
-    uint16_t logicalPort(0);
-    std::shared_ptr<RTCPMessageManager> rtcp_message_manager;
+    std::weak_ptr<RTCPMessageManager> rtcp_manager_weak_ptr = rtcp_message_manager_;
+
+    // Reads on TLS connections block a thread of the io_service, so they are never done from the reactor threads
+    if (0 == configuration()->reactor_threads || configuration()->apply_security)
+    {
+        auto channel = channel_weak.lock();
+        if (channel)
+        {
+            channel->thread(std::thread(&TCPTransportInterface::perform_listen_operation, this,
+                        channel_weak, rtcp_manager_weak_ptr));
+        }
+        return;
+    }
+
     std::shared_ptr<TCPChannelResource> channel;
+    if (start_negotiation(channel_weak, rtcp_manager_weak_ptr, channel) && channel)
+    {
+        // A new buffer on every connection, so the reads of a previous one know they have to stop
+        auto buffer = std::make_shared<TCPFramingBuffer>(configuration()->maxMessageSize);
+        {
+            std::lock_guard<std::mutex> read_lock(channel->read_mutex_);
+            channel->framing_buffer_ = buffer;
+        }
+        async_receive(channel, rtcp_manager_weak_ptr, buffer);
+    }
+}
+
+bool TCPTransportInterface::start_negotiation(
+        const std::weak_ptr<TCPChannelResource>& channel_weak,
+        std::weak_ptr<RTCPMessageManager>& rtcp_manager,
+        std::shared_ptr<TCPChannelResource>& channel)
+{
+    std::shared_ptr<RTCPMessageManager> rtcp_message_manager;
     rtcp_message_manager = rtcp_manager.lock();
 
     // RTCP Control Message
@@ -751,8 +799,111 @@ void TCPTransportInterface::perform_listen_operation(
         std::unique_lock<std::mutex> lock(rtcp_message_manager_mutex_);
         rtcp_message_manager.reset();
         rtcp_message_manager_cv_.notify_one();
+        return true;
+    }
+
+    return false;
+}
+
+void TCPTransportInterface::async_receive(
+        std::shared_ptr<TCPChannelResource> channel,
+        std::weak_ptr<RTCPMessageManager> rtcp_manager,
+        std::shared_ptr<TCPFramingBuffer> buffer)
+{
+    // The handler keeps the channel and its buffer alive while the read is pending
+    bool started = channel->async_read_some(buffer->write_position(), buffer->free_space(),
+                    [this, channel, rtcp_manager, buffer](const asio::error_code& ec, std::size_t bytes_received)
+                    {
+                        on_bytes_received(channel, rtcp_manager, buffer, ec, bytes_received);
+                    });
+
+    if (!started)
+    {
+        logError(RTCP_MSG_IN, "Channel " << channel->locator() << " does not support asynchronous reads");
+        close_tcp_socket(channel);
+    }
+}
+
+void TCPTransportInterface::on_bytes_received(
+        std::shared_ptr<TCPChannelResource> channel,
+        std::weak_ptr<RTCPMessageManager> rtcp_manager,
+        std::shared_ptr<TCPFramingBuffer> buffer,
+        const asio::error_code& ec,
+        std::size_t bytes_received)
+{
+    if (ec)
+    {
+        if (ec != asio::error::operation_aborted)
+        {
+            logWarning(DEBUG, "Error reading TCP channel: " << ec.message());
+            close_tcp_socket(channel);
+        }
+        return;
+    }
+
+    buffer->commit(bytes_received);
+
+    // All the messages completed by this read are processed before reading again
+    TCPHeader tcp_header;
+    octet* body = nullptr;
+    uint32_t body_size = 0;
+    bool more = true;
+    while (more && TCPChannelResource::eConnectionStatus::eConnecting < channel->connection_status())
+    {
+        switch (buffer->next_message(tcp_header, body, body_size))
+        {
+            case TCPFramingBuffer::Result::MESSAGE:
+            {
+                logInfo(RTCP_MSG_IN, "Received RTCP MSG. Logical Port " << tcp_header.logical_port);
+                Locator_t remote_locator = channel->locator();
+                if (process_message(rtcp_manager, channel, tcp_header, body, body_size, remote_locator) &&
+                        0 < body_size &&
+                        TCPChannelResource::eConnectionStatus::eConnecting < channel->connection_status())
+                {
+                    deliver_message(channel, body, body_size, remote_locator);
+                }
+                break;
+            }
+            case TCPFramingBuffer::Result::TOO_BIG:
+                logError(RTCP_MSG_IN, "Size of incoming TCP message is bigger than buffer capacity: "
+                        << body_size << " vs. " << configuration()->maxMessageSize << ". "
+                        << "The full message will be dropped.");
+                break;
+            case TCPFramingBuffer::Result::BAD_HEADER:
+                logError(RTCP_MSG_IN, "Bad RTCP header identifier, closing connection.");
+                close_tcp_socket(channel);
+                return;
+            case TCPFramingBuffer::Result::NEED_MORE:
+                more = false;
+                break;
+        }
+    }
+
+    bool current_connection = false;
+    {
+        std::lock_guard<std::mutex> read_lock(channel->read_mutex_);
+        current_connection = channel->framing_buffer_ == buffer;
+    }
+
+    if (current_connection && TCPChannelResource::eConnectionStatus::eConnecting < channel->connection_status())
+    {
+        buffer->compact();
+        async_receive(channel, rtcp_manager, buffer);
     }
     else
+    {
+        logInfo(RTCP, "End receiving from " << channel->locator());
+    }
+}
+
+void TCPTransportInterface::perform_listen_operation(
+        std::weak_ptr<TCPChannelResource> channel_weak,
+        std::weak_ptr<RTCPMessageManager> rtcp_manager)
+{
+    Locator_t remote_locator;
+    std::shared_ptr<TCPChannelResource> channel;
+
+    if (!start_negotiation(channel_weak, rtcp_manager, channel))
     {
         return;
     }
@@ -769,26 +920,7 @@ void TCPTransportInterface::perform_listen_operation(
 
         if(TCPChannelResource::eConnectionStatus::eConnecting < channel->connection_status())
         {
-            // Processes the data through the CDR Message interface.
-            logicalPort = IPLocator::getLogicalPort(remote_locator);
-            std::unique_lock<std::mutex> scopedLock(sockets_map_mutex_);
-            auto it = receiver_resources_.find(logicalPort);
-            //TransportReceiverInterface* receiver = channel->GetMessageReceiver(logicalPort);
-            if (it != receiver_resources_.end())
-            {
-                TransportReceiverInterface* receiver = it->second.first;
-                ReceiverInUseCV* receiver_in_use = it->second.second;
-                receiver_in_use->in_use = true;
-                scopedLock.unlock();
-                receiver->OnDataReceived(msg.buffer, msg.length, channel->locator(), remote_locator);
-                scopedLock.lock();
-                receiver_in_use->in_use = false;
-                receiver_in_use->cv.notify_one();
-            }
-            else
-            {
-                logWarning(RTCP, "Received Message, but no TransportReceiverInterface attached: " << logicalPort);
-            }
+            deliver_message(channel, msg.buffer, msg.length, remote_locator);
         }
     }
 
@@ -820,6 +952,93 @@ bool TCPTransportInterface::read_body(
     return true;
 }
 
+bool TCPTransportInterface::process_message(
+        std::weak_ptr<RTCPMessageManager>& rtcp_manager,
+        std::shared_ptr<TCPChannelResource>& channel,
+        const TCPHeader& tcp_header,
+        octet* body,
+        uint32_t body_size,
+        Locator_t& remote_locator)
+{
+    bool success = true;
+
+    if (configuration()->check_crc
+            && !check_crc(tcp_header, body, body_size, channel->crc32c()))
+    {
+        logWarning(RTCP_MSG_IN, "Bad TCP header CRC");
+    }
+
+    if (tcp_header.logical_port == 0)
+    {
+        std::shared_ptr<RTCPMessageManager> rtcp_message_manager;
+        if(TCPChannelResource::eConnectionStatus::eDisconnected != channel->connection_status())
+
+        {
+            std::unique_lock<std::mutex> lock(rtcp_message_manager_mutex_);
+            rtcp_message_manager = rtcp_manager.lock();
+        }
+
+        if (rtcp_message_manager)
+        {
+            // The channel is not going to be deleted because we lock it for reading.
+            ResponseCode responseCode = rtcp_message_manager->processRTCPMessage(
+                    channel, body, body_size);
+
+            if (responseCode != RETCODE_OK)
+            {
+                close_tcp_socket(channel);
+            }
+            success = false;
+
+            std::unique_lock<std::mutex> lock(rtcp_message_manager_mutex_);
+            rtcp_message_manager.reset();
+            rtcp_message_manager_cv_.notify_one();
+        }
+        else
+        {
+            success = false;
+            close_tcp_socket(channel);
+        }
+
+    }
+    else
+    {
+        IPLocator::setLogicalPort(remote_locator, tcp_header.logical_port);
+        logInfo(RTCP_MSG_IN, "[RECEIVE] From: " << remote_locator \
+                << " - " << body_size << " bytes.");
+    }
+
+    return success;
+}
+
+void TCPTransportInterface::deliver_message(
+        std::shared_ptr<TCPChannelResource>& channel,
+        const octet* data,
+        uint32_t size,
+        const Locator_t& remote_locator)
+{
+    // Processes the data through the CDR Message interface.
+    uint16_t logicalPort = IPLocator::getLogicalPort(remote_locator);
+    std::unique_lock<std::mutex> scopedLock(sockets_map_mutex_);
+    auto it = receiver_resources_.find(logicalPort);
+    //TransportReceiverInterface* receiver = channel->GetMessageReceiver(logicalPort);
+    if (it != receiver_resources_.end())
+    {
+        TransportReceiverInterface* receiver = it->second.first;
+        ReceiverInUseCV* receiver_in_use = it->second.second;
+        receiver_in_use->in_use = true;
+        scopedLock.unlock();
+        receiver->OnDataReceived(data, size, channel->locator(), remote_locator);
+        scopedLock.lock();
+        receiver_in_use->in_use = false;
+        receiver_in_use->cv.notify_one();
+    }
+    else
+    {
+        logWarning(RTCP, "Received Message, but no TransportReceiverInterface attached: " << logicalPort);
+    }
+}
+
 /**
 * On TCP, we must receive the header (14 Bytes) and then,
 * the rest of the message, whose length is on the header.
@@ -908,51 +1127,8 @@ bool TCPTransportInterface::Receive(
 
                     if (success)
                     {
-                        if (configuration()->check_crc
-                                && !check_crc(tcp_header, receive_buffer, receive_buffer_size))
-                        {
-                            logWarning(RTCP_MSG_IN, "Bad TCP header CRC");
-                        }
-
-                        if (tcp_header.logical_port == 0)
-                        {
-                            std::shared_ptr<RTCPMessageManager> rtcp_message_manager;
-                            if(TCPChannelResource::eConnectionStatus::eDisconnected != channel->connection_status())
-
-                            {
-                                std::unique_lock<std::mutex> lock(rtcp_message_manager_mutex_);
-                                rtcp_message_manager = rtcp_manager.lock();
-                            }
-
-                            if (rtcp_message_manager)
-                            {
-                                // The channel is not going to be deleted because we lock it for reading.
-                                ResponseCode responseCode = rtcp_message_manager->processRTCPMessage(
-                                        channel, receive_buffer, body_size);
-
-                                if (responseCode != RETCODE_OK)
-                                {
-                                    close_tcp_socket(channel);
-                                }
-                                success = false;
-
-                                std::unique_lock<std::mutex> lock(rtcp_message_manager_mutex_);
-                                rtcp_message_manager.reset();
-                                rtcp_message_manager_cv_.notify_one();
-                            }
-                            else
-                            {
-                                success = false;
-                                close_tcp_socket(channel);
-                            }
-
-                        }
-                        else
-                        {
-                            IPLocator::setLogicalPort(remote_locator, tcp_header.logical_port);
-                            logInfo(RTCP_MSG_IN, "[RECEIVE] From: " << remote_locator \
-                                    << " - " << receive_buffer_size << " bytes.");
-                        }
+                        success = process_message(rtcp_manager, channel, tcp_header, receive_buffer,
+                                        receive_buffer_size, remote_locator);
                     }
                     // Error message already shown by read_body method.
                 }
@@ -1069,7 +1245,7 @@ bool TCPTransportInterface::send(
             if (channel->is_logical_port_opened(logical_port))
             {
                 TCPHeader tcp_header;
-                fill_rtcp_header(tcp_header, send_buffer, send_buffer_size, logical_port);
+                fill_rtcp_header(tcp_header, send_buffer, send_buffer_size, logical_port, channel->crc32c());
 
                 {
                     asio::error_code ec;
@@ -1080,7 +1256,14 @@ bool TCPTransportInterface::send(
                         send_buffer_size,
                         ec);
 
-                    if (sent != static_cast<uint32_t>(TCPHeader::size() + send_buffer_size) || ec)
+                    if (asio::error::would_block == ec)
+                    {
+                        // Discarded by non_blocking_send, the peer is not reading fast enough
+                        logInfo(RTCP, "Message to " << IPLocator::to_string(remote_locator) <<
+                                " discarded, the send buffer of the socket is full");
+                        success = false;
+                    }
+                    else if (sent != static_cast<uint32_t>(TCPHeader::size() + send_buffer_size) || ec)
                     {
                         logWarning(DEBUG, "Failed to send RTCP message (" << sent << " of " <<
                                 TCPHeader::size() + send_buffer_size << " b): " << ec.message());
@@ -1109,6 +1292,32 @@ bool TCPTransportInterface::send(
     return success;
 }
 
+bool TCPTransportInterface::check_socket_send_buffer(
+        size_t msg_size,
+        const asio::ip::tcp::socket::native_handle_type& socket_native_handle) const
+{
+    int bytes_in_send_queue = 0;
+
+#if defined(__linux__)
+    if (ioctl(socket_native_handle, TIOCOUTQ, &bytes_in_send_queue) == -1)
+    {
+        bytes_in_send_queue = 0;
+    }
+#elif defined(__APPLE__)
+    socklen_t option_size = sizeof(bytes_in_send_queue);
+    if (getsockopt(socket_native_handle, SOL_SOCKET, SO_NWRITE, &bytes_in_send_queue, &option_size) == -1)
+    {
+        bytes_in_send_queue = 0;
+    }
+#else
+    // The bytes queued on the socket cannot be queried, so the message is always written
+    (void)msg_size;
+    (void)socket_native_handle;
+#endif // if defined(__linux__)
+
+    return static_cast<size_t>(bytes_in_send_queue) + msg_size <= configuration()->sendBufferSize;
+}
+
 void TCPTransportInterface::select_locators(LocatorSelector& selector) const
 {
     fastrtps::ResourceLimitedVector<LocatorSelectorEntry*>& entries =  selector.transport_starts();
@@ -1155,10 +1364,7 @@ void TCPTransportInterface::SocketAccepted(
             }
 
             channel->set_options(configuration());
-            std::weak_ptr<TCPChannelResource> channel_weak_ptr = channel;
-            std::weak_ptr<RTCPMessageManager> rtcp_manager_weak_ptr = rtcp_message_manager_;
-            channel->thread(std::thread(&TCPTransportInterface::perform_listen_operation, this,
-                        channel_weak_ptr, rtcp_manager_weak_ptr));
+            start_receiving(channel);
 
             logInfo(RTCP, " Accepted connection (local: " << IPLocator::to_string(locator)
                     << ", remote: " << channel->remote_endpoint().address()
@@ -1244,10 +1450,7 @@ void TCPTransportInterface::SocketConnected(
                 {
                     channel->change_status(TCPChannelResource::eConnectionStatus::eConnected);
                     channel->set_options(configuration());
-
-                    std::weak_ptr<RTCPMessageManager> rtcp_manager_weak_ptr = rtcp_message_manager_;
-                    channel->thread(std::thread(&TCPTransportInterface::perform_listen_operation, this,
-                                channel_weak_ptr, rtcp_manager_weak_ptr));
+                    start_receiving(channel_weak_ptr);
                 }
             }
             else
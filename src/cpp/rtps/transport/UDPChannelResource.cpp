@@ -17,6 +17,15 @@
 #include <fastdds/rtps/transport/UDPChannelResource.h>
 #include <fastdds/rtps/messages/MessageReceiver.h>
 
+#include <cerrno>
+#include <cstring>
+#include <vector>
+
+#ifdef __linux__
+#include <sys/socket.h>
+#include <sys/uio.h>
+#endif // ifdef __linux__
+
 namespace eprosima {
 namespace fastdds {
 namespace rtps {
@@ -25,13 +34,106 @@ using Locator_t = fastrtps::rtps::Locator_t;
 using octet = fastrtps::rtps::octet;
 using Log = fastdds::dds::Log;
 
+#ifdef __linux__
+
+/**
+ * Ring of preallocated receive buffers filled with a single recvmmsg call.
+ */
+class UDPChannelResource::BatchReceiver
+{
+public:
+
+    BatchReceiver(
+            uint32_t batch_size,
+            uint32_t max_msg_size)
+        : buffers_(static_cast<size_t>(batch_size) * max_msg_size)
+        , headers_(batch_size)
+        , iovecs_(batch_size)
+        , addresses_(batch_size)
+    {
+        for (uint32_t i = 0; i < batch_size; ++i)
+        {
+            iovecs_[i].iov_base = &buffers_[static_cast<size_t>(i) * max_msg_size];
+            iovecs_[i].iov_len = max_msg_size;
+
+            msghdr& header = headers_[i].msg_hdr;
+            header.msg_iov = &iovecs_[i];
+            header.msg_iovlen = 1;
+            header.msg_name = &addresses_[i];
+        }
+    }
+
+    /**
+     * Blocks until at least one datagram is available, and then reads the ones already queued on the socket.
+     * @param fd Native handle of the socket.
+     * @return Number of datagrams received, or -1 on error.
+     */
+    int receive(
+            int fd)
+    {
+        for (mmsghdr& header : headers_)
+        {
+            header.msg_hdr.msg_namelen = sizeof(sockaddr_storage);
+            header.msg_hdr.msg_controllen = 0;
+            header.msg_hdr.msg_flags = 0;
+            header.msg_len = 0;
+        }
+
+        return recvmmsg(fd, headers_.data(), static_cast<unsigned int>(headers_.size()), MSG_WAITFORONE, nullptr);
+    }
+
+    octet* data(
+            size_t index)
+    {
+        return static_cast<octet*>(iovecs_[index].iov_base);
+    }
+
+    uint32_t length(
+            size_t index) const
+    {
+        return static_cast<uint32_t>(headers_[index].msg_len);
+    }
+
+    bool sender_endpoint(
+            size_t index,
+            asio::ip::udp::endpoint& endpoint) const
+    {
+        const msghdr& header = headers_[index].msg_hdr;
+        if (header.msg_namelen > endpoint.capacity())
+        {
+            return false;
+        }
+
+        memcpy(endpoint.data(), header.msg_name, header.msg_namelen);
+        endpoint.resize(header.msg_namelen);
+        return true;
+    }
+
+private:
+
+    std::vector<octet> buffers_;
+    std::vector<mmsghdr> headers_;
+    std::vector<iovec> iovecs_;
+    std::vector<sockaddr_storage> addresses_;
+};
+
+#else
+
+// Batched reception is only supported on platforms with recvmmsg
+class UDPChannelResource::BatchReceiver
+{
+};
+
+#endif // ifdef __linux__
+
 UDPChannelResource::UDPChannelResource(
         UDPTransportInterface* transport,
         eProsimaUDPSocket& socket,
         uint32_t maxMsgSize,
         const Locator_t& locator,
         const std::string& sInterface,
-        TransportReceiverInterface* receiver)
+        TransportReceiverInterface* receiver,
+        uint32_t receive_batch_size)
     : ChannelResource(maxMsgSize)
     , message_receiver_(receiver)
     , socket_(moveSocket(socket))
@@ -39,6 +141,16 @@ UDPChannelResource::UDPChannelResource(
     , interface_(sInterface)
     , transport_(transport)
 {
+    if (receive_batch_size > 1)
+    {
+#ifdef __linux__
+        batch_receiver_.reset(new BatchReceiver(receive_batch_size, maxMsgSize));
+#else
+        logWarning(RTPS_MSG_IN,
+                "Batched reception is not supported on this platform. Receiving one datagram at a time.");
+#endif // ifdef __linux__
+    }
+
     thread(std::thread(&UDPChannelResource::perform_listen_operation, this, locator));
 }
 
@@ -49,6 +161,13 @@ UDPChannelResource::~UDPChannelResource()
 
 void UDPChannelResource::perform_listen_operation(Locator_t input_locator)
 {
+    if (batch_receiver_)
+    {
+        perform_batch_listen_operation(input_locator);
+        message_receiver(nullptr);
+        return;
+    }
+
     Locator_t remote_locator;
 
     while (alive())
@@ -74,6 +193,60 @@ void UDPChannelResource::perform_listen_operation(Locator_t input_locator)
     message_receiver(nullptr);
 }
 
+void UDPChannelResource::perform_batch_listen_operation(
+        const Locator_t& input_locator)
+{
+#ifdef __linux__
+    Locator_t remote_locator;
+
+    while (alive())
+    {
+        // Blocking receive of all the datagrams queued on the socket.
+        int received = batch_receiver_->receive(socket()->native_handle());
+        if (received < 0)
+        {
+            if (errno != EINTR && alive())
+            {
+                logWarning(RTPS_MSG_IN, "Error receiving data: " << strerror(errno) << " - " << message_receiver()
+                    << " (" << this << ")");
+            }
+            continue;
+        }
+
+        for (int i = 0; i < received; ++i)
+        {
+            octet* data = batch_receiver_->data(i);
+            uint32_t length = batch_receiver_->length(i);
+            // Close message is not necessary anymore but it's left here for back compatibility with versions older
+            // than 1.8.1
+            if (length == 0 || (length == 13 && memcmp(data, "EPRORTPSCLOSE", 13) == 0))
+            {
+                continue;
+            }
+
+            asio::ip::udp::endpoint sender_endpoint;
+            if (!batch_receiver_->sender_endpoint(i, sender_endpoint))
+            {
+                continue;
+            }
+            transport_->endpoint_to_locator(sender_endpoint, remote_locator);
+
+            // Processes the data through the CDR Message interface.
+            if (message_receiver() != nullptr)
+            {
+                message_receiver()->OnDataReceived(data, length, input_locator, remote_locator);
+            }
+            else if (alive())
+            {
+                logWarning(RTPS_MSG_IN, "Received Message, but no receiver attached");
+            }
+        }
+    }
+#else
+    (void)input_locator;
+#endif // ifdef __linux__
+}
+
 bool UDPChannelResource::Receive(
         octet* receive_buffer,
         uint32_t receive_buffer_capacity,
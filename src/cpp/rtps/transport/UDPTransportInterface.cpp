@@ -25,6 +25,12 @@
 #include <algorithm>
 #include <chrono>
 
+#ifdef __linux__
+#include <cerrno>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#endif // ifdef __linux__
+
 using namespace std;
 using namespace asio;
 
@@ -64,6 +70,9 @@ UDPTransportDescriptor::UDPTransportDescriptor()
 UDPTransportDescriptor::UDPTransportDescriptor(const UDPTransportDescriptor& t)
     : SocketTransportDescriptor(t)
     , m_output_udp_socket(t.m_output_udp_socket)
+    , non_blocking_send(t.non_blocking_send)
+    , receive_batch_size(t.receive_batch_size)
+    , batched_send(t.batched_send)
 {
 }
 
@@ -226,7 +235,8 @@ UDPChannelResource* UDPTransportInterface::CreateInputChannelResource(
     eProsimaUDPSocket unicastSocket = OpenAndBindInputSocket(sInterface,
                                                              IPLocator::getPhysicalPort(locator), is_multicast);
     UDPChannelResource* p_channel_resource = new UDPChannelResource(this, unicastSocket, maxMsgSize, locator,
-                                                                    sInterface, receiver);
+                                                                    sInterface, receiver,
+                                                                    configuration()->receive_batch_size);
     return p_channel_resource;
 }
 
@@ -454,6 +464,14 @@ bool UDPTransportInterface::send(
     auto time_out = std::chrono::duration_cast<std::chrono::microseconds>(
         max_blocking_time_point - std::chrono::steady_clock::now());
 
+#ifdef __linux__
+    if (configuration()->batched_send)
+    {
+        return send_batch(send_buffer, send_buffer_size, socket, it, *destination_locators_end,
+                   only_multicast_purpose, time_out);
+    }
+#endif // ifdef __linux__
+
     while (it != *destination_locators_end)
     {
         if (IsLocatorSupported(*it))
@@ -535,6 +553,131 @@ bool UDPTransportInterface::send(
     return success;
 }
 
+#ifdef __linux__
+
+//! Maximum number of destinations submitted on each sendmmsg call
+static constexpr size_t max_send_batch = 64;
+
+int UDPTransportInterface::send_mmsg(
+        int fd,
+        mmsghdr* headers,
+        unsigned int count)
+{
+    return sendmmsg(fd, headers, count, 0);
+}
+
+bool UDPTransportInterface::send_datagrams(
+        int fd,
+        mmsghdr* headers,
+        size_t count)
+{
+    bool ret = true;
+    size_t sent = 0;
+
+    while (sent < count)
+    {
+        int result = send_mmsg(fd, headers + sent, static_cast<unsigned int>(count - sent));
+        if (result < 0)
+        {
+            if (EINTR == errno)
+            {
+                continue;
+            }
+
+            if ((EAGAIN == errno) || (EWOULDBLOCK == errno))
+            {
+                // Only the datagram which would block is dropped, as on the single destination path, so the
+                // rest of the destinations are still sent to
+                logWarning(RTPS_MSG_OUT, "UDP send would have blocked. Packet is dropped.");
+                ++sent;
+                continue;
+            }
+
+            // Skip the datagram which could not be sent
+            logWarning(RTPS_MSG_OUT, "Error sending data: " << strerror(errno));
+            ret = false;
+            ++sent;
+            continue;
+        }
+
+        sent += static_cast<size_t>(result);
+    }
+
+    return ret;
+}
+
+bool UDPTransportInterface::send_batch(
+        const octet* send_buffer,
+        uint32_t send_buffer_size,
+        eProsimaUDPSocket& socket,
+        fastrtps::rtps::LocatorsIterator& destination_locators_begin,
+        fastrtps::rtps::LocatorsIterator& destination_locators_end,
+        bool only_multicast_purpose,
+        const std::chrono::microseconds& timeout)
+{
+    if (send_buffer_size > configuration()->sendBufferSize)
+    {
+        return false;
+    }
+
+    int fd = getSocketPtr(socket)->native_handle();
+    struct timeval timeStruct;
+    timeStruct.tv_sec = 0;
+    timeStruct.tv_usec = timeout.count() > 0 ? timeout.count() : 0;
+    setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, reinterpret_cast<const char*>(&timeStruct), sizeof(timeStruct));
+
+    // All the datagrams share the same buffer
+    iovec data;
+    data.iov_base = const_cast<octet*>(send_buffer);
+    data.iov_len = send_buffer_size;
+
+    asio::ip::udp::endpoint endpoints[max_send_batch];
+    mmsghdr headers[max_send_batch];
+    size_t pending = 0;
+    bool ret = true;
+
+    fastrtps::rtps::LocatorsIterator& it = destination_locators_begin;
+    while (it != destination_locators_end)
+    {
+        if (IsLocatorSupported(*it))
+        {
+            if (IPLocator::isMulticast(*it) || !only_multicast_purpose)
+            {
+                endpoints[pending] = generate_endpoint(*it, IPLocator::getPhysicalPort(*it));
+
+                mmsghdr& header = headers[pending];
+                memset(&header, 0, sizeof(header));
+                header.msg_hdr.msg_name = endpoints[pending].data();
+                header.msg_hdr.msg_namelen = static_cast<socklen_t>(endpoints[pending].size());
+                header.msg_hdr.msg_iov = &data;
+                header.msg_hdr.msg_iovlen = 1;
+
+                if (++pending == max_send_batch)
+                {
+                    ret &= send_datagrams(fd, headers, pending);
+                    pending = 0;
+                }
+            }
+            else
+            {
+                // Same result as sending to a single destination
+                ret = false;
+            }
+        }
+
+        ++it;
+    }
+
+    if (pending > 0)
+    {
+        ret &= send_datagrams(fd, headers, pending);
+    }
+
+    return ret;
+}
+
+#endif // ifdef __linux__
+
 /**
  * Invalidate all selector entries containing certain multicast locator.
  *
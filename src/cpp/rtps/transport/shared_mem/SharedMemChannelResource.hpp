@@ -37,11 +37,13 @@ public:
             const fastrtps::rtps::Locator_t& locator,
             TransportReceiverInterface* receiver,
             const std::string& dump_file,
-            bool should_init_thread = true)
+            bool should_init_thread = true,
+            bool keep_received_buffers = false)
         : ChannelResource()
         , message_receiver_(receiver)
         , listener_(listener)
         , only_multicast_purpose_(false)
+        , keep_received_buffers_(keep_received_buffers)
         , locator_(locator)
     {
         if (!dump_file.empty())
@@ -143,10 +145,12 @@ private:
             // Processes the data through the CDR Message interface.
             if (message_receiver() != nullptr)
             {
+                // Readers may keep the buffer instead of copying the payloads
                 message_receiver()->OnDataReceived(
                     static_cast<fastrtps::rtps::octet*>(message->data()),
                     message->size(),
-                    input_locator, remote_locator);
+                    input_locator, remote_locator,
+                    keep_received_buffers_ ? message : std::shared_ptr<SharedMemManager::Buffer>());
             }
             else if (alive())
             {
@@ -204,6 +208,7 @@ protected:
 private:
 
     bool only_multicast_purpose_;
+    bool keep_received_buffers_;
     fastrtps::rtps::Locator_t locator_;
 
     SharedMemChannelResource(
@@ -330,6 +330,11 @@ public:
             buffer_node_->dec_enqueued_count(validity_id);
         }
 
+        BufferNode* buffer_node() const
+        {
+            return buffer_node_;
+        }
+
     private:
 
         std::shared_ptr<SharedMemSegment> segment_;
@@ -477,6 +482,34 @@ public:
             return new_buffer;
         }
 
+        /**
+         * Reduces the size of a buffer which has not been enqueued yet, releasing the memory it does not need.
+         * @param buffer Buffer allocated on this segment.
+         * @param size   Size the buffer should have. Should not be greater than its current size.
+         * @return true when the buffer has the new size, false when it keeps the old one.
+         */
+        bool shrink_buffer(
+                const std::shared_ptr<Buffer>& buffer,
+                uint32_t size)
+        {
+            std::lock_guard<std::mutex> lock(alloc_mutex_);
+
+            BufferNode* buffer_node = std::static_pointer_cast<SharedMemBuffer>(buffer)->buffer_node();
+            if (size >= buffer_node->data_size)
+            {
+                return size == buffer_node->data_size;
+            }
+
+            if (!segment_->shrink_in_place(buffer->data(), buffer_node->data_size, size))
+            {
+                return false;
+            }
+
+            free_bytes_ += buffer_node->data_size - size;
+            buffer_node->data_size = size;
+            return true;
+        }
+
         uint64_t mem_size()
         {
             return segment_->mem_size();
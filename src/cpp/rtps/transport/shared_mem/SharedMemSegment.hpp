@@ -130,6 +130,25 @@ public:
         return *segment_;
     }
 
+    /**
+     * Reduces the size of a block allocated on the segment, without moving it.
+     * @param address  Address of the block.
+     * @param size     Current size of the block.
+     * @param new_size Size the block should have.
+     * @return true when the rest of the block has been released, false when the block is kept as it was.
+     */
+    bool shrink_in_place(
+            void* address,
+            uint32_t size,
+            uint32_t new_size)
+    {
+        managed_shared_memory_type::size_type received_size = new_size;
+        char* reuse = static_cast<char*>(address);
+        return nullptr != segment_->allocation_command<char>(
+            boost::interprocess::shrink_in_place | boost::interprocess::nothrow_allocation, size, received_size,
+            reuse);
+    }
+
     static void remove(
             const std::string& name)
     {
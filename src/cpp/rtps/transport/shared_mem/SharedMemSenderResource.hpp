@@ -29,6 +29,7 @@ public:
     SharedMemSenderResource(
             SharedMemTransport& transport)
         : fastrtps::rtps::SenderResource(transport.kind())
+        , transport_(transport)
     {
         // Implementation functions are bound to the right transport parameters
         clean_up = []()
@@ -71,6 +72,12 @@ public:
         return returned_resource;
     }
 
+    //! Transport messages are sent through.
+    SharedMemTransport& transport() const
+    {
+        return transport_;
+    }
+
 private:
 
     SharedMemSenderResource() = delete;
@@ -80,6 +87,8 @@ private:
 
     SharedMemSenderResource& operator=(
             const SenderResource&) = delete;
+
+    SharedMemTransport& transport_;
 };
 
 } // namespace rtps
@@ -319,7 +319,9 @@ SharedMemChannelResource* SharedMemTransport::CreateInputChannelResource(
             open_mode)->create_listener(),
         locator,
         receiver,
-        configuration_.rtps_dump_file());
+        configuration_.rtps_dump_file(),
+        true,
+        configuration_.keep_received_buffers());
 }
 
 bool SharedMemTransport::OpenOutputChannel(
@@ -402,6 +404,62 @@ std::shared_ptr<SharedMemManager::Buffer> SharedMemTransport::copy_to_shared_buf
     return shared_buffer;
 }
 
+std::shared_ptr<SharedMemManager::Buffer> SharedMemTransport::loan_buffer(
+        uint32_t max_size,
+        const std::chrono::steady_clock::time_point& max_blocking_time_point)
+{
+    assert(shared_mem_segment_);
+
+    std::shared_ptr<SharedMemManager::Buffer> buffer;
+    try
+    {
+        buffer = shared_mem_segment_->alloc_buffer(max_size, max_blocking_time_point);
+    }
+    catch (const std::exception& e)
+    {
+        // The caller will serialize the message on its own buffer
+        logInfo(RTPS_TRANSPORT_SHM, "Cannot loan a buffer: " << e.what());
+        (void)e;
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> guard(loaned_buffers_mutex_);
+    loaned_buffers_.push_back(buffer);
+    return buffer;
+}
+
+void SharedMemTransport::return_loan(
+        const std::shared_ptr<SharedMemManager::Buffer>& buffer)
+{
+    std::lock_guard<std::mutex> guard(loaned_buffers_mutex_);
+    auto it = std::find(loaned_buffers_.begin(), loaned_buffers_.end(), buffer);
+    if (it != loaned_buffers_.end())
+    {
+        loaned_buffers_.erase(it);
+    }
+}
+
+std::shared_ptr<SharedMemManager::Buffer> SharedMemTransport::find_loaned_buffer(
+        const octet* send_buffer,
+        uint32_t send_buffer_size)
+{
+    std::lock_guard<std::mutex> guard(loaned_buffers_mutex_);
+    for (const std::shared_ptr<SharedMemManager::Buffer>& buffer : loaned_buffers_)
+    {
+        if (buffer->data() == send_buffer)
+        {
+            // When the unused space cannot be released, the message is copied to a buffer of its size
+            if (shared_mem_segment_->shrink_buffer(buffer, send_buffer_size))
+            {
+                return buffer;
+            }
+            break;
+        }
+    }
+
+    return nullptr;
+}
+
 bool SharedMemTransport::send(
         const octet* send_buffer,
         uint32_t send_buffer_size,
@@ -421,7 +479,11 @@ bool SharedMemTransport::send(
         {
             if (IsLocatorSupported(*it))
             {
-                // Only copy the first time
+                // Only copy the first time, and only when the message has not been serialized on the segment
+                if (shared_buffer == nullptr)
+                {
+                    shared_buffer = find_loaned_buffer(send_buffer, send_buffer_size);
+                }
                 if (shared_buffer == nullptr)
                 {
                     shared_buffer = copy_to_shared_buffer(send_buffer, send_buffer_size, max_blocking_time_point);
@@ -22,6 +22,8 @@
 #include <rtps/transport/shared_mem/SharedMemLog.hpp>
 
 #include <map>
+#include <mutex>
+#include <vector>
 
 namespace eprosima {
 namespace fastdds {
@@ -187,6 +189,26 @@ public:
         return (std::numeric_limits<uint32_t>::max)();
     }
 
+    /**
+     * Allocates a buffer on the segment of this transport, where the caller can serialize a message.
+     * When send() is called with the data of a loaned buffer, the buffer is enqueued on the destination ports
+     * without copying the message, after releasing the space the message does not use.
+     * @param max_size Maximum size of the message.
+     * @param max_blocking_time_point Future timepoint where the allocation should end.
+     * @return The buffer, or nullptr when the segment has no room for it.
+     */
+    std::shared_ptr<SharedMemManager::Buffer> loan_buffer(
+            uint32_t max_size,
+            const std::chrono::steady_clock::time_point& max_blocking_time_point);
+
+    /**
+     * Gives back a buffer obtained with loan_buffer().
+     * The buffer is released once the ports it has been sent to do not reference it.
+     * @param buffer Buffer to give back.
+     */
+    void return_loan(
+            const std::shared_ptr<SharedMemManager::Buffer>& buffer);
+
 private:
 
     //! Constructor with no descriptor is necessary for implementations derived from this class.
@@ -216,6 +238,11 @@ private:
 
     std::shared_ptr<PacketsLog<SHMPacketFileConsumer>> packet_logger_;
 
+    //! Buffers loaned to be filled by the caller of send().
+    std::vector<std::shared_ptr<SharedMemManager::Buffer>> loaned_buffers_;
+
+    std::mutex loaned_buffers_mutex_;
+
     friend class SharedMemChannelResource;
 
 protected:
@@ -233,6 +260,11 @@ protected:
 
 private:
 
+    //! Finds the loaned buffer holding a message, and shrinks it to the size of the message.
+    std::shared_ptr<SharedMemManager::Buffer> find_loaned_buffer(
+            const fastrtps::rtps::octet* send_buffer,
+            uint32_t send_buffer_size);
+
     std::shared_ptr<SharedMemManager::Buffer> copy_to_shared_buffer(
             const fastrtps::rtps::octet* send_buffer,
             uint32_t send_buffer_size,
@@ -38,6 +38,7 @@ SharedMemTransportDescriptor::SharedMemTransportDescriptor()
     , port_queue_capacity_(shm_default_port_queue_capacity)
     , healthy_check_timeout_ms_(shm_default_healthy_check_timeout_ms)
     , rtps_dump_file_("")
+    , keep_received_buffers_(false)
 {
     maxMessageSize = s_maximumMessageSize;
 }
@@ -49,6 +50,7 @@ SharedMemTransportDescriptor::SharedMemTransportDescriptor(
     , port_queue_capacity_(t.port_queue_capacity_)
     , healthy_check_timeout_ms_(t.healthy_check_timeout_ms_)
     , rtps_dump_file_(t.rtps_dump_file_)
+    , keep_received_buffers_(t.keep_received_buffers_)
 {
     maxMessageSize = t.max_message_size();
 }
@@ -144,7 +144,19 @@ bool RTCPMessageManager::sendData(
 
     fillHeaders(kind, transaction_id, ctrlHeader, header, payload, code);
 
-    RTPSMessageCreator::addCustomContent(&msg, (octet*)&header, TCPHeader::size());
+    // Bind messages are checked before the checksum is negotiated, so they always carry the additive one
+    bool bind_message = BIND_CONNECTION_REQUEST == kind || BIND_CONNECTION_RESPONSE == kind;
+    if (BIND_CONNECTION_REQUEST == kind)
+    {
+        ctrlHeader.crc32c(mTransport->configuration()->use_crc32c);
+    }
+    else if (BIND_CONNECTION_RESPONSE == kind)
+    {
+        ctrlHeader.crc32c(channel->crc32c());
+    }
+
+    // The TCP header is written once the CRC of the rest of the message is known
+    msg.pos = msg.length = static_cast<uint32_t>(TCPHeader::size());
     RTPSMessageCreator::addCustomContent(&msg, (octet*)&ctrlHeader, TCPControlMsgHeader::size());
     if (code != nullptr)
     {
@@ -157,6 +169,13 @@ bool RTCPMessageManager::sendData(
         RTPSMessageCreator::addCustomContent(&msg, payload->data, payload->length); // Data
     }
 
+    if (mTransport->configuration()->calculate_crc)
+    {
+        mTransport->calculate_crc(header, &msg.buffer[TCPHeader::size()],
+            msg.length - static_cast<uint32_t>(TCPHeader::size()), !bind_message && channel->crc32c());
+    }
+    memcpy(msg.buffer, &header, TCPHeader::size());
+
     return sendMessage(channel, msg) > 0;
 }
 
@@ -214,45 +233,7 @@ void RTCPMessageManager::fillHeaders(
     retCtrlHeader.endianess(fastrtps::rtps::DEFAULT_ENDIAN); // Override "false" endianess set on the switch
     header.logical_port = 0; // This is a control message
     header.length = static_cast<uint32_t>(retCtrlHeader.length() + TCPHeader::size());
-
-    // Finally, calculate the CRC
-
-    uint32_t crc = 0;
-    if (alive() && mTransport->configuration()->calculate_crc)
-    {
-        octet* it = (octet*)&retCtrlHeader;
-        for (size_t i = 0; i < TCPControlMsgHeader::size(); ++i)
-        {
-            crc = addToCRC(crc, it[i]);
-        }
-        if (respCode != nullptr)
-        {
-            it = (octet*)respCode;
-            for (int i = 0; i < 4; ++i)
-            {
-                crc = addToCRC(crc, it[i]);
-            }
-        }
-        if (payload != nullptr)
-        {
-            octet* pay = (octet*)&(payload->encapsulation);
-            for (uint32_t i = 0; i < 2; ++i)
-            {
-                crc = addToCRC(crc, pay[i]);
-            }
-            pay = (octet*)&(payload->length);
-            for (uint32_t i = 0; i < 4; ++i)
-            {
-                crc = addToCRC(crc, pay[i]);
-            }
-            for (uint32_t i = 0; i < payload->length; ++i)
-            {
-                crc = addToCRC(crc, payload->data[i]);
-            }
-        }
-    }
-    header.crc = crc;
-    //logInfo(RTCP, "Send (CRC= " << header.crc << ")");
+    header.crc = 0; // Calculated by sendData over the serialized message
 
     // LOG
     /*
@@ -324,6 +305,7 @@ TCPTransactionId RTCPMessageManager::sendConnectionRequest(
     logInfo(RTCP_MSG, "Send [BIND_CONNECTION_REQUEST] PhysicalPort: " << IPLocator::getPhysicalPort(locator));
     //logError(DEBUG, "Sending Connection Request with locator: " << IPLocator::to_string(request.transportLocator()));
     channel->change_status(TCPChannelResource::eConnectionStatus::eWaitingForBindResponse);
+    channel->crc32c_ = false; // Negotiated again on every connection
     TCPTransactionId id = getTransactionId();
     bool success = sendData(channel, BIND_CONNECTION_REQUEST, id, &payload);
     if (!success)
@@ -431,7 +413,8 @@ ResponseCode RTCPMessageManager::processBindConnectionRequest(
         std::shared_ptr<TCPChannelResource>& channel,
         const ConnectionRequest_t &request,
         const TCPTransactionId &transaction_id,
-        Locator_t &localLocator)
+        Locator_t &localLocator,
+        bool crc32c_offered)
 {
     BindConnectionResponse_t response;
 
@@ -473,6 +456,8 @@ ResponseCode RTCPMessageManager::processBindConnectionRequest(
         mTransport->bind_socket(channel);
     }
 
+    // The response tells the client whether the following messages use CRC-32C
+    channel->crc32c_ = crc32c_offered && mTransport->configuration()->use_crc32c;
     sendData(channel, BIND_CONNECTION_RESPONSE, transaction_id, &payload, code);
 
     return RETCODE_OK;
@@ -710,7 +695,8 @@ ResponseCode RTCPMessageManager::processRTCPMessage(
             "LogicalPort: " << IPLocator::getLogicalPort(request.transportLocator())
             << ", Physical remote: " << IPLocator::getPhysicalPort(request.transportLocator()));
 
-        responseCode = processBindConnectionRequest(channel, request, controlHeader.transaction_id(), myLocator);
+        responseCode = processBindConnectionRequest(channel, request, controlHeader.transaction_id(), myLocator,
+                controlHeader.crc32c());
     }
     break;
     case BIND_CONNECTION_RESPONSE:
@@ -729,6 +715,8 @@ ResponseCode RTCPMessageManager::processRTCPMessage(
 
         if (respCode == RETCODE_OK || respCode == RETCODE_EXISTING_CONNECTION)
         {
+            // Servers not supporting CRC-32C never set the flag, so the additive checksum is kept with them
+            channel->crc32c_ = controlHeader.crc32c() && mTransport->configuration()->use_crc32c;
             std::unique_lock<std::recursive_mutex> scopedLock(channel->pending_logical_mutex_);
             if (!channel->pending_logical_output_ports_.empty())
             {
@@ -0,0 +1,241 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <rtps/transport/tcp/TCPChecksum.hpp>
+
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define FASTDDS_CRC32C_X86
+#include <nmmintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define FASTDDS_CRC32C_TARGET
+#else
+#define FASTDDS_CRC32C_TARGET __attribute__((target("sse4.2")))
+#endif // if defined(_MSC_VER)
+#elif defined(__ARM_FEATURE_CRC32)
+#define FASTDDS_CRC32C_ARM
+#include <arm_acle.h>
+#endif // if defined(__x86_64__) || defined(_M_X64)
+
+namespace eprosima {
+namespace fastdds {
+namespace rtps {
+
+using octet = fastrtps::rtps::octet;
+
+namespace {
+
+using Crc32cFunction = uint32_t (*)(
+    uint32_t crc,
+    const octet* data,
+    size_t size);
+
+//! Slice-by-8 tables of the reflected Castagnoli polynomial.
+struct Crc32cTables
+{
+    uint32_t table[8][256];
+
+    Crc32cTables()
+    {
+        for (uint32_t i = 0; i < 256; ++i)
+        {
+            uint32_t crc = i;
+            for (int bit = 0; bit < 8; ++bit)
+            {
+                crc = (crc >> 1) ^ (0x82F63B78u & (0u - (crc & 1u)));
+            }
+            table[0][i] = crc;
+        }
+
+        for (uint32_t i = 0; i < 256; ++i)
+        {
+            for (int slice = 1; slice < 8; ++slice)
+            {
+                uint32_t previous = table[slice - 1][i];
+                table[slice][i] = (previous >> 8) ^ table[0][previous & 0xFF];
+            }
+        }
+    }
+
+};
+
+const Crc32cTables& crc32c_tables()
+{
+    static const Crc32cTables tables;
+    return tables;
+}
+
+uint32_t crc32c_slice_by_8(
+        uint32_t crc,
+        const octet* data,
+        size_t size)
+{
+    const uint32_t (&t)[8][256] = crc32c_tables().table;
+
+    while (size >= 8)
+    {
+        // Bytes are combined explicitly, so the result does not depend on the endianness of the host
+        crc ^= static_cast<uint32_t>(data[0]) | (static_cast<uint32_t>(data[1]) << 8) |
+                (static_cast<uint32_t>(data[2]) << 16) | (static_cast<uint32_t>(data[3]) << 24);
+        crc = t[7][crc & 0xFF] ^ t[6][(crc >> 8) & 0xFF] ^ t[5][(crc >> 16) & 0xFF] ^ t[4][crc >> 24] ^
+                t[3][data[4]] ^ t[2][data[5]] ^ t[1][data[6]] ^ t[0][data[7]];
+        data += 8;
+        size -= 8;
+    }
+
+    while (size > 0)
+    {
+        crc = (crc >> 8) ^ t[0][(crc ^ *data) & 0xFF];
+        ++data;
+        --size;
+    }
+
+    return crc;
+}
+
+#if defined(FASTDDS_CRC32C_X86)
+
+FASTDDS_CRC32C_TARGET uint32_t crc32c_sse42(
+        uint32_t crc,
+        const octet* data,
+        size_t size)
+{
+    uint64_t crc64 = crc;
+    while (size >= 8)
+    {
+        uint64_t word;
+        memcpy(&word, data, sizeof(word));
+        crc64 = _mm_crc32_u64(crc64, word);
+        data += 8;
+        size -= 8;
+    }
+
+    uint32_t crc32 = static_cast<uint32_t>(crc64);
+    while (size > 0)
+    {
+        crc32 = _mm_crc32_u8(crc32, *data);
+        ++data;
+        --size;
+    }
+
+    return crc32;
+}
+
+bool cpu_has_sse42()
+{
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 1);
+    return 0 != (info[2] & (1 << 20));
+#else
+    return 0 != __builtin_cpu_supports("sse4.2");
+#endif // if defined(_MSC_VER)
+}
+
+Crc32cFunction select_crc32c()
+{
+    return cpu_has_sse42() ? crc32c_sse42 : crc32c_slice_by_8;
+}
+
+#elif defined(FASTDDS_CRC32C_ARM)
+
+uint32_t crc32c_armv8(
+        uint32_t crc,
+        const octet* data,
+        size_t size)
+{
+    while (size >= 8)
+    {
+        uint64_t word;
+        memcpy(&word, data, sizeof(word));
+        crc = __crc32cd(crc, word);
+        data += 8;
+        size -= 8;
+    }
+
+    while (size > 0)
+    {
+        crc = __crc32cb(crc, *data);
+        ++data;
+        --size;
+    }
+
+    return crc;
+}
+
+Crc32cFunction select_crc32c()
+{
+    return crc32c_armv8;
+}
+
+#else
+
+Crc32cFunction select_crc32c()
+{
+    return crc32c_slice_by_8;
+}
+
+#endif // if defined(FASTDDS_CRC32C_X86)
+
+Crc32cFunction crc32c_function()
+{
+    static const Crc32cFunction function = select_crc32c();
+    return function;
+}
+
+} // namespace
+
+uint32_t TCPChecksum::additive(
+        const octet* data,
+        size_t size)
+{
+    // Carries are folded at the end, which gives the same result as folding them on every byte
+    uint64_t sum = 0;
+    for (size_t i = 0; i < size; ++i)
+    {
+        sum += data[i];
+    }
+
+    while (0 != (sum >> 32))
+    {
+        sum = (sum & 0xFFFFFFFFu) + (sum >> 32);
+    }
+
+    return static_cast<uint32_t>(sum);
+}
+
+uint32_t TCPChecksum::crc32c(
+        const octet* data,
+        size_t size)
+{
+    return ~crc32c_function()(0xFFFFFFFFu, data, size);
+}
+
+uint32_t TCPChecksum::crc32c_software(
+        const octet* data,
+        size_t size)
+{
+    return ~crc32c_slice_by_8(0xFFFFFFFFu, data, size);
+}
+
+bool TCPChecksum::crc32c_hardware_available()
+{
+    return crc32c_function() != crc32c_slice_by_8;
+}
+
+} // namespace rtps
+} // namespace fastdds
+} // namespace eprosima
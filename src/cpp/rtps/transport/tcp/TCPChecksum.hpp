@@ -0,0 +1,68 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _FASTDDS_TCP_CHECKSUM_HPP_
+#define _FASTDDS_TCP_CHECKSUM_HPP_
+
+#include <fastdds/rtps/common/Types.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace eprosima {
+namespace fastdds {
+namespace rtps {
+
+/**
+ * Checksums of the RTPS messages framed on a TCP connection.
+ *
+ * The checksum stored on the TCPHeader is the additive one, unless both peers announce support for CRC-32C
+ * when the connection is bound.
+ */
+class TCPChecksum
+{
+public:
+
+    /**
+     * Sum of the bytes with end-around carry.
+     * It is the checksum of the first versions of the TCP transport, and gives the same result as calling
+     * RTCPMessageManager::addToCRC for every byte, just much faster.
+     */
+    static uint32_t additive(
+            const fastrtps::rtps::octet* data,
+            size_t size);
+
+    /**
+     * CRC-32C (Castagnoli).
+     * Computed with the CRC32 instruction of the CPU when it is available, which is detected at runtime, and with a
+     * slice-by-8 table otherwise.
+     */
+    static uint32_t crc32c(
+            const fastrtps::rtps::octet* data,
+            size_t size);
+
+    //! CRC-32C computed without the help of the CPU.
+    static uint32_t crc32c_software(
+            const fastrtps::rtps::octet* data,
+            size_t size);
+
+    //! Whether crc32c uses the CRC32 instruction of the CPU.
+    static bool crc32c_hardware_available();
+};
+
+} // namespace rtps
+} // namespace fastdds
+} // namespace eprosima
+
+#endif // _FASTDDS_TCP_CHECKSUM_HPP_
@@ -0,0 +1,97 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <rtps/transport/tcp/TCPFramingBuffer.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+namespace eprosima {
+namespace fastdds {
+namespace rtps {
+
+TCPFramingBuffer::TCPFramingBuffer(
+        uint32_t max_body_size)
+    : buffer_(max_body_size + TCPHeader::size())
+    , max_body_size_(max_body_size)
+    , begin_(0)
+    , end_(0)
+    , pending_discard_(0)
+{
+}
+
+TCPFramingBuffer::Result TCPFramingBuffer::next_message(
+        TCPHeader& header,
+        fastrtps::rtps::octet*& body,
+        uint32_t& body_size)
+{
+    if (0 < pending_discard_)
+    {
+        size_t discarded = (std::min)(pending_discard_, end_ - begin_);
+        begin_ += discarded;
+        pending_discard_ -= discarded;
+        if (0 < pending_discard_)
+        {
+            return Result::NEED_MORE;
+        }
+    }
+
+    size_t available = end_ - begin_;
+    if (available < TCPHeader::size())
+    {
+        return Result::NEED_MORE;
+    }
+
+    memcpy(&header, &buffer_[begin_], TCPHeader::size());
+    if (header.rtcp[0] != 'R' || header.rtcp[1] != 'T' || header.rtcp[2] != 'C' || header.rtcp[3] != 'P' ||
+            header.length < TCPHeader::size())
+    {
+        return Result::BAD_HEADER;
+    }
+
+    body_size = header.length - static_cast<uint32_t>(TCPHeader::size());
+    if (body_size > max_body_size_)
+    {
+        begin_ += TCPHeader::size();
+        pending_discard_ = body_size;
+        return Result::TOO_BIG;
+    }
+
+    if (available < header.length)
+    {
+        return Result::NEED_MORE;
+    }
+
+    body = &buffer_[begin_ + TCPHeader::size()];
+    begin_ += header.length;
+    return Result::MESSAGE;
+}
+
+void TCPFramingBuffer::compact()
+{
+    if (begin_ == end_)
+    {
+        begin_ = end_ = 0;
+    }
+    else if (0 < begin_)
+    {
+        memmove(&buffer_[0], &buffer_[begin_], end_ - begin_);
+        end_ -= begin_;
+        begin_ = 0;
+    }
+}
+
+} // namespace rtps
+} // namespace fastdds
+} // namespace eprosima
@@ -0,0 +1,106 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _FASTDDS_TCP_FRAMING_BUFFER_HPP_
+#define _FASTDDS_TCP_FRAMING_BUFFER_HPP_
+
+#include <fastdds/rtps/transport/tcp/RTCPHeader.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace eprosima {
+namespace fastdds {
+namespace rtps {
+
+/**
+ * Splits the byte stream of a TCP connection into the messages framed by a TCPHeader.
+ *
+ * Each read stores as many bytes as the socket has available, which may contain several messages, or only a part
+ * of one. The complete messages are taken with next_message, and the partial one is kept for the next read.
+ */
+class TCPFramingBuffer
+{
+public:
+
+    enum class Result
+    {
+        //! A complete message was extracted.
+        MESSAGE,
+        //! More bytes have to be read to complete the next message.
+        NEED_MORE,
+        //! The body of the next message is bigger than the maximum. Its bytes are skipped as they arrive.
+        TOO_BIG,
+        //! The bytes received are not a TCPHeader. The stream cannot be resynchronized.
+        BAD_HEADER
+    };
+
+    /**
+     * @param max_body_size Maximum size of the body of a message. The buffer always has room for a complete
+     * message of this size.
+     */
+    explicit TCPFramingBuffer(
+            uint32_t max_body_size);
+
+    //! Position where the next read has to store the bytes received.
+    fastrtps::rtps::octet* write_position()
+    {
+        return &buffer_[end_];
+    }
+
+    //! Number of bytes the next read can store.
+    size_t free_space() const
+    {
+        return buffer_.size() - end_;
+    }
+
+    //! Makes available the bytes a read stored on write_position.
+    void commit(
+            size_t bytes)
+    {
+        end_ += bytes;
+    }
+
+    /**
+     * Extracts the next message of the buffer.
+     * @param [out] header Header of the message, when the result is MESSAGE or TOO_BIG.
+     * @param [out] body Body of the message, valid until compact is called, when the result is MESSAGE.
+     * @param [out] body_size Size of the body, when the result is MESSAGE or TOO_BIG.
+     */
+    Result next_message(
+            TCPHeader& header,
+            fastrtps::rtps::octet*& body,
+            uint32_t& body_size);
+
+    //! Moves the bytes of the partial message to the beginning of the buffer, making room for the next read.
+    void compact();
+
+private:
+
+    std::vector<fastrtps::rtps::octet> buffer_;
+    uint32_t max_body_size_;
+    //! Position of the first byte not extracted yet.
+    size_t begin_;
+    //! Position after the last byte read.
+    size_t end_;
+    //! Bytes of a message too big which have not been received yet.
+    size_t pending_discard_;
+};
+
+} // namespace rtps
+} // namespace fastdds
+} // namespace eprosima
+
+#endif // _FASTDDS_TCP_FRAMING_BUFFER_HPP_
@@ -0,0 +1,479 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file ChangeForReaderRing.cpp
+ */
+
+#include <fastdds/rtps/writer/ChangeForReaderRing.h>
+
+#include <algorithm>
+#include <bitset>
+#include <cassert>
+#include <cstring>
+
+namespace eprosima {
+namespace fastrtps {
+namespace rtps {
+
+static inline size_t ones(
+        uint64_t bits)
+{
+    return std::bitset<64>(bits).count();
+}
+
+//! Smallest valid number of slots spanning a number of sequence numbers.
+static size_t slots_for(
+        uint64_t span)
+{
+    size_t slots = 64;
+    while (slots < span)
+    {
+        slots <<= 1;
+    }
+    return slots;
+}
+
+static bool change_less_than_sequence(
+        const ChangeForReader_t& change,
+        uint64_t seq)
+{
+    return change.getSequenceNumber().to64long() < seq;
+}
+
+static bool sequence_less_than_change(
+        uint64_t seq,
+        const ChangeForReader_t& change)
+{
+    return seq < change.getSequenceNumber().to64long();
+}
+
+ChangeForReaderRing::ChangeForReaderRing(
+        const ResourceLimitedContainerConfig& allocation)
+    : head_(0)
+    , origin_(0)
+    , last_(0)
+    , size_(0)
+    , max_slots_(slots_for((std::min)(allocation.maximum, static_cast<size_t>(max_window_size))))
+    , max_size_(allocation.maximum)
+{
+    if (0 < allocation.initial)
+    {
+        size_t slots = (std::min)(slots_for(allocation.initial), max_slots_);
+        changes_.resize(slots);
+        bits_.resize(slots >> 6);
+
+        // On fixed size configurations, nothing is allocated afterwards
+        if (allocation.initial == allocation.maximum)
+        {
+            overflow_.reserve(allocation.maximum);
+        }
+    }
+    clear();
+}
+
+void ChangeForReaderRing::clear()
+{
+    if (!bits_.empty())
+    {
+        memset(&bits_[0], 0, bits_.size() * sizeof(StatusBits));
+    }
+    head_ = 0;
+    size_ = 0;
+    overflow_.clear();
+    std::fill(status_count_, status_count_ + num_status, 0);
+}
+
+bool ChangeForReaderRing::insert(
+        const ChangeForReader_t& change)
+{
+    if (size() >= max_size_)
+    {
+        return false;
+    }
+
+    uint64_t seq = change.getSequenceNumber().to64long();
+    if (empty())
+    {
+        if (changes_.empty())
+        {
+            grow(1);
+        }
+        origin_ = seq;
+        last_ = seq;
+    }
+    else if (seq < origin_)
+    {
+        // Move the beginning of the ring back a number of words, keeping the changes on their slots
+        uint64_t distance = ((origin_ - seq + 63) >> 6) << 6;
+        uint64_t span = last_ - origin_ + 1 + distance;
+        if (distance > origin_ || span > max_slots_)
+        {
+            // Sequence numbers close to zero, or too far from the last change, so origin_ is moved to the change.
+            // The last changes may be moved to overflow_.
+            rebuild(seq, last_ - seq + 1);
+        }
+        else
+        {
+            if (span > changes_.size())
+            {
+                grow(span);
+            }
+            head_ = (head_ - static_cast<size_t>(distance >> 6)) & (bits_.size() - 1);
+            origin_ -= distance;
+        }
+    }
+    else if (is_overflow(seq))
+    {
+        assert(nullptr == find_in_overflow(seq));
+
+        // Usually the last one
+        auto it = std::upper_bound(overflow_.begin(), overflow_.end(), seq, sequence_less_than_change);
+        overflow_.insert(it, change);
+        ++status_count_[change.getStatus()];
+        return true;
+    }
+    else if (seq - origin_ >= changes_.size())
+    {
+        grow(seq - origin_ + 1);
+    }
+
+    assert(nullptr == find(change.getSequenceNumber()));
+
+    place(change);
+    ++status_count_[change.getStatus()];
+    return true;
+}
+
+ChangeForReader_t* ChangeForReaderRing::find(
+        const SequenceNumber_t& seq_num)
+{
+    return const_cast<ChangeForReader_t*>(static_cast<const ChangeForReaderRing*>(this)->find(seq_num));
+}
+
+const ChangeForReader_t* ChangeForReaderRing::find(
+        const SequenceNumber_t& seq_num) const
+{
+    uint64_t seq = seq_num.to64long();
+    if (empty() || seq < origin_)
+    {
+        return nullptr;
+    }
+
+    if (seq > last_)
+    {
+        return find_in_overflow(seq);
+    }
+
+    uint64_t position = seq - origin_;
+    if (0 == (bits_[word(position)].present & (1ull << (position & 63))))
+    {
+        return nullptr;
+    }
+
+    return &changes_[slot(position)];
+}
+
+const ChangeForReader_t* ChangeForReaderRing::find_in_overflow(
+        uint64_t seq) const
+{
+    auto it = std::lower_bound(overflow_.begin(), overflow_.end(), seq, change_less_than_sequence);
+    if (it == overflow_.end() || it->getSequenceNumber().to64long() != seq)
+    {
+        return nullptr;
+    }
+
+    return &(*it);
+}
+
+void ChangeForReaderRing::erase(
+        const SequenceNumber_t& seq_num)
+{
+    assert(nullptr != find(seq_num));
+
+    uint64_t seq = seq_num.to64long();
+    if (seq > last_)
+    {
+        auto it = std::lower_bound(overflow_.begin(), overflow_.end(), seq, change_less_than_sequence);
+        --status_count_[it->getStatus()];
+        overflow_.erase(it);
+        return;
+    }
+
+    uint64_t position = seq - origin_;
+    remove_bits(bits_[word(position)], 1ull << (position & 63));
+
+    if (0 < size_ && seq == last_)
+    {
+        // Look for the previous change, a word at a time
+        uint64_t word_position = position & ~63ull;
+        uint64_t bits = bits_[word(word_position)].present & ((1ull << (position & 63)) - 1);
+        while (0 == bits)
+        {
+            word_position -= 64;
+            bits = bits_[word(word_position)].present;
+        }
+
+        uint32_t bit = 63;
+        while (0 == (bits & (1ull << bit)))
+        {
+            --bit;
+        }
+        last_ = origin_ + word_position + bit;
+    }
+
+    refill();
+}
+
+void ChangeForReaderRing::erase_before(
+        const SequenceNumber_t& seq_num)
+{
+    uint64_t seq = seq_num.to64long();
+    if (empty() || seq <= origin_)
+    {
+        return;
+    }
+
+    auto overflow_end = std::lower_bound(overflow_.begin(), overflow_.end(), seq, change_less_than_sequence);
+    for (auto it = overflow_.begin(); it != overflow_end; ++it)
+    {
+        --status_count_[it->getStatus()];
+    }
+    overflow_.erase(overflow_.begin(), overflow_end);
+
+    uint64_t end = (std::min)(seq, last_ + 1) - origin_;
+    for (uint64_t word_position = 0; word_position < end; word_position += 64)
+    {
+        uint64_t mask = ~0ull;
+        if (end - word_position < 64)
+        {
+            mask = (1ull << (end - word_position)) - 1;
+        }
+        remove_bits(bits_[word(word_position)], mask);
+    }
+
+    refill();
+}
+
+void ChangeForReaderRing::set_status(
+        ChangeForReader_t& change,
+        ChangeForReaderStatus_t status)
+{
+    uint64_t seq = change.getSequenceNumber().to64long();
+    --status_count_[change.getStatus()];
+    ++status_count_[status];
+
+    if (seq <= last_)
+    {
+        uint64_t position = seq - origin_;
+        assert(&change == &changes_[slot(position)]);
+
+        uint64_t mask = 1ull << (position & 63);
+        StatusBits& bits = bits_[word(position)];
+        bits.status[change.getStatus()] &= ~mask;
+        bits.status[status] |= mask;
+    }
+    else
+    {
+        assert(&change == find_in_overflow(seq));
+    }
+
+    change.setStatus(status);
+}
+
+bool ChangeForReaderRing::convert_status(
+        ChangeForReaderStatus_t previous,
+        ChangeForReaderStatus_t next)
+{
+    if (!has_status(previous))
+    {
+        return false;
+    }
+
+    if (previous == next)
+    {
+        return true;
+    }
+
+    uint64_t end = last_ - origin_ + 1;
+    for (uint64_t word_position = 0; word_position < end; word_position += 64)
+    {
+        StatusBits& bits = bits_[word(word_position)];
+        uint64_t changes = bits.status[previous];
+        bits.status[previous] = 0;
+        bits.status[next] |= changes;
+        while (0 != changes)
+        {
+            changes_[slot(word_position + trailing_zeros(changes))].setStatus(next);
+            changes &= changes - 1;
+        }
+    }
+
+    for (ChangeForReader_t& change : overflow_)
+    {
+        if (change.getStatus() == previous)
+        {
+            change.setStatus(next);
+        }
+    }
+
+    status_count_[next] += status_count_[previous];
+    status_count_[previous] = 0;
+    return true;
+}
+
+void ChangeForReaderRing::grow(
+        uint64_t span)
+{
+    rebuild(origin_, span);
+}
+
+void ChangeForReaderRing::rebuild(
+        uint64_t new_origin,
+        uint64_t span)
+{
+    span = (std::min)(span, static_cast<uint64_t>(max_slots_));
+    size_t new_size = slots_for((std::max)(span, static_cast<uint64_t>(changes_.size())));
+    std::vector<ChangeForReader_t> new_changes(new_size);
+    std::vector<StatusBits> new_bits(new_size >> 6);
+    memset(&new_bits[0], 0, new_bits.size() * sizeof(StatusBits));
+
+    // Changes which do not fit go to the front of overflow_, as they are before the ones already there
+    std::vector<ChangeForReader_t> moved;
+    size_t new_count = 0;
+    uint64_t new_last = new_origin;
+
+    // Move every change to its slot on the new ring, which starts at its first word
+    for (size_t i = 0; i < bits_.size(); ++i)
+    {
+        uint64_t word_position = static_cast<uint64_t>(i) << 6;
+        const StatusBits& bits = bits_[word(word_position)];
+        uint64_t present = bits.present;
+        while (0 != present)
+        {
+            uint32_t bit = trailing_zeros(present);
+            uint64_t position = word_position + bit;
+            uint64_t new_position = origin_ + position - new_origin;
+            if (new_position >= new_size)
+            {
+                moved.push_back(changes_[slot(position)]);
+            }
+            else
+            {
+                uint64_t new_mask = 1ull << (new_position & 63);
+                StatusBits& target = new_bits[static_cast<size_t>(new_position >> 6)];
+                target.present |= new_mask;
+                for (size_t status = 0; status < num_status; ++status)
+                {
+                    if (0 != (bits.status[status] & (1ull << bit)))
+                    {
+                        target.status[status] |= new_mask;
+                    }
+                }
+                new_changes[static_cast<size_t>(new_position)] = changes_[slot(position)];
+                new_last = (std::max)(new_last, new_origin + new_position);
+                ++new_count;
+            }
+            present &= present - 1;
+        }
+    }
+
+    changes_.swap(new_changes);
+    bits_.swap(new_bits);
+    head_ = 0;
+    origin_ = new_origin;
+    if (!moved.empty())
+    {
+        overflow_.insert(overflow_.begin(), moved.begin(), moved.end());
+        size_ = new_count;
+        last_ = new_last;
+    }
+}
+
+void ChangeForReaderRing::place(
+        const ChangeForReader_t& change)
+{
+    uint64_t seq = change.getSequenceNumber().to64long();
+    uint64_t position = seq - origin_;
+    uint64_t mask = 1ull << (position & 63);
+    StatusBits& bits = bits_[word(position)];
+    bits.present |= mask;
+    bits.status[change.getStatus()] |= mask;
+    changes_[slot(position)] = change;
+    ++size_;
+    last_ = (std::max)(last_, seq);
+}
+
+void ChangeForReaderRing::refill()
+{
+    if (0 == size_)
+    {
+        head_ = 0;
+        if (overflow_.empty())
+        {
+            return;
+        }
+
+        // Anchor the ring on the first change of overflow_
+        origin_ = overflow_.front().getSequenceNumber().to64long();
+        last_ = origin_;
+    }
+    else
+    {
+        release_empty_words();
+    }
+
+    auto it = overflow_.begin();
+    for (; it != overflow_.end(); ++it)
+    {
+        uint64_t seq = it->getSequenceNumber().to64long();
+        if (is_overflow(seq))
+        {
+            break;
+        }
+
+        if (seq - origin_ >= changes_.size())
+        {
+            grow(seq - origin_ + 1);
+        }
+        place(*it);
+    }
+    overflow_.erase(overflow_.begin(), it);
+}
+
+void ChangeForReaderRing::remove_bits(
+        StatusBits& bits,
+        uint64_t mask)
+{
+    size_ -= ones(bits.present & mask);
+    bits.present &= ~mask;
+    for (size_t status = 0; status < num_status; ++status)
+    {
+        status_count_[status] -= ones(bits.status[status] & mask);
+        bits.status[status] &= ~mask;
+    }
+}
+
+void ChangeForReaderRing::release_empty_words()
+{
+    while (0 == bits_[head_].present)
+    {
+        head_ = (head_ + 1) & (bits_.size() - 1);
+        origin_ += 64;
+    }
+}
+
+} /* namespace rtps */
+} /* namespace fastrtps */
+} /* namespace eprosima */
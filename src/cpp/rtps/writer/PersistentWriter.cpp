@@ -71,6 +71,12 @@ void PersistentWriter::remove_persistent_change(
     persistence_->remove_writer_change_from_storage(persistence_guid_, *change);
 }
 
+bool PersistentWriter::wait_for_all_stored(
+        const std::chrono::steady_clock::time_point& max_blocking_time)
+{
+    return persistence_->wait_for_all_stored(max_blocking_time);
+}
+
 } // namespace rtps
 } // namespace fastrtps
 } // namespace eprosima
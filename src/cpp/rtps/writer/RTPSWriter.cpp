@@ -23,6 +23,7 @@
 #include <fastdds/dds/log/Log.hpp>
 #include <rtps/participant/RTPSParticipantImpl.h>
 #include <rtps/flowcontrol/FlowController.h>
+#include <rtps/flowcontrol/SchedulingFlowController.h>
 
 #include <mutex>
 
@@ -42,6 +43,7 @@ RTPSWriter::RTPSWriter(
     , mp_listener(listen)
     , is_async_(att.mode == SYNCHRONOUS_WRITER ? false : true)
     , m_separateSendingEnabled(false)
+    , scheduling_flow_controller_(nullptr)
     , locator_selector_(att.matched_readers_allocation)
     , all_remote_readers_(att.matched_readers_allocation)
     , all_remote_participants_(att.matched_readers_allocation)
@@ -49,9 +51,22 @@ RTPSWriter::RTPSWriter(
     , liveliness_lease_duration_(att.liveliness_lease_duration)
     , liveliness_announcement_period_(att.liveliness_announcement_period)
     , next_{nullptr}
+    , async_thread_index_(0)
 {
     mp_history->mp_writer = this;
     mp_history->mp_mutex = &mp_mutex;
+    impl->async_thread().register_writer(this, att.endpoint.properties);
+
+    // The participant has already checked the flow controller exists
+    if (!att.flow_controller_name.empty())
+    {
+        scheduling_flow_controller_ = impl->find_flow_controller(att.flow_controller_name);
+        if (scheduling_flow_controller_ != nullptr)
+        {
+            scheduling_flow_controller_->register_writer(this, att.endpoint.properties);
+        }
+    }
+
     logInfo(RTPS_WRITER, "RTPSWriter created");
 }
 
@@ -65,6 +80,42 @@ RTPSWriter::~RTPSWriter()
     mp_history->mp_mutex = nullptr;
 }
 
+void RTPSWriter::wake_up_async_thread()
+{
+    if (scheduling_flow_controller_ != nullptr)
+    {
+        scheduling_flow_controller_->wake_up(this);
+    }
+    else
+    {
+        mp_RTPSParticipant->async_thread().wake_up(this);
+    }
+}
+
+void RTPSWriter::wake_up_async_thread(
+        const std::chrono::time_point<std::chrono::steady_clock>& max_blocking_time)
+{
+    if (scheduling_flow_controller_ != nullptr)
+    {
+        scheduling_flow_controller_->wake_up(this);
+    }
+    else
+    {
+        mp_RTPSParticipant->async_thread().wake_up(this, max_blocking_time);
+    }
+}
+
+void RTPSWriter::unregister_async_thread()
+{
+    // The flow controller is kept, so wake ups from now on are ignored instead of reaching the participant thread
+    if (scheduling_flow_controller_ != nullptr)
+    {
+        scheduling_flow_controller_->unregister_writer(this);
+    }
+
+    mp_RTPSParticipant->async_thread().unregister_writer(this);
+}
+
 CacheChange_t* RTPSWriter::new_change(
         const std::function<uint32_t()>& dataCdrSerializedSize,
         ChangeKind_t changeKind,
@@ -227,6 +278,20 @@ const std::vector<GUID_t>& RTPSWriter::remote_guids() const
     return all_remote_readers_;
 }
 
+bool RTPSWriter::destinations_are_of_kind(
+        int32_t kind) const
+{
+    bool any_locator = false;
+    bool all_of_kind = true;
+    locator_selector_.for_each([&any_locator, &all_of_kind, kind](const Locator_t& locator)
+            {
+                any_locator = true;
+                all_of_kind &= (locator.kind == kind);
+            });
+
+    return any_locator && all_of_kind;
+}
+
 bool RTPSWriter::send(
         CDRMessage_t* message,
         std::chrono::steady_clock::time_point& max_blocking_time_point) const
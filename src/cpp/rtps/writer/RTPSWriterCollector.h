@@ -24,6 +24,7 @@
 #include <fastdds/rtps/common/CacheChange.h>
 
 #include <vector>
+#include <set>
 #include <cassert>
 
 namespace eprosima {
@@ -219,7 +219,7 @@ void ReaderProxy::add_change(
         return;
     }
 
-    if (changes_for_reader_.push_back(change) == nullptr)
+    if (!changes_for_reader_.insert(change))
     {
         // This should never happen
         logError(RTPS_WRITER, "Error adding change " << change.getSequenceNumber() << " to reader proxy " << \
@@ -242,8 +242,8 @@ bool ReaderProxy::change_is_acked(
         return true;
     }
 
-    ChangeConstIterator chit = find_change(seq_num);
-    if (chit == changes_for_reader_.end())
+    const ChangeForReader_t* chit = changes_for_reader_.find(seq_num);
+    if (chit == nullptr)
     {
         // There is a hole in changes_for_reader_
         // This means a change was removed.
@@ -263,8 +263,8 @@ bool ReaderProxy::change_is_unsent(
         return false;
     }
 
-    ChangeConstIterator chit = find_change(seq_num);
-    if (chit == changes_for_reader_.end())
+    const ChangeForReader_t* chit = changes_for_reader_.find(seq_num);
+    if (chit == nullptr)
     {
         // There is a hole in changes_for_reader_
         // This means a change was removed.
@@ -286,16 +286,14 @@ void ReaderProxy::acked_changes_set(
 
     if (seq_num > changes_low_mark_)
     {
-        ChangeIterator chit = find_change(seq_num, false);
         // continue advancing until next change is not acknowledged
-        while (chit != changes_for_reader_.end()
-                && chit->getSequenceNumber() == future_low_mark
-                && chit->getStatus() == ACKNOWLEDGED)
+        const ChangeForReader_t* chit = changes_for_reader_.find(future_low_mark);
+        while (chit != nullptr && chit->getStatus() == ACKNOWLEDGED)
         {
-            ++chit;
             ++future_low_mark;
+            chit = changes_for_reader_.find(future_low_mark);
         }
-        changes_for_reader_.erase(changes_for_reader_.begin(), chit);
+        changes_for_reader_.erase_before(future_low_mark);
     }
     else
     {
@@ -316,36 +314,20 @@ void ReaderProxy::acked_changes_set(
                 }
                 future_low_mark = current_sequence;
 
-                bool should_sort = false;
                 for (; current_sequence <= changes_low_mark_; ++current_sequence)
                 {
-                    // Skip all consecutive changes already in the collection
-                    ChangeConstIterator it = find_change(current_sequence);
-                    while ( it != changes_for_reader_.end() &&
-                            current_sequence <= changes_low_mark_ &&
-                            it->getSequenceNumber() == current_sequence)
-                    {
-                        ++current_sequence;
-                        ++it;
-                    }
-
-                    if (current_sequence <= changes_low_mark_)
+                    // Skip changes already in the collection. The ring keeps them sorted by sequence number.
+                    if (changes_for_reader_.find(current_sequence) == nullptr)
                     {
                         CacheChange_t* change = nullptr;
                         if (writer_->mp_history->get_change(current_sequence, writer_->getGuid(), &change))
                         {
-                            should_sort = true;
                             ChangeForReader_t cr(change);
                             cr.setStatus(UNACKNOWLEDGED);
-                            changes_for_reader_.push_back(cr);
+                            changes_for_reader_.insert(cr);
                         }
                     }
                 }
-                // Keep changes sorted by sequence number
-                if (should_sort)
-                {
-                    std::sort(changes_for_reader_.begin(), changes_for_reader_.end(), ChangeForReaderCmp());
-                }
             }
             else if (!is_local_reader())
             {
@@ -363,10 +345,10 @@ bool ReaderProxy::requested_changes_set(
 
     seq_num_set.for_each([&](SequenceNumber_t sit)
             {
-                ChangeIterator chit = find_change(sit, true);
-                if (chit != changes_for_reader_.end() && UNACKNOWLEDGED == chit->getStatus())
+                ChangeForReader_t* chit = changes_for_reader_.find(sit);
+                if (chit != nullptr && UNACKNOWLEDGED == chit->getStatus())
                 {
-                    chit->setStatus(REQUESTED);
+                    changes_for_reader_.set_status(*chit, REQUESTED);
                     chit->markAllFragmentsAsUnsent();
                     isSomeoneWasSetRequested = true;
                 }
@@ -406,7 +388,7 @@ bool ReaderProxy::set_change_to_status(
         return false;
     }
 
-    ChangeIterator it = find_change(seq_num, true);
+    ChangeForReader_t* it = changes_for_reader_.find(seq_num);
     bool change_was_modified = false;
 
     // If the status is UNDERWAY (change was right now sent) and the reader is besteffort,
@@ -432,20 +414,20 @@ bool ReaderProxy::set_change_to_status(
         change_was_modified = true;
     }
 
-    if (it != changes_for_reader_.end())
+    if (it != nullptr)
     {
         if (status == ACKNOWLEDGED && changes_low_mark_ == seq_num)
         {
             // Erase the first change when it is acknowledged
-            assert(it == changes_for_reader_.begin());
-            changes_for_reader_.erase(it);
+            assert(it == &changes_for_reader_.front());
+            changes_for_reader_.erase(seq_num);
         }
         else
         {
             // Otherwise change status
             if (it->getStatus() != status)
             {
-                it->setStatus(status);
+                changes_for_reader_.set_status(*it, status);
                 change_was_modified = true;
             }
         }
@@ -467,9 +449,9 @@ bool ReaderProxy::mark_fragment_as_sent_for_change(
     }
 
     bool change_found = false;
-    ChangeIterator it = find_change(seq_num, true);
+    ChangeForReader_t* it = changes_for_reader_.find(seq_num);
 
-    if (it != changes_for_reader_.end())
+    if (it != nullptr)
     {
         change_found = true;
         it->markFragmentsAsSent(frag_num);
@@ -498,51 +480,33 @@ bool ReaderProxy::convert_status_on_all_changes(
     // NOTE: This is only called for REQUESTED=>UNSENT (acknack response) or
     //       UNDERWAY=>UNACKNOWLEDGED (nack supression)
 
-    bool at_least_one_modified = false;
-    for (ChangeForReader_t& change : changes_for_reader_)
-    {
-        if (change.getStatus() == previous)
-        {
-            at_least_one_modified = true;
-            change.setStatus(next);
-        }
-    }
-
-    return at_least_one_modified;
+    return changes_for_reader_.convert_status(previous, next);
 }
 
 void ReaderProxy::change_has_been_removed(
         const SequenceNumber_t& seq_num)
 {
     // Check sequence number is in the container, because it was not clean up.
-    if (changes_for_reader_.empty() || seq_num < changes_for_reader_.begin()->getSequenceNumber())
+    // Element may not be in the container when marked as irrelevant.
+    const ChangeForReader_t* chit = changes_for_reader_.find(seq_num);
+    if (chit == nullptr)
     {
         return;
     }
 
-    auto chit = find_change(seq_num);
-
     // In intraprocess, if there is an UNACKNOWLEDGED, a GAP has to be send because there is no reliable mechanism.
     if (is_local_reader() && ACKNOWLEDGED > chit->getStatus())
     {
         writer_->intraprocess_gap(this, seq_num);
     }
 
-    // Element may not be in the container when marked as irrelevant.
-    changes_for_reader_.erase(chit);
+    changes_for_reader_.erase(seq_num);
 }
 
 bool ReaderProxy::has_unacknowledged() const
 {
-    for (const ChangeForReader_t& it : changes_for_reader_)
-    {
-        if (it.isRelevant() && it.getStatus() == UNACKNOWLEDGED)
-        {
-            return true;
-        }
-    }
-
-    return false;
+    // Irrelevant changes are not added to the collection
+    return changes_for_reader_.has_status(UNACKNOWLEDGED);
 }
 
 bool ReaderProxy::requested_fragment_set(
@@ -550,8 +514,8 @@ bool ReaderProxy::requested_fragment_set(
         const FragmentNumberSet_t& frag_set)
 {
     // Locate the outbound change referenced by the NACK_FRAG
-    ChangeIterator changeIter = find_change(seq_num, true);
-    if (changeIter == changes_for_reader_.end())
+    ChangeForReader_t* changeIter = changes_for_reader_.find(seq_num);
+    if (changeIter == nullptr)
     {
         return false;
     }
@@ -561,7 +525,7 @@ bool ReaderProxy::requested_fragment_set(
     // If it was UNSENT, we shouldn't switch back to REQUESTED to prevent stalling.
     if (changeIter->getStatus() != UNSENT)
     {
-        changeIter->setStatus(REQUESTED);
+        changes_for_reader_.set_status(*changeIter, REQUESTED);
     }
 
     return true;
@@ -588,45 +552,11 @@ bool ReaderProxy::process_nack_frag(
     return false;
 }
 
-static bool change_less_than_sequence(
-        const ChangeForReader_t& change,
-        const SequenceNumber_t& seq_num)
-{
-    return change.getSequenceNumber() < seq_num;
-}
-
-ReaderProxy::ChangeIterator ReaderProxy::find_change(
-        const SequenceNumber_t& seq_num,
-        bool exact)
-{
-    ReaderProxy::ChangeIterator it;
-    ReaderProxy::ChangeIterator end = changes_for_reader_.end();
-    it = std::lower_bound(changes_for_reader_.begin(), end, seq_num, change_less_than_sequence);
-
-    return (!exact)
-           ? it
-           : it == end
-           ? it
-           : it->getSequenceNumber() == seq_num ? it : end;
-}
-
-ReaderProxy::ChangeConstIterator ReaderProxy::find_change(
-        const SequenceNumber_t& seq_num) const
-{
-    ReaderProxy::ChangeConstIterator it;
-    ReaderProxy::ChangeConstIterator end = changes_for_reader_.end();
-    it = std::lower_bound(changes_for_reader_.begin(), end, seq_num, change_less_than_sequence);
-
-    return it == end
-           ? it
-           : it->getSequenceNumber() == seq_num ? it : end;
-}
-
 bool ReaderProxy::are_there_gaps()
 {
     return (0 < changes_for_reader_.size() &&
            changes_low_mark_ + uint32_t(changes_for_reader_.size()) !=
-           changes_for_reader_.rbegin()->getSequenceNumber());
+           changes_for_reader_.back().getSequenceNumber());
 }
 
 void ReaderProxy::send_gaps(
@@ -638,22 +568,21 @@ void ReaderProxy::send_gaps(
         try
         {
             if (are_there_gaps() ||
-                    (0 < changes_for_reader_.size() && next_seq != changes_for_reader_.rbegin()->getSequenceNumber()))
+                    (0 < changes_for_reader_.size() && next_seq != changes_for_reader_.back().getSequenceNumber()))
             {
                 RTPSGapBuilder gap_builder(group);
                 SequenceNumber_t current_seq = changes_low_mark_ + 1;
 
-                for (ReaderProxy::ChangeConstIterator cit = changes_for_reader_.begin();
-                        cit != changes_for_reader_.end(); ++cit)
-                {
-                    SequenceNumber_t seq_num = cit->getSequenceNumber();
-                    while (current_seq != seq_num)
-                    {
-                        gap_builder.add(current_seq);
-                        ++current_seq;
-                    }
-                    ++current_seq;
-                }
+                changes_for_reader_.for_each([&](const ChangeForReader_t& change)
+                        {
+                            SequenceNumber_t seq_num = change.getSequenceNumber();
+                            while (current_seq != seq_num)
+                            {
+                                gap_builder.add(current_seq);
+                                ++current_seq;
+                            }
+                            ++current_seq;
+                        });
 
                 while (current_seq < next_seq)
                 {
@@ -19,6 +19,7 @@
 
 #include <fastdds/rtps/writer/StatefulPersistentWriter.h>
 #include <fastdds/rtps/history/WriterHistory.h>
+#include <fastrtps/utils/TimeConversion.h>
 #include <rtps/persistence/PersistenceService.h>
 #include <fastrtps_deprecated/participant/ParticipantImpl.h>
 
@@ -63,6 +64,15 @@ bool StatefulPersistentWriter::change_removed_by_history(
     return StatefulWriter::change_removed_by_history(change);
 }
 
+bool StatefulPersistentWriter::wait_for_all_acked(
+        const Duration_t& max_wait)
+{
+    auto max_blocking_time = std::chrono::steady_clock::now() +
+            std::chrono::microseconds(TimeConv::Duration_t2MicroSecondsInt64(max_wait));
+    bool all_acked = StatefulWriter::wait_for_all_acked(max_wait);
+    return wait_for_all_stored(max_blocking_time) && all_acked;
+}
+
 } // namespace rtps
 } // namespace fastrtps
 } // namespace eprosima
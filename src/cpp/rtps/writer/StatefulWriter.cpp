@@ -24,6 +24,7 @@
 
 #include <rtps/participant/RTPSParticipantImpl.h>
 #include <rtps/flowcontrol/FlowController.h>
+#include <rtps/flowcontrol/SchedulingFlowController.h>
 
 #include <fastdds/rtps/messages/RTPSMessageCreator.h>
 #include <fastdds/rtps/messages/RTPSMessageGroup.h>
@@ -44,6 +45,7 @@
 #include "rtps/RTPSDomainImpl.hpp"
 #include "rtps/messages/RTPSGapBuilder.hpp"
 
+#include <algorithm>
 #include <mutex>
 #include <vector>
 #include <stdexcept>
@@ -181,7 +183,7 @@ StatefulWriter::~StatefulWriter()
         nack_response_event_ = nullptr;
     }
 
-    mp_RTPSParticipant->async_thread().unregister_writer(this);
+    unregister_async_thread();
 
     // After unregistering writer from AsyncWriterThread, delete all flow_controllers because they register the writer in
     // the AsyncWriterThread.
@@ -385,7 +387,7 @@ void StatefulWriter::unsent_change_added_to_history(
 
             if (m_pushMode)
             {
-                mp_RTPSParticipant->async_thread().wake_up(this, max_blocking_time);
+                wake_up_async_thread(max_blocking_time);
             }
         }
 
@@ -525,7 +527,8 @@ void StatefulWriter::send_any_unsent_changes()
     }
     else
     {
-        bool no_flow_controllers = m_controllers.empty() && mp_RTPSParticipant->getFlowControllers().empty();
+        bool no_flow_controllers = m_controllers.empty() && mp_RTPSParticipant->getFlowControllers().empty() &&
+                scheduling_flow_controller_ == nullptr;
         if (no_flow_controllers || !there_are_remote_readers_)
         {
             send_all_unsent_changes(max_sequence, activateHeartbeatPeriod);
@@ -802,8 +805,15 @@ void StatefulWriter::send_all_unsent_changes(
         RTPSGapBuilder gap_builder(group);
         uint32_t total_sent_size = 0;
 
+        // Skip the history when no remote reader has changes to be sent
+        bool any_unsent = std::any_of(matched_readers_.begin(), matched_readers_.end(),
+                        [](ReaderProxy* reader)
+                        {
+                            return !reader->is_local_reader() && reader->has_unsent_changes();
+                        });
+
         History::iterator cit;
-        for (cit = mp_history->changesBegin();
+        for (cit = any_unsent ? mp_history->changesBegin() : mp_history->changesEnd();
                 cit != mp_history->changesEnd() && (total_sent_size < implicit_flow_controller_size);
                 cit++)
         {
@@ -887,7 +897,7 @@ void StatefulWriter::send_all_unsent_changes(
 
         if (cit != mp_history->changesEnd())
         {
-            mp_RTPSParticipant->async_thread().wake_up(this);
+            wake_up_async_thread();
         }
     }
 }
@@ -979,6 +989,12 @@ void StatefulWriter::send_unsent_changes_with_flow_control(
         (*controller)(relevantChanges);
     }
 
+    // And finally through the flow controller this writer is attached to, which accounts what is sent
+    if (scheduling_flow_controller_ != nullptr)
+    {
+        scheduling_flow_controller_->filter(this, relevantChanges);
+    }
+
     try
     {
         uint32_t lastBytesProcessed = 0;
@@ -1044,7 +1060,7 @@ void StatefulWriter::send_unsent_changes_with_flow_control(
 
                     if (must_wake_up_async_thread)
                     {
-                        mp_RTPSParticipant->async_thread().wake_up(this);
+                        wake_up_async_thread();
                     }
                 }
                 else
@@ -1378,7 +1394,7 @@ bool StatefulWriter::matched_reader_add(
         {
             if (rp->is_local_reader())
             {
-                mp_RTPSParticipant->async_thread().wake_up(this);
+                wake_up_async_thread();
             }
             else if (is_reliable)
             {
@@ -1953,7 +1969,7 @@ void StatefulWriter::perform_nack_response()
 
     if (must_wake_up_async_thread)
     {
-        mp_RTPSParticipant->async_thread().wake_up(this);
+        wake_up_async_thread();
     }
 }
 
@@ -2011,7 +2027,7 @@ bool StatefulWriter::process_acknack(
                         {
                             if (remote_reader->is_local_reader())
                             {
-                                mp_RTPSParticipant->async_thread().wake_up(this);
+                                wake_up_async_thread();
                             }
                             else
                             {
@@ -19,6 +19,7 @@
 
 #include <fastdds/rtps/writer/StatelessPersistentWriter.h>
 #include <fastdds/rtps/history/WriterHistory.h>
+#include <fastrtps/utils/TimeConversion.h>
 #include <rtps/persistence/PersistenceService.h>
 #include <fastrtps_deprecated/participant/ParticipantImpl.h>
 
@@ -62,6 +63,14 @@ bool StatelessPersistentWriter::change_removed_by_history(
     return StatelessWriter::change_removed_by_history(change);
 }
 
+bool StatelessPersistentWriter::wait_for_all_acked(
+        const Duration_t& max_wait)
+{
+    auto max_blocking_time = std::chrono::steady_clock::now() +
+            std::chrono::microseconds(TimeConv::Duration_t2MicroSecondsInt64(max_wait));
+    return wait_for_all_stored(max_blocking_time) && StatelessWriter::wait_for_all_acked(max_wait);
+}
+
 } // namespace rtps
 } // namespace fastrtps
 } // namespace eprosima
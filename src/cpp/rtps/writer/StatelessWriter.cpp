@@ -23,6 +23,7 @@
 #include <fastdds/rtps/resources/AsyncWriterThread.h>
 #include <rtps/participant/RTPSParticipantImpl.h>
 #include <rtps/flowcontrol/FlowController.h>
+#include <rtps/flowcontrol/SchedulingFlowController.h>
 #include <rtps/history/HistoryAttributesExtension.hpp>
 #include <rtps/writer/RTPSWriterCollector.h>
 #include <fastdds/rtps/builtin/BuiltinProtocols.h>
@@ -115,7 +116,7 @@ StatelessWriter::~StatelessWriter()
         controller->disable();
     }
 
-    mp_RTPSParticipant->async_thread().unregister_writer(this);
+    unregister_async_thread();
 
     // After unregistering writer from AsyncWriterThread, delete all flow_controllers because they register the writer in
     // the AsyncWriterThread.
@@ -290,7 +291,7 @@ void StatelessWriter::unsent_change_added_to_history(
         else
         {
             unsent_changes_.push_back(ChangeForReader_t(change));
-            mp_RTPSParticipant->async_thread().wake_up(this, max_blocking_time);
+            wake_up_async_thread(max_blocking_time);
         }
     }
     else
@@ -397,7 +398,8 @@ void StatelessWriter::send_any_unsent_changes()
     std::lock_guard<RecursiveTimedMutex> guard(mp_mutex);
 
     bool remote_destinations = there_are_remote_readers_ || !fixed_locators_.empty();
-    bool no_flow_controllers = flow_controllers_.empty() && mp_RTPSParticipant->getFlowControllers().empty();
+    bool no_flow_controllers = flow_controllers_.empty() && mp_RTPSParticipant->getFlowControllers().empty() &&
+            scheduling_flow_controller_ == nullptr;
     if (!remote_destinations || no_flow_controllers)
     {
         send_all_unsent_changes();
@@ -502,7 +504,7 @@ void StatelessWriter::send_all_unsent_changes()
 
     if (!unsent_changes_.empty())
     {
-        mp_RTPSParticipant->async_thread().wake_up(this);
+        wake_up_async_thread();
     }
 }
 
@@ -554,6 +556,12 @@ void StatelessWriter::send_unsent_changes_with_flow_control()
             (*controller)(changesToSend);
         }
 
+        // And finally through the flow controller this writer is attached to, which accounts what is sent
+        if (scheduling_flow_controller_ != nullptr)
+        {
+            scheduling_flow_controller_->filter(this, changesToSend);
+        }
+
         flow_controllers_limited = n_items != changesToSend.size();
 
         try
@@ -719,7 +727,7 @@ bool StatelessWriter::matched_reader_add(
         // Mark newcommer's guid as receiver of old changes
         late_joiner_guids_.emplace_back(data.guid());
         // History is always sent asynchronously to late joiners
-        mp_RTPSParticipant->async_thread().wake_up(this);
+        wake_up_async_thread();
     }
 
     logInfo(RTPS_READER, "Reader " << data.guid() << " added to " << m_guid.entityId);
@@ -796,7 +804,7 @@ void StatelessWriter::unsent_changes_reset()
         // Send to all from the beginning
         first_seq_for_all_readers_ = unsent_changes_.front().getSequenceNumber();
         // Do it asynchronously
-        mp_RTPSParticipant->async_thread().wake_up(this);
+        wake_up_async_thread();
     }
 }
 
@@ -275,6 +275,8 @@ XMLP_ret XMLParser::parseXMLTransportData(
                 <xs:element name="receiveBufferSize" type="int32Type" minOccurs="0" maxOccurs="1"/>
                 <xs:element name="TTL" type="uint8Type" minOccurs="0" maxOccurs="1"/>
                 <xs:element name="non_blocking_send" type="boolType" minOccurs="0" maxOccurs="1"/>
+                <xs:element name="receive_batch_size" type="uint32Type" minOccurs="0" maxOccurs="1"/>
+                <xs:element name="batched_send" type="boolType" minOccurs="0" maxOccurs="1"/>
                 <xs:element name="maxMessageSize" type="uint32Type" minOccurs="0" maxOccurs="1"/>
                 <xs:element name="maxInitialPeersRange" type="uint32Type" minOccurs="0" maxOccurs="1"/>
                 <xs:element name="interfaceWhiteList" type="stringListType" minOccurs="0" maxOccurs="1"/>
@@ -289,7 +291,9 @@ XMLP_ret XMLParser::parseXMLTransportData(
                 <xs:element name="listening_ports" type="portListType" minOccurs="0" maxOccurs="1"/>
                 <xs:element name="calculate_crc" type="boolType" minOccurs="0" maxOccurs="1"/>
                 <xs:element name="check_crc" type="boolType" minOccurs="0" maxOccurs="1"/>
+                <xs:element name="use_crc32c" type="boolType" minOccurs="0" maxOccurs="1"/>
                 <xs:element name="enable_tcp_nodelay" type="boolType" minOccurs="0" maxOccurs="1"/>
+                <xs:element name="reactor_threads" type="uint32Type" minOccurs="0" maxOccurs="1"/>
                 <xs:element name="tls" type="tlsConfigType" minOccurs="0" maxOccurs="1"/>
             </xs:all>
         </xs:complexType>
@@ -351,6 +355,23 @@ XMLP_ret XMLParser::parseXMLTransportData(
                     return XMLP_ret::XML_ERROR;
                 }
             }
+            // Receive batch size
+            if (nullptr != (p_aux0 = p_root->FirstChildElement(RECEIVE_BATCH_SIZE)))
+            {
+                if (XMLP_ret::XML_OK != getXMLUint(p_aux0, &pUDPDesc->receive_batch_size, 0) ||
+                        pUDPDesc->receive_batch_size == 0)
+                {
+                    return XMLP_ret::XML_ERROR;
+                }
+            }
+            // Batched send
+            if (nullptr != (p_aux0 = p_root->FirstChildElement(BATCHED_SEND)))
+            {
+                if (XMLP_ret::XML_OK != getXMLBool(p_aux0, &pUDPDesc->batched_send, 0))
+                {
+                    return XMLP_ret::XML_ERROR;
+                }
+            }
         }
         else if (sType == TCPv4)
         {
@@ -530,12 +551,14 @@ XMLP_ret XMLParser::parseXMLCommonTransportData(
                 strcmp(name, MAX_LOGICAL_PORT) == 0 || strcmp(name, LOGICAL_PORT_RANGE) == 0 ||
                 strcmp(name, LOGICAL_PORT_INCREMENT) == 0 || strcmp(name, LISTENING_PORTS) == 0 ||
                 strcmp(name, CALCULATE_CRC) == 0 || strcmp(name, CHECK_CRC) == 0 ||
+                strcmp(name, USE_CRC32C) == 0 || strcmp(name, REACTOR_THREADS) == 0 ||
                 strcmp(name, ENABLE_TCP_NODELAY) == 0 || strcmp(name, TLS) == 0 ||
-                strcmp(name, NON_BLOCKING_SEND) == 0  ||
+                strcmp(name, NON_BLOCKING_SEND) == 0  || strcmp(name, RECEIVE_BATCH_SIZE) == 0 ||
+                strcmp(name, BATCHED_SEND) == 0 ||
                 strcmp(name, SEGMENT_SIZE) == 0 || strcmp(name, PORT_QUEUE_CAPACITY) == 0 ||
                 strcmp(name, PORT_OVERFLOW_POLICY) == 0 || strcmp(name, SEGMENT_OVERFLOW_POLICY) == 0 ||
                 strcmp(name, HEALTHY_CHECK_TIMEOUT_MS) == 0 || strcmp(name, HEALTHY_CHECK_TIMEOUT_MS) == 0 ||
-                strcmp(name, RTPS_DUMP_FILE) == 0)
+                strcmp(name, RTPS_DUMP_FILE) == 0 || strcmp(name, KEEP_RECEIVED_BUFFERS) == 0)
         {
             // Parsed outside of this method
         }
@@ -568,6 +591,8 @@ XMLP_ret XMLParser::parseXMLCommonTCPTransportData(
                 <xs:element name="calculate_crc" type="boolType" minOccurs="0" maxOccurs="1"/>
                 <xs:element name="check_crc" type="boolType" minOccurs="0" maxOccurs="1"/>
                 <xs:element name="enable_tcp_nodelay" type="boolType" minOccurs="0" maxOccurs="1"/>
+                <xs:element name="reactor_threads" type="uint32Type" minOccurs="0" maxOccurs="1"/>
+                <xs:element name="non_blocking_send" type="boolType" minOccurs="0" maxOccurs="1"/>
                 <xs:element name="tls" type="tlsConfigType" minOccurs="0" maxOccurs="1"/>
             </xs:all>
         </xs:complexType>
@@ -641,6 +666,14 @@ XMLP_ret XMLParser::parseXMLCommonTCPTransportData(
                     return XMLP_ret::XML_ERROR;
                 }
             }
+            // non_blocking_send - boolType
+            else if (strcmp(name, NON_BLOCKING_SEND) == 0)
+            {
+                if (XMLP_ret::XML_OK != getXMLBool(p_aux0, &pTCPDesc->non_blocking_send, 0))
+                {
+                    return XMLP_ret::XML_ERROR;
+                }
+            }
             else if (strcmp(name, LISTENING_PORTS) == 0)
             {
                 // listening_ports uint16ListType
@@ -671,6 +704,21 @@ XMLP_ret XMLParser::parseXMLCommonTCPTransportData(
                     return XMLP_ret::XML_ERROR;
                 }
             }
+            else if (strcmp(name, USE_CRC32C) == 0)
+            {
+                if (XMLP_ret::XML_OK != getXMLBool(p_aux0, &pTCPDesc->use_crc32c, 0))
+                {
+                    return XMLP_ret::XML_ERROR;
+                }
+            }
+            else if (strcmp(name, REACTOR_THREADS) == 0)
+            {
+                // reactor_threads - uint32Type
+                if (XMLP_ret::XML_OK != getXMLUint(p_aux0, &pTCPDesc->reactor_threads, 0))
+                {
+                    return XMLP_ret::XML_ERROR;
+                }
+            }
             else if (strcmp(name, TLS) == 0)
             {
                 if (XMLP_ret::XML_OK != parse_tls_config(p_aux0, p_transport))
@@ -715,6 +763,7 @@ XMLP_ret XMLParser::parseXMLCommonSharedMemTransportData(
                 <xs:element name="port_queue_capacity" type="uint32Type" minOccurs="0" maxOccurs="1"/>
                 <xs:element name="healthy_check_timeout_ms" type="uint32Type" minOccurs="0" maxOccurs="1"/>
                 <xs:element name="rtps_dump_file" type="stringType" minOccurs="0" maxOccurs="1"/>
+                <xs:element name="keep_received_buffers" type="boolType" minOccurs="0" maxOccurs="1"/>
                 </xs:all>
         </xs:complexType>
      */
@@ -763,6 +812,15 @@ XMLP_ret XMLParser::parseXMLCommonSharedMemTransportData(
                 }
                 transport_descriptor->rtps_dump_file(str);
             }
+            else if (strcmp(name, KEEP_RECEIVED_BUFFERS) == 0)
+            {
+                bool keep = false;
+                if (XMLP_ret::XML_OK != getXMLBool(p_aux0, &keep, 0))
+                {
+                    return XMLP_ret::XML_ERROR;
+                }
+                transport_descriptor->keep_received_buffers(keep);
+            }
             else if (strcmp(name, MAX_MESSAGE_SIZE) == 0)
             {
                 // maxMessageSize - uint32Type
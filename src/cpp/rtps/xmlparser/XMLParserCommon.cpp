@@ -44,6 +44,8 @@ const char* RECEIVE_BUFFER_SIZE = "receiveBufferSize";
 const char* SEND_BUFFER_SIZE = "sendBufferSize";
 const char* TTL = "TTL";
 const char* NON_BLOCKING_SEND = "non_blocking_send";
+const char* RECEIVE_BATCH_SIZE = "receive_batch_size";
+const char* BATCHED_SEND = "batched_send";
 const char* WHITE_LIST = "interfaceWhiteList";
 const char* MAX_MESSAGE_SIZE = "maxMessageSize";
 const char* MAX_INITIAL_PEERS_RANGE = "maxInitialPeersRange";
@@ -57,6 +59,8 @@ const char* METADATA_LOGICAL_PORT = "metadata_logical_port";
 const char* LISTENING_PORTS = "listening_ports";
 const char* CALCULATE_CRC = "calculate_crc";
 const char* CHECK_CRC = "check_crc";
+const char* USE_CRC32C = "use_crc32c";
+const char* REACTOR_THREADS = "reactor_threads";
 const char* SEGMENT_SIZE = "segment_size";
 const char* PORT_QUEUE_CAPACITY = "port_queue_capacity";
 const char* PORT_OVERFLOW_POLICY = "port_overflow_policy";
@@ -65,6 +69,7 @@ const char* HEALTHY_CHECK_TIMEOUT_MS = "healthy_check_timeout_ms";
 const char* DISCARD = "DISCARD";
 const char* FAIL = "FAIL";
 const char* RTPS_DUMP_FILE = "rtps_dump_file";
+const char* KEEP_RECEIVED_BUFFERS = "keep_received_buffers";
 
 const char* OFF = "OFF";
 const char* USER_DATA_ONLY = "USER_DATA_ONLY";
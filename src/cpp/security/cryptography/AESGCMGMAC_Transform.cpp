@@ -61,6 +61,77 @@ static KeyMaterial_AES_GCM_GMAC* find_key(
     return nullptr;
 }
 
+/*!
+ * Cipher context reused by the operations performed on the same thread.
+ * Allocating a context for each message is avoided, and while the cipher does not change only the key and the
+ * initialization vector are set, keeping the memory of the cipher state.
+ */
+class ThreadCipherContext
+{
+public:
+
+    ThreadCipherContext()
+        : ctx_(EVP_CIPHER_CTX_new())
+        , cipher_(nullptr)
+    {
+    }
+
+    ~ThreadCipherContext()
+    {
+        EVP_CIPHER_CTX_free(ctx_);
+    }
+
+    ThreadCipherContext(
+            const ThreadCipherContext&) = delete;
+
+    ThreadCipherContext& operator =(
+            const ThreadCipherContext&) = delete;
+
+    EVP_CIPHER_CTX* init(
+            const EVP_CIPHER* cipher,
+            const unsigned char* key,
+            const unsigned char* iv,
+            int enc)
+    {
+        if (nullptr == ctx_ || nullptr == cipher)
+        {
+            return nullptr;
+        }
+
+        if (!EVP_CipherInit_ex(ctx_, cipher == cipher_ ? nullptr : cipher, nullptr, key, iv, enc))
+        {
+            cipher_ = nullptr;
+            return nullptr;
+        }
+
+        cipher_ = cipher;
+        return ctx_;
+    }
+
+private:
+
+    EVP_CIPHER_CTX* ctx_;
+    const EVP_CIPHER* cipher_;
+};
+
+static EVP_CIPHER_CTX* init_encrypt_context(
+        const EVP_CIPHER* cipher,
+        const unsigned char* key,
+        const unsigned char* iv)
+{
+    static thread_local ThreadCipherContext context;
+    return context.init(cipher, key, iv, 1);
+}
+
+static EVP_CIPHER_CTX* init_decrypt_context(
+        const EVP_CIPHER* cipher,
+        const unsigned char* key,
+        const unsigned char* iv)
+{
+    static thread_local ThreadCipherContext context;
+    return context.init(cipher, key, iv, 0);
+}
+
 AESGCMGMAC_Transform::AESGCMGMAC_Transform()
 {
 }
@@ -683,7 +754,7 @@ bool AESGCMGMAC_Transform::decode_rtps_message(
 
     //Sessionkey
     std::array<uint8_t, 32> session_key{};
-    compute_sessionkey(session_key,
+    get_remote_sessionkey(session_key, sending_participant->RemoteSessionKeys,
             sending_participant->RemoteParticipant2ParticipantKeyMaterial.at(0),
             session_id);
     //IV
@@ -768,7 +839,7 @@ bool AESGCMGMAC_Transform::decode_rtps_message(
 
         SecurityException exception;
 
-        if (!deserialize_SecureDataTag(decoder, tag,
+        if (!deserialize_SecureDataTag(decoder, tag, sending_participant->RemoteSessionKeys,
                 sending_participant->RemoteParticipant2ParticipantKeyMaterial.at(0).transformation_kind,
                 sending_participant->RemoteParticipant2ParticipantKeyMaterial.at(0).receiver_specific_key_id,
                 sending_participant->RemoteParticipant2ParticipantKeyMaterial.at(0).master_receiver_specific_key,
@@ -1052,7 +1123,7 @@ bool AESGCMGMAC_Transform::decode_datawriter_submessage(
     memcpy(&session_id, header.session_id.data(), 4);
     //Sessionkey
     std::array<uint8_t, 32> session_key{};
-    compute_sessionkey(session_key, *keyMat, session_id);
+    get_remote_sessionkey(session_key, sending_writer->RemoteSessionKeys, *keyMat, session_id);
     //IV
     std::array<uint8_t, 12> initialization_vector{};
     memcpy(initialization_vector.data(), header.session_id.data(), 4);
@@ -1107,7 +1178,7 @@ bool AESGCMGMAC_Transform::decode_datawriter_submessage(
 
         SecurityException exception;
 
-        if (!deserialize_SecureDataTag(decoder, tag, keyMat->transformation_kind,
+        if (!deserialize_SecureDataTag(decoder, tag, sending_writer->RemoteSessionKeys, keyMat->transformation_kind,
                 keyMat->receiver_specific_key_id,
                 keyMat->master_receiver_specific_key,
                 keyMat->master_salt,
@@ -1232,7 +1303,7 @@ bool AESGCMGMAC_Transform::decode_datareader_submessage(
     memcpy(&session_id, header.session_id.data(), 4);
     //Sessionkey
     std::array<uint8_t, 32> session_key{};
-    compute_sessionkey(session_key, *keyMat, session_id);
+    get_remote_sessionkey(session_key, sending_reader->RemoteSessionKeys, *keyMat, session_id);
     //IV
     std::array<uint8_t, 12> initialization_vector{};
     memcpy(initialization_vector.data(), header.session_id.data(), 4);
@@ -1287,7 +1358,7 @@ bool AESGCMGMAC_Transform::decode_datareader_submessage(
 
         SecurityException exception;
 
-        if (!deserialize_SecureDataTag(decoder, tag, keyMat->transformation_kind,
+        if (!deserialize_SecureDataTag(decoder, tag, sending_reader->RemoteSessionKeys, keyMat->transformation_kind,
                 keyMat->receiver_specific_key_id,
                 keyMat->master_receiver_specific_key,
                 keyMat->master_salt,
@@ -1388,7 +1459,7 @@ bool AESGCMGMAC_Transform::decode_serialized_payload(
 
     //Sessionkey
     std::array<uint8_t, 32> session_key{};
-    compute_sessionkey(session_key, *keyMat, session_id);
+    get_remote_sessionkey(session_key, sending_writer->RemoteSessionKeys, *keyMat, session_id);
     //IV
     std::array<uint8_t, 12> initialization_vector{};
     memcpy(initialization_vector.data(), header.session_id.data(), 4);
@@ -1428,7 +1499,7 @@ bool AESGCMGMAC_Transform::decode_serialized_payload(
     // Tag
     try
     {
-        deserialize_SecureDataTag(decoder, tag, {}, {}, {}, {}, {}, 0, exception);
+        deserialize_SecureDataTag(decoder, tag, sending_writer->RemoteSessionKeys, {}, {}, {}, {}, {}, 0, exception);
     }
     catch (eprosima::fastcdr::exception::NotEnoughMemoryException&)
     {
@@ -1516,6 +1587,37 @@ void AESGCMGMAC_Transform::compute_sessionkey(
 #endif // if IS_OPENSSL_1_1
 }
 
+void AESGCMGMAC_Transform::get_remote_sessionkey(
+        std::array<uint8_t, 32>& session_key,
+        SessionKeyCache& remote_session_keys,
+        const KeyMaterial_AES_GCM_GMAC& key_mat,
+        const uint32_t session_id)
+{
+    bool use_256_bits = (key_mat.transformation_kind == c_transfrom_kind_aes256_gcm ||
+            key_mat.transformation_kind == c_transfrom_kind_aes256_gmac);
+    int key_len = use_256_bits ? 32 : 16;
+
+    get_remote_sessionkey(session_key, remote_session_keys, false, key_mat.sender_key_id, key_mat.master_sender_key,
+            key_mat.master_salt, session_id, key_len);
+}
+
+void AESGCMGMAC_Transform::get_remote_sessionkey(
+        std::array<uint8_t, 32>& session_key,
+        SessionKeyCache& remote_session_keys,
+        bool receiver_specific,
+        const CryptoTransformKeyId& key_id,
+        const std::array<uint8_t, 32>& master_key,
+        const std::array<uint8_t, 32>& master_salt,
+        const uint32_t session_id,
+        int key_len)
+{
+    if (!remote_session_keys.find(key_id, master_key, master_salt, session_id, receiver_specific, session_key))
+    {
+        compute_sessionkey(session_key, receiver_specific, master_key, master_salt, session_id, key_len);
+        remote_session_keys.add(key_id, master_key, master_salt, session_id, receiver_specific, session_key);
+    }
+}
+
 void AESGCMGMAC_Transform::serialize_SecureDataHeader(
         eprosima::fastcdr::Cdr& serializer,
         const CryptoTransformKind& transformation_kind,
@@ -1543,32 +1645,16 @@ bool AESGCMGMAC_Transform::serialize_SecureDataBody(
             transformation_kind == c_transfrom_kind_aes256_gmac);
 
     // AES_BLOCK_SIZE = 16
-    int cipher_block_size = 0, actual_size = 0, final_size = 0;
-    EVP_CIPHER_CTX* e_ctx = EVP_CIPHER_CTX_new();
-
-    if (!use_256_bits)
-    {
-        if (!EVP_EncryptInit(e_ctx, EVP_aes_128_gcm(), (const unsigned char*)(session_key.data()),
-                initialization_vector.data()))
-        {
-            logError(SECURITY_CRYPTO, "Unable to encode the payload. EVP_EncryptInit function returns an error");
-            EVP_CIPHER_CTX_free(e_ctx);
-            return false;
-        }
+    int actual_size = 0, final_size = 0;
+    const EVP_CIPHER* cipher = use_256_bits ? EVP_aes_256_gcm() : EVP_aes_128_gcm();
+    int cipher_block_size = EVP_CIPHER_block_size(cipher);
 
-        cipher_block_size = EVP_CIPHER_block_size(EVP_aes_128_gcm());
-    }
-    else
+    EVP_CIPHER_CTX* e_ctx = init_encrypt_context(cipher, (const unsigned char*)(session_key.data()),
+                    initialization_vector.data());
+    if (nullptr == e_ctx)
     {
-        if (!EVP_EncryptInit(e_ctx, EVP_aes_256_gcm(), (const unsigned char*)(session_key.data()),
-                initialization_vector.data()))
-        {
-            logError(SECURITY_CRYPTO, "Unable to encode the payload. EVP_EncryptInit function returns an error");
-            EVP_CIPHER_CTX_free(e_ctx);
-            return false;
-        }
-
-        cipher_block_size = EVP_CIPHER_block_size(EVP_aes_256_gcm());
+        logError(SECURITY_CRYPTO, "Unable to encode the payload. EVP_EncryptInit_ex function returns an error");
+        return false;
     }
 
     if (!do_encryption)
@@ -1578,7 +1664,6 @@ bool AESGCMGMAC_Transform::serialize_SecureDataBody(
                 plain_buffer_len)
         {
             logError(SECURITY_CRYPTO, "Not enough memory to copy payload");
-            EVP_CIPHER_CTX_free(e_ctx);
             return false;
         }
         memcpy(serializer.getCurrentPosition(), plain_buffer, plain_buffer_len);
@@ -1587,14 +1672,12 @@ bool AESGCMGMAC_Transform::serialize_SecureDataBody(
         if (!EVP_EncryptUpdate(e_ctx, nullptr, &actual_size, plain_buffer, static_cast<int>(plain_buffer_len)))
         {
             logError(SECURITY_CRYPTO, "Unable to encode the payload. EVP_EncryptUpdate function returns an error");
-            EVP_CIPHER_CTX_free(e_ctx);
             return false;
         }
 
-        if (!EVP_EncryptFinal(e_ctx, nullptr, &final_size))
+        if (!EVP_EncryptFinal_ex(e_ctx, nullptr, &final_size))
         {
-            logError(SECURITY_CRYPTO, "Unable to encode the payload. EVP_EncryptFinal function returns an error");
-            EVP_CIPHER_CTX_free(e_ctx);
+            logError(SECURITY_CRYPTO, "Unable to encode the payload. EVP_EncryptFinal_ex function returns an error");
             return false;
         }
     }
@@ -1638,7 +1721,6 @@ bool AESGCMGMAC_Transform::serialize_SecureDataBody(
                 (plain_buffer_len + (2 * cipher_block_size) - 1))
         {
             logError(SECURITY_CRYPTO, "Not enough memory to cipher payload");
-            EVP_CIPHER_CTX_free(e_ctx);
             return false;
         }
 
@@ -1646,14 +1728,12 @@ bool AESGCMGMAC_Transform::serialize_SecureDataBody(
                 static_cast<int>(plain_buffer_len)))
         {
             logError(SECURITY_CRYPTO, "Unable to encode the payload. EVP_EncryptUpdate function returns an error");
-            EVP_CIPHER_CTX_free(e_ctx);
             return false;
         }
 
-        if (!EVP_EncryptFinal(e_ctx, &output_buffer_raw[actual_size], &final_size))
+        if (!EVP_EncryptFinal_ex(e_ctx, &output_buffer_raw[actual_size], &final_size))
         {
-            logError(SECURITY_CRYPTO, "Unable to encode the payload. EVP_EncryptFinal function returns an error");
-            EVP_CIPHER_CTX_free(e_ctx);
+            logError(SECURITY_CRYPTO, "Unable to encode the payload. EVP_EncryptFinal_ex function returns an error");
             return false;
         }
 
@@ -1679,7 +1759,6 @@ bool AESGCMGMAC_Transform::serialize_SecureDataBody(
 
     // Get commmon_mac
     EVP_CIPHER_CTX_ctrl(e_ctx, EVP_CTRL_GCM_GET_TAG, AES_BLOCK_SIZE, tag.common_mac.data());
-    EVP_CIPHER_CTX_free(e_ctx);
 
     if (submessage)
     {
@@ -1710,6 +1789,18 @@ bool AESGCMGMAC_Transform::serialize_SecureDataTag(
             transformation_kind == c_transfrom_kind_aes256_gmac);
     int key_len = use_256_bits ? 32 : 16;
 
+    const EVP_CIPHER* e_cipher = nullptr;
+    if (transformation_kind == c_transfrom_kind_aes128_gcm ||
+            transformation_kind == c_transfrom_kind_aes128_gmac)
+    {
+        e_cipher = EVP_aes_128_gcm();
+    }
+    else if (transformation_kind == c_transfrom_kind_aes256_gcm ||
+            transformation_kind == c_transfrom_kind_aes256_gmac)
+    {
+        e_cipher = EVP_aes_256_gcm();
+    }
+
     serializer << tag.common_mac;
 
     // Align to 4.
@@ -1750,60 +1841,41 @@ bool AESGCMGMAC_Transform::serialize_SecureDataTag(
             break;
         }
 
+        KeySessionData& session = remote_entity->Sessions[sessionIndex];
+
         //Update the key if needed
-        if (update_specific_keys || remote_entity->Sessions[sessionIndex].session_id != session_id)
+        if (update_specific_keys || session.session_id != session_id || !session.MacContext.has_key())
         {
             //Update triggered!
-            remote_entity->Sessions[sessionIndex].session_id = session_id;
-            compute_sessionkey(remote_entity->Sessions[sessionIndex].SessionKey, true,
+            session.session_id = session_id;
+            compute_sessionkey(session.SessionKey, true,
                     keyMat.master_receiver_specific_key, keyMat.master_salt, session_id, key_len);
+            session.MacContext.set_key(e_cipher, session.SessionKey);
         }
 
         //Obtain MAC using ReceiverSpecificKey and the same Initialization Vector as before
         int actual_size = 0, final_size = 0;
-        EVP_CIPHER_CTX* e_ctx = EVP_CIPHER_CTX_new();
-        if (transformation_kind == c_transfrom_kind_aes128_gcm ||
-                transformation_kind == c_transfrom_kind_aes128_gmac)
-        {
-            if (!EVP_EncryptInit(e_ctx, EVP_aes_128_gcm(),
-                    (const unsigned char*)(remote_entity->Sessions[sessionIndex].SessionKey.data()),
-                    initialization_vector.data()))
-            {
-                logError(SECURITY_CRYPTO, "Unable to encode the payload. EVP_EncryptInit function returns an error");
-                EVP_CIPHER_CTX_free(e_ctx);
-                continue;
-            }
-        }
-        else if (transformation_kind == c_transfrom_kind_aes256_gcm ||
-                transformation_kind == c_transfrom_kind_aes256_gmac)
+        EVP_CIPHER_CTX* e_ctx = session.MacContext.init(initialization_vector);
+        if (nullptr == e_ctx)
         {
-            if (!EVP_EncryptInit(e_ctx, EVP_aes_256_gcm(),
-                    (const unsigned char*)(remote_entity->Sessions[sessionIndex].SessionKey.data()),
-                    initialization_vector.data()))
-            {
-                logError(SECURITY_CRYPTO, "Unable to encode the payload. EVP_EncryptInit function returns an error");
-                EVP_CIPHER_CTX_free(e_ctx);
-                continue;
-            }
+            logError(SECURITY_CRYPTO, "Unable to encode the payload. EVP_EncryptInit_ex function returns an error");
+            continue;
         }
         if (!EVP_EncryptUpdate(e_ctx, NULL, &actual_size, tag.common_mac.data(), 16))
         {
             logError(SECURITY_CRYPTO,
                     "Unable to create authentication for the datawriter submessage. EVP_EncryptUpdate function returns an error");
-            EVP_CIPHER_CTX_free(e_ctx);
             continue;
         }
-        if (!EVP_EncryptFinal(e_ctx, NULL, &final_size))
+        if (!EVP_EncryptFinal_ex(e_ctx, NULL, &final_size))
         {
             logError(SECURITY_CRYPTO,
-                    "Unable to create authentication for the datawriter submessage. EVP_EncryptFinal function returns an error");
-            EVP_CIPHER_CTX_free(e_ctx);
+                    "Unable to create authentication for the datawriter submessage. EVP_EncryptFinal_ex function returns an error");
             continue;
         }
         serializer << remote_entity->Remote2EntityKeyMaterial.at(0).receiver_specific_key_id;
         EVP_CIPHER_CTX_ctrl(e_ctx, EVP_CTRL_GCM_GET_TAG, AES_BLOCK_SIZE, serializer.getCurrentPosition());
         serializer.jump(16);
-        EVP_CIPHER_CTX_free(e_ctx);
 
         ++length;
     }
@@ -1859,62 +1931,60 @@ bool AESGCMGMAC_Transform::serialize_SecureDataTag(
                 keyMat.transformation_kind == c_transfrom_kind_aes256_gmac);
         int key_len = use_256_bits ? 32 : 16;
 
+        const EVP_CIPHER* e_cipher = nullptr;
+        auto& trans_kind = remote_participant->Participant2ParticipantKeyMaterial.at(0).transformation_kind;
+        if (trans_kind == c_transfrom_kind_aes128_gcm ||
+                trans_kind == c_transfrom_kind_aes128_gmac)
+        {
+            e_cipher = EVP_aes_128_gcm();
+        }
+        else if (trans_kind == c_transfrom_kind_aes256_gcm ||
+                trans_kind == c_transfrom_kind_aes256_gmac)
+        {
+            e_cipher = EVP_aes_256_gcm();
+        }
+
+        bool is_local_participant = !(*remote_participant != *local_participant);
+
         //Update the key if needed
         if ((update_specific_keys || remote_participant->session_id != local_participant->session_id) &&
-                (*remote_participant != *local_participant))
+                !is_local_participant)
         {
             //Update triggered!
             remote_participant->session_id = local_participant->session_id;
             compute_sessionkey(remote_participant->SessionKey, true,
                     keyMat.master_receiver_specific_key, keyMat.master_salt, remote_participant->session_id, key_len);
+            remote_participant->MacContext.set_key(e_cipher, remote_participant->SessionKey);
+        }
+        else if (is_local_participant || !remote_participant->MacContext.has_key())
+        {
+            // The session key of the local participant changes on each of its sessions
+            remote_participant->MacContext.set_key(e_cipher, remote_participant->SessionKey);
         }
 
         //Obtain MAC using ReceiverSpecificKey and the same Initialization Vector as before
         int actual_size = 0, final_size = 0;
-        EVP_CIPHER_CTX* e_ctx = EVP_CIPHER_CTX_new();
-        auto& trans_kind = remote_participant->Participant2ParticipantKeyMaterial.at(0).transformation_kind;
-        if (trans_kind == c_transfrom_kind_aes128_gcm ||
-                trans_kind == c_transfrom_kind_aes128_gmac)
+        EVP_CIPHER_CTX* e_ctx = remote_participant->MacContext.init(initialization_vector);
+        if (nullptr == e_ctx)
         {
-            if (!EVP_EncryptInit(e_ctx, EVP_aes_128_gcm(),
-                    (const unsigned char*)(remote_participant->SessionKey.data()),
-                    initialization_vector.data()))
-            {
-                logError(SECURITY_CRYPTO, "Unable to encode the payload. EVP_EncryptInit function returns an error");
-                EVP_CIPHER_CTX_free(e_ctx);
-                continue;
-            }
-        }
-        else if (trans_kind == c_transfrom_kind_aes256_gcm ||
-                trans_kind == c_transfrom_kind_aes256_gmac)
-        {
-            if (!EVP_EncryptInit(e_ctx, EVP_aes_256_gcm(),
-                    (const unsigned char*)(remote_participant->SessionKey.data()),
-                    initialization_vector.data()))
-            {
-                logError(SECURITY_CRYPTO, "Unable to encode the payload. EVP_EncryptInit function returns an error");
-                EVP_CIPHER_CTX_free(e_ctx);
-                continue;
-            }
+            logError(SECURITY_CRYPTO, "Unable to encode the payload. EVP_EncryptInit_ex function returns an error");
+            continue;
         }
         if (!EVP_EncryptUpdate(e_ctx, NULL, &actual_size, tag.common_mac.data(), 16))
         {
             logError(SECURITY_CRYPTO,
                     "Unable to create authentication for the datawriter submessage. EVP_EncryptUpdate function returns an error");
-            EVP_CIPHER_CTX_free(e_ctx);
             continue;
         }
-        if (!EVP_EncryptFinal(e_ctx, NULL, &final_size))
+        if (!EVP_EncryptFinal_ex(e_ctx, NULL, &final_size))
         {
             logError(SECURITY_CRYPTO,
-                    "Unable to create authentication for the datawriter submessage. EVP_EncryptFinal function returns an error");
-            EVP_CIPHER_CTX_free(e_ctx);
+                    "Unable to create authentication for the datawriter submessage. EVP_EncryptFinal_ex function returns an error");
             continue;
         }
         serializer << remote_participant->Participant2ParticipantKeyMaterial.at(0).receiver_specific_key_id;
         EVP_CIPHER_CTX_ctrl(e_ctx, EVP_CTRL_GCM_GET_TAG, AES_BLOCK_SIZE, serializer.getCurrentPosition());
         serializer.jump(16);
-        EVP_CIPHER_CTX_free(e_ctx);
 
         ++length;
     }
@@ -1956,32 +2026,16 @@ bool AESGCMGMAC_Transform::deserialize_SecureDataBody(
     bool use_256_bits = (transformation_kind == c_transfrom_kind_aes256_gcm ||
             transformation_kind == c_transfrom_kind_aes256_gmac);
 
-    EVP_CIPHER_CTX* d_ctx = EVP_CIPHER_CTX_new();
-    int cipher_block_size = 0, actual_size = 0, final_size = 0;
+    int actual_size = 0, final_size = 0;
+    const EVP_CIPHER* cipher = use_256_bits ? EVP_aes_256_gcm() : EVP_aes_128_gcm();
+    int cipher_block_size = EVP_CIPHER_block_size(cipher);
 
-    if (!use_256_bits)
+    EVP_CIPHER_CTX* d_ctx = init_decrypt_context(cipher, (const unsigned char*)session_key.data(),
+                    initialization_vector.data());
+    if (nullptr == d_ctx)
     {
-        if (!EVP_DecryptInit(d_ctx, EVP_aes_128_gcm(), (const unsigned char*)session_key.data(),
-                initialization_vector.data()))
-        {
-            logError(SECURITY_CRYPTO, "Unable to decode the payload. EVP_DecryptInit function returns an error");
-            EVP_CIPHER_CTX_free(d_ctx);
-            return false;
-        }
-
-        cipher_block_size = EVP_CIPHER_block_size(EVP_aes_128_gcm());
-    }
-    else
-    {
-        if (!EVP_DecryptInit(d_ctx, EVP_aes_256_gcm(), (const unsigned char*)session_key.data(),
-                initialization_vector.data()))
-        {
-            logError(SECURITY_CRYPTO, "Unable to decode the payload. EVP_DecryptInit function returns an error");
-            EVP_CIPHER_CTX_free(d_ctx);
-            return false;
-        }
-
-        cipher_block_size = EVP_CIPHER_block_size(EVP_aes_256_gcm());
+        logError(SECURITY_CRYPTO, "Unable to decode the payload. EVP_DecryptInit_ex function returns an error");
+        return false;
     }
 
     uint32_t protected_len = body_length;
@@ -1994,7 +2048,6 @@ bool AESGCMGMAC_Transform::deserialize_SecureDataBody(
         if (plain_buffer_len < (protected_len + cipher_block_size))
         {
             logWarning(SECURITY_CRYPTO, "Not enough memory to decode payload");
-            EVP_CIPHER_CTX_free(d_ctx);
             return false;
         }
     }
@@ -2004,19 +2057,16 @@ bool AESGCMGMAC_Transform::deserialize_SecureDataBody(
     if (!EVP_DecryptUpdate(d_ctx, output_buffer, &actual_size, input_buffer, protected_len))
     {
         logWarning(SECURITY_CRYPTO, "Unable to decode the payload. EVP_DecryptUpdate function returns an error");
-        EVP_CIPHER_CTX_free(d_ctx);
         return false;
     }
 
     EVP_CIPHER_CTX_ctrl(d_ctx, EVP_CTRL_GCM_SET_TAG, AES_BLOCK_SIZE, tag.common_mac.data());
 
-    if (!EVP_DecryptFinal(d_ctx, output_buffer ? &output_buffer[actual_size] : NULL, &final_size))
+    if (!EVP_DecryptFinal_ex(d_ctx, output_buffer ? &output_buffer[actual_size] : NULL, &final_size))
     {
-        logWarning(SECURITY_CRYPTO, "Unable to decode the payload. EVP_DecryptFinal function returns an error");
-        EVP_CIPHER_CTX_free(d_ctx);
+        logWarning(SECURITY_CRYPTO, "Unable to decode the payload. EVP_DecryptFinal_ex function returns an error");
         return false;
     }
-    EVP_CIPHER_CTX_free(d_ctx);
 
     uint32_t cnt_len = do_encryption ? static_cast<uint32_t>(actual_size + final_size) : body_length;
     if (plain_buffer_len < cnt_len)
@@ -2078,6 +2128,7 @@ bool AESGCMGMAC_Transform::predeserialize_SecureDataBody(
 bool AESGCMGMAC_Transform::deserialize_SecureDataTag(
         eprosima::fastcdr::Cdr& decoder,
         SecureDataTag& tag,
+        SessionKeyCache& remote_session_keys,
         const CryptoTransformKind& transformation_kind,
         const CryptoTransformKeyId& receiver_specific_key_id,
         const std::array<uint8_t, 32>& receiver_specific_key,
@@ -2118,7 +2169,6 @@ bool AESGCMGMAC_Transform::deserialize_SecureDataTag(
         }
 
         //Auth message - The point is that we cannot verify the authorship of the message with our receiver_specific_key the message could be crafted
-        EVP_CIPHER_CTX* d_ctx = EVP_CIPHER_CTX_new();
         const EVP_CIPHER* d_cipher = nullptr;
 
         int actual_size = 0, final_size = 0;
@@ -2130,27 +2180,29 @@ bool AESGCMGMAC_Transform::deserialize_SecureDataTag(
         if (transformation_kind == c_transfrom_kind_aes128_gcm ||
                 transformation_kind == c_transfrom_kind_aes128_gmac)
         {
-            compute_sessionkey(specific_session_key, true, receiver_specific_key, master_salt, session_id, 16);
+            get_remote_sessionkey(specific_session_key, remote_session_keys, true, receiver_specific_key_id,
+                    receiver_specific_key, master_salt, session_id, 16);
             d_cipher = EVP_aes_128_gcm();
         }
         else if (transformation_kind == c_transfrom_kind_aes256_gcm ||
                 transformation_kind == c_transfrom_kind_aes256_gmac)
         {
-            compute_sessionkey(specific_session_key, true, receiver_specific_key, master_salt, session_id, 32);
+            get_remote_sessionkey(specific_session_key, remote_session_keys, true, receiver_specific_key_id,
+                    receiver_specific_key, master_salt, session_id, 32);
             d_cipher = EVP_aes_256_gcm();
         }
         else
         {
             logError(SECURITY_CRYPTO, "Invalid transformation kind)");
-            EVP_CIPHER_CTX_free(d_ctx);
             return false;
         }
 
-        if (!EVP_DecryptInit(d_ctx, d_cipher, (const unsigned char*)specific_session_key.data(),
-                initialization_vector.data()))
+        EVP_CIPHER_CTX* d_ctx = init_decrypt_context(d_cipher, (const unsigned char*)specific_session_key.data(),
+                        initialization_vector.data());
+        if (nullptr == d_ctx)
         {
-            logError(SECURITY_CRYPTO, "Unable to authenticate the message. EVP_DecryptInit function returns an error");
-            EVP_CIPHER_CTX_free(d_ctx);
+            logError(SECURITY_CRYPTO,
+                    "Unable to authenticate the message. EVP_DecryptInit_ex function returns an error");
             return false;
         }
 
@@ -2158,7 +2210,6 @@ bool AESGCMGMAC_Transform::deserialize_SecureDataTag(
         {
             logError(SECURITY_CRYPTO,
                     "Unable to authenticate the message. EVP_DecryptUpdate function returns an error");
-            EVP_CIPHER_CTX_free(d_ctx);
             return false;
         }
 
@@ -2166,7 +2217,6 @@ bool AESGCMGMAC_Transform::deserialize_SecureDataTag(
         {
             logError(SECURITY_CRYPTO,
                     "Unable to authenticate the message. EVP_CIPHER_CTX_ctrl function returns an error");
-            EVP_CIPHER_CTX_free(d_ctx);
             return false;
         }
 
@@ -2174,11 +2224,8 @@ bool AESGCMGMAC_Transform::deserialize_SecureDataTag(
         {
             logError(SECURITY_CRYPTO,
                     "Unable to authenticate the message. EVP_DecryptFinal_ex function returns an error");
-            EVP_CIPHER_CTX_free(d_ctx);
             return false;
         }
-
-        EVP_CIPHER_CTX_free(d_ctx);
     }
 
     return true;
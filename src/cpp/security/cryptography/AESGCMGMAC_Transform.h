@@ -118,6 +118,23 @@ public:
             const KeyMaterial_AES_GCM_GMAC& key,
             const uint32_t session_id);
 
+    //Session keys of received messages, only computed when not found on the cache of the sending element
+    void get_remote_sessionkey(
+            std::array<uint8_t, 32>& session_key,
+            SessionKeyCache& remote_session_keys,
+            const KeyMaterial_AES_GCM_GMAC& key,
+            const uint32_t session_id);
+
+    void get_remote_sessionkey(
+            std::array<uint8_t, 32>& session_key,
+            SessionKeyCache& remote_session_keys,
+            bool receiver_specific,
+            const CryptoTransformKeyId& key_id,
+            const std::array<uint8_t, 32>& master_key,
+            const std::array<uint8_t, 32>& master_salt,
+            const uint32_t session_id,
+            int key_len);
+
     //Serialization and deserialization of message components
     void serialize_SecureDataHeader(
             eprosima::fastcdr::Cdr& serializer,
@@ -184,6 +201,7 @@ public:
     bool deserialize_SecureDataTag(
             eprosima::fastcdr::Cdr& decoder,
             SecureDataTag& tag,
+            SessionKeyCache& remote_session_keys,
             const CryptoTransformKind& transformation_kind,
             const CryptoTransformKeyId& receiver_specific_key_id,
             const std::array<uint8_t, 32>& receiver_specific_key,
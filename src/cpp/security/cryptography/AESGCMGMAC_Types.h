@@ -26,6 +26,9 @@
 #include <fastdds/rtps/security/accesscontrol/ParticipantSecurityAttributes.h>
 #include <fastdds/rtps/security/accesscontrol/EndpointSecurityAttributes.h>
 
+#include <openssl/evp.h>
+
+#include <array>
 #include <mutex>
 #include <limits>
 
@@ -126,15 +129,184 @@ struct SecureDataTag{
  * Note: the common key of the remote cryptohandle is stored along with the specific keys. KeyMaterial->master_sender_key
  */
 
+/* Receiver specific MAC context
+ * -----------------------------
+ * Holds a cipher context with the key schedule of a receiver specific session key already computed.
+ * The same key is used to compute the receiver specific MAC of every message sent on a session, so for each of them
+ * only the initialization vector is set, and neither the context nor the key schedule are created again.
+ */
+class ReceiverMacContext
+{
+    public:
+
+        ReceiverMacContext() : ctx_(nullptr), has_key_(false)
+        {
+        }
+
+        ~ReceiverMacContext()
+        {
+            EVP_CIPHER_CTX_free(ctx_);
+        }
+
+        ReceiverMacContext(
+                const ReceiverMacContext&) = delete;
+
+        ReceiverMacContext& operator =(
+                const ReceiverMacContext&) = delete;
+
+        bool has_key() const
+        {
+            return has_key_;
+        }
+
+        /*!
+         * Set the session key used by the next MAC computations.
+         * @param cipher AES-GCM cipher matching the length of the key.
+         * @param session_key Receiver specific session key.
+         * @return true on success.
+         */
+        bool set_key(
+                const EVP_CIPHER* cipher,
+                const std::array<uint8_t, 32>& session_key)
+        {
+            has_key_ = false;
+            if (nullptr == ctx_)
+            {
+                ctx_ = EVP_CIPHER_CTX_new();
+            }
+
+            if (nullptr != ctx_ && nullptr != cipher &&
+                    EVP_EncryptInit_ex(ctx_, cipher, nullptr, session_key.data(), nullptr))
+            {
+                has_key_ = true;
+            }
+
+            return has_key_;
+        }
+
+        /*!
+         * Prepare the context to compute the MAC of a message.
+         * @param initialization_vector Initialization vector of the message.
+         * @return The context to use, or nullptr on error.
+         */
+        EVP_CIPHER_CTX* init(
+                const std::array<uint8_t, 12>& initialization_vector)
+        {
+            if (!has_key_ || !EVP_EncryptInit_ex(ctx_, nullptr, nullptr, nullptr, initialization_vector.data()))
+            {
+                return nullptr;
+            }
+
+            return ctx_;
+        }
+
+    private:
+
+        EVP_CIPHER_CTX* ctx_;
+        bool has_key_;
+};
+
 struct KeySessionData
 {
     uint32_t session_id;
     std::array<uint8_t, 32> SessionKey;
     uint64_t session_block_counter;
+    //Only used on remote entities, to compute the receiver specific MACs with SessionKey
+    ReceiverMacContext MacContext;
 
     KeySessionData() : session_id(std::numeric_limits<uint32_t>::max()), session_block_counter(0) {}
 };
 
+/* Session key cache
+ * -----------------
+ * Session keys are derived from the master keys with an HMAC, and only change every max_blocks_per_session.
+ * Received messages carry the session id they were encoded with, so the keys derived for the most recent sessions
+ * of a remote element are kept to avoid deriving them again for each message.
+ * Several threads may decode messages from the same remote element, so accesses are protected by a mutex.
+ */
+class SessionKeyCache
+{
+    public:
+
+        SessionKeyCache() : next_(0)
+        {
+        }
+
+        /*!
+         * Look for a session key on the cache.
+         * @param key_id Id of the master key the session key was derived from.
+         * @param master_key Master key the session key was derived from.
+         * @param master_salt Master salt the session key was derived from.
+         * @param session_id Id of the session.
+         * @param receiver_specific Whether it is a receiver specific session key.
+         * @param session_key [out] Where the session key is copied to.
+         * @return true when the session key was found.
+         */
+        bool find(
+                const CryptoTransformKeyId& key_id,
+                const std::array<uint8_t, 32>& master_key,
+                const std::array<uint8_t, 32>& master_salt,
+                uint32_t session_id,
+                bool receiver_specific,
+                std::array<uint8_t, 32>& session_key)
+        {
+            std::lock_guard<std::mutex> guard(mutex_);
+            for (const Entry& entry : entries_)
+            {
+                if (entry.valid && entry.session_id == session_id && entry.receiver_specific == receiver_specific &&
+                        entry.key_id == key_id && entry.master_key == master_key && entry.master_salt == master_salt)
+                {
+                    session_key = entry.session_key;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        /*!
+         * Add a session key to the cache, replacing the oldest one when it is full.
+         * Arguments are the same as on find.
+         */
+        void add(
+                const CryptoTransformKeyId& key_id,
+                const std::array<uint8_t, 32>& master_key,
+                const std::array<uint8_t, 32>& master_salt,
+                uint32_t session_id,
+                bool receiver_specific,
+                const std::array<uint8_t, 32>& session_key)
+        {
+            std::lock_guard<std::mutex> guard(mutex_);
+            Entry& entry = entries_[next_];
+            next_ = (next_ + 1) % entries_.size();
+
+            entry.valid = true;
+            entry.key_id = key_id;
+            entry.master_key = master_key;
+            entry.master_salt = master_salt;
+            entry.session_id = session_id;
+            entry.receiver_specific = receiver_specific;
+            entry.session_key = session_key;
+        }
+
+    private:
+
+        struct Entry
+        {
+            bool valid = false;
+            bool receiver_specific = false;
+            uint32_t session_id = 0;
+            CryptoTransformKeyId key_id{};
+            std::array<uint8_t, 32> master_key{};
+            std::array<uint8_t, 32> master_salt{};
+            std::array<uint8_t, 32> session_key{};
+        };
+
+        // Common and receiver specific keys for the current and the previous session
+        std::array<Entry, 4> entries_;
+        size_t next_;
+        std::mutex mutex_;
+};
+
 class  EntityKeyHandle
 {
     public:
@@ -166,6 +338,8 @@ class  EntityKeyHandle
         KeySessionData Sessions[2];
         uint64_t max_blocks_per_session;
         std::mutex mutex_;
+        //Session keys used to decode the messages received from a remote entity
+        mutable SessionKeyCache RemoteSessionKeys;
 };
 typedef HandleImpl<EntityKeyHandle> AESGCMGMAC_WriterCryptoHandle;
 typedef HandleImpl<EntityKeyHandle> AESGCMGMAC_ReaderCryptoHandle;
@@ -204,6 +378,10 @@ class  ParticipantKeyHandle
         uint64_t session_block_counter;
         uint64_t max_blocks_per_session;
         std::mutex mutex_;
+        //Only used on remote participants, to compute the receiver specific MACs with SessionKey
+        ReceiverMacContext MacContext;
+        //Session keys used to decode the messages received from a remote participant
+        mutable SessionKeyCache RemoteSessionKeys;
 };
 
 typedef HandleImpl<ParticipantKeyHandle> AESGCMGMAC_ParticipantCryptoHandle;
@@ -32,10 +32,12 @@
 #include <fastdds/dds/subscriber/DataReader.hpp>
 #include <fastdds/dds/subscriber/qos/DataReaderQos.hpp>
 #include <fastdds/dds/subscriber/DataReaderListener.hpp>
+#include <fastdds/dds/subscriber/SampleInfo.hpp>
 
 #include <asio.hpp>
 #include <condition_variable>
 #include <gtest/gtest.h>
+#include <map>
 #include <thread>
 #include <vector>
 #include <tuple>
@@ -117,6 +119,20 @@ class PubSubParticipant
 
         }
 
+        void on_data_available(
+                eprosima::fastdds::dds::DataReader* datareader) override
+        {
+            type data;
+            eprosima::fastdds::dds::SampleInfo info;
+            while (ReturnCode_t::RETCODE_OK == datareader->take_next_sample((void*)&data, &info))
+            {
+                if (info.instance_state == eprosima::fastdds::dds::ALIVE)
+                {
+                    participant_->sub_data_received(info.sample_identity);
+                }
+            }
+        }
+
     private:
 
         SubListener& operator =(
@@ -367,6 +383,21 @@ public:
         std::cout << "Subscriber discovery finished " << std::endl;
     }
 
+    /**
+     * Wait until the subscribers have received the given number of samples.
+     * @return Whether they were received before the timeout.
+     */
+    bool sub_wait_data_received(
+            unsigned int num_samples,
+            std::chrono::seconds timeout)
+    {
+        std::unique_lock<std::mutex> lock(sub_data_mutex_);
+        return sub_data_cv_.wait_for(lock, timeout, [&]()
+                       {
+                           return sub_samples_received_ >= num_samples;
+                       });
+    }
+
     void pub_wait_liveliness_lost(
             unsigned int times = 1)
     {
@@ -425,6 +456,28 @@ public:
         return *this;
     }
 
+    PubSubParticipant& history_kind(
+            const eprosima::fastdds::dds::HistoryQosPolicyKind kind)
+    {
+        datawriter_qos_.history().kind = kind;
+        datareader_qos_.history().kind = kind;
+        return *this;
+    }
+
+    PubSubParticipant& asynchronously(
+            const eprosima::fastdds::dds::PublishModeQosPolicyKind kind)
+    {
+        datawriter_qos_.publish_mode().kind = kind;
+        return *this;
+    }
+
+    PubSubParticipant& property_policy(
+            const eprosima::fastrtps::rtps::PropertyPolicy property_policy)
+    {
+        participant_qos_.properties() = property_policy;
+        return *this;
+    }
+
     PubSubParticipant& pub_liveliness_kind(
             const eprosima::fastdds::dds::LivelinessQosPolicyKind kind)
     {
@@ -566,6 +619,22 @@ private:
         sub_cv_.notify_one();
     }
 
+    void sub_data_received(
+            const eprosima::fastrtps::rtps::SampleIdentity& sample)
+    {
+        std::unique_lock<std::mutex> lock(sub_data_mutex_);
+
+        // Samples of each writer should arrive in order
+        auto it = sub_last_seq_.find(sample.writer_guid());
+        if (it != sub_last_seq_.end())
+        {
+            EXPECT_LT(it->second, sample.sequence_number());
+        }
+        sub_last_seq_[sample.writer_guid()] = sample.sequence_number();
+        ++sub_samples_received_;
+        sub_data_cv_.notify_one();
+    }
+
     //! The participant
     eprosima::fastdds::dds::DomainParticipant* participant_;
     //! Participant attributes
@@ -620,6 +689,14 @@ private:
     std::mutex pub_liveliness_mutex_;
     //! A condition variable for liveliness of publisher
     std::condition_variable pub_liveliness_cv_;
+    //! Number of samples received by the subscribers
+    unsigned int sub_samples_received_ = 0;
+    //! Last sequence number received from each writer
+    std::map<eprosima::fastrtps::rtps::GUID_t, eprosima::fastrtps::rtps::SequenceNumber_t> sub_last_seq_;
+    //! A mutex protecting received data
+    std::mutex sub_data_mutex_;
+    //! A condition variable for received data
+    std::condition_variable sub_data_cv_;
 
     eprosima::fastdds::dds::TypeSupport type_;
 };
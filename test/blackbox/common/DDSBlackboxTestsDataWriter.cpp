@@ -0,0 +1,111 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "BlackboxTests.hpp"
+
+#include "PubSubParticipant.hpp"
+#include <fastrtps/xmlparser/XMLProfileManager.h>
+
+#include <gtest/gtest.h>
+
+using namespace eprosima::fastrtps;
+using namespace eprosima::fastrtps::rtps;
+
+class DDSDataWriter : public testing::TestWithParam<bool>
+{
+public:
+
+    void SetUp() override
+    {
+        LibrarySettingsAttributes library_settings;
+        if (GetParam())
+        {
+            library_settings.intraprocess_delivery = IntraprocessDeliveryType::INTRAPROCESS_FULL;
+            xmlparser::XMLProfileManager::library_settings(library_settings);
+        }
+
+    }
+
+    void TearDown() override
+    {
+        LibrarySettingsAttributes library_settings;
+        if (GetParam())
+        {
+            library_settings.intraprocess_delivery = IntraprocessDeliveryType::INTRAPROCESS_OFF;
+            xmlparser::XMLProfileManager::library_settings(library_settings);
+        }
+    }
+
+};
+
+/*!
+ * @fn TEST_P(DDSDataWriter, AsyncWritersOnSeveralThreads)
+ * @brief This test checks that all the samples of several asynchronous writers of a participant are delivered in
+ * order when the writers are spread over several async writer threads.
+ */
+TEST_P(DDSDataWriter, AsyncWritersOnSeveralThreads)
+{
+    static constexpr unsigned int num_writers = 6u;
+    static constexpr unsigned int samples_per_writer = 20u;
+
+    PropertyPolicy properties;
+    properties.properties().emplace_back("fastdds.async_writer.threads", "3");
+
+    PubSubParticipant<HelloWorldType> writers(num_writers, 0u, num_writers, 0u);
+    writers.pub_topic_name(TEST_TOPIC_NAME)
+    .reliability(eprosima::fastdds::dds::RELIABLE_RELIABILITY_QOS)
+    .history_kind(eprosima::fastdds::dds::KEEP_ALL_HISTORY_QOS)
+    .asynchronously(eprosima::fastdds::dds::ASYNCHRONOUS_PUBLISH_MODE)
+    .property_policy(properties);
+    ASSERT_TRUE(writers.init_participant());
+
+    PubSubParticipant<HelloWorldType> readers(0u, 1u, 0u, num_writers);
+    readers.sub_topic_name(TEST_TOPIC_NAME)
+    .reliability(eprosima::fastdds::dds::RELIABLE_RELIABILITY_QOS)
+    .history_kind(eprosima::fastdds::dds::KEEP_ALL_HISTORY_QOS);
+    ASSERT_TRUE(readers.init_participant());
+    ASSERT_TRUE(readers.init_subscriber(0));
+
+    for (unsigned int i = 0; i < num_writers; ++i)
+    {
+        ASSERT_TRUE(writers.init_publisher(i));
+    }
+
+    writers.pub_wait_discovery();
+    readers.sub_wait_discovery();
+
+    // Writers send at the same time, so their threads run concurrently
+    auto data = default_helloworld_data_generator(samples_per_writer);
+    for (auto& sample : data)
+    {
+        for (unsigned int i = 0; i < num_writers; ++i)
+        {
+            ASSERT_TRUE(writers.send_sample(sample, i));
+        }
+    }
+
+    ASSERT_TRUE(readers.sub_wait_data_received(num_writers * samples_per_writer, std::chrono::seconds(10)));
+}
+
+INSTANTIATE_TEST_CASE_P(DDSDataWriter,
+        DDSDataWriter,
+        testing::Values(false, true),
+        [](const testing::TestParamInfo<DDSDataWriter::ParamType>& info)
+        {
+            if (info.param)
+            {
+                return "Intraprocess";
+            }
+            return "NonIntraprocess";
+        });
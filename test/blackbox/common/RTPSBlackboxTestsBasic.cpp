@@ -81,6 +81,42 @@ TEST_P(RTPS, RTPSAsNonReliableSocket)
     reader.block_for_at_least(2);
 }
 
+/*!
+ * Data directed to ENTITYID_UNKNOWN from a writer no reader is matched with should reach every reader accepting
+ * messages from unknown writers.
+ */
+TEST_P(RTPS, RTPSAsNonReliableSocketWithUnmatchedReaders)
+{
+    RTPSAsSocketReader<HelloWorldType> reader_1(TEST_TOPIC_NAME);
+    RTPSAsSocketReader<HelloWorldType> reader_2(TEST_TOPIC_NAME);
+    RTPSAsSocketWriter<HelloWorldType> writer(TEST_TOPIC_NAME);
+    std::string ip("239.255.1.4");
+
+    reader_1.add_to_multicast_locator_list(ip, global_port).init();
+    ASSERT_TRUE(reader_1.isInitialized());
+    reader_2.add_to_multicast_locator_list(ip, global_port).init();
+    ASSERT_TRUE(reader_2.isInitialized());
+
+    writer.reliability(eprosima::fastrtps::rtps::ReliabilityKind_t::BEST_EFFORT).
+    add_to_multicast_locator_list(ip, global_port).init();
+
+    ASSERT_TRUE(writer.isInitialized());
+
+    auto data = default_helloworld_data_generator();
+
+    reader_1.expected_data(data);
+    reader_1.startReception();
+    reader_2.expected_data(data);
+    reader_2.startReception();
+    // Send data
+    writer.send(data);
+    // In this test all data should be sent.
+    ASSERT_TRUE(data.empty());
+    // Block readers until reception finished or timeout.
+    reader_1.block_for_at_least(2);
+    reader_2.block_for_at_least(2);
+}
+
 TEST_P(RTPS, AsyncRTPSAsNonReliableSocket)
 {
     RTPSAsSocketReader<HelloWorldType> reader(TEST_TOPIC_NAME);
@@ -81,7 +81,32 @@ public:
     MOCK_METHOD0(ParticipantProxiesEnd, ResourceLimitedVector<ParticipantProxyData*>::const_iterator());
     // *INDENT-ON*
 
+    class TopicIteration
+    {
+    public:
+
+        explicit TopicIteration(
+                const PDP& /*pdp*/)
+        {
+        }
+
+    };
+
+    const std::vector<ReaderProxyData*>& reader_proxies_on_topic(
+            const string_255& /*topic_name*/) const
+    {
+        return reader_proxies_;
+    }
+
+    const std::vector<WriterProxyData*>& writer_proxies_on_topic(
+            const string_255& /*topic_name*/) const
+    {
+        return writer_proxies_;
+    }
+
     std::recursive_mutex* mutex_;
+    std::vector<ReaderProxyData*> reader_proxies_;
+    std::vector<WriterProxyData*> writer_proxies_;
 };
 
 
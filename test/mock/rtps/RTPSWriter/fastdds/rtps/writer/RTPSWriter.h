@@ -98,6 +98,10 @@ public:
     {
     }
 
+    virtual void wake_up_async_thread()
+    {
+    }
+
     virtual bool try_remove_change(
             const std::chrono::steady_clock::time_point&,
             std::unique_lock<RecursiveTimedMutex>&)
@@ -165,6 +169,10 @@ public:
 
     LivelinessLostStatus liveliness_lost_status_;
 
+    RTPSWriter* next_[2] = {nullptr, nullptr};
+
+    uint32_t async_thread_index_ = 0;
+
 };
 
 } // namespace rtps
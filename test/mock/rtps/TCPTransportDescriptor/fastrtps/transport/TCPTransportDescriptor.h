@@ -157,10 +157,13 @@ typedef struct TCPTransportDescriptor : public SocketTransportDescriptor
     uint16_t logical_port_range;
     uint16_t logical_port_increment;
     uint32_t tcp_negotiation_timeout;
+    uint32_t reactor_threads = 0;
     bool enable_tcp_nodelay;
+    bool non_blocking_send = false;
     bool wait_for_tcp_negotiation;
     bool calculate_crc;
     bool check_crc;
+    bool use_crc32c = true;
     bool apply_security;
 
     TLSConfig tls_config;
@@ -0,0 +1,291 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file main_ReceiveBenchmark.cpp
+ *
+ * Compares the snapshots of associated endpoints used by MessageReceiver with the mutex it replaced.
+ *
+ * Each simulated transport has a receive thread dispatching submessages to the readers associated with its
+ * receiver, while a discovery thread keeps associating and removing an endpoint on every receiver, the way the
+ * participant does when endpoints are created and deleted.
+ */
+
+#include <fastrtps/utils/SnapshotPtr.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+using namespace eprosima::fastrtps;
+using clock_type = std::chrono::steady_clock;
+
+struct Reader
+{
+    explicit Reader(
+            uint32_t id)
+        : entity_id(id)
+    {
+    }
+
+    // Simulates the work done by a reader with a submessage
+    void process(
+            std::chrono::nanoseconds work)
+    {
+        auto end = clock_type::now() + work;
+        while (clock_type::now() < end)
+        {
+        }
+        ++processed;
+    }
+
+    uint32_t entity_id;
+    uint64_t processed = 0;
+};
+
+using ReaderTable = std::unordered_map<uint32_t, std::vector<Reader*> >;
+
+// Former MessageReceiver approach: a mutex taken by each submessage and by endpoint (dis)association
+class MutexReceiver
+{
+public:
+
+    void associate(
+            Reader* reader)
+    {
+        std::lock_guard<std::mutex> guard(mtx_);
+        readers_[reader->entity_id].push_back(reader);
+    }
+
+    void remove(
+            Reader* reader)
+    {
+        std::lock_guard<std::mutex> guard(mtx_);
+        auto it = readers_.find(reader->entity_id);
+        if (it != readers_.end())
+        {
+            readers_.erase(it);
+        }
+    }
+
+    void dispatch(
+            uint32_t entity_id,
+            std::chrono::nanoseconds work)
+    {
+        std::lock_guard<std::mutex> guard(mtx_);
+        auto it = readers_.find(entity_id);
+        if (it != readers_.end())
+        {
+            for (Reader* reader : it->second)
+            {
+                reader->process(work);
+            }
+        }
+    }
+
+private:
+
+    std::mutex mtx_;
+    ReaderTable readers_;
+};
+
+class SnapshotReceiver
+{
+public:
+
+    void associate(
+            Reader* reader)
+    {
+        readers_.update([reader](ReaderTable& readers)
+                {
+                    readers[reader->entity_id].push_back(reader);
+                    return true;
+                });
+    }
+
+    void remove(
+            Reader* reader)
+    {
+        readers_.update_and_synchronize([reader](ReaderTable& readers)
+                {
+                    return 0 < readers.erase(reader->entity_id);
+                });
+    }
+
+    void dispatch(
+            uint32_t entity_id,
+            std::chrono::nanoseconds work)
+    {
+        auto readers = readers_.load();
+        auto it = readers->find(entity_id);
+        if (it != readers->end())
+        {
+            for (Reader* reader : it->second)
+            {
+                reader->process(work);
+            }
+        }
+    }
+
+private:
+
+    SnapshotPtr<ReaderTable> readers_;
+};
+
+struct Result
+{
+    double submessages_per_second;
+    double discovery_per_second;
+    double max_association_us;
+};
+
+template<typename Receiver>
+static Result run(
+        size_t num_transports,
+        size_t num_readers,
+        std::chrono::nanoseconds work,
+        std::chrono::milliseconds duration)
+{
+    std::vector<std::unique_ptr<Receiver> > receivers;
+    std::vector<std::unique_ptr<Reader> > readers;
+    for (size_t i = 0; i < num_transports; ++i)
+    {
+        receivers.emplace_back(new Receiver());
+    }
+    for (uint32_t id = 0; id < num_readers; ++id)
+    {
+        readers.emplace_back(new Reader(id));
+        for (auto& receiver : receivers)
+        {
+            receiver->associate(readers.back().get());
+        }
+    }
+
+    std::atomic<bool> stop(false);
+    std::vector<uint64_t> submessages(num_transports, 0);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < num_transports; ++i)
+    {
+        threads.emplace_back([&, i]()
+                {
+                    Receiver& receiver = *receivers[i];
+                    uint32_t id = static_cast<uint32_t>(i);
+                    uint64_t count = 0;
+                    while (!stop.load(std::memory_order_relaxed))
+                    {
+                        receiver.dispatch(id, work);
+                        id = (id + 1) % static_cast<uint32_t>(num_readers);
+                        ++count;
+                    }
+                    submessages[i] = count;
+                });
+    }
+
+    // Discovery creates and deletes an endpoint on every receiver
+    uint64_t discovery_operations = 0;
+    double max_association_us = 0;
+    Reader discovered(static_cast<uint32_t>(num_readers));
+    auto start = clock_type::now();
+    auto end = start + duration;
+    while (clock_type::now() < end)
+    {
+        auto association_start = clock_type::now();
+        for (auto& receiver : receivers)
+        {
+            receiver->associate(&discovered);
+        }
+        double association_us = std::chrono::duration<double, std::micro>(
+            clock_type::now() - association_start).count();
+        max_association_us = std::max(max_association_us, association_us);
+
+        for (auto& receiver : receivers)
+        {
+            receiver->remove(&discovered);
+        }
+        ++discovery_operations;
+    }
+    stop = true;
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+    double elapsed = std::chrono::duration<double>(clock_type::now() - start).count();
+
+    for (auto& reader : readers)
+    {
+        for (auto& receiver : receivers)
+        {
+            receiver->remove(reader.get());
+        }
+    }
+
+    uint64_t total = 0;
+    for (uint64_t count : submessages)
+    {
+        total += count;
+    }
+
+    return {
+               static_cast<double>(total) / elapsed,
+               static_cast<double>(discovery_operations) / elapsed,
+               max_association_us
+    };
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    size_t num_readers = 200;
+    std::chrono::nanoseconds work(2000);
+    std::chrono::milliseconds duration(1000);
+    std::vector<size_t> transport_counts = {1, 2, 4, 8};
+
+    if (argc > 1)
+    {
+        num_readers = static_cast<size_t>(std::strtoul(argv[1], nullptr, 10));
+    }
+    if (argc > 2)
+    {
+        work = std::chrono::nanoseconds(std::strtoul(argv[2], nullptr, 10));
+    }
+    if (argc > 3)
+    {
+        transport_counts.assign(1, static_cast<size_t>(std::strtoul(argv[3], nullptr, 10)));
+    }
+
+    printf("%10s | %14s %14s %16s | %14s %14s %16s\n", "", "mutex", "", "", "snapshot", "", "");
+    printf("%10s | %14s %14s %16s | %14s %14s %16s\n", "transports", "submsg/s", "discovery/s", "max assoc (us)",
+            "submsg/s", "discovery/s", "max assoc (us)");
+    for (size_t num_transports : transport_counts)
+    {
+        Result mutex_result = run<MutexReceiver>(num_transports, num_readers, work, duration);
+        Result snapshot_result = run<SnapshotReceiver>(num_transports, num_readers, work, duration);
+
+        printf("%10zu | %14.0f %14.0f %16.1f | %14.0f %14.0f %16.1f\n", num_transports,
+                mutex_result.submessages_per_second, mutex_result.discovery_per_second,
+                mutex_result.max_association_us,
+                snapshot_result.submessages_per_second, snapshot_result.discovery_per_second,
+                snapshot_result.max_association_us);
+    }
+
+    return 0;
+}
@@ -0,0 +1,278 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file main_CryptoBenchmark.cpp
+ *
+ * Measures the number of messages per second the builtin AES-GCM-GMAC plugin is able to encode and decode, for
+ * RTPS messages protected with origin authentication and for encrypted serialized payloads.
+ * RTPS messages carry a receiver specific MAC for each of the receiving participants.
+ *
+ * Usage: CryptoBenchmark [message_size] [messages] [receivers]
+ */
+
+#include <security/cryptography/AESGCMGMAC.h>
+#include <security/authentication/PKIIdentityHandle.h>
+#include <security/accesscontrol/AccessPermissionsHandle.h>
+#include <fastrtps/rtps/common/CDRMessage_t.h>
+
+#include <openssl/rand.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+using namespace eprosima::fastrtps::rtps;
+using namespace eprosima::fastrtps::rtps::security;
+using clock_type = std::chrono::steady_clock;
+
+static void fill_shared_secret(
+        SharedSecretHandle& shared_secret)
+{
+    const char* names[] = { "Challenge1", "Challenge2", "SharedSecret" };
+    for (const char* name : names)
+    {
+        std::vector<uint8_t> value(32);
+        RAND_bytes(value.data(), 32);
+
+        SharedSecret::BinaryData binary_data;
+        binary_data.name(name);
+        binary_data.value(value);
+        shared_secret->data_.push_back(binary_data);
+    }
+}
+
+static void report(
+        const char* name,
+        uint32_t messages,
+        clock_type::duration encode_time,
+        clock_type::duration decode_time)
+{
+    double encode_secs = std::chrono::duration<double>(encode_time).count();
+    double decode_secs = std::chrono::duration<double>(decode_time).count();
+    printf("%-20s encode %10.0f msg/s    decode %10.0f msg/s\n", name, messages / encode_secs,
+            messages / decode_secs);
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    uint32_t message_size = 256;
+    uint32_t messages = 200000;
+    uint32_t num_receivers = 1;
+
+    if (argc > 1)
+    {
+        message_size = static_cast<uint32_t>(std::strtoul(argv[1], nullptr, 10));
+    }
+    if (argc > 2)
+    {
+        messages = static_cast<uint32_t>(std::strtoul(argv[2], nullptr, 10));
+    }
+    if (argc > 3)
+    {
+        num_receivers = static_cast<uint32_t>(std::strtoul(argv[3], nullptr, 10));
+    }
+
+    if (0 == message_size || message_size > 60000 || 0 == messages || 0 == num_receivers || num_receivers > 1000)
+    {
+        printf("Usage: CryptoBenchmark [message_size (1-60000)] [messages] [receivers (1-1000)]\n");
+        return -1;
+    }
+
+    AESGCMGMAC plugin;
+    PKIIdentityHandle i_handle;
+    AccessPermissionsHandle perm_handle;
+    SharedSecretHandle shared_secret;
+    PropertySeq prop_handle;
+    SecurityException exception;
+
+    fill_shared_secret(shared_secret);
+
+    ParticipantSecurityAttributes part_sec_attr;
+    part_sec_attr.is_rtps_protected = true;
+    part_sec_attr.plugin_participant_attributes = PLUGIN_PARTICIPANT_SECURITY_ATTRIBUTES_FLAG_IS_RTPS_ENCRYPTED |
+            PLUGIN_PARTICIPANT_SECURITY_ATTRIBUTES_FLAG_IS_RTPS_ORIGIN_AUTHENTICATED;
+
+    EndpointSecurityAttributes sec_attrs;
+    sec_attrs.is_submessage_protected = true;
+    sec_attrs.is_payload_protected = true;
+    sec_attrs.plugin_endpoint_attributes = PLUGIN_ENDPOINT_SECURITY_ATTRIBUTES_FLAG_IS_SUBMESSAGE_ENCRYPTED |
+            PLUGIN_ENDPOINT_SECURITY_ATTRIBUTES_FLAG_IS_SUBMESSAGE_ORIGIN_AUTHENTICATED |
+            PLUGIN_ENDPOINT_SECURITY_ATTRIBUTES_FLAG_IS_PAYLOAD_ENCRYPTED;
+
+    // Participant A sends to participant B
+    ParticipantCryptoHandle* participant_A = plugin.keyfactory()->register_local_participant(i_handle, perm_handle,
+                    prop_handle, part_sec_attr, exception);
+    ParticipantCryptoHandle* participant_B = plugin.keyfactory()->register_local_participant(i_handle, perm_handle,
+                    prop_handle, part_sec_attr, exception);
+    if (nullptr == participant_A || nullptr == participant_B)
+    {
+        printf("Error registering participants\n");
+        return -1;
+    }
+
+    ParticipantCryptoHandle* remote_B = plugin.keyfactory()->register_matched_remote_participant(*participant_A,
+                    i_handle, perm_handle, shared_secret, exception);
+    ParticipantCryptoHandle* remote_A = plugin.keyfactory()->register_matched_remote_participant(*participant_B,
+                    i_handle, perm_handle, shared_secret, exception);
+
+    ParticipantCryptoTokenSeq tokens_A, tokens_B;
+    plugin.keyexchange()->create_local_participant_crypto_tokens(tokens_A, *participant_A, *remote_B, exception);
+    plugin.keyexchange()->create_local_participant_crypto_tokens(tokens_B, *participant_B, *remote_A, exception);
+    plugin.keyexchange()->set_remote_participant_crypto_tokens(*participant_A, *remote_B, tokens_B, exception);
+    plugin.keyexchange()->set_remote_participant_crypto_tokens(*participant_B, *remote_A, tokens_A, exception);
+
+    // Writer on participant A, reader on participant B
+    DatawriterCryptoHandle* writer = plugin.keyfactory()->register_local_datawriter(*participant_A, prop_handle,
+                    sec_attrs, exception);
+    DatareaderCryptoHandle* reader = plugin.keyfactory()->register_local_datareader(*participant_B, prop_handle,
+                    sec_attrs, exception);
+    DatareaderCryptoHandle* remote_reader = plugin.keyfactory()->register_matched_remote_datareader(*writer,
+                    *remote_B, shared_secret, false, exception);
+    DatawriterCryptoHandle* remote_writer = plugin.keyfactory()->register_matched_remote_datawriter(*reader,
+                    *remote_A, shared_secret, exception);
+
+    DatawriterCryptoTokenSeq writer_tokens;
+    DatareaderCryptoTokenSeq reader_tokens;
+    plugin.keyexchange()->create_local_datawriter_crypto_tokens(writer_tokens, *writer, *remote_reader, exception);
+    plugin.keyexchange()->create_local_datareader_crypto_tokens(reader_tokens, *reader, *remote_writer, exception);
+    plugin.keyexchange()->set_remote_datareader_crypto_tokens(*writer, *remote_reader, reader_tokens, exception);
+    plugin.keyexchange()->set_remote_datawriter_crypto_tokens(*reader, *remote_writer, writer_tokens, exception);
+
+    // Other participants receiving the RTPS messages of participant A
+    std::vector<ParticipantCryptoHandle*> receivers{ remote_B };
+    for (uint32_t i = 1; i < num_receivers; ++i)
+    {
+        receivers.push_back(plugin.keyfactory()->register_matched_remote_participant(*participant_A, i_handle,
+                perm_handle, shared_secret, exception));
+    }
+
+    uint32_t extra_size = 1024 + 20 * num_receivers;
+    bool ok = true;
+
+    printf("%u messages of %u bytes, %u receivers\n", messages, message_size, num_receivers);
+
+    // RTPS messages
+    {
+        CDRMessage_t plain(message_size);
+        CDRMessage_t decoded(message_size + extra_size);
+        std::vector<CDRMessage_t> encoded(messages < 1024 ? messages : 1024, CDRMessage_t(message_size + extra_size));
+
+        RAND_bytes(plain.buffer, static_cast<int>(message_size));
+        plain.length = message_size;
+
+        clock_type::duration encode_time = clock_type::duration::zero();
+        clock_type::duration decode_time = clock_type::duration::zero();
+
+        // Encode a batch, and then decode it, so decoding is measured on messages of different sessions
+        for (uint32_t sent = 0; ok && sent < messages; sent += static_cast<uint32_t>(encoded.size()))
+        {
+            auto t0 = clock_type::now();
+            for (CDRMessage_t& msg : encoded)
+            {
+                msg.pos = 0;
+                msg.length = 0;
+                plain.pos = 0;
+                ok &= plugin.cryptotransform()->encode_rtps_message(msg, plain, *participant_A, receivers,
+                                exception);
+            }
+            auto t1 = clock_type::now();
+            for (CDRMessage_t& msg : encoded)
+            {
+                msg.pos = 0;
+                decoded.pos = 0;
+                decoded.length = 0;
+                ok &= plugin.cryptotransform()->decode_rtps_message(decoded, msg, *participant_B, *remote_A,
+                                exception);
+            }
+            auto t2 = clock_type::now();
+            encode_time += t1 - t0;
+            decode_time += t2 - t1;
+        }
+
+        ok &= (decoded.length == message_size) && (0 == memcmp(decoded.buffer, plain.buffer, message_size));
+        report("RTPS message", messages, encode_time, decode_time);
+    }
+
+    // Serialized payloads
+    {
+        SerializedPayload_t plain(message_size);
+        SerializedPayload_t decoded(message_size + extra_size);
+        std::vector<SerializedPayload_t> encoded(messages < 1024 ? messages : 1024);
+        std::vector<uint8_t> inline_qos;
+
+        for (SerializedPayload_t& payload : encoded)
+        {
+            payload.reserve(message_size + extra_size);
+        }
+
+        RAND_bytes(plain.data, static_cast<int>(message_size));
+        plain.length = message_size;
+
+        clock_type::duration encode_time = clock_type::duration::zero();
+        clock_type::duration decode_time = clock_type::duration::zero();
+
+        for (uint32_t sent = 0; ok && sent < messages; sent += static_cast<uint32_t>(encoded.size()))
+        {
+            auto t0 = clock_type::now();
+            for (SerializedPayload_t& payload : encoded)
+            {
+                payload.pos = 0;
+                payload.length = 0;
+                plain.pos = 0;
+                ok &= plugin.cryptotransform()->encode_serialized_payload(payload, inline_qos, plain, *writer,
+                                exception);
+            }
+            auto t1 = clock_type::now();
+            for (SerializedPayload_t& payload : encoded)
+            {
+                payload.pos = 0;
+                decoded.pos = 0;
+                decoded.length = 0;
+                ok &= plugin.cryptotransform()->decode_serialized_payload(decoded, payload, inline_qos, *reader,
+                                *remote_writer, exception);
+            }
+            auto t2 = clock_type::now();
+            encode_time += t1 - t0;
+            decode_time += t2 - t1;
+        }
+
+        ok &= (decoded.length == message_size) && (0 == memcmp(decoded.data, plain.data, message_size));
+        report("Serialized payload", messages, encode_time, decode_time);
+    }
+
+    plugin.keyfactory()->unregister_datawriter(writer, exception);
+    plugin.keyfactory()->unregister_datawriter(remote_writer, exception);
+    plugin.keyfactory()->unregister_datareader(reader, exception);
+    plugin.keyfactory()->unregister_datareader(remote_reader, exception);
+    plugin.keyfactory()->unregister_participant(remote_A, exception);
+    for (ParticipantCryptoHandle* receiver : receivers)
+    {
+        plugin.keyfactory()->unregister_participant(receiver, exception);
+    }
+    plugin.keyfactory()->unregister_participant(participant_A, exception);
+    plugin.keyfactory()->unregister_participant(participant_B, exception);
+
+    if (!ok)
+    {
+        printf("Error encoding or decoding messages\n");
+        return -1;
+    }
+
+    return 0;
+}
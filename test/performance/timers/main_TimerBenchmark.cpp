@@ -0,0 +1,212 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file main_TimerBenchmark.cpp
+ *
+ * Compares the timing wheel used by ResourceEvent with the sorted vector it replaced, re-arming timers on a
+ * simulated clock the way reliable endpoints do (heartbeats, nack response and nack supression delays).
+ */
+
+#include <rtps/resources/TimerWheel.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using namespace eprosima::fastrtps::rtps;
+using clock_type = std::chrono::steady_clock;
+
+struct Timer : public TimerWheelEntry
+{
+    clock_type::time_point deadline;
+};
+
+// Former ResourceEvent approach: timers sorted by deadline on a vector
+class SortedVectorTimers
+{
+public:
+
+    static bool compare(
+            const Timer* lhs,
+            const Timer* rhs)
+    {
+        return lhs->deadline < rhs->deadline;
+    }
+
+    void arm(
+            Timer* timer,
+            clock_type::time_point deadline)
+    {
+        cancel(timer);
+        timer->deadline = deadline;
+        timers_.insert(std::lower_bound(timers_.begin(), timers_.end(), timer, compare), timer);
+    }
+
+    void cancel(
+            Timer* timer)
+    {
+        auto it = std::lower_bound(timers_.begin(), timers_.end(), timer, compare);
+        it = std::find(it, timers_.end(), timer);
+        if (it != timers_.end())
+        {
+            timers_.erase(it);
+        }
+    }
+
+    size_t expire(
+            clock_type::time_point now)
+    {
+        auto it = timers_.begin();
+        while (it != timers_.end() && (*it)->deadline <= now)
+        {
+            ++it;
+        }
+        size_t ret = static_cast<size_t>(it - timers_.begin());
+        timers_.erase(timers_.begin(), it);
+        return ret;
+    }
+
+private:
+
+    std::vector<Timer*> timers_;
+};
+
+class WheelTimers
+{
+public:
+
+    explicit WheelTimers(
+            clock_type::time_point origin)
+        : wheel_(origin)
+    {
+    }
+
+    void arm(
+            Timer* timer,
+            clock_type::time_point deadline)
+    {
+        wheel_.remove(timer);
+        wheel_.insert(timer, deadline);
+    }
+
+    void cancel(
+            Timer* timer)
+    {
+        wheel_.remove(timer);
+    }
+
+    size_t expire(
+            clock_type::time_point now)
+    {
+        expired_.clear();
+        wheel_.advance(now, expired_);
+        return expired_.size();
+    }
+
+private:
+
+    TimerWheel wheel_;
+    std::vector<TimerWheelEntry*> expired_;
+};
+
+template<typename Timers>
+static double run(
+        Timers& timers,
+        clock_type::time_point origin,
+        size_t num_timers,
+        size_t num_operations,
+        size_t& expired)
+{
+    std::mt19937 gen(1234);
+    std::uniform_int_distribution<size_t> pick(0, num_timers - 1);
+    std::uniform_int_distribution<int> delay_ms(1, 3000);
+    std::uniform_int_distribution<int> action(0, 9);
+
+    std::vector<Timer> entries(num_timers);
+    clock_type::time_point now = origin;
+    for (Timer& timer : entries)
+    {
+        timers.arm(&timer, now + std::chrono::milliseconds(delay_ms(gen)));
+    }
+
+    expired = 0;
+    auto start = clock_type::now();
+    for (size_t i = 0; i < num_operations; ++i)
+    {
+        Timer* timer = &entries[pick(gen)];
+        if (0 == action(gen))
+        {
+            timers.cancel(timer);
+        }
+        else
+        {
+            timers.arm(timer, now + std::chrono::milliseconds(delay_ms(gen)));
+        }
+
+        // Simulated time runs 10 microseconds per operation
+        now += std::chrono::microseconds(10);
+        if (0 == (i % 64))
+        {
+            expired += timers.expire(now);
+        }
+    }
+    auto end = clock_type::now();
+
+    return std::chrono::duration<double, std::nano>(end - start).count() / static_cast<double>(num_operations);
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    size_t num_operations = 1000000;
+    std::vector<size_t> timer_counts = {100, 1000, 10000, 100000};
+
+    if (argc > 1)
+    {
+        num_operations = static_cast<size_t>(std::strtoul(argv[1], nullptr, 10));
+    }
+    if (argc > 2)
+    {
+        timer_counts.assign(1, static_cast<size_t>(std::strtoul(argv[2], nullptr, 10)));
+    }
+
+    printf("%10s %18s %18s %10s\n", "timers", "vector (ns/op)", "wheel (ns/op)", "expired");
+    for (size_t num_timers : timer_counts)
+    {
+        clock_type::time_point origin = clock_type::now();
+        size_t vector_expired = 0;
+        size_t wheel_expired = 0;
+
+        SortedVectorTimers vector_timers;
+        double vector_ns = run(vector_timers, origin, num_timers, num_operations, vector_expired);
+
+        WheelTimers wheel_timers(origin);
+        double wheel_ns = run(wheel_timers, origin, num_timers, num_operations, wheel_expired);
+
+        if (vector_expired != wheel_expired)
+        {
+            printf("Mismatch on expired timers: %zu != %zu\n", vector_expired, wheel_expired);
+            return 1;
+        }
+
+        printf("%10zu %18.1f %18.1f %10zu\n", num_timers, vector_ns, wheel_ns, wheel_expired);
+    }
+
+    return 0;
+}
@@ -115,6 +115,88 @@ public:
 
 };
 
+struct LoanableType
+{
+    uint32_t index;
+    double value;
+};
+
+class LoanableTopicDataTypeMock : public TopicDataType
+{
+public:
+
+    typedef LoanableType type;
+
+    LoanableTopicDataTypeMock()
+        : TopicDataType()
+    {
+        m_typeSize = 4u + sizeof(LoanableType);
+        setName("loanabletype");
+    }
+
+    bool serialize(
+            void* data,
+            fastrtps::rtps::SerializedPayload_t* payload) override
+    {
+        payload->data[0] = 0;
+        payload->data[1] = CDR_LE;
+        payload->data[2] = 0;
+        payload->data[3] = 0;
+        memcpy(payload->data + 4, data, sizeof(LoanableType));
+        payload->length = m_typeSize;
+        return true;
+    }
+
+    bool deserialize(
+            fastrtps::rtps::SerializedPayload_t* payload,
+            void* data) override
+    {
+        memcpy(data, payload->data + 4, sizeof(LoanableType));
+        return true;
+    }
+
+    std::function<uint32_t()> getSerializedSizeProvider(
+            void* /*data*/) override
+    {
+        return [this]()
+               {
+                   return m_typeSize;
+               };
+    }
+
+    void* createData() override
+    {
+        return new LoanableType();
+    }
+
+    void deleteData(
+            void* data) override
+    {
+        delete static_cast<LoanableType*>(data);
+    }
+
+    bool getKey(
+            void* /*data*/,
+            fastrtps::rtps::InstanceHandle_t* /*ihandle*/,
+            bool /*force_md5*/) override
+    {
+        return true;
+    }
+
+    inline bool is_plain() const override
+    {
+        return true;
+    }
+
+    inline bool construct_sample(
+            void* memory) const override
+    {
+        new (memory) LoanableType();
+        return true;
+    }
+
+};
+
 TEST(DataWriterTests, ChangeDataWriterQos)
 {
     DomainParticipant* participant =
@@ -204,6 +286,101 @@ TEST(DataWriterTests, Write)
     ASSERT_TRUE(DomainParticipantFactory::get_instance()->delete_participant(participant) == ReturnCode_t::RETCODE_OK);
 }
 
+TEST(DataWriterTests, LoanPositiveTests)
+{
+    DomainParticipant* participant =
+            DomainParticipantFactory::get_instance()->create_participant(0, PARTICIPANT_QOS_DEFAULT);
+    ASSERT_NE(participant, nullptr);
+
+    Publisher* publisher = participant->create_publisher(PUBLISHER_QOS_DEFAULT);
+    ASSERT_NE(publisher, nullptr);
+
+    TypeSupport type(new LoanableTopicDataTypeMock());
+    type.register_type(participant);
+
+    Topic* topic = participant->create_topic("loanable_topic", type.get_type_name(), TOPIC_QOS_DEFAULT);
+    ASSERT_NE(topic, nullptr);
+
+    DataWriter* datawriter = publisher->create_datawriter(topic, DATAWRITER_QOS_DEFAULT);
+    ASSERT_NE(datawriter, nullptr);
+
+    // Loan, modify and write a sample
+    void* sample = nullptr;
+    ASSERT_EQ(ReturnCode_t::RETCODE_OK, datawriter->loan_sample(sample));
+    ASSERT_NE(nullptr, sample);
+    static_cast<LoanableType*>(sample)->index = 1u;
+    EXPECT_TRUE(datawriter->write(sample));
+
+    // Loan with zero initialization
+    ASSERT_EQ(ReturnCode_t::RETCODE_OK,
+            datawriter->loan_sample(sample, DataWriter::LoanInitializationKind::ZERO_LOAN_INITIALIZATION));
+    ASSERT_NE(nullptr, sample);
+    EXPECT_EQ(0u, static_cast<LoanableType*>(sample)->index);
+    EXPECT_EQ(ReturnCode_t::RETCODE_OK, datawriter->write(sample, fastrtps::rtps::c_InstanceHandle_Unknown));
+
+    // Loan with in-place construction and discard
+    ASSERT_EQ(ReturnCode_t::RETCODE_OK,
+            datawriter->loan_sample(sample, DataWriter::LoanInitializationKind::CONSTRUCTED_LOAN_INITIALIZATION));
+    ASSERT_NE(nullptr, sample);
+    EXPECT_EQ(ReturnCode_t::RETCODE_OK, datawriter->discard_loan(sample));
+    EXPECT_EQ(nullptr, sample);
+
+    // Samples still loaned when the writer is deleted are returned to the history
+    ASSERT_EQ(ReturnCode_t::RETCODE_OK, datawriter->loan_sample(sample));
+
+    ASSERT_TRUE(publisher->delete_datawriter(datawriter) == ReturnCode_t::RETCODE_OK);
+    ASSERT_TRUE(participant->delete_topic(topic) == ReturnCode_t::RETCODE_OK);
+    ASSERT_TRUE(participant->delete_publisher(publisher) == ReturnCode_t::RETCODE_OK);
+    ASSERT_TRUE(DomainParticipantFactory::get_instance()->delete_participant(participant) == ReturnCode_t::RETCODE_OK);
+}
+
+TEST(DataWriterTests, LoanNegativeTests)
+{
+    DomainParticipant* participant =
+            DomainParticipantFactory::get_instance()->create_participant(0, PARTICIPANT_QOS_DEFAULT);
+    ASSERT_NE(participant, nullptr);
+
+    Publisher* publisher = participant->create_publisher(PUBLISHER_QOS_DEFAULT);
+    ASSERT_NE(publisher, nullptr);
+
+    // Non-plain types cannot be loaned
+    TypeSupport type(new TopicDataTypeMock());
+    type.register_type(participant);
+
+    Topic* topic = participant->create_topic("footopic", type.get_type_name(), TOPIC_QOS_DEFAULT);
+    ASSERT_NE(topic, nullptr);
+
+    DataWriter* datawriter = publisher->create_datawriter(topic, DATAWRITER_QOS_DEFAULT);
+    ASSERT_NE(datawriter, nullptr);
+
+    void* sample = nullptr;
+    EXPECT_EQ(ReturnCode_t::RETCODE_ILLEGAL_OPERATION, datawriter->loan_sample(sample));
+    EXPECT_EQ(ReturnCode_t::RETCODE_ILLEGAL_OPERATION, datawriter->discard_loan(sample));
+
+    ASSERT_TRUE(publisher->delete_datawriter(datawriter) == ReturnCode_t::RETCODE_OK);
+    ASSERT_TRUE(participant->delete_topic(topic) == ReturnCode_t::RETCODE_OK);
+
+    // Discarding a pointer that was not loaned is rejected
+    TypeSupport loanable_type(new LoanableTopicDataTypeMock());
+    loanable_type.register_type(participant);
+
+    topic = participant->create_topic("loanable_topic", loanable_type.get_type_name(), TOPIC_QOS_DEFAULT);
+    ASSERT_NE(topic, nullptr);
+
+    datawriter = publisher->create_datawriter(topic, DATAWRITER_QOS_DEFAULT);
+    ASSERT_NE(datawriter, nullptr);
+
+    LoanableType data;
+    sample = &data;
+    EXPECT_EQ(ReturnCode_t::RETCODE_BAD_PARAMETER, datawriter->discard_loan(sample));
+    EXPECT_EQ(&data, sample);
+
+    ASSERT_TRUE(publisher->delete_datawriter(datawriter) == ReturnCode_t::RETCODE_OK);
+    ASSERT_TRUE(participant->delete_topic(topic) == ReturnCode_t::RETCODE_OK);
+    ASSERT_TRUE(participant->delete_publisher(publisher) == ReturnCode_t::RETCODE_OK);
+    ASSERT_TRUE(DomainParticipantFactory::get_instance()->delete_participant(participant) == ReturnCode_t::RETCODE_OK);
+}
+
 void set_listener_test (
         DataWriter* writer,
         DataWriterListener* listener,
@@ -24,6 +24,9 @@
 #include <fastdds/dds/subscriber/Subscriber.hpp>
 #include <fastdds/dds/subscriber/DataReaderListener.hpp>
 #include <fastdds/dds/subscriber/SampleInfo.hpp>
+#include <fastdds/dds/core/LoanableSequence.hpp>
+#include <fastdds/dds/publisher/Publisher.hpp>
+#include <fastdds/dds/publisher/DataWriter.hpp>
 #include <dds/sub/Subscriber.hpp>
 #include <dds/sub/DataReader.hpp>
 #include <dds/sub/qos/DataReaderQos.hpp>
@@ -34,6 +37,10 @@
 #include <fastrtps/attributes/SubscriberAttributes.h>
 #include <fastrtps/xmlparser/XMLProfileManager.h>
 
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
 
 namespace eprosima {
 namespace fastdds {
@@ -157,6 +164,376 @@ TEST(DataReaderTests, ReadData)
 }
 
 
+TEST(DataReaderTests, ReadTakeCollections)
+{
+    DomainParticipant* participant =
+            DomainParticipantFactory::get_instance()->create_participant(0, PARTICIPANT_QOS_DEFAULT);
+    ASSERT_NE(participant, nullptr);
+
+    Subscriber* subscriber = participant->create_subscriber(SUBSCRIBER_QOS_DEFAULT);
+    ASSERT_NE(subscriber, nullptr);
+
+    TypeSupport type(new TopicDataTypeMock());
+    type.register_type(participant);
+
+    Topic* topic = participant->create_topic("footopic", type.get_type_name(), TOPIC_QOS_DEFAULT);
+    ASSERT_NE(topic, nullptr);
+
+    DataReader* data_reader = subscriber->create_datareader(topic, DATAREADER_QOS_DEFAULT);
+    ASSERT_NE(data_reader, nullptr);
+
+    // Loan requested on an empty history
+    LoanableSequence<FooType> data_seq;
+    SampleInfoSeq info_seq;
+    EXPECT_EQ(data_reader->read(data_seq, info_seq), ReturnCode_t::RETCODE_NO_DATA);
+    EXPECT_EQ(data_reader->take(data_seq, info_seq), ReturnCode_t::RETCODE_NO_DATA);
+    EXPECT_TRUE(data_seq.has_ownership());
+    EXPECT_EQ(data_seq.maximum(), 0);
+
+    // Copy requested on an empty history
+    LoanableSequence<FooType> data_buffer(10);
+    SampleInfoSeq info_buffer(10);
+    EXPECT_EQ(data_reader->read(data_buffer, info_buffer, 5), ReturnCode_t::RETCODE_NO_DATA);
+    EXPECT_EQ(data_reader->take(data_buffer, info_buffer), ReturnCode_t::RETCODE_NO_DATA);
+    EXPECT_EQ(data_buffer.length(), 0);
+
+    // Collections with different properties
+    EXPECT_EQ(data_reader->read(data_buffer, info_seq), ReturnCode_t::RETCODE_PRECONDITION_NOT_MET);
+    EXPECT_EQ(data_reader->take(data_seq, info_buffer), ReturnCode_t::RETCODE_PRECONDITION_NOT_MET);
+
+    // Invalid number of samples
+    EXPECT_EQ(data_reader->take(data_seq, info_seq, -2), ReturnCode_t::RETCODE_BAD_PARAMETER);
+
+    // Collections not loaned by the reader
+    EXPECT_EQ(data_reader->return_loan(data_seq, info_seq), ReturnCode_t::RETCODE_PRECONDITION_NOT_MET);
+    FooType* foreign_data[1] = { nullptr };
+    SampleInfo* foreign_info[1] = { nullptr };
+    ASSERT_TRUE(data_seq.loan(reinterpret_cast<LoanableCollection::element_type*>(foreign_data), 1, 1));
+    ASSERT_TRUE(info_seq.loan(reinterpret_cast<LoanableCollection::element_type*>(foreign_info), 1, 1));
+    EXPECT_EQ(data_reader->return_loan(data_seq, info_seq), ReturnCode_t::RETCODE_PRECONDITION_NOT_MET);
+    data_seq.unloan();
+    info_seq.unloan();
+
+    ASSERT_EQ(subscriber->delete_datareader(data_reader), ReturnCode_t::RETCODE_OK);
+    ASSERT_EQ(participant->delete_topic(topic), ReturnCode_t::RETCODE_OK);
+    ASSERT_EQ(participant->delete_subscriber(subscriber), ReturnCode_t::RETCODE_OK);
+    ASSERT_EQ(DomainParticipantFactory::get_instance()->delete_participant(participant), ReturnCode_t::RETCODE_OK);
+}
+
+//! Sample whose serialized form is its representation in memory.
+struct IndexedFoo
+{
+    int32_t index;
+};
+
+class IndexedFooType : public TopicDataType
+{
+public:
+
+    explicit IndexedFooType(
+            bool plain)
+        : TopicDataType()
+        , plain_(plain)
+    {
+        setName("indexedfootype");
+        m_typeSize = fastrtps::rtps::SerializedPayload_t::representation_header_size + sizeof(IndexedFoo);
+    }
+
+    bool serialize(
+            void* data,
+            fastrtps::rtps::SerializedPayload_t* payload) override
+    {
+        payload->encapsulation = (fastrtps::rtps::DEFAULT_ENDIAN == fastrtps::rtps::BIGEND) ? CDR_BE : CDR_LE;
+        payload->data[0] = 0;
+        payload->data[1] = static_cast<fastrtps::rtps::octet>(payload->encapsulation);
+        payload->data[2] = 0;
+        payload->data[3] = 0;
+        memcpy(payload->data + fastrtps::rtps::SerializedPayload_t::representation_header_size, data, sizeof(IndexedFoo));
+        payload->length = m_typeSize;
+        return true;
+    }
+
+    bool deserialize(
+            fastrtps::rtps::SerializedPayload_t* payload,
+            void* data) override
+    {
+        memcpy(data, payload->data + fastrtps::rtps::SerializedPayload_t::representation_header_size, sizeof(IndexedFoo));
+        return true;
+    }
+
+    std::function<uint32_t()> getSerializedSizeProvider(
+            void* /*data*/) override
+    {
+        uint32_t size = m_typeSize;
+        return [size]()
+               {
+                   return size;
+               };
+    }
+
+    void* createData() override
+    {
+        return new IndexedFoo();
+    }
+
+    void deleteData(
+            void* data) override
+    {
+        delete static_cast<IndexedFoo*>(data);
+    }
+
+    bool getKey(
+            void* /*data*/,
+            fastrtps::rtps::InstanceHandle_t* /*ihandle*/,
+            bool /*force_md5*/) override
+    {
+        return false;
+    }
+
+    bool is_plain() const override
+    {
+        return plain_;
+    }
+
+private:
+
+    bool plain_;
+};
+
+/**
+ * Participant with a writer and a reader of IndexedFoo samples on the same topic.
+ * The samples are delivered to the reader without going through the transports.
+ */
+class IndexedFooEntities : public DataReaderListener
+{
+public:
+
+    IndexedFooEntities(
+            bool plain,
+            const std::string& topic_name = "indexedfootopic")
+    {
+        participant_ = DomainParticipantFactory::get_instance()->create_participant(0, PARTICIPANT_QOS_DEFAULT);
+        EXPECT_NE(participant_, nullptr);
+
+        TypeSupport type(new IndexedFooType(plain));
+        type.register_type(participant_);
+
+        topic_ = participant_->create_topic(topic_name, type.get_type_name(), TOPIC_QOS_DEFAULT);
+        EXPECT_NE(topic_, nullptr);
+
+        subscriber_ = participant_->create_subscriber(SUBSCRIBER_QOS_DEFAULT);
+        DataReaderQos reader_qos = DATAREADER_QOS_DEFAULT;
+        reader_qos.reliability().kind = RELIABLE_RELIABILITY_QOS;
+        reader_qos.history().kind = KEEP_ALL_HISTORY_QOS;
+        reader = subscriber_->create_datareader(topic_, reader_qos, this);
+        EXPECT_NE(reader, nullptr);
+
+        publisher_ = participant_->create_publisher(PUBLISHER_QOS_DEFAULT);
+        writer_ = publisher_->create_datawriter(topic_, DATAWRITER_QOS_DEFAULT);
+        EXPECT_NE(writer_, nullptr);
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        EXPECT_TRUE(cv_.wait_for(lock, std::chrono::seconds(5), [this]()
+                {
+                    return matched_;
+                }));
+    }
+
+    ~IndexedFooEntities()
+    {
+        EXPECT_EQ(publisher_->delete_datawriter(writer_), ReturnCode_t::RETCODE_OK);
+        EXPECT_EQ(participant_->delete_publisher(publisher_), ReturnCode_t::RETCODE_OK);
+        EXPECT_EQ(subscriber_->delete_datareader(reader), ReturnCode_t::RETCODE_OK);
+        EXPECT_EQ(participant_->delete_subscriber(subscriber_), ReturnCode_t::RETCODE_OK);
+        EXPECT_EQ(participant_->delete_topic(topic_), ReturnCode_t::RETCODE_OK);
+        EXPECT_EQ(DomainParticipantFactory::get_instance()->delete_participant(participant_),
+                ReturnCode_t::RETCODE_OK);
+    }
+
+    //! Write samples with consecutive indexes, and wait until the reader has received them.
+    bool send(
+            int32_t first,
+            int32_t count)
+    {
+        for (int32_t i = first; i < first + count; ++i)
+        {
+            IndexedFoo sample{ i };
+            if (!writer_->write(&sample))
+            {
+                return false;
+            }
+        }
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        return cv_.wait_for(lock, std::chrono::seconds(5), [this, first, count]()
+                       {
+                           return received_ >= first + count;
+                       });
+    }
+
+    void on_subscription_matched(
+            DataReader*,
+            const SubscriptionMatchedStatus& info) override
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+        matched_ = info.current_count > 0;
+        cv_.notify_all();
+    }
+
+    void on_data_available(
+            DataReader*) override
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+        ++received_;
+        cv_.notify_all();
+    }
+
+    DataReader* reader = nullptr;
+
+private:
+
+    DomainParticipant* participant_ = nullptr;
+    Topic* topic_ = nullptr;
+    Subscriber* subscriber_ = nullptr;
+    Publisher* publisher_ = nullptr;
+    DataWriter* writer_ = nullptr;
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool matched_ = false;
+    int32_t received_ = 0;
+};
+
+static void check_samples(
+        LoanableSequence<IndexedFoo>& data_seq,
+        SampleInfoSeq& info_seq,
+        int32_t first,
+        int32_t count)
+{
+    ASSERT_EQ(data_seq.length(), count);
+    ASSERT_EQ(info_seq.length(), count);
+    for (int32_t i = 0; i < count; ++i)
+    {
+        EXPECT_EQ(data_seq[i].index, first + i);
+        EXPECT_TRUE(info_seq[i].valid_data);
+        EXPECT_EQ(info_seq[i].instance_state, ALIVE);
+    }
+}
+
+TEST(DataReaderTests, ReadTakeSamplesCopied)
+{
+    IndexedFooEntities entities(false);
+    DataReader* reader = entities.reader;
+    ASSERT_TRUE(entities.send(0, 5));
+
+    LoanableSequence<IndexedFoo> data_seq(10);
+    SampleInfoSeq info_seq(10);
+
+    // Read samples are kept on the reader, but are not read again
+    ASSERT_EQ(reader->read(data_seq, info_seq, 3), ReturnCode_t::RETCODE_OK);
+    check_samples(data_seq, info_seq, 0, 3);
+    EXPECT_TRUE(data_seq.has_ownership());
+    ASSERT_EQ(reader->read(data_seq, info_seq), ReturnCode_t::RETCODE_OK);
+    check_samples(data_seq, info_seq, 3, 2);
+    EXPECT_EQ(reader->read(data_seq, info_seq), ReturnCode_t::RETCODE_NO_DATA);
+
+    // Take gets all of them, up to the size of the collection
+    ASSERT_TRUE(entities.send(5, 10));
+    ASSERT_EQ(reader->take(data_seq, info_seq), ReturnCode_t::RETCODE_OK);
+    check_samples(data_seq, info_seq, 0, 10);
+    ASSERT_EQ(reader->take(data_seq, info_seq), ReturnCode_t::RETCODE_OK);
+    check_samples(data_seq, info_seq, 10, 5);
+    EXPECT_EQ(reader->take(data_seq, info_seq), ReturnCode_t::RETCODE_NO_DATA);
+
+    // Collections owning their buffer are not loans
+    EXPECT_EQ(reader->return_loan(data_seq, info_seq), ReturnCode_t::RETCODE_PRECONDITION_NOT_MET);
+}
+
+/*!
+ * Checks samples loaned by a reader, for plain types (pointing to the received payload) or not (deserialized on
+ * samples owned by the reader).
+ */
+static void check_loaned_samples(
+        bool plain)
+{
+    IndexedFooEntities entities(plain);
+    DataReader* reader = entities.reader;
+    ASSERT_TRUE(entities.send(0, 6));
+
+    // Read loans
+    LoanableSequence<IndexedFoo> data_seq;
+    SampleInfoSeq info_seq;
+    ASSERT_EQ(reader->read(data_seq, info_seq, 2), ReturnCode_t::RETCODE_OK);
+    EXPECT_FALSE(data_seq.has_ownership());
+    EXPECT_FALSE(info_seq.has_ownership());
+    check_samples(data_seq, info_seq, 0, 2);
+
+    // Loaned collections cannot be used again until they are returned
+    EXPECT_EQ(reader->read(data_seq, info_seq), ReturnCode_t::RETCODE_PRECONDITION_NOT_MET);
+    EXPECT_EQ(reader->take(data_seq, info_seq), ReturnCode_t::RETCODE_PRECONDITION_NOT_MET);
+    check_samples(data_seq, info_seq, 0, 2);
+
+    ASSERT_EQ(reader->return_loan(data_seq, info_seq), ReturnCode_t::RETCODE_OK);
+    EXPECT_TRUE(data_seq.has_ownership());
+    EXPECT_TRUE(info_seq.has_ownership());
+    EXPECT_EQ(data_seq.length(), 0);
+    EXPECT_EQ(data_seq.maximum(), 0);
+
+    // A loan can only be returned once
+    EXPECT_EQ(reader->return_loan(data_seq, info_seq), ReturnCode_t::RETCODE_PRECONDITION_NOT_MET);
+
+    // Take loans, several at the same time
+    LoanableSequence<IndexedFoo> other_data_seq;
+    SampleInfoSeq other_info_seq;
+    ASSERT_EQ(reader->take(data_seq, info_seq, 3), ReturnCode_t::RETCODE_OK);
+    check_samples(data_seq, info_seq, 0, 3);
+    ASSERT_EQ(reader->take(other_data_seq, other_info_seq), ReturnCode_t::RETCODE_OK);
+    check_samples(other_data_seq, other_info_seq, 3, 3);
+    LoanableSequence<IndexedFoo> empty_data_seq;
+    SampleInfoSeq empty_info_seq;
+    EXPECT_EQ(reader->take(empty_data_seq, empty_info_seq), ReturnCode_t::RETCODE_NO_DATA);
+
+    // Collections of different loans cannot be returned together
+    EXPECT_EQ(reader->return_loan(data_seq, other_info_seq), ReturnCode_t::RETCODE_PRECONDITION_NOT_MET);
+    EXPECT_EQ(reader->return_loan(other_data_seq, info_seq), ReturnCode_t::RETCODE_PRECONDITION_NOT_MET);
+
+    // Loans of other readers cannot be returned
+    {
+        IndexedFooEntities other_entities(plain, "otherindexedfootopic");
+        LoanableSequence<IndexedFoo> foreign_data_seq;
+        SampleInfoSeq foreign_info_seq;
+        ASSERT_TRUE(other_entities.send(0, 2));
+        ASSERT_EQ(other_entities.reader->take(foreign_data_seq, foreign_info_seq), ReturnCode_t::RETCODE_OK);
+        EXPECT_EQ(reader->return_loan(foreign_data_seq, foreign_info_seq),
+                ReturnCode_t::RETCODE_PRECONDITION_NOT_MET);
+        EXPECT_EQ(other_entities.reader->return_loan(foreign_data_seq, foreign_info_seq), ReturnCode_t::RETCODE_OK);
+    }
+
+    // Samples keep their values until their loan is returned, even when more samples are received
+    ASSERT_TRUE(entities.send(6, 4));
+    check_samples(data_seq, info_seq, 0, 3);
+    check_samples(other_data_seq, other_info_seq, 3, 3);
+
+    // Loans are returned in any order
+    ASSERT_EQ(reader->return_loan(other_data_seq, other_info_seq), ReturnCode_t::RETCODE_OK);
+    ASSERT_EQ(reader->return_loan(data_seq, info_seq), ReturnCode_t::RETCODE_OK);
+
+    // Returned loans are reused
+    ASSERT_EQ(reader->take(data_seq, info_seq), ReturnCode_t::RETCODE_OK);
+    check_samples(data_seq, info_seq, 6, 4);
+
+    // Loans not returned are released with the reader
+}
+
+TEST(DataReaderTests, ReadTakeSamplesLoaned)
+{
+    check_loaned_samples(false);
+}
+
+TEST(DataReaderTests, ReadTakeSamplesLoanedPlain)
+{
+    check_loaned_samples(true);
+}
 
 void set_listener_test (
         DataReader* reader,
@@ -313,6 +313,42 @@ TEST_F(LogTests, validate_multithread_flush_calls)
     }
 }
 
+// 'burst_logging' tests that entries logged from several threads at once are all delivered with a timestamp
+TEST_F(LogTests, burst_logging)
+{
+    constexpr int threads_number = 4;
+    constexpr int entries_per_thread = 256;
+
+    uint64_t dropped_before = Log::GetDroppedEntries();
+
+    vector<unique_ptr<thread>> threads;
+    for (int i = 0; i < threads_number; i++)
+    {
+        threads.emplace_back(new thread([i]
+        {
+            for (int j = 0; j < entries_per_thread; j++)
+            {
+                logWarning(burst_checks, "Thread " << i << " entry " << j);
+            }
+        }));
+    }
+
+    for (auto& thread : threads) {
+        thread->join();
+    }
+
+    Log::Flush();
+
+    // The queue is big enough for the whole burst
+    auto consumedEntries = mockConsumer->ConsumedEntries();
+    ASSERT_EQ(static_cast<size_t>(threads_number * entries_per_thread), consumedEntries.size());
+    ASSERT_EQ(dropped_before, Log::GetDroppedEntries());
+    for (auto& entry : consumedEntries)
+    {
+        ASSERT_FALSE(entry.timestamp.empty());
+    }
+}
+
 std::vector<Log::Entry> LogTests::HELPER_WaitForEntries(uint32_t amount)
 {
     size_t entries = 0;
@@ -15,12 +15,21 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
 #include <fastdds/rtps/builtin/discovery/endpoint/EDP.h>
 #include <fastdds/rtps/builtin/discovery/participant/PDP.h>
 #include <fastrtps/rtps/builtin/data/WriterProxyData.h>
 #include <fastrtps/rtps/builtin/data/ReaderProxyData.h>
+#include <fastdds/rtps/reader/StatefulReader.h>
+#include <fastdds/rtps/writer/StatefulWriter.h>
 #include <rtps/participant/RTPSParticipantImpl.h>
 #include <rtps/participant/RTPSParticipantImpl.h>
+#include <rtps/builtin/data/ProxyTopicIndex.hpp>
 
 
 namespace eprosima {
@@ -45,6 +54,9 @@ public:
     {
     }
 
+    using EDP::pairingReader;
+    using EDP::pairingWriter;
+
     bool initEDP(
             BuiltinAttributes& /*attributes*/) override
     {
@@ -388,6 +400,144 @@ TEST_F(EdpTests, CheckPositiveAckCompatibility)
     }
 }
 
+TEST(ProxyTopicIndexTests, ProxiesByTopic)
+{
+    ::testing::NiceMock<ReaderProxyData> reader_1(1, 1);
+    ::testing::NiceMock<ReaderProxyData> reader_2(1, 1);
+    ::testing::NiceMock<ReaderProxyData> reader_3(1, 1);
+    reader_1.topicName("Topic");
+    reader_2.topicName("AnotherTopic");
+    reader_3.topicName("Topic");
+
+    ProxyTopicIndex<ReaderProxyData> index;
+    EXPECT_TRUE(index.find("Topic").empty());
+
+    index.add(&reader_1);
+    index.add(&reader_2);
+    index.add(&reader_3);
+
+    const std::vector<ReaderProxyData*>& topic_readers = index.find("Topic");
+    ASSERT_EQ(2u, topic_readers.size());
+    EXPECT_EQ(&reader_1, topic_readers[0]);
+    EXPECT_EQ(&reader_3, topic_readers[1]);
+    ASSERT_EQ(1u, index.find("AnotherTopic").size());
+    EXPECT_EQ(&reader_2, index.find("AnotherTopic")[0]);
+    EXPECT_TRUE(index.find("UnknownTopic").empty());
+
+    EXPECT_EQ(2u, index.topic_count());
+
+    // Collections of a topic are kept while they are being iterated
+    index.begin_iteration();
+    index.remove(&reader_1);
+    index.remove(&reader_3);
+    EXPECT_TRUE(topic_readers.empty());
+    EXPECT_EQ(2u, index.topic_count());
+
+    index.add(&reader_3);
+    ASSERT_EQ(1u, topic_readers.size());
+    EXPECT_EQ(&reader_3, topic_readers[0]);
+    index.remove(&reader_3);
+    index.end_iteration();
+    EXPECT_EQ(1u, index.topic_count());
+    EXPECT_TRUE(index.find("Topic").empty());
+
+    // Removing a proxy twice has no effect
+    index.remove(&reader_3);
+    EXPECT_EQ(1u, index.find("AnotherTopic").size());
+
+    // Otherwise they are erased with their last proxy
+    index.remove(&reader_2);
+    EXPECT_EQ(0u, index.topic_count());
+    EXPECT_TRUE(index.find("AnotherTopic").empty());
+}
+
+//! Prints the time EDP pairing takes when visiting all the proxies and when visiting the proxies on the same topic.
+TEST_F(EdpTests, PairingBenchmark)
+{
+    const size_t proxies_per_topic = 10;
+    const int repetitions = 100;
+    std::recursive_mutex pdp_mutex;
+    pdp_.mutex_ = &pdp_mutex;
+
+    ::testing::NiceMock<StatefulReader> reader;
+    reader.setListener(nullptr);
+    ::testing::NiceMock<StatefulWriter> writer;
+    GUID_t writer_guid(GuidPrefix_t(), 1);
+    ON_CALL(static_cast<RTPSWriter&>(writer), getGuid()).WillByDefault(ReturnRef(writer_guid));
+
+    for (size_t num_proxies : {100u, 1000u, 10000u})
+    {
+        // Proxies on the same type and QoS, spread over several topics
+        std::vector<std::unique_ptr<::testing::NiceMock<WriterProxyData>>> writers;
+        std::vector<std::unique_ptr<::testing::NiceMock<ReaderProxyData>>> readers;
+        ProxyTopicIndex<WriterProxyData> writer_index;
+        ProxyTopicIndex<ReaderProxyData> reader_index;
+        std::vector<WriterProxyData*> all_writers;
+        std::vector<ReaderProxyData*> all_readers;
+        for (size_t n = 0; n < num_proxies; ++n)
+        {
+            std::string topic_name = "Topic_" + std::to_string(n / proxies_per_topic);
+            writers.emplace_back(new ::testing::NiceMock<WriterProxyData>(1, 1));
+            writers.back()->guid(GUID_t(GuidPrefix_t(), static_cast<uint32_t>(2 * n + 2)));
+            writers.back()->topicName(topic_name.c_str());
+            writers.back()->typeName("TypeName");
+            writers.back()->topicKind(TopicKind_t::NO_KEY);
+            writers.back()->isAlive(true);
+            writer_index.add(writers.back().get());
+            all_writers.push_back(writers.back().get());
+
+            readers.emplace_back(new ::testing::NiceMock<ReaderProxyData>(1, 1));
+            readers.back()->guid(GUID_t(GuidPrefix_t(), static_cast<uint32_t>(2 * n + 3)));
+            readers.back()->topicName(topic_name.c_str());
+            readers.back()->typeName("TypeName");
+            readers.back()->topicKind(TopicKind_t::NO_KEY);
+            readers.back()->m_qos.type_consistency.m_force_type_validation = false;
+            readers.back()->isAlive(true);
+            reader_index.add(readers.back().get());
+            all_readers.push_back(readers.back().get());
+        }
+
+        rdata->topicName("Topic_0");
+        wdata->topicName("Topic_0");
+
+        auto measure = [&](const char* name)
+                {
+                    auto start = std::chrono::steady_clock::now();
+                    for (int i = 0; i < repetitions; ++i)
+                    {
+                        edp->pairingReader(&reader, GUID_t(), *rdata);
+                    }
+                    auto reader_time = std::chrono::steady_clock::now() - start;
+
+                    start = std::chrono::steady_clock::now();
+                    for (int i = 0; i < repetitions; ++i)
+                    {
+                        edp->pairingWriter(&writer, GUID_t(), *wdata);
+                    }
+                    auto writer_time = std::chrono::steady_clock::now() - start;
+
+                    std::cout << num_proxies << " proxies, " << name << ": pairingReader " <<
+                        std::chrono::duration<double, std::micro>(reader_time).count() / repetitions <<
+                        " us, pairingWriter " <<
+                        std::chrono::duration<double, std::micro>(writer_time).count() / repetitions <<
+                        " us" << std::endl;
+                };
+
+        // All the proxies are visited, as before the topic index
+        pdp_.writer_proxies_ = all_writers;
+        pdp_.reader_proxies_ = all_readers;
+        measure("all proxies");
+
+        pdp_.writer_proxies_ = writer_index.find("Topic_0");
+        pdp_.reader_proxies_ = reader_index.find("Topic_0");
+        ASSERT_EQ(proxies_per_topic, pdp_.writer_proxies_.size());
+        ASSERT_EQ(proxies_per_topic, pdp_.reader_proxies_.size());
+        measure("topic index");
+    }
+
+    pdp_.writer_proxies_.clear();
+    pdp_.reader_proxies_.clear();
+}
 
 } // namespace rtps
 } // namespace fastrtps
@@ -0,0 +1,379 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <rtps/flowcontrol/SchedulingFlowController.h>
+
+#include <fastdds/rtps/attributes/PropertyPolicy.h>
+#include <fastrtps/rtps/writer/RTPSWriter.h>
+
+#include <gtest/gtest.h>
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+using namespace eprosima::fastrtps::rtps;
+using ::testing::ReturnRef;
+
+//! Writer sending its pending changes through a SchedulingFlowController, recording the order they are sent.
+class TestWriter : public RTPSWriter
+{
+public:
+
+    TestWriter(
+            char id,
+            std::vector<char>& sent_log,
+            std::mutex& log_mutex)
+        : id_(id)
+        , sent_log_(sent_log)
+        , log_mutex_(log_mutex)
+    {
+        guid_.guidPrefix.value[11] = static_cast<octet>(id);
+        guid_.entityId = EntityId_t(0x103);
+        EXPECT_CALL(*this, getGuid()).WillRepeatedly(ReturnRef(guid_));
+    }
+
+    bool matched_reader_add(
+            const ReaderProxyData&) override
+    {
+        return true;
+    }
+
+    bool matched_reader_remove(
+            const GUID_t&) override
+    {
+        return true;
+    }
+
+    bool matched_reader_is_matched(
+            const GUID_t&) override
+    {
+        return false;
+    }
+
+    void add_changes(
+            uint32_t count,
+            uint32_t size)
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            changes_.emplace_back(new CacheChange_t(size));
+            changes_.back()->sequenceNumber = {0, static_cast<uint32_t>(changes_.size())};
+            changes_.back()->serializedPayload.length = size;
+            pending_.push_back(changes_.back().get());
+        }
+    }
+
+    void send_any_unsent_changes() override
+    {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [this]()
+                    {
+                        return !blocked_;
+                    });
+        }
+
+        std::lock_guard<std::mutex> guard(mutex_);
+        RTPSWriterCollector<ReaderLocator*> collector;
+        for (CacheChange_t* change : pending_)
+        {
+            collector.add_change(change, nullptr, FragmentNumberSet_t());
+        }
+
+        controller_->filter(this, collector);
+
+        pending_.erase(pending_.begin(), pending_.begin() + collector.size());
+        std::lock_guard<std::mutex> log_guard(log_mutex_);
+        for (size_t i = 0; i < collector.size(); ++i)
+        {
+            sent_log_.push_back(id_);
+        }
+    }
+
+    size_t pending()
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+        return pending_.size();
+    }
+
+    void block(
+            bool blocked)
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+        blocked_ = blocked;
+        cv_.notify_all();
+    }
+
+    SchedulingFlowController* controller_ = nullptr;
+
+private:
+
+    char id_;
+    GUID_t guid_;
+    std::vector<char>& sent_log_;
+    std::mutex& log_mutex_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool blocked_ = false;
+    std::vector<std::unique_ptr<CacheChange_t>> changes_;
+    std::vector<CacheChange_t*> pending_;
+};
+
+class SchedulingFlowControllerTests : public ::testing::Test
+{
+protected:
+
+    TestWriter& add_writer(
+            SchedulingFlowController& controller,
+            char id,
+            int32_t priority = 0)
+    {
+        writers_.emplace_back(new TestWriter(id, sent_log_, log_mutex_));
+        TestWriter& writer = *writers_.back();
+        writer.controller_ = &controller;
+
+        PropertyPolicy properties;
+        properties.properties().emplace_back("fastdds.sfc.priority", std::to_string(priority));
+        controller.register_writer(&writer, properties);
+        return writer;
+    }
+
+    void unregister_all(
+            SchedulingFlowController& controller)
+    {
+        for (auto& writer : writers_)
+        {
+            controller.unregister_writer(writer.get());
+        }
+    }
+
+    bool wait_all_sent(
+            std::chrono::milliseconds max_wait = std::chrono::milliseconds(5000))
+    {
+        auto limit = std::chrono::steady_clock::now() + max_wait;
+        while (std::chrono::steady_clock::now() < limit)
+        {
+            bool all_sent = true;
+            for (auto& writer : writers_)
+            {
+                all_sent = all_sent && 0 == writer->pending();
+            }
+            if (all_sent)
+            {
+                return true;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return false;
+    }
+
+    std::string sent_order()
+    {
+        std::lock_guard<std::mutex> guard(log_mutex_);
+        return std::string(sent_log_.begin(), sent_log_.end());
+    }
+
+    // Gives a turn to a writer which blocks on it, so other writers queue up in a known order meanwhile.
+    void hold_turn(
+            TestWriter& gate,
+            SchedulingFlowController& controller)
+    {
+        gate.block(true);
+        gate.add_changes(1, 10);
+        controller.wake_up(&gate);
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+
+    std::mutex log_mutex_;
+    std::vector<char> sent_log_;
+    std::vector<std::unique_ptr<TestWriter>> writers_;
+};
+
+TEST_F(SchedulingFlowControllerTests, UnlimitedFifo)
+{
+    FlowControllerDescriptor descriptor;
+    descriptor.name = "fifo";
+    SchedulingFlowController controller(descriptor);
+
+    TestWriter& gate = add_writer(controller, 'G');
+    TestWriter& a = add_writer(controller, 'A');
+    TestWriter& b = add_writer(controller, 'B');
+
+    hold_turn(gate, controller);
+    a.add_changes(3, 40000);
+    b.add_changes(3, 40000);
+    controller.wake_up(&a);
+    controller.wake_up(&b);
+    gate.block(false);
+
+    ASSERT_TRUE(wait_all_sent());
+    EXPECT_EQ("GAAABBB", sent_order());
+    unregister_all(controller);
+}
+
+TEST_F(SchedulingFlowControllerTests, RoundRobin)
+{
+    FlowControllerDescriptor descriptor;
+    descriptor.name = "round_robin";
+    descriptor.scheduler = ROUND_ROBIN_SCHEDULER;
+    SchedulingFlowController controller(descriptor);
+
+    TestWriter& gate = add_writer(controller, 'G');
+    TestWriter& a = add_writer(controller, 'A');
+    TestWriter& b = add_writer(controller, 'B');
+
+    // Only one of these changes fits on a turn
+    hold_turn(gate, controller);
+    a.add_changes(3, 40000);
+    b.add_changes(3, 40000);
+    controller.wake_up(&a);
+    controller.wake_up(&b);
+    gate.block(false);
+
+    ASSERT_TRUE(wait_all_sent());
+    EXPECT_EQ("GABABAB", sent_order());
+    unregister_all(controller);
+}
+
+TEST_F(SchedulingFlowControllerTests, HighPriority)
+{
+    FlowControllerDescriptor descriptor;
+    descriptor.name = "priority";
+    descriptor.scheduler = HIGH_PRIORITY_SCHEDULER;
+    SchedulingFlowController controller(descriptor);
+
+    TestWriter& gate = add_writer(controller, 'G');
+    TestWriter& low = add_writer(controller, 'L', 10);
+    TestWriter& high = add_writer(controller, 'H', -1);
+
+    hold_turn(gate, controller);
+    low.add_changes(2, 40000);
+    high.add_changes(2, 40000);
+    controller.wake_up(&low);
+    controller.wake_up(&high);
+    gate.block(false);
+
+    ASSERT_TRUE(wait_all_sent());
+    EXPECT_EQ("GHHLL", sent_order());
+    unregister_all(controller);
+}
+
+TEST_F(SchedulingFlowControllerTests, TokenBucket)
+{
+    FlowControllerDescriptor descriptor;
+    descriptor.name = "limited";
+    descriptor.max_bytes_per_period = 5000;
+    descriptor.period_ms = 100;
+    SchedulingFlowController controller(descriptor);
+
+    TestWriter& writer = add_writer(controller, 'A');
+    writer.add_changes(15, 1000);
+
+    auto start = std::chrono::steady_clock::now();
+    controller.wake_up(&writer);
+
+    // The first five changes are sent right away, the rest as the bucket refills
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_GE(11u, writer.pending());
+    ASSERT_TRUE(wait_all_sent());
+    EXPECT_LE(180, std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - start).count());
+
+    std::vector<FlowControllerWriterStatistics> statistics;
+    controller.get_statistics(statistics);
+    ASSERT_EQ(1u, statistics.size());
+    EXPECT_EQ(15000u, statistics[0].bytes_sent);
+    EXPECT_EQ(15u, statistics[0].submessages_sent);
+    EXPECT_LT(0u, statistics[0].submessages_deferred);
+    EXPECT_EQ(0u, statistics[0].queued_bytes);
+    EXPECT_LE(9000u, statistics[0].max_queued_bytes);
+    unregister_all(controller);
+}
+
+TEST_F(SchedulingFlowControllerTests, ChangeBiggerThanBucket)
+{
+    FlowControllerDescriptor descriptor;
+    descriptor.name = "small";
+    descriptor.max_bytes_per_period = 1000;
+    descriptor.period_ms = 20;
+    SchedulingFlowController controller(descriptor);
+
+    TestWriter& writer = add_writer(controller, 'A');
+    writer.add_changes(3, 4000);
+    controller.wake_up(&writer);
+
+    ASSERT_TRUE(wait_all_sent());
+    EXPECT_EQ("AAA", sent_order());
+    unregister_all(controller);
+}
+
+TEST_F(SchedulingFlowControllerTests, Statistics)
+{
+    FlowControllerDescriptor descriptor;
+    descriptor.name = "statistics";
+    SchedulingFlowController controller(descriptor);
+
+    TestWriter& a = add_writer(controller, 'A', 3);
+    PropertyPolicy wrong;
+    wrong.properties().emplace_back("fastdds.sfc.priority", "wrong");
+    writers_.emplace_back(new TestWriter('B', sent_log_, log_mutex_));
+    writers_.back()->controller_ = &controller;
+    controller.register_writer(writers_.back().get(), wrong);
+
+    a.add_changes(2, 100);
+    controller.wake_up(&a);
+    ASSERT_TRUE(wait_all_sent());
+
+    std::vector<FlowControllerWriterStatistics> statistics;
+    controller.get_statistics(statistics);
+    ASSERT_EQ(2u, statistics.size());
+    for (const FlowControllerWriterStatistics& writer_statistics : statistics)
+    {
+        if (writer_statistics.writer_guid == a.getGuid())
+        {
+            EXPECT_EQ(3, writer_statistics.priority);
+            EXPECT_EQ(200u, writer_statistics.bytes_sent);
+            EXPECT_EQ(2u, writer_statistics.submessages_sent);
+        }
+        else
+        {
+            EXPECT_EQ(0, writer_statistics.priority);
+            EXPECT_EQ(0u, writer_statistics.bytes_sent);
+        }
+    }
+
+    // Writers unregistered do not get more turns
+    controller.unregister_writer(&a);
+    a.add_changes(1, 100);
+    controller.wake_up(&a);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_EQ(1u, a.pending());
+
+    statistics.clear();
+    controller.get_statistics(statistics);
+    EXPECT_EQ(1u, statistics.size());
+    controller.unregister_writer(writers_.back().get());
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,352 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <fastdds/rtps/common/CacheChange.h>
+
+#include <rtps/history/PoolConfig.h>
+#include <rtps/history/ReceivedBufferOwner.hpp>
+#include <rtps/history/SharedPayloadPool.hpp>
+
+#include <cstring>
+#include <memory>
+#include <vector>
+
+using namespace eprosima::fastrtps::rtps;
+using namespace ::testing;
+using namespace std;
+
+class SharedPayloadPoolTest : public TestWithParam<MemoryManagementPolicy>
+{
+protected:
+
+    static constexpr uint32_t payload_size = 128;
+
+    virtual void SetUp()
+    {
+        PoolConfig cfg { GetParam(), payload_size, 10, 0 };
+        writer_pool_ = std::make_shared<SharedPayloadPool>(cfg);
+        reader_pool_ = std::make_shared<SharedPayloadPool>(cfg);
+    }
+
+    static void fill_writer_change(
+            CacheChange_t& change,
+            uint32_t data_size)
+    {
+        change.writerGUID = GUID_t(GuidPrefix_t::unknown(), 1);
+        change.sequenceNumber = SequenceNumber_t(0, 1);
+        change.serializedPayload.length = data_size;
+        for (uint32_t i = 0; i < data_size; ++i)
+        {
+            change.serializedPayload.data[i] = static_cast<octet>(i);
+        }
+    }
+
+    static void prepare_reader_change(
+            const CacheChange_t& received,
+            CacheChange_t& change)
+    {
+        change.writerGUID = received.writerGUID;
+        change.sequenceNumber = received.sequenceNumber;
+    }
+
+    std::shared_ptr<SharedPayloadPool> writer_pool_;
+    std::shared_ptr<SharedPayloadPool> reader_pool_;
+};
+
+constexpr uint32_t SharedPayloadPoolTest::payload_size;
+
+TEST_P(SharedPayloadPoolTest, share_between_pools)
+{
+    CacheChange_t writer_change;
+    ASSERT_TRUE(writer_pool_->get_payload(64, writer_change));
+    fill_writer_change(writer_change, 64);
+
+    CacheChange_t reader_change_1;
+    CacheChange_t reader_change_2;
+    prepare_reader_change(writer_change, reader_change_1);
+    prepare_reader_change(writer_change, reader_change_2);
+
+    IPayloadPool* owner = writer_change.payload_owner();
+    ASSERT_TRUE(reader_pool_->get_payload(writer_change.serializedPayload, owner, reader_change_1));
+    ASSERT_TRUE(reader_pool_->get_payload(writer_change.serializedPayload, owner, reader_change_2));
+
+    // Readers point to the writer's buffer, and incoming data is left untouched
+    EXPECT_EQ(writer_pool_.get(), owner);
+    EXPECT_EQ(reader_pool_.get(), reader_change_1.payload_owner());
+    EXPECT_EQ(writer_change.serializedPayload.data, reader_change_1.serializedPayload.data);
+    EXPECT_EQ(writer_change.serializedPayload.data, reader_change_2.serializedPayload.data);
+    EXPECT_EQ(64u, reader_change_1.serializedPayload.length);
+
+    // Buffer is still valid after the writer releases it
+    ASSERT_TRUE(writer_pool_->release_payload(writer_change));
+    EXPECT_EQ(nullptr, writer_change.serializedPayload.data);
+    for (uint32_t i = 0; i < 64; ++i)
+    {
+        ASSERT_EQ(static_cast<octet>(i), reader_change_1.serializedPayload.data[i]);
+    }
+
+    ASSERT_TRUE(reader_pool_->release_payload(reader_change_1));
+    ASSERT_TRUE(reader_pool_->release_payload(reader_change_2));
+    EXPECT_EQ(nullptr, reader_change_2.payload_owner());
+}
+
+TEST_P(SharedPayloadPoolTest, copy_unowned_data)
+{
+    octet buffer[32];
+    memset(buffer, 0xA5, sizeof(buffer));
+
+    SerializedPayload_t data;
+    data.data = buffer;
+    data.length = sizeof(buffer);
+
+    CacheChange_t reader_change;
+    reader_change.writerGUID = GUID_t(GuidPrefix_t::unknown(), 1);
+    reader_change.sequenceNumber = SequenceNumber_t(0, 1);
+
+    IPayloadPool* owner = nullptr;
+    ASSERT_TRUE(reader_pool_->get_payload(data, owner, reader_change));
+    EXPECT_EQ(nullptr, owner);
+    EXPECT_NE(buffer, reader_change.serializedPayload.data);
+    EXPECT_EQ(0, memcmp(buffer, reader_change.serializedPayload.data, sizeof(buffer)));
+    ASSERT_TRUE(reader_pool_->release_payload(reader_change));
+
+    // Stack data should not be freed by the payload
+    data.data = nullptr;
+}
+
+TEST_P(SharedPayloadPoolTest, copy_data_of_other_owners)
+{
+    // An owner not tagged as sharing its payloads
+    struct OtherPool : public IPayloadPool
+    {
+        bool get_payload(
+                uint32_t,
+                CacheChange_t&) override
+        {
+            return false;
+        }
+
+        bool get_payload(
+                SerializedPayload_t&,
+                IPayloadPool*&,
+                CacheChange_t&) override
+        {
+            return false;
+        }
+
+        bool release_payload(
+                CacheChange_t&) override
+        {
+            return false;
+        }
+
+    };
+
+    OtherPool other_pool;
+    EXPECT_EQ(IPayloadPool::OwnerKind::OTHER, other_pool.owner_kind());
+    EXPECT_EQ(IPayloadPool::OwnerKind::SHARED_POOL, reader_pool_->owner_kind());
+
+    octet buffer[32];
+    memset(buffer, 0x5A, sizeof(buffer));
+
+    SerializedPayload_t data;
+    data.data = buffer;
+    data.length = sizeof(buffer);
+
+    CacheChange_t reader_change;
+    reader_change.writerGUID = GUID_t(GuidPrefix_t::unknown(), 1);
+    reader_change.sequenceNumber = SequenceNumber_t(0, 1);
+
+    IPayloadPool* owner = &other_pool;
+    ASSERT_TRUE(reader_pool_->get_payload(data, owner, reader_change));
+    EXPECT_EQ(&other_pool, owner);
+    EXPECT_NE(buffer, reader_change.serializedPayload.data);
+    EXPECT_EQ(0, memcmp(buffer, reader_change.serializedPayload.data, sizeof(buffer)));
+    ASSERT_TRUE(reader_pool_->release_payload(reader_change));
+
+    data.data = nullptr;
+}
+
+TEST_P(SharedPayloadPoolTest, keep_received_buffer)
+{
+    auto buffer = std::make_shared<std::vector<octet> >(64, static_cast<octet>(0x5A));
+
+    ReceivedBufferOwner received_owner;
+    received_owner.set_buffer(buffer, buffer->data(), static_cast<uint32_t>(buffer->size()));
+
+    // Received change points to the middle of the reception buffer
+    CacheChange_t received;
+    received.writerGUID = GUID_t(GuidPrefix_t::unknown(), 1);
+    received.sequenceNumber = SequenceNumber_t(0, 1);
+    received.serializedPayload.data = buffer->data() + 16;
+    received.serializedPayload.length = 32;
+    received.payload_owner(&received_owner);
+
+    CacheChange_t reader_change;
+    prepare_reader_change(received, reader_change);
+    IPayloadPool* owner = received.payload_owner();
+    ASSERT_TRUE(reader_pool_->get_payload(received.serializedPayload, owner, reader_change));
+    EXPECT_EQ(&received_owner, owner);
+    EXPECT_EQ(buffer->data() + 16, reader_change.serializedPayload.data);
+    EXPECT_EQ(32u, reader_change.serializedPayload.length);
+
+    // Reception thread is done with the buffer, but the reader still holds it
+    ASSERT_TRUE(received_owner.release_payload(received));
+    received_owner.clear();
+    EXPECT_EQ(2, buffer.use_count());
+
+    // Change is owned by the kept buffer, not by the pool
+    IPayloadPool* kept_owner = reader_change.payload_owner();
+    EXPECT_NE(reader_pool_.get(), kept_owner);
+    ASSERT_TRUE(kept_owner->release_payload(reader_change));
+    EXPECT_EQ(1, buffer.use_count());
+    EXPECT_EQ(nullptr, reader_change.serializedPayload.data);
+}
+
+TEST_P(SharedPayloadPoolTest, keep_received_buffer_on_several_readers)
+{
+    auto buffer = std::make_shared<std::vector<octet> >(64, static_cast<octet>(0x5A));
+
+    ReceivedBufferOwner received_owner;
+    received_owner.set_buffer(buffer, buffer->data(), static_cast<uint32_t>(buffer->size()));
+
+    CacheChange_t received;
+    received.writerGUID = GUID_t(GuidPrefix_t::unknown(), 1);
+    received.sequenceNumber = SequenceNumber_t(0, 1);
+    received.serializedPayload.data = buffer->data();
+    received.serializedPayload.length = 32;
+    received.payload_owner(&received_owner);
+
+    // Changes of both readers share the owner keeping the buffer
+    CacheChange_t reader_change_1;
+    CacheChange_t reader_change_2;
+    prepare_reader_change(received, reader_change_1);
+    prepare_reader_change(received, reader_change_2);
+    IPayloadPool* owner = received.payload_owner();
+    ASSERT_TRUE(reader_pool_->get_payload(received.serializedPayload, owner, reader_change_1));
+    ASSERT_TRUE(writer_pool_->get_payload(received.serializedPayload, owner, reader_change_2));
+    EXPECT_EQ(reader_change_1.payload_owner(), reader_change_2.payload_owner());
+    EXPECT_EQ(buffer->data(), reader_change_2.serializedPayload.data);
+
+    ASSERT_TRUE(received_owner.release_payload(received));
+    received_owner.clear();
+    EXPECT_EQ(2, buffer.use_count());
+
+    // Buffer is released with the last change keeping it
+    ASSERT_TRUE(reader_change_1.payload_owner()->release_payload(reader_change_1));
+    EXPECT_EQ(2, buffer.use_count());
+    ASSERT_TRUE(reader_change_2.payload_owner()->release_payload(reader_change_2));
+    EXPECT_EQ(1, buffer.use_count());
+
+    // Next buffer gets a new owner
+    received_owner.set_buffer(buffer, buffer->data(), static_cast<uint32_t>(buffer->size()));
+    received.payload_owner(&received_owner);
+    received.serializedPayload.data = buffer->data();
+    owner = received.payload_owner();
+    ASSERT_TRUE(reader_pool_->get_payload(received.serializedPayload, owner, reader_change_1));
+    EXPECT_EQ(3, buffer.use_count());
+    ASSERT_TRUE(received_owner.release_payload(received));
+    received_owner.clear();
+    ASSERT_TRUE(reader_change_1.payload_owner()->release_payload(reader_change_1));
+    EXPECT_EQ(1, buffer.use_count());
+}
+
+TEST_P(SharedPayloadPoolTest, copy_outside_received_buffer)
+{
+    auto buffer = std::make_shared<std::vector<octet> >(64, static_cast<octet>(0x5A));
+    octet decoded[16];
+    memset(decoded, 0x3C, sizeof(decoded));
+
+    ReceivedBufferOwner received_owner;
+    received_owner.set_buffer(buffer, buffer->data(), static_cast<uint32_t>(buffer->size()));
+
+    // Data decoded on a different buffer should be copied
+    SerializedPayload_t data;
+    data.data = decoded;
+    data.length = sizeof(decoded);
+
+    CacheChange_t reader_change;
+    reader_change.writerGUID = GUID_t(GuidPrefix_t::unknown(), 1);
+    reader_change.sequenceNumber = SequenceNumber_t(0, 1);
+
+    IPayloadPool* owner = &received_owner;
+    ASSERT_TRUE(reader_pool_->get_payload(data, owner, reader_change));
+    EXPECT_NE(decoded, reader_change.serializedPayload.data);
+    EXPECT_EQ(0, memcmp(decoded, reader_change.serializedPayload.data, sizeof(decoded)));
+    EXPECT_EQ(2, buffer.use_count());
+    ASSERT_TRUE(reader_pool_->release_payload(reader_change));
+
+    data.data = nullptr;
+}
+
+TEST_P(SharedPayloadPoolTest, release_after_origin_destroyed)
+{
+    CacheChange_t writer_change;
+    ASSERT_TRUE(writer_pool_->get_payload(16, writer_change));
+    fill_writer_change(writer_change, 16);
+
+    CacheChange_t reader_change;
+    prepare_reader_change(writer_change, reader_change);
+    IPayloadPool* owner = writer_change.payload_owner();
+    ASSERT_TRUE(reader_pool_->get_payload(writer_change.serializedPayload, owner, reader_change));
+
+    ASSERT_TRUE(writer_pool_->release_payload(writer_change));
+    writer_pool_.reset();
+
+    EXPECT_EQ(15u, reader_change.serializedPayload.data[15]);
+    ASSERT_TRUE(reader_pool_->release_payload(reader_change));
+}
+
+TEST_P(SharedPayloadPoolTest, preallocated_limit)
+{
+    PoolConfig cfg { MemoryManagementPolicy::PREALLOCATED_MEMORY_MODE, payload_size / 2, 10, 0 };
+    SharedPayloadPool small_pool(cfg);
+
+    CacheChange_t writer_change;
+    ASSERT_TRUE(writer_pool_->get_payload(payload_size, writer_change));
+    fill_writer_change(writer_change, payload_size);
+
+    CacheChange_t reader_change;
+    prepare_reader_change(writer_change, reader_change);
+    IPayloadPool* owner = writer_change.payload_owner();
+    EXPECT_FALSE(small_pool.get_payload(writer_change.serializedPayload, owner, reader_change));
+    EXPECT_EQ(nullptr, reader_change.payload_owner());
+
+    ASSERT_TRUE(writer_pool_->release_payload(writer_change));
+}
+
+#ifdef INSTANTIATE_TEST_SUITE_P
+#define GTEST_INSTANTIATE_TEST_MACRO(x, y, z) INSTANTIATE_TEST_SUITE_P(x, y, z)
+#else
+#define GTEST_INSTANTIATE_TEST_MACRO(x, y, z) INSTANTIATE_TEST_CASE_P(x, y, z, )
+#endif // ifdef INSTANTIATE_TEST_SUITE_P
+
+GTEST_INSTANTIATE_TEST_MACRO(
+    SharedPayloadPoolTest,
+    SharedPayloadPoolTest,
+    Values(MemoryManagementPolicy::PREALLOCATED_MEMORY_MODE,
+    MemoryManagementPolicy::PREALLOCATED_WITH_REALLOC_MEMORY_MODE,
+    MemoryManagementPolicy::DYNAMIC_RESERVE_MEMORY_MODE,
+    MemoryManagementPolicy::DYNAMIC_REUSABLE_MEMORY_MODE)
+    );
+
+int main(
+        int argc,
+        char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
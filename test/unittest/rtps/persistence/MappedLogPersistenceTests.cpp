@@ -0,0 +1,506 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fastdds/rtps/attributes/PropertyPolicy.h>
+
+#include <rtps/history/CacheChangePool.h>
+#include <rtps/persistence/PersistenceService.h>
+
+#include <cstdio>
+#include <gtest/gtest.h>
+
+using namespace eprosima::fastrtps::rtps;
+
+class NoOpPayloadPool : public IPayloadPool
+{
+    virtual bool get_payload(
+            uint32_t,
+            CacheChange_t&) override
+    {
+        return true;
+    }
+
+    virtual bool get_payload(
+            SerializedPayload_t&,
+            IPayloadPool*&,
+            CacheChange_t&) override
+    {
+        return true;
+    }
+
+    virtual bool release_payload(
+            CacheChange_t&) override
+    {
+        return true;
+    }
+
+};
+
+class MappedLogPersistenceTest : public ::testing::Test
+{
+protected:
+
+    IPersistenceService* service = nullptr;
+
+    PropertyPolicy policy;
+
+    std::shared_ptr<NoOpPayloadPool> payload_pool_ = std::make_shared<NoOpPayloadPool>();
+
+    std::shared_ptr<CacheChangePool> change_pool_;
+
+    virtual void SetUp()
+    {
+        remove_files();
+
+        policy.properties().emplace_back("dds.persistence.plugin", "builtin.MAPPED_LOG");
+        policy.properties().emplace_back("dds.persistence.mapped_log.filename", "test.log");
+
+        auto init_cache = [](CacheChange_t* item)
+                {
+                    item->serializedPayload.reserve(128);
+                };
+        PoolConfig cfg{ MemoryManagementPolicy_t::PREALLOCATED_MEMORY_MODE, 0, 100, 0 };
+        change_pool_ = std::make_shared<CacheChangePool>(cfg, init_cache);
+    }
+
+    virtual void TearDown()
+    {
+        if (service != nullptr)
+        {
+            delete service;
+        }
+
+        remove_files();
+    }
+
+    static std::string segment_name(
+            uint32_t index)
+    {
+        char name[32];
+        snprintf(name, sizeof(name), "test.log.%08u", index);
+        return name;
+    }
+
+    static bool segment_exists(
+            uint32_t index)
+    {
+        FILE* f = std::fopen(segment_name(index).c_str(), "rb");
+        if (f != nullptr)
+        {
+            std::fclose(f);
+            return true;
+        }
+        return false;
+    }
+
+    static void remove_files()
+    {
+        std::remove("test.log");
+        std::remove("test.log.tmp");
+        for (uint32_t i = 0; i < 1000; ++i)
+        {
+            std::remove(segment_name(i).c_str());
+        }
+    }
+
+    void restart()
+    {
+        delete service;
+        service = PersistenceFactory::create_persistence_service(policy);
+        ASSERT_NE(service, nullptr);
+    }
+
+    void load(
+            const std::string& persist_guid,
+            const GUID_t& guid,
+            std::vector<CacheChange_t*>& changes,
+            SequenceNumber_t& max_seq)
+    {
+        for (CacheChange_t* change : changes)
+        {
+            change_pool_->release_cache(change);
+        }
+        changes.clear();
+        ASSERT_TRUE(service->load_writer_from_storage(persist_guid, guid, changes, change_pool_, payload_pool_,
+                max_seq));
+    }
+
+};
+
+/*!
+ * @fn TEST_F(MappedLogPersistenceTest, Writer)
+ * @brief This test checks the writer persistence interface of the persistence service.
+ */
+TEST_F(MappedLogPersistenceTest, Writer)
+{
+    const std::string persist_guid("TEST_WRITER");
+
+    service = PersistenceFactory::create_persistence_service(policy);
+    ASSERT_NE(service, nullptr);
+
+    SequenceNumber_t max_seq;
+    CacheChange_t change;
+    GUID_t guid(GuidPrefix_t::unknown(), 1U);
+    std::vector<CacheChange_t*> changes;
+    change.kind = ALIVE;
+    change.writerGUID = guid;
+    change.serializedPayload.length = 0;
+
+    // Initial load should return empty vector
+    load(persist_guid, guid, changes, max_seq);
+    ASSERT_EQ(changes.size(), 0u);
+
+    // Add two changes
+    change.sequenceNumber.low = 1;
+    ASSERT_TRUE(service->add_writer_change_to_storage(persist_guid, change));
+    change.sequenceNumber.low = 2;
+    ASSERT_TRUE(service->add_writer_change_to_storage(persist_guid, change));
+
+    // Should not be able to add same sequence again
+    change.sequenceNumber.low = 1;
+    ASSERT_FALSE(service->add_writer_change_to_storage(persist_guid, change));
+    change.sequenceNumber.low = 2;
+    ASSERT_FALSE(service->add_writer_change_to_storage(persist_guid, change));
+
+    // Loading should return two changes (seqs = 1, 2)
+    load(persist_guid, guid, changes, max_seq);
+    ASSERT_EQ(changes.size(), 2u);
+    uint32_t i = 0;
+    for (auto it : changes)
+    {
+        ++i;
+        ASSERT_EQ(it->sequenceNumber, SequenceNumber_t(0, i));
+    }
+
+    // Remove seq = 1, and test it can be safely removed twice
+    change.sequenceNumber.low = 1;
+    ASSERT_TRUE(service->remove_writer_change_from_storage(persist_guid, change));
+    ASSERT_TRUE(service->remove_writer_change_from_storage(persist_guid, change));
+
+    // Loading should return one change (seq = 2), also after a restart
+    load(persist_guid, guid, changes, max_seq);
+    ASSERT_EQ(changes.size(), 1u);
+    ASSERT_EQ((*changes.begin())->sequenceNumber, SequenceNumber_t(0, 2));
+    restart();
+    load(persist_guid, guid, changes, max_seq);
+    ASSERT_EQ(changes.size(), 1u);
+    ASSERT_EQ((*changes.begin())->sequenceNumber, SequenceNumber_t(0, 2));
+    ASSERT_EQ(max_seq, SequenceNumber_t(0, 2));
+
+    // Remove seq = 2, and check that load returns empty vector
+    change.sequenceNumber.low = 2;
+    ASSERT_TRUE(service->remove_writer_change_from_storage(persist_guid, change));
+    load(persist_guid, guid, changes, max_seq);
+    ASSERT_EQ(changes.size(), 0u);
+}
+
+/*!
+ * @fn TEST_F(MappedLogPersistenceTest, Reader)
+ * @brief This test checks the reader persistence interface of the persistence service.
+ */
+TEST_F(MappedLogPersistenceTest, Reader)
+{
+    const std::string persist_guid("TEST_READER");
+
+    service = PersistenceFactory::create_persistence_service(policy);
+    ASSERT_NE(service, nullptr);
+
+    IPersistenceService::map_allocator_t pool(128, 1024);
+    foonathan::memory::map<GUID_t, SequenceNumber_t, IPersistenceService::map_allocator_t> seq_map(pool);
+    foonathan::memory::map<GUID_t, SequenceNumber_t, IPersistenceService::map_allocator_t> seq_map_loaded(pool);
+    GUID_t guid_1(GuidPrefix_t::unknown(), 1U);
+    SequenceNumber_t seq_1(0, 1);
+    GUID_t guid_2(GuidPrefix_t::unknown(), 2U);
+    SequenceNumber_t seq_2(0, 1);
+
+    // Initial load should return empty map
+    ASSERT_TRUE(service->load_reader_from_storage(persist_guid, seq_map_loaded));
+    ASSERT_EQ(seq_map_loaded.size(), 0u);
+
+    // Add two changes
+    seq_map[guid_1] = seq_1;
+    ASSERT_TRUE(service->update_writer_seq_on_storage(persist_guid, guid_1, seq_1));
+    seq_map[guid_2] = seq_2;
+    ASSERT_TRUE(service->update_writer_seq_on_storage(persist_guid, guid_2, seq_2));
+
+    // Loading should return local map
+    ASSERT_TRUE(service->load_reader_from_storage(persist_guid, seq_map_loaded));
+    ASSERT_EQ(seq_map_loaded, seq_map);
+
+    // Update previously added changes
+    seq_1.low = 100;
+    seq_map[guid_1] = seq_1;
+    ASSERT_TRUE(service->update_writer_seq_on_storage(persist_guid, guid_1, seq_1));
+    seq_2.low = 200;
+    seq_map[guid_2] = seq_2;
+    ASSERT_TRUE(service->update_writer_seq_on_storage(persist_guid, guid_2, seq_2));
+
+    // Loading should return local map, also after a restart
+    seq_map_loaded.clear();
+    ASSERT_TRUE(service->load_reader_from_storage(persist_guid, seq_map_loaded));
+    ASSERT_EQ(seq_map_loaded, seq_map);
+    restart();
+    seq_map_loaded.clear();
+    ASSERT_TRUE(service->load_reader_from_storage(persist_guid, seq_map_loaded));
+    ASSERT_EQ(seq_map_loaded, seq_map);
+}
+
+/*!
+ * @fn TEST_F(MappedLogPersistenceTest, Segments)
+ * @brief This test checks that data spanning several segments is kept after a restart, and that segments which
+ * are not needed anymore are removed.
+ */
+TEST_F(MappedLogPersistenceTest, Segments)
+{
+    const std::string persist_guid("TEST_WRITER");
+    policy.properties().emplace_back("dds.persistence.mapped_log.segment_size", "4096");
+
+    service = PersistenceFactory::create_persistence_service(policy);
+    ASSERT_NE(service, nullptr);
+
+    SequenceNumber_t max_seq;
+    CacheChange_t change;
+    GUID_t guid(GuidPrefix_t::unknown(), 1U);
+    std::vector<CacheChange_t*> changes;
+    change.kind = ALIVE;
+    change.writerGUID = guid;
+    change.serializedPayload.reserve(100);
+    change.serializedPayload.length = 100;
+
+    // Each segment holds around 25 changes
+    for (uint32_t i = 1; i <= 200; ++i)
+    {
+        memset(change.serializedPayload.data, static_cast<int>(i), 100);
+        change.instanceHandle.value[0] = static_cast<octet>(i);
+        change.sequenceNumber.low = i;
+        ASSERT_TRUE(service->add_writer_change_to_storage(persist_guid, change));
+    }
+    ASSERT_TRUE(segment_exists(0));
+    ASSERT_TRUE(segment_exists(7));
+
+    // Keep one change every 40, which should allow removing the first segments
+    for (uint32_t i = 1; i <= 200; ++i)
+    {
+        if (i % 40 != 0)
+        {
+            change.sequenceNumber.low = i;
+            ASSERT_TRUE(service->remove_writer_change_from_storage(persist_guid, change));
+        }
+    }
+    ASSERT_FALSE(segment_exists(0));
+
+    // Loading after a restart should only read the needed changes
+    restart();
+    load(persist_guid, guid, changes, max_seq);
+    ASSERT_EQ(changes.size(), 5u);
+    ASSERT_EQ(max_seq, SequenceNumber_t(0, 200));
+    uint32_t i = 0;
+    for (CacheChange_t* it : changes)
+    {
+        i += 40;
+        ASSERT_EQ(it->sequenceNumber, SequenceNumber_t(0, i));
+        ASSERT_EQ(it->instanceHandle.value[0], static_cast<octet>(i));
+        ASSERT_EQ(it->serializedPayload.length, 100u);
+        for (uint32_t j = 0; j < 100; ++j)
+        {
+            ASSERT_EQ(it->serializedPayload.data[j], static_cast<octet>(i));
+        }
+    }
+
+    // New changes are added after the loaded ones
+    change.sequenceNumber.low = 201;
+    ASSERT_TRUE(service->add_writer_change_to_storage(persist_guid, change));
+    restart();
+    load(persist_guid, guid, changes, max_seq);
+    ASSERT_EQ(changes.size(), 6u);
+    ASSERT_EQ(max_seq, SequenceNumber_t(0, 201));
+}
+
+/*!
+ * @fn TEST_F(MappedLogPersistenceTest, IncompleteRecord)
+ * @brief This test checks that a record which was not completely written is discarded on restart.
+ */
+TEST_F(MappedLogPersistenceTest, IncompleteRecord)
+{
+    const std::string persist_guid("TEST_WRITER");
+
+    service = PersistenceFactory::create_persistence_service(policy);
+    ASSERT_NE(service, nullptr);
+
+    SequenceNumber_t max_seq;
+    CacheChange_t change;
+    GUID_t guid(GuidPrefix_t::unknown(), 1U);
+    std::vector<CacheChange_t*> changes;
+    change.kind = ALIVE;
+    change.writerGUID = guid;
+    change.serializedPayload.length = 0;
+
+    for (uint32_t i = 1; i <= 3; ++i)
+    {
+        change.sequenceNumber.low = i;
+        ASSERT_TRUE(service->add_writer_change_to_storage(persist_guid, change));
+    }
+    delete service;
+    service = nullptr;
+
+    // Segment header takes 32 bytes, and each of these records 56 bytes. Corrupt the body of the last one.
+    FILE* f = std::fopen(segment_name(0).c_str(), "r+b");
+    ASSERT_NE(f, nullptr);
+    ASSERT_EQ(0, std::fseek(f, 32 + 2 * 56 + 20, SEEK_SET));
+    ASSERT_EQ(1u, std::fwrite("X", 1, 1, f));
+    std::fclose(f);
+
+    service = PersistenceFactory::create_persistence_service(policy);
+    ASSERT_NE(service, nullptr);
+    load(persist_guid, guid, changes, max_seq);
+    ASSERT_EQ(changes.size(), 2u);
+    ASSERT_EQ(max_seq, SequenceNumber_t(0, 2));
+
+    // The discarded record is overwritten by the next one
+    change.sequenceNumber.low = 3;
+    ASSERT_TRUE(service->add_writer_change_to_storage(persist_guid, change));
+    restart();
+    load(persist_guid, guid, changes, max_seq);
+    ASSERT_EQ(changes.size(), 3u);
+}
+
+/*!
+ * @fn TEST_F(MappedLogPersistenceTest, IncompleteSegment)
+ * @brief This test checks that a last segment which was not completely created is discarded on restart.
+ */
+TEST_F(MappedLogPersistenceTest, IncompleteSegment)
+{
+    const std::string persist_guid("TEST_WRITER");
+
+    service = PersistenceFactory::create_persistence_service(policy);
+    ASSERT_NE(service, nullptr);
+
+    SequenceNumber_t max_seq;
+    CacheChange_t change;
+    GUID_t guid(GuidPrefix_t::unknown(), 1U);
+    std::vector<CacheChange_t*> changes;
+    change.kind = ALIVE;
+    change.writerGUID = guid;
+    change.serializedPayload.length = 0;
+
+    for (uint32_t i = 1; i <= 3; ++i)
+    {
+        change.sequenceNumber.low = i;
+        ASSERT_TRUE(service->add_writer_change_to_storage(persist_guid, change));
+    }
+    delete service;
+    service = nullptr;
+
+    // Empty segment, as left when the process stops right after creating the file
+    FILE* f = std::fopen(segment_name(1).c_str(), "wb");
+    ASSERT_NE(f, nullptr);
+    std::fclose(f);
+
+    service = PersistenceFactory::create_persistence_service(policy);
+    ASSERT_NE(service, nullptr);
+    load(persist_guid, guid, changes, max_seq);
+    ASSERT_EQ(changes.size(), 3u);
+    ASSERT_EQ(max_seq, SequenceNumber_t(0, 3));
+    ASSERT_FALSE(segment_exists(1));
+    delete service;
+    service = nullptr;
+
+    // Segment with only part of its header
+    f = std::fopen(segment_name(1).c_str(), "wb");
+    ASSERT_NE(f, nullptr);
+    ASSERT_EQ(4u, std::fwrite("FDDS", 1, 4, f));
+    std::fclose(f);
+
+    service = PersistenceFactory::create_persistence_service(policy);
+    ASSERT_NE(service, nullptr);
+    load(persist_guid, guid, changes, max_seq);
+    ASSERT_EQ(changes.size(), 3u);
+
+    change.sequenceNumber.low = 4;
+    ASSERT_TRUE(service->add_writer_change_to_storage(persist_guid, change));
+    restart();
+    load(persist_guid, guid, changes, max_seq);
+    ASSERT_EQ(changes.size(), 4u);
+    ASSERT_EQ(max_seq, SequenceNumber_t(0, 4));
+}
+
+/*!
+ * @fn TEST_F(MappedLogPersistenceTest, HeadIndex)
+ * @brief This test checks that the index of the oldest segment is only taken from a complete file.
+ */
+TEST_F(MappedLogPersistenceTest, HeadIndex)
+{
+    service = PersistenceFactory::create_persistence_service(policy);
+    ASSERT_NE(service, nullptr);
+    delete service;
+    service = nullptr;
+
+    // What is left of an update that did not finish is ignored
+    FILE* f = std::fopen("test.log.tmp", "wb");
+    ASSERT_NE(f, nullptr);
+    ASSERT_EQ(1u, std::fwrite("X", 1, 1, f));
+    std::fclose(f);
+
+    service = PersistenceFactory::create_persistence_service(policy);
+    ASSERT_NE(service, nullptr);
+    delete service;
+    service = nullptr;
+
+    // An index which cannot be read is reported instead of starting again from the first segment
+    f = std::fopen("test.log", "wb");
+    ASSERT_NE(f, nullptr);
+    std::fclose(f);
+
+    service = PersistenceFactory::create_persistence_service(policy);
+    ASSERT_EQ(service, nullptr);
+}
+
+/*!
+ * @fn TEST_F(MappedLogPersistenceTest, SharedLog)
+ * @brief This test checks that services created with the same configuration share the log.
+ */
+TEST_F(MappedLogPersistenceTest, SharedLog)
+{
+    service = PersistenceFactory::create_persistence_service(policy);
+    ASSERT_NE(service, nullptr);
+    IPersistenceService* other = PersistenceFactory::create_persistence_service(policy);
+    ASSERT_NE(other, nullptr);
+
+    SequenceNumber_t max_seq;
+    CacheChange_t change;
+    GUID_t guid(GuidPrefix_t::unknown(), 1U);
+    std::vector<CacheChange_t*> changes;
+    change.kind = ALIVE;
+    change.writerGUID = guid;
+    change.serializedPayload.length = 0;
+
+    change.sequenceNumber.low = 1;
+    ASSERT_TRUE(service->add_writer_change_to_storage("WRITER_1", change));
+    ASSERT_TRUE(other->add_writer_change_to_storage("WRITER_2", change));
+    delete other;
+
+    restart();
+    load("WRITER_1", guid, changes, max_seq);
+    ASSERT_EQ(changes.size(), 1u);
+    load("WRITER_2", guid, changes, max_seq);
+    ASSERT_EQ(changes.size(), 1u);
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
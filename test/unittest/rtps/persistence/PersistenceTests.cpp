@@ -17,6 +17,7 @@
 #include <rtps/history/CacheChangePool.h>
 #include <rtps/persistence/PersistenceService.h>
 
+#include <chrono>
 #include <climits>
 #include <gtest/gtest.h>
 
@@ -58,6 +59,8 @@ protected:
     virtual void SetUp()
     {
         std::remove("test.db");
+        std::remove("test.db-wal");
+        std::remove("test.db-shm");
     }
 
     virtual void TearDown()
@@ -68,6 +71,8 @@ protected:
         }
 
         std::remove("test.db");
+        std::remove("test.db-wal");
+        std::remove("test.db-shm");
     }
 
 };
@@ -203,6 +208,142 @@ TEST_F(PersistenceTest, Reader)
     ASSERT_EQ(seq_map_loaded, seq_map);
 }
 
+/*!
+ * @fn TEST_F(PersistenceTest, AsyncWriter)
+ * @brief This test checks the writer persistence interface when operations are stored on a dedicated thread.
+ */
+TEST_F(PersistenceTest, AsyncWriter)
+{
+    const std::string persist_guid("TEST_WRITER");
+
+    PropertyPolicy policy;
+    policy.properties().emplace_back("dds.persistence.plugin", "builtin.SQLITE3");
+    policy.properties().emplace_back("dds.persistence.sqlite3.filename", "test.db");
+    policy.properties().emplace_back("dds.persistence.sqlite3.async", "true");
+    policy.properties().emplace_back("dds.persistence.sqlite3.synchronous", "NORMAL");
+    policy.properties().emplace_back("dds.persistence.sqlite3.queue_size", "4");
+
+    // Get service from factory
+    service = PersistenceFactory::create_persistence_service(policy);
+    ASSERT_NE(service, nullptr);
+
+    auto init_cache = [](CacheChange_t* item)
+            {
+                item->serializedPayload.reserve(128);
+            };
+    PoolConfig cfg{ MemoryManagementPolicy_t::PREALLOCATED_MEMORY_MODE, 0, 10, 0 };
+    auto pool = std::make_shared<CacheChangePool>(cfg, init_cache);
+    SequenceNumber_t max_seq;
+    CacheChange_t change;
+    GUID_t guid(GuidPrefix_t::unknown(), 1U);
+    std::vector<CacheChange_t*> changes;
+    change.kind = ALIVE;
+    change.writerGUID = guid;
+    change.serializedPayload.length = 0;
+
+    // Add more changes than the queue can hold
+    for (uint32_t i = 1; i <= 10; ++i)
+    {
+        change.sequenceNumber.low = i;
+        ASSERT_TRUE(service->add_writer_change_to_storage(persist_guid, change));
+    }
+    ASSERT_TRUE(service->wait_for_all_stored(std::chrono::steady_clock::now() + std::chrono::seconds(10)));
+
+    // Loading should return all changes
+    changes.clear();
+    ASSERT_TRUE(service->load_writer_from_storage(persist_guid, guid, changes, pool, payload_pool_, max_seq));
+    ASSERT_EQ(changes.size(), 10u);
+    ASSERT_EQ(max_seq, SequenceNumber_t(0, 10));
+    for (CacheChange_t* it : changes)
+    {
+        pool->release_cache(it);
+    }
+
+    // Remove all but the last one. Loading should wait for them to be stored
+    for (uint32_t i = 1; i < 10; ++i)
+    {
+        change.sequenceNumber.low = i;
+        ASSERT_TRUE(service->remove_writer_change_from_storage(persist_guid, change));
+    }
+    changes.clear();
+    ASSERT_TRUE(service->load_writer_from_storage(persist_guid, guid, changes, pool, payload_pool_, max_seq));
+    ASSERT_EQ(changes.size(), 1u);
+    ASSERT_EQ((*changes.begin())->sequenceNumber, SequenceNumber_t(0, 10));
+    pool->release_cache(*changes.begin());
+
+    // Pending operations should be stored when the service is destroyed
+    change.sequenceNumber.low = 11;
+    ASSERT_TRUE(service->add_writer_change_to_storage(persist_guid, change));
+    delete service;
+    service = PersistenceFactory::create_persistence_service(policy);
+    ASSERT_NE(service, nullptr);
+
+    changes.clear();
+    ASSERT_TRUE(service->load_writer_from_storage(persist_guid, guid, changes, pool, payload_pool_, max_seq));
+    ASSERT_EQ(changes.size(), 2u);
+    ASSERT_EQ(max_seq, SequenceNumber_t(0, 11));
+}
+
+/*!
+ * @fn TEST_F(PersistenceTest, AsyncReader)
+ * @brief This test checks the reader persistence interface when operations are stored on a dedicated thread.
+ */
+TEST_F(PersistenceTest, AsyncReader)
+{
+    const std::string persist_guid("TEST_READER");
+
+    PropertyPolicy policy;
+    policy.properties().emplace_back("dds.persistence.plugin", "builtin.SQLITE3");
+    policy.properties().emplace_back("dds.persistence.sqlite3.filename", "test.db");
+    policy.properties().emplace_back("dds.persistence.sqlite3.async", "true");
+
+    // Get service from factory
+    service = PersistenceFactory::create_persistence_service(policy);
+    ASSERT_NE(service, nullptr);
+
+    IPersistenceService::map_allocator_t pool(128, 1024);
+    foonathan::memory::map<GUID_t, SequenceNumber_t, IPersistenceService::map_allocator_t> seq_map(pool);
+    foonathan::memory::map<GUID_t, SequenceNumber_t, IPersistenceService::map_allocator_t> seq_map_loaded(pool);
+    GUID_t guid_1(GuidPrefix_t::unknown(), 1U);
+    GUID_t guid_2(GuidPrefix_t::unknown(), 2U);
+
+    // Only the last update of each writer should be kept
+    for (uint32_t i = 1; i <= 100; ++i)
+    {
+        SequenceNumber_t seq(0, i);
+        seq_map[guid_1] = seq;
+        ASSERT_TRUE(service->update_writer_seq_on_storage(persist_guid, guid_1, seq));
+        seq.low += 1000;
+        seq_map[guid_2] = seq;
+        ASSERT_TRUE(service->update_writer_seq_on_storage(persist_guid, guid_2, seq));
+    }
+
+    // Loading should return local map
+    seq_map_loaded.clear();
+    ASSERT_TRUE(service->load_reader_from_storage(persist_guid, seq_map_loaded));
+    ASSERT_EQ(seq_map_loaded, seq_map);
+}
+
+/*!
+ * @fn TEST_F(PersistenceTest, WrongConfiguration)
+ * @brief This test checks that the service is not created with unknown SQLite3 settings.
+ */
+TEST_F(PersistenceTest, WrongConfiguration)
+{
+    PropertyPolicy policy;
+    policy.properties().emplace_back("dds.persistence.plugin", "builtin.SQLITE3");
+    policy.properties().emplace_back("dds.persistence.sqlite3.filename", "test.db");
+    policy.properties().emplace_back("dds.persistence.sqlite3.journal_mode", "WAL; DROP TABLE writers");
+
+    service = PersistenceFactory::create_persistence_service(policy);
+    ASSERT_EQ(service, nullptr);
+
+    policy.properties().pop_back();
+    policy.properties().emplace_back("dds.persistence.sqlite3.synchronous", "SOMETIMES");
+    service = PersistenceFactory::create_persistence_service(policy);
+    ASSERT_EQ(service, nullptr);
+}
+
 int main(
         int argc,
         char** argv)
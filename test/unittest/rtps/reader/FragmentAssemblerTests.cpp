@@ -0,0 +1,371 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <rtps/reader/FragmentAssembler.hpp>
+
+#include <fastdds/rtps/attributes/HistoryAttributes.h>
+#include <fastdds/rtps/attributes/PropertyPolicy.h>
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <vector>
+
+using namespace eprosima::fastrtps::rtps;
+
+static constexpr uint16_t fragment_size = 100;
+
+class FragmentAssemblerTests : public ::testing::Test
+{
+protected:
+
+    FragmentAssemblerTests()
+    {
+        writer_.guidPrefix.value[11] = 1;
+        writer_.entityId = EntityId_t(0x102);
+        other_writer_.guidPrefix.value[11] = 2;
+        other_writer_.entityId = EntityId_t(0x102);
+    }
+
+    static std::vector<octet> make_sample(
+            uint32_t size,
+            uint8_t seed)
+    {
+        std::vector<octet> sample(size);
+        for (uint32_t i = 0; i < size; ++i)
+        {
+            sample[i] = static_cast<octet>(i * 7 + seed);
+        }
+        return sample;
+    }
+
+    // Adds the fragments [first, first + count) of a sample, with 1-based fragment numbers
+    static bool add(
+            FragmentAssembler& assembler,
+            const GUID_t& writer,
+            uint64_t sn,
+            const std::vector<octet>& sample,
+            uint32_t first,
+            uint32_t count)
+    {
+        uint32_t offset = (first - 1) * fragment_size;
+        uint32_t length = std::min(count * fragment_size, static_cast<uint32_t>(sample.size()) - offset);
+
+        CacheChange_t incoming(length);
+        incoming.writerGUID = writer;
+        incoming.sequenceNumber = SequenceNumber_t(0, static_cast<uint32_t>(sn));
+        incoming.serializedPayload.length = length;
+        memcpy(incoming.serializedPayload.data, &sample[offset], length);
+        incoming.setFragmentSize(fragment_size);
+
+        return assembler.add_fragments(incoming, static_cast<uint32_t>(sample.size()), first, count);
+    }
+
+    static bool take(
+            FragmentAssembler& assembler,
+            const GUID_t& writer,
+            uint64_t sn,
+            const std::vector<octet>& expected)
+    {
+        CacheChange_t change(static_cast<uint32_t>(expected.size()));
+        if (!assembler.take(writer, SequenceNumber_t(0, static_cast<uint32_t>(sn)), change))
+        {
+            return false;
+        }
+
+        return change.is_fully_assembled() &&
+               change.sequenceNumber == SequenceNumber_t(0, static_cast<uint32_t>(sn)) &&
+               change.writerGUID == writer &&
+               change.serializedPayload.length == expected.size() &&
+               0 == memcmp(change.serializedPayload.data, expected.data(), expected.size());
+    }
+
+    GUID_t writer_;
+    GUID_t other_writer_;
+};
+
+TEST_F(FragmentAssemblerTests, OutOfOrderFragments)
+{
+    FragmentAssemblerConfig config;
+    config.chunk_size = 1024;
+    FragmentAssembler assembler(config);
+
+    // 25 fragments, the last one shorter, spread over 3 chunks
+    std::vector<octet> sample = make_sample(2450, 3);
+    for (uint32_t fragment = 25; fragment > 1; fragment -= 2)
+    {
+        ASSERT_FALSE(add(assembler, writer_, 1, sample, fragment, 1));
+    }
+    ASSERT_FALSE(add(assembler, writer_, 1, sample, 2, 1));
+    ASSERT_FALSE(add(assembler, writer_, 1, sample, 1, 1));
+    ASSERT_FALSE(add(assembler, writer_, 1, sample, 23, 1));
+    for (uint32_t fragment = 4; fragment < 23; fragment += 2)
+    {
+        ASSERT_FALSE(add(assembler, writer_, 1, sample, fragment, 1));
+    }
+
+    // Repeated fragments are ignored
+    ASSERT_FALSE(add(assembler, writer_, 1, sample, 25, 1));
+    ASSERT_TRUE(add(assembler, writer_, 1, sample, 24, 1));
+
+    EXPECT_EQ(1u, assembler.samples());
+    EXPECT_EQ(3u * 1024u, assembler.memory());
+    EXPECT_TRUE(take(assembler, writer_, 1, sample));
+    EXPECT_EQ(0u, assembler.samples());
+
+    // Chunks are reused by the following samples
+    std::vector<octet> next = make_sample(2450, 9);
+    ASSERT_FALSE(add(assembler, writer_, 2, next, 13, 13));
+    ASSERT_TRUE(add(assembler, writer_, 2, next, 1, 12));
+    EXPECT_EQ(3u * 1024u, assembler.memory());
+    EXPECT_TRUE(take(assembler, writer_, 2, next));
+}
+
+TEST_F(FragmentAssemblerTests, InvalidFragments)
+{
+    FragmentAssembler assembler(FragmentAssemblerConfig{});
+    std::vector<octet> sample = make_sample(1000, 1);
+
+    // Fragment numbers out of the sample
+    EXPECT_FALSE(add(assembler, writer_, 1, sample, 10, 2));
+    EXPECT_FALSE(assembler.add_fragments(CacheChange_t(), 1000, 1, 1));
+
+    // Inconsistent sample size
+    ASSERT_FALSE(add(assembler, writer_, 1, sample, 1, 1));
+    std::vector<octet> bigger = make_sample(2000, 1);
+    EXPECT_FALSE(add(assembler, writer_, 1, bigger, 2, 1));
+
+    CacheChange_t small(500);
+    EXPECT_FALSE(assembler.take(writer_, SequenceNumber_t(0, 1), small));
+}
+
+TEST_F(FragmentAssemblerTests, MissingFragments)
+{
+    FragmentAssembler assembler(FragmentAssemblerConfig{});
+    std::vector<octet> sample = make_sample(1000, 1);
+
+    FragmentNumberSet_t missing;
+    EXPECT_FALSE(assembler.get_missing_fragments(writer_, SequenceNumber_t(0, 1), missing));
+
+    ASSERT_FALSE(add(assembler, writer_, 1, sample, 1, 2));
+    ASSERT_FALSE(add(assembler, writer_, 1, sample, 5, 1));
+    ASSERT_FALSE(add(assembler, writer_, 1, sample, 9, 2));
+
+    ASSERT_TRUE(assembler.get_missing_fragments(writer_, SequenceNumber_t(0, 1), missing));
+    EXPECT_EQ(3u, missing.base());
+    std::vector<FragmentNumber_t> expected = {3, 4, 6, 7, 8};
+    std::vector<FragmentNumber_t> result;
+    missing.for_each([&result](FragmentNumber_t fragment)
+            {
+                result.push_back(fragment);
+            });
+    EXPECT_EQ(expected, result);
+}
+
+TEST_F(FragmentAssemblerTests, MemoryBudget)
+{
+    FragmentAssemblerConfig config;
+    config.chunk_size = 1024;
+    // Four chunks and the indexes of two samples, 24 bytes each
+    config.max_memory = 4 * 1024 + 48;
+    FragmentAssembler assembler(config);
+
+    std::vector<octet> first = make_sample(2048, 1);
+    std::vector<octet> second = make_sample(2048, 2);
+    std::vector<octet> third = make_sample(2048, 3);
+
+    // Only the chunks holding received fragments are reserved
+    ASSERT_FALSE(add(assembler, writer_, 1, first, 1, 1));
+    ASSERT_FALSE(add(assembler, other_writer_, 1, second, 1, 1));
+    EXPECT_EQ(2u * 1024u, assembler.memory());
+    EXPECT_EQ(48u, assembler.index_memory());
+
+    ASSERT_FALSE(add(assembler, writer_, 1, first, 21, 1));
+    ASSERT_FALSE(add(assembler, other_writer_, 1, second, 21, 1));
+    EXPECT_EQ(4u * 1024u, assembler.memory());
+
+    // The sample least recently updated is discarded to store this one
+    ASSERT_FALSE(add(assembler, writer_, 2, third, 1, 1));
+    EXPECT_EQ(2u, assembler.samples());
+    EXPECT_EQ(4u * 1024u, assembler.memory());
+
+    FragmentNumberSet_t missing;
+    EXPECT_FALSE(assembler.get_missing_fragments(writer_, SequenceNumber_t(0, 1), missing));
+    ASSERT_TRUE(add(assembler, other_writer_, 1, second, 2, 19));
+    EXPECT_TRUE(take(assembler, other_writer_, 1, second));
+
+    EXPECT_EQ(24u, assembler.index_memory());
+
+    // A sample bigger than the budget is discarded without reserving anything
+    std::vector<octet> huge = make_sample(8192, 4);
+    EXPECT_FALSE(add(assembler, other_writer_, 2, huge, 1, 82));
+    EXPECT_EQ(1u, assembler.samples());
+    EXPECT_EQ(4u * 1024u, assembler.memory());
+    EXPECT_EQ(24u, assembler.index_memory());
+}
+
+TEST_F(FragmentAssemblerTests, IndexMemory)
+{
+    FragmentAssemblerConfig config;
+    config.chunk_size = 1024;
+    config.max_memory = 2048 + 64;
+    FragmentAssembler assembler(config);
+
+    // Tiny fragments make the bitmap of the sample exceed the budget
+    CacheChange_t incoming(1);
+    incoming.writerGUID = writer_;
+    incoming.sequenceNumber = SequenceNumber_t(0, 1);
+    incoming.serializedPayload.length = 1;
+    incoming.setFragmentSize(1);
+    EXPECT_FALSE(assembler.add_fragments(incoming, 2048, 1, 1));
+    EXPECT_EQ(0u, assembler.samples());
+    EXPECT_EQ(0u, assembler.memory());
+    EXPECT_EQ(0u, assembler.index_memory());
+
+    // Sizes read from the wire are not trusted to allocate the index
+    incoming.setFragmentSize(1);
+    EXPECT_FALSE(assembler.add_fragments(incoming, 0xFFFFFFFF, 1, 1));
+    EXPECT_EQ(0u, assembler.samples());
+
+    std::vector<octet> sample = make_sample(2048, 1);
+    ASSERT_FALSE(add(assembler, writer_, 1, sample, 1, 1));
+    EXPECT_EQ(24u, assembler.index_memory());
+
+    ASSERT_TRUE(add(assembler, writer_, 1, sample, 2, 20));
+    EXPECT_TRUE(take(assembler, writer_, 1, sample));
+    EXPECT_EQ(0u, assembler.index_memory());
+    EXPECT_EQ(2u * 1024u, assembler.memory());
+
+    // The index of a new sample can take the place of the free chunks
+    incoming.sequenceNumber = SequenceNumber_t(0, 2);
+    EXPECT_FALSE(assembler.add_fragments(incoming, 1024, 1, 1));
+    EXPECT_EQ(136u, assembler.index_memory());
+    EXPECT_EQ(1u, assembler.samples());
+    EXPECT_EQ(1024u, assembler.memory());
+}
+
+TEST_F(FragmentAssemblerTests, MaxSampleSize)
+{
+    FragmentAssemblerConfig config;
+    config.max_sample_size = 1000;
+    FragmentAssembler assembler(config);
+
+    std::vector<octet> sample = make_sample(1000, 1);
+    std::vector<octet> bigger = make_sample(1001, 1);
+    EXPECT_FALSE(add(assembler, writer_, 1, bigger, 1, 1));
+    EXPECT_EQ(0u, assembler.samples());
+    EXPECT_EQ(0u, assembler.memory());
+
+    ASSERT_TRUE(add(assembler, writer_, 2, sample, 1, 10));
+    EXPECT_TRUE(take(assembler, writer_, 2, sample));
+}
+
+TEST_F(FragmentAssemblerTests, HistoryLimits)
+{
+    FragmentAssemblerConfig config;
+    config.set_history_limits(HistoryAttributes(PREALLOCATED_MEMORY_MODE, 1000, 10, 10));
+    EXPECT_EQ(1000u, config.max_sample_size);
+    EXPECT_EQ(FragmentAssemblerConfig::default_max_memory, config.max_memory);
+
+    // Histories able to grow their payloads do not limit the sample size
+    config = FragmentAssemblerConfig();
+    config.set_history_limits(HistoryAttributes(PREALLOCATED_WITH_REALLOC_MEMORY_MODE, 1000, 10, 10));
+    EXPECT_EQ(0u, config.max_sample_size);
+
+    // The budget is enough for the samples of a writer
+    config = FragmentAssemblerConfig();
+    config.chunk_size = 1024 * 1024;
+    config.set_history_limits(HistoryAttributes(PREALLOCATED_MEMORY_MODE, 100 * 1024 * 1024 - 1, 10, 10));
+    EXPECT_EQ(4u * 100u * 1024u * 1024u, config.max_memory);
+
+    // Properties take precedence
+    PropertyPolicy properties;
+    properties.properties().emplace_back("fastdds.reassembly.max_memory", "0");
+    config.load(properties);
+    EXPECT_EQ(0u, config.max_memory);
+}
+
+TEST_F(FragmentAssemblerTests, SamplesPerWriter)
+{
+    FragmentAssemblerConfig config;
+    config.max_samples_per_writer = 2;
+    FragmentAssembler assembler(config);
+
+    std::vector<octet> sample = make_sample(1000, 1);
+    ASSERT_FALSE(add(assembler, writer_, 5, sample, 1, 1));
+    ASSERT_FALSE(add(assembler, writer_, 3, sample, 1, 1));
+    ASSERT_FALSE(add(assembler, other_writer_, 1, sample, 1, 1));
+    EXPECT_EQ(3u, assembler.samples());
+
+    // Samples older than all the ones being reassembled are ignored
+    ASSERT_FALSE(add(assembler, writer_, 2, sample, 1, 1));
+    EXPECT_EQ(3u, assembler.samples());
+
+    // Otherwise the oldest one is discarded
+    ASSERT_FALSE(add(assembler, writer_, 7, sample, 1, 1));
+    EXPECT_EQ(3u, assembler.samples());
+
+    FragmentNumberSet_t missing;
+    EXPECT_FALSE(assembler.get_missing_fragments(writer_, SequenceNumber_t(0, 3), missing));
+    EXPECT_TRUE(assembler.get_missing_fragments(writer_, SequenceNumber_t(0, 5), missing));
+    EXPECT_TRUE(assembler.get_missing_fragments(writer_, SequenceNumber_t(0, 7), missing));
+    EXPECT_TRUE(assembler.get_missing_fragments(other_writer_, SequenceNumber_t(0, 1), missing));
+}
+
+TEST_F(FragmentAssemblerTests, Remove)
+{
+    FragmentAssembler assembler(FragmentAssemblerConfig{});
+    std::vector<octet> sample = make_sample(1000, 1);
+    for (uint64_t sn = 1; sn <= 4; ++sn)
+    {
+        ASSERT_FALSE(add(assembler, writer_, sn, sample, 1, 1));
+        ASSERT_FALSE(add(assembler, other_writer_, sn, sample, 1, 1));
+    }
+
+    FragmentNumberSet_t missing;
+    assembler.remove(writer_, SequenceNumber_t(0, 4));
+    EXPECT_FALSE(assembler.get_missing_fragments(writer_, SequenceNumber_t(0, 4), missing));
+    EXPECT_EQ(7u, assembler.samples());
+
+    assembler.remove_until(writer_, SequenceNumber_t(0, 3));
+    EXPECT_FALSE(assembler.get_missing_fragments(writer_, SequenceNumber_t(0, 2), missing));
+    EXPECT_TRUE(assembler.get_missing_fragments(writer_, SequenceNumber_t(0, 3), missing));
+    EXPECT_EQ(5u, assembler.samples());
+
+    assembler.remove_writer(other_writer_);
+    EXPECT_EQ(1u, assembler.samples());
+    EXPECT_TRUE(assembler.get_missing_fragments(writer_, SequenceNumber_t(0, 3), missing));
+}
+
+TEST_F(FragmentAssemblerTests, LoadConfiguration)
+{
+    PropertyPolicy properties;
+    properties.properties().emplace_back("fastdds.reassembly.chunk_size", "16");
+    properties.properties().emplace_back("fastdds.reassembly.max_memory", "1048576");
+    properties.properties().emplace_back("fastdds.reassembly.max_samples_per_writer", "wrong");
+
+    FragmentAssemblerConfig config;
+    config.load(properties);
+    EXPECT_EQ(1024u, config.chunk_size);
+    EXPECT_EQ(1048576u, config.max_memory);
+    EXPECT_EQ(4u, config.max_samples_per_writer);
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,133 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <rtps/messages/MatchedReadersIndex.hpp>
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+using namespace eprosima::fastrtps::rtps;
+
+class MatchedReadersIndexTests : public ::testing::Test
+{
+protected:
+
+    MatchedReadersIndexTests()
+    {
+        // Readers are never accessed by the index
+        for (uintptr_t i = 0; i < 3; ++i)
+        {
+            readers_[i] = reinterpret_cast<RTPSReader*>((i + 1) * 64);
+            reader_ids_[i] = EntityId_t(static_cast<uint32_t>(0x100 + i) << 8 | 0x07);
+        }
+
+        for (uint8_t i = 0; i < 2; ++i)
+        {
+            writers_[i].guidPrefix.value[11] = i + 1;
+            writers_[i].entityId = EntityId_t(0x102);
+        }
+    }
+
+    std::vector<RTPSReader*> get(
+            const GUID_t& writer_guid)
+    {
+        std::vector<RTPSReader*> ret;
+        index_.get(writer_guid,
+                [](RTPSReader*, const EntityId_t&)
+                {
+                    return true;
+                }, ret);
+        return ret;
+    }
+
+    void add(
+            size_t writer,
+            size_t reader)
+    {
+        index_.add(writers_[writer], readers_[reader], reader_ids_[reader]);
+    }
+
+    MatchedReadersIndex index_;
+    RTPSReader* readers_[3];
+    EntityId_t reader_ids_[3];
+    GUID_t writers_[2];
+};
+
+TEST_F(MatchedReadersIndexTests, AddRemove)
+{
+    EXPECT_TRUE(get(writers_[0]).empty());
+
+    add(0, 0);
+    add(0, 1);
+    add(1, 1);
+    add(1, 2);
+
+    // Adding twice has no effect
+    add(0, 0);
+
+    EXPECT_EQ(get(writers_[0]), (std::vector<RTPSReader*>{readers_[0], readers_[1]}));
+    EXPECT_EQ(get(writers_[1]), (std::vector<RTPSReader*>{readers_[1], readers_[2]}));
+
+    index_.remove(writers_[0], readers_[0]);
+    EXPECT_EQ(get(writers_[0]), (std::vector<RTPSReader*>{readers_[1]}));
+
+    // Removing a reader not matched has no effect
+    index_.remove(writers_[0], readers_[2]);
+    EXPECT_EQ(get(writers_[0]), (std::vector<RTPSReader*>{readers_[1]}));
+
+    index_.remove(writers_[0], readers_[1]);
+    EXPECT_TRUE(get(writers_[0]).empty());
+    EXPECT_EQ(get(writers_[1]), (std::vector<RTPSReader*>{readers_[1], readers_[2]}));
+}
+
+TEST_F(MatchedReadersIndexTests, RemoveReader)
+{
+    add(0, 0);
+    add(0, 1);
+    add(1, 1);
+
+    index_.remove_reader(readers_[1]);
+    EXPECT_EQ(get(writers_[0]), (std::vector<RTPSReader*>{readers_[0]}));
+    EXPECT_TRUE(get(writers_[1]).empty());
+
+    index_.remove_reader(readers_[0]);
+    EXPECT_TRUE(get(writers_[0]).empty());
+}
+
+TEST_F(MatchedReadersIndexTests, Filter)
+{
+    add(0, 0);
+    add(0, 1);
+    add(0, 2);
+
+    std::vector<RTPSReader*> readers{readers_[2]};
+    EntityId_t filtered = reader_ids_[1];
+    index_.get(writers_[0],
+            [&filtered](RTPSReader*, const EntityId_t& reader_id)
+            {
+                return reader_id != filtered;
+            }, readers);
+
+    // Readers are appended
+    EXPECT_EQ(readers, (std::vector<RTPSReader*>{readers_[2], readers_[0], readers_[2]}));
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,333 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <rtps/reader/ReceivedChangesBitmap.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <set>
+#include <vector>
+
+using namespace eprosima::fastrtps;
+using namespace eprosima::fastrtps::rtps;
+
+/**
+ * Received changes kept on a tree, as WriterProxy did before ReceivedChangesBitmap.
+ * Used as reference for the results, and for the benchmark.
+ */
+struct TreeChanges
+{
+    std::set<SequenceNumber_t> received;
+
+    bool insert(
+            const SequenceNumber_t& seq_num,
+            const SequenceNumber_t&)
+    {
+        return received.insert(seq_num).second;
+    }
+
+    bool contains(
+            const SequenceNumber_t& seq_num) const
+    {
+        return received.find(seq_num) != received.end();
+    }
+
+    SequenceNumber_t advance(
+            const SequenceNumber_t& low_mark)
+    {
+        SequenceNumber_t result = low_mark;
+        auto it = received.lower_bound(low_mark + 1);
+        while (it != received.end() && *it == result + 1)
+        {
+            ++it;
+            ++result;
+        }
+        received.erase(received.begin(), it);
+        return result;
+    }
+
+    uint32_t count(
+            const SequenceNumber_t& first,
+            const SequenceNumber_t& last) const
+    {
+        uint32_t result = 0;
+        for (auto it = received.lower_bound(first); it != received.end() && *it < last; ++it)
+        {
+            ++result;
+        }
+        return result;
+    }
+
+    void add_missing(
+            SequenceNumber_t first,
+            const SequenceNumber_t& last,
+            SequenceNumberSet_t& missing) const
+    {
+        for (SequenceNumber_t seq : received)
+        {
+            seq = (std::min)(seq, last);
+            missing.add_range(first, seq);
+            first = seq + 1;
+            if (first >= last)
+            {
+                break;
+            }
+        }
+        if (first < last)
+        {
+            missing.add_range(first, last);
+        }
+    }
+
+};
+
+static std::vector<SequenceNumber_t> to_vector(
+        const SequenceNumberSet_t& set)
+{
+    std::vector<SequenceNumber_t> result;
+    set.for_each([&result](const SequenceNumber_t& seq)
+            {
+                result.push_back(seq);
+            });
+    return result;
+}
+
+/**
+ * Receives the changes of a writer with the reception order of a lossy network, checking the queries of
+ * ReceivedChangesBitmap against TreeChanges.
+ * @param max_gap  Maximum distance from the low mark of the changes received out of order.
+ */
+static void check_against_tree(
+        uint32_t seed,
+        uint32_t max_gap,
+        uint32_t operations)
+{
+    std::mt19937 generator(seed);
+    std::uniform_int_distribution<uint32_t> operation(0, 99);
+    std::uniform_int_distribution<uint32_t> gap(2, max_gap);
+
+    ResourceLimitedContainerConfig config;
+    ReceivedChangesBitmap bitmap(config);
+    TreeChanges tree;
+    SequenceNumber_t low_mark(0, 0xFFFFFF00u);
+    bitmap.clear(low_mark);
+
+    for (uint32_t i = 0; i < operations; ++i)
+    {
+        uint32_t op = operation(generator);
+        if (op < 70)
+        {
+            // Change received out of order
+            SequenceNumber_t seq = low_mark + gap(generator);
+            ASSERT_EQ(tree.insert(seq, low_mark), bitmap.insert(seq, low_mark));
+        }
+        else if (op < 85)
+        {
+            // Repair of the first missing change
+            low_mark = low_mark + 1;
+            SequenceNumber_t expected = tree.advance(low_mark);
+            ASSERT_EQ(expected, bitmap.advance(low_mark));
+            low_mark = expected;
+        }
+        else if (op < 90)
+        {
+            // Heartbeat informing of lost changes
+            SequenceNumber_t first_available = low_mark + gap(generator) / 2 + 1;
+            SequenceNumber_t expected = tree.advance(first_available - 1);
+            ASSERT_EQ(expected, bitmap.advance(first_available - 1));
+            low_mark = expected;
+        }
+        else
+        {
+            SequenceNumber_t first = low_mark + 1;
+            SequenceNumber_t last = first + gap(generator);
+            ASSERT_EQ(tree.count(first, last), bitmap.count(first, last));
+
+            SequenceNumberSet_t expected(first);
+            SequenceNumberSet_t missing(first);
+            tree.add_missing(first, (std::min)(last, first + 256u), expected);
+            bitmap.add_missing(first, (std::min)(last, first + 256u), missing);
+            ASSERT_EQ(to_vector(expected), to_vector(missing));
+
+            SequenceNumber_t seq = low_mark + gap(generator);
+            ASSERT_EQ(tree.contains(seq), bitmap.contains(seq));
+        }
+    }
+}
+
+TEST(ReceivedChangesBitmapTests, in_order_and_gaps)
+{
+    ResourceLimitedContainerConfig config;
+    ReceivedChangesBitmap bitmap(config);
+    SequenceNumber_t low_mark(0, 0);
+    bitmap.clear(low_mark);
+
+    // 1 is missing, 2 to 100 received
+    for (uint32_t i = 2; i <= 100; ++i)
+    {
+        EXPECT_TRUE(bitmap.insert(SequenceNumber_t(0, i), low_mark));
+    }
+    EXPECT_FALSE(bitmap.insert(SequenceNumber_t(0, 50), low_mark));
+    EXPECT_TRUE(bitmap.contains(SequenceNumber_t(0, 64)));
+    EXPECT_FALSE(bitmap.contains(SequenceNumber_t(0, 101)));
+    EXPECT_EQ(99u, bitmap.count(SequenceNumber_t(0, 1), SequenceNumber_t(0, 200)));
+
+    SequenceNumberSet_t missing(SequenceNumber_t(0, 1));
+    bitmap.add_missing(SequenceNumber_t(0, 1), SequenceNumber_t(0, 103), missing);
+    std::vector<SequenceNumber_t> expected{SequenceNumber_t(0, 1), SequenceNumber_t(0, 101), SequenceNumber_t(0, 102)};
+    EXPECT_EQ(expected, to_vector(missing));
+
+    // No change is received in order while 1 is missing
+    EXPECT_EQ(low_mark, bitmap.advance(low_mark));
+
+    // Receiving 1 moves the low mark over all of them
+    EXPECT_EQ(SequenceNumber_t(0, 100), bitmap.advance(SequenceNumber_t(0, 1)));
+    EXPECT_EQ(0u, bitmap.count(SequenceNumber_t(0, 101), SequenceNumber_t(0, 200)));
+}
+
+TEST(ReceivedChangesBitmapTests, large_gaps)
+{
+    ResourceLimitedContainerConfig config;
+    ReceivedChangesBitmap bitmap(config);
+    SequenceNumber_t low_mark(0, 10);
+    bitmap.clear(low_mark);
+
+    // Beyond the maximum size of the ring
+    SequenceNumber_t far = low_mark + 3 * ReceivedChangesBitmap::max_window_size;
+    SequenceNumber_t farther(1, 5);
+    EXPECT_TRUE(bitmap.insert(far, low_mark));
+    EXPECT_TRUE(bitmap.insert(farther, low_mark));
+    EXPECT_FALSE(bitmap.insert(far, low_mark));
+    EXPECT_TRUE(bitmap.insert(low_mark + 2, low_mark));
+    EXPECT_TRUE(bitmap.contains(far));
+    EXPECT_TRUE(bitmap.contains(farther));
+    EXPECT_EQ(3u, bitmap.count(low_mark + 1, farther + 1));
+
+    SequenceNumberSet_t missing(far - 10);
+    bitmap.add_missing(far - 10, far + 10, missing);
+    std::vector<SequenceNumber_t> values = to_vector(missing);
+    EXPECT_EQ(19u, values.size());
+    EXPECT_TRUE(std::find(values.begin(), values.end(), far) == values.end());
+
+    // The changes beyond the ring are taken into account when the low mark gets close to them
+    EXPECT_EQ(far, bitmap.advance(far - 1));
+    EXPECT_TRUE(bitmap.contains(farther));
+    EXPECT_EQ(farther, bitmap.advance(farther - 1));
+    EXPECT_EQ(0u, bitmap.count(farther + 1, farther + 1000));
+}
+
+TEST(ReceivedChangesBitmapTests, against_tree)
+{
+    for (uint32_t seed = 0; seed < 20; ++seed)
+    {
+        check_against_tree(seed, 300, 5000);
+    }
+    for (uint32_t seed = 0; seed < 5; ++seed)
+    {
+        check_against_tree(seed, 4 * ReceivedChangesBitmap::max_window_size, 5000);
+    }
+}
+
+/**
+ * Prints the time taken to receive a stream with 1% of losses, each one repaired after 200 changes,
+ * asking for the missing changes every 100 changes.
+ */
+template<typename Changes>
+static double receive_lossy_stream(
+        Changes& changes,
+        uint32_t num_changes)
+{
+    std::mt19937 generator(1);
+    std::uniform_int_distribution<uint32_t> loss(0, 99);
+    std::vector<SequenceNumber_t> lost;
+    SequenceNumber_t low_mark;
+    SequenceNumber_t max_seq;
+    volatile uint32_t result = 0;
+
+    auto receive = [&](const SequenceNumber_t& seq)
+            {
+                // Same steps as WriterProxy::received_change_set
+                if (seq == low_mark + 1 && seq > max_seq)
+                {
+                    low_mark = seq;
+                }
+                else if (seq == low_mark + 1)
+                {
+                    low_mark = changes.advance(seq);
+                }
+                else
+                {
+                    changes.insert(seq, low_mark);
+                }
+                max_seq = (std::max)(max_seq, seq);
+            };
+
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 1; i <= num_changes; ++i)
+    {
+        SequenceNumber_t seq(0, i);
+        if (loss(generator) == 0)
+        {
+            lost.push_back(seq);
+        }
+        else
+        {
+            receive(seq);
+        }
+
+        if (!lost.empty() && lost.front() + 200 < seq)
+        {
+            receive(lost.front());
+            lost.erase(lost.begin());
+        }
+
+        if (i % 100 == 0 && low_mark < max_seq)
+        {
+            SequenceNumber_t first = low_mark + 1;
+            SequenceNumber_t last = (std::min)(first + 256u, max_seq + 1);
+            SequenceNumberSet_t missing(first);
+            changes.add_missing(first, last, missing);
+            result = result + changes.count(first, max_seq + 1) + missing.empty();
+        }
+    }
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+TEST(ReceivedChangesBitmapTests, benchmark)
+{
+    const uint32_t num_changes = 1000000;
+
+    TreeChanges tree;
+    double tree_time = receive_lossy_stream(tree, num_changes);
+
+    ResourceLimitedContainerConfig config;
+    ReceivedChangesBitmap bitmap(config);
+    bitmap.clear(SequenceNumber_t());
+    double bitmap_time = receive_lossy_stream(bitmap, num_changes);
+
+    std::cout << "tree: " << num_changes / tree_time << " changes/s" << std::endl;
+    std::cout << "bitmap: " << num_changes / bitmap_time << " changes/s" << std::endl;
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
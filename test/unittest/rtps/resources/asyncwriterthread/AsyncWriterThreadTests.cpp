@@ -0,0 +1,421 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fastdds/rtps/resources/AsyncWriterThread.h>
+
+#include <fastdds/rtps/attributes/PropertyPolicy.h>
+#include <fastrtps/rtps/writer/RTPSWriter.h>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <pthread.h>
+#include <sched.h>
+#endif // if !defined(_WIN32)
+
+using namespace eprosima::fastrtps::rtps;
+using ::testing::ReturnRef;
+
+//! Writer recording the threads that process it.
+class TestWriter : public RTPSWriter
+{
+public:
+
+    explicit TestWriter(
+            uint32_t entity_key)
+    {
+        guid_.entityId = EntityId_t((entity_key << 8) | 0x03);
+        EXPECT_CALL(*this, getGuid()).WillRepeatedly(ReturnRef(guid_));
+    }
+
+    bool matched_reader_add(
+            const ReaderProxyData&) override
+    {
+        return true;
+    }
+
+    bool matched_reader_remove(
+            const GUID_t&) override
+    {
+        return true;
+    }
+
+    bool matched_reader_is_matched(
+            const GUID_t&) override
+    {
+        return false;
+    }
+
+    void send_any_unsent_changes() override
+    {
+        if (on_send)
+        {
+            on_send();
+        }
+
+        std::lock_guard<std::mutex> guard(mutex_);
+        thread_id_ = std::this_thread::get_id();
+        ++sent_;
+        cv_.notify_all();
+    }
+
+    //! Wait until the writer has been processed the given number of times.
+    bool wait_sent(
+            uint32_t count)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        return cv_.wait_for(lock, std::chrono::seconds(5), [&]()
+                       {
+                           return sent_ >= count;
+                       });
+    }
+
+    std::thread::id thread_id()
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+        return thread_id_;
+    }
+
+    //! Called from the thread processing the writer.
+    std::function<void()> on_send;
+
+private:
+
+    GUID_t guid_;
+
+    std::mutex mutex_;
+
+    std::condition_variable cv_;
+
+    uint32_t sent_ = 0;
+
+    std::thread::id thread_id_;
+};
+
+static PropertyPolicy make_properties(
+        const std::map<std::string, std::string>& values)
+{
+    PropertyPolicy properties;
+    for (const auto& value : values)
+    {
+        properties.properties().emplace_back(value.first, value.second);
+    }
+    return properties;
+}
+
+/*!
+ * @fn TEST(AsyncWriterThread, thread_count)
+ * @brief This test checks the number of threads read from the properties of the participant.
+ */
+TEST(AsyncWriterThread, thread_count)
+{
+    EXPECT_EQ(1u, AsyncWriterThread().thread_count());
+    EXPECT_EQ(1u, AsyncWriterThread(PropertyPolicy()).thread_count());
+    EXPECT_EQ(4u, AsyncWriterThread(make_properties({{"fastdds.async_writer.threads", "4"}})).thread_count());
+
+    // Wrong values are limited, or ignored when they are not a number
+    EXPECT_EQ(1u, AsyncWriterThread(make_properties({{"fastdds.async_writer.threads", "0"}})).thread_count());
+    EXPECT_EQ(1u, AsyncWriterThread(make_properties({{"fastdds.async_writer.threads", "-3"}})).thread_count());
+    EXPECT_EQ(64u, AsyncWriterThread(make_properties({{"fastdds.async_writer.threads", "1000"}})).thread_count());
+    EXPECT_EQ(1u, AsyncWriterThread(make_properties({{"fastdds.async_writer.threads", "many"}})).thread_count());
+}
+
+/*!
+ * @fn TEST(AsyncWriterThread, writer_thread_least_loaded)
+ * @brief This test checks that writers are attached to the thread with fewer writers, whatever their entity ids,
+ * and that writers attached to the same thread are processed by the same one.
+ */
+TEST(AsyncWriterThread, writer_thread_least_loaded)
+{
+    const uint32_t thread_count = 4;
+    std::vector<std::unique_ptr<TestWriter>> writers;
+    for (uint32_t i = 1; i <= 16; ++i)
+    {
+        // Readers created between writers take the rest of the entity keys
+        writers.emplace_back(new TestWriter(2 * i));
+    }
+
+    AsyncWriterThread async_thread(make_properties({{"fastdds.async_writer.threads", std::to_string(thread_count)}}));
+    ASSERT_EQ(thread_count, async_thread.thread_count());
+
+    std::map<uint32_t, uint32_t> writers_per_thread;
+    PropertyPolicy no_properties;
+    for (auto& writer : writers)
+    {
+        async_thread.register_writer(writer.get(), no_properties);
+        ++writers_per_thread[writer->async_thread_index_];
+    }
+    ASSERT_EQ(thread_count, writers_per_thread.size());
+    for (const auto& count : writers_per_thread)
+    {
+        EXPECT_EQ(4u, count.second);
+    }
+
+    for (auto& writer : writers)
+    {
+        async_thread.wake_up(writer.get());
+        ASSERT_TRUE(writer->wait_sent(1));
+    }
+
+    std::map<uint32_t, std::thread::id> thread_ids;
+    std::set<std::thread::id> different_ids;
+    for (auto& writer : writers)
+    {
+        auto it = thread_ids.emplace(writer->async_thread_index_, writer->thread_id()).first;
+        EXPECT_EQ(it->second, writer->thread_id());
+        EXPECT_NE(std::this_thread::get_id(), writer->thread_id());
+        different_ids.insert(writer->thread_id());
+    }
+    EXPECT_EQ(thread_count, different_ids.size());
+
+    // A new writer takes the place left by a removed one
+    uint32_t freed_thread = writers[5]->async_thread_index_;
+    async_thread.unregister_writer(writers[5].get());
+    TestWriter new_writer(100);
+    async_thread.register_writer(&new_writer, no_properties);
+    EXPECT_EQ(freed_thread, new_writer.async_thread_index_);
+    async_thread.unregister_writer(&new_writer);
+
+    for (size_t i = 0; i < writers.size(); ++i)
+    {
+        if (5u != i)
+        {
+            async_thread.unregister_writer(writers[i].get());
+        }
+    }
+}
+
+/*!
+ * @fn TEST(AsyncWriterThread, writer_thread_property)
+ * @brief This test checks that property fastdds.async_writer.thread of a writer selects its thread, when valid.
+ */
+TEST(AsyncWriterThread, writer_thread_property)
+{
+    TestWriter writer(1);
+    AsyncWriterThread async_thread(make_properties({{"fastdds.async_writer.threads", "4"}}));
+
+    for (uint32_t i = 0; i < 4; ++i)
+    {
+        async_thread.register_writer(&writer, make_properties({{"fastdds.async_writer.thread", std::to_string(i)}}));
+        EXPECT_EQ(i, writer.async_thread_index_);
+        async_thread.unregister_writer(&writer);
+    }
+
+    // Writers selecting a thread count as load for the rest
+    TestWriter other_writer(2);
+    async_thread.register_writer(&other_writer, make_properties({{"fastdds.async_writer.thread", "0"}}));
+
+    // Threads which do not exist are ignored
+    async_thread.register_writer(&writer, make_properties({{"fastdds.async_writer.thread", "4"}}));
+    EXPECT_EQ(1u, writer.async_thread_index_);
+    async_thread.unregister_writer(&writer);
+    async_thread.register_writer(&writer, make_properties({{"fastdds.async_writer.thread", "-1"}}));
+    EXPECT_EQ(1u, writer.async_thread_index_);
+    async_thread.unregister_writer(&writer);
+    async_thread.register_writer(&writer, make_properties({{"fastdds.async_writer.thread", "last"}}));
+    EXPECT_EQ(1u, writer.async_thread_index_);
+    async_thread.unregister_writer(&writer);
+
+    async_thread.unregister_writer(&other_writer);
+}
+
+/*!
+ * @fn TEST(AsyncWriterThread, threads_are_independent)
+ * @brief This test checks that a writer which takes long to be processed does not delay writers on other threads.
+ */
+TEST(AsyncWriterThread, threads_are_independent)
+{
+    TestWriter slow_writer(1);
+    TestWriter fast_writer(2);
+    AsyncWriterThread async_thread(make_properties({{"fastdds.async_writer.threads", "2"}}));
+    async_thread.register_writer(&slow_writer, make_properties({{"fastdds.async_writer.thread", "0"}}));
+    async_thread.register_writer(&fast_writer, make_properties({{"fastdds.async_writer.thread", "1"}}));
+
+    std::promise<void> slow_started;
+    std::promise<void> slow_release;
+    std::shared_future<void> release = slow_release.get_future().share();
+    slow_writer.on_send = [&slow_started, release]()
+            {
+                slow_started.set_value();
+                release.wait();
+            };
+
+    async_thread.wake_up(&slow_writer);
+    ASSERT_EQ(std::future_status::ready, slow_started.get_future().wait_for(std::chrono::seconds(5)));
+
+    async_thread.wake_up(&fast_writer);
+    EXPECT_TRUE(fast_writer.wait_sent(1));
+
+    slow_release.set_value();
+    EXPECT_TRUE(slow_writer.wait_sent(1));
+    EXPECT_NE(slow_writer.thread_id(), fast_writer.thread_id());
+
+    async_thread.unregister_writer(&slow_writer);
+    async_thread.unregister_writer(&fast_writer);
+}
+
+/*!
+ * @fn TEST(AsyncWriterThread, unregister_waits_for_processing)
+ * @brief This test checks that unregistering a writer waits until its thread stops processing it.
+ */
+TEST(AsyncWriterThread, unregister_waits_for_processing)
+{
+    TestWriter writer(1);
+    AsyncWriterThread async_thread;
+    async_thread.register_writer(&writer, PropertyPolicy());
+
+    std::promise<void> started;
+    std::promise<void> release_promise;
+    std::shared_future<void> release = release_promise.get_future().share();
+    writer.on_send = [&started, release]()
+            {
+                started.set_value();
+                release.wait();
+            };
+
+    async_thread.wake_up(&writer);
+    ASSERT_EQ(std::future_status::ready, started.get_future().wait_for(std::chrono::seconds(5)));
+
+    std::future<void> unregistered = std::async(std::launch::async, [&]()
+                    {
+                        async_thread.unregister_writer(&writer);
+                    });
+    EXPECT_EQ(std::future_status::timeout, unregistered.wait_for(std::chrono::milliseconds(200)));
+
+    release_promise.set_value();
+    EXPECT_EQ(std::future_status::ready, unregistered.wait_for(std::chrono::seconds(5)));
+    EXPECT_TRUE(writer.wait_sent(1));
+}
+
+#if defined(__linux__)
+/*!
+ * @fn TEST(AsyncWriterThread, cpu_affinity)
+ * @brief This test checks that threads are pinned to the CPUs on property fastdds.async_writer.cpu_affinity, and
+ * that wrong entries on the list are ignored.
+ */
+TEST(AsyncWriterThread, cpu_affinity)
+{
+    cpu_set_t allowed;
+    ASSERT_EQ(0, pthread_getaffinity_np(pthread_self(), sizeof(allowed), &allowed));
+    std::vector<int> cpus;
+    for (int cpu = 0; cpu < CPU_SETSIZE && cpus.size() < 2; ++cpu)
+    {
+        if (CPU_ISSET(cpu, &allowed))
+        {
+            cpus.push_back(cpu);
+        }
+    }
+    ASSERT_FALSE(cpus.empty());
+    int last_cpu = cpus.back();
+
+    TestWriter writer_0(1);
+    TestWriter writer_1(2);
+    AsyncWriterThread async_thread(make_properties({
+        {"fastdds.async_writer.threads", "2"},
+        {"fastdds.async_writer.cpu_affinity", std::to_string(cpus.front()) + ",none," + std::to_string(last_cpu)}}));
+    async_thread.register_writer(&writer_0, make_properties({{"fastdds.async_writer.thread", "0"}}));
+    async_thread.register_writer(&writer_1, make_properties({{"fastdds.async_writer.thread", "1"}}));
+
+    cpu_set_t affinity_0;
+    cpu_set_t affinity_1;
+    writer_0.on_send = [&affinity_0]()
+            {
+                pthread_getaffinity_np(pthread_self(), sizeof(affinity_0), &affinity_0);
+            };
+    writer_1.on_send = [&affinity_1]()
+            {
+                pthread_getaffinity_np(pthread_self(), sizeof(affinity_1), &affinity_1);
+            };
+
+    async_thread.wake_up(&writer_0);
+    async_thread.wake_up(&writer_1);
+    ASSERT_TRUE(writer_0.wait_sent(1));
+    ASSERT_TRUE(writer_1.wait_sent(1));
+
+    EXPECT_EQ(1, CPU_COUNT(&affinity_0));
+    EXPECT_TRUE(CPU_ISSET(cpus.front(), &affinity_0));
+    EXPECT_EQ(1, CPU_COUNT(&affinity_1));
+    EXPECT_TRUE(CPU_ISSET(last_cpu, &affinity_1));
+
+    async_thread.unregister_writer(&writer_0);
+    async_thread.unregister_writer(&writer_1);
+}
+
+#endif // if defined(__linux__)
+
+#if !defined(_WIN32)
+/*!
+ * @fn TEST(AsyncWriterThread, priority)
+ * @brief This test checks that threads use the real-time priority on property fastdds.async_writer.priority, when
+ * the process is allowed to.
+ */
+TEST(AsyncWriterThread, priority)
+{
+    // Find out whether this process may use real-time priorities
+    bool allowed = false;
+    std::thread probe([&allowed]()
+            {
+                sched_param param;
+                param.sched_priority = 1;
+                allowed = (0 == pthread_setschedparam(pthread_self(), SCHED_FIFO, &param));
+            });
+    probe.join();
+
+    TestWriter writer(1);
+    AsyncWriterThread async_thread(make_properties({{"fastdds.async_writer.priority", "1"}}));
+    async_thread.register_writer(&writer, PropertyPolicy());
+
+    int policy = -1;
+    sched_param param;
+    writer.on_send = [&policy, &param]()
+            {
+                pthread_getschedparam(pthread_self(), &policy, &param);
+            };
+    async_thread.wake_up(&writer);
+    ASSERT_TRUE(writer.wait_sent(1));
+
+    if (allowed)
+    {
+        EXPECT_EQ(SCHED_FIFO, policy);
+        EXPECT_EQ(1, param.sched_priority);
+    }
+    else
+    {
+        EXPECT_NE(SCHED_FIFO, policy);
+    }
+
+    async_thread.unregister_writer(&writer);
+}
+
+#endif // if !defined(_WIN32)
+
+int main(
+        int argc,
+        char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,169 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <rtps/resources/TimerWheel.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <vector>
+
+using namespace eprosima::fastrtps::rtps;
+using namespace std::chrono;
+
+class TimerWheelTests : public ::testing::Test
+{
+protected:
+
+    TimerWheelTests()
+        : origin_(steady_clock::now())
+        , wheel_(origin_)
+    {
+    }
+
+    std::vector<TimerWheelEntry*> advance(
+            steady_clock::duration elapsed)
+    {
+        std::vector<TimerWheelEntry*> expired;
+        wheel_.advance(origin_ + elapsed, expired);
+        return expired;
+    }
+
+    steady_clock::time_point origin_;
+    TimerWheel wheel_;
+};
+
+TEST_F(TimerWheelTests, expiration_is_exact)
+{
+    TimerWheelEntry entry;
+    wheel_.insert(&entry, origin_ + microseconds(2500));
+    EXPECT_EQ(1u, wheel_.size());
+    EXPECT_EQ(origin_ + microseconds(2500), wheel_.next_expiration(origin_ + seconds(1)));
+
+    // Same tick as the deadline, but before it
+    EXPECT_TRUE(advance(microseconds(2400)).empty());
+    EXPECT_FALSE(wheel_.empty());
+
+    auto expired = advance(microseconds(2500));
+    ASSERT_EQ(1u, expired.size());
+    EXPECT_EQ(&entry, expired[0]);
+    EXPECT_TRUE(wheel_.empty());
+    EXPECT_EQ(nullptr, entry.wheel_slot);
+}
+
+TEST_F(TimerWheelTests, same_deadline_share_slot)
+{
+    TimerWheelEntry entries[3];
+    for (auto& entry : entries)
+    {
+        wheel_.insert(&entry, origin_ + milliseconds(10));
+    }
+
+    EXPECT_EQ(entries[0].wheel_slot, entries[1].wheel_slot);
+    EXPECT_EQ(entries[0].wheel_slot, entries[2].wheel_slot);
+
+    wheel_.remove(&entries[1]);
+    wheel_.remove(&entries[1]);
+    EXPECT_EQ(2u, wheel_.size());
+
+    EXPECT_EQ(2u, advance(milliseconds(10)).size());
+    EXPECT_TRUE(wheel_.empty());
+}
+
+TEST_F(TimerWheelTests, overdue_entries)
+{
+    EXPECT_TRUE(advance(milliseconds(100)).empty());
+
+    TimerWheelEntry entry;
+    wheel_.insert(&entry, origin_ + milliseconds(50));
+    EXPECT_EQ(origin_ + milliseconds(50), wheel_.next_expiration(origin_ + seconds(1)));
+    EXPECT_EQ(1u, advance(milliseconds(100)).size());
+}
+
+TEST_F(TimerWheelTests, higher_levels)
+{
+    TimerWheelEntry near_entry;
+    TimerWheelEntry far_entry;
+    TimerWheelEntry farthest_entry;
+    wheel_.insert(&near_entry, origin_ + milliseconds(300));
+    wheel_.insert(&far_entry, origin_ + seconds(100));
+    wheel_.insert(&farthest_entry, origin_ + hours(24 * 60));
+    EXPECT_EQ(1u, near_entry.wheel_level);
+
+    // Wheel should be advanced when the first level wraps around
+    EXPECT_EQ(origin_ + milliseconds(256), wheel_.next_expiration(origin_ + seconds(1)));
+    EXPECT_TRUE(advance(milliseconds(256)).empty());
+    EXPECT_EQ(0u, near_entry.wheel_level);
+    EXPECT_EQ(origin_ + milliseconds(300), wheel_.next_expiration(origin_ + seconds(1)));
+
+    auto expired = advance(milliseconds(300));
+    ASSERT_EQ(1u, expired.size());
+    EXPECT_EQ(&near_entry, expired[0]);
+
+    expired = advance(seconds(100));
+    ASSERT_EQ(1u, expired.size());
+    EXPECT_EQ(&far_entry, expired[0]);
+
+    EXPECT_EQ(1u, wheel_.size());
+    wheel_.remove(&farthest_entry);
+    EXPECT_TRUE(wheel_.empty());
+}
+
+TEST_F(TimerWheelTests, random_deadlines)
+{
+    constexpr size_t num_entries = 2000;
+
+    std::mt19937 gen(12345);
+    std::uniform_int_distribution<int64_t> distribution(0, 300000);
+
+    std::vector<TimerWheelEntry> entries(num_entries);
+    for (auto& entry : entries)
+    {
+        wheel_.insert(&entry, origin_ + microseconds(distribution(gen) * 10));
+    }
+
+    // Advance in random steps, checking that entries expire in time
+    microseconds elapsed(0);
+    std::uniform_int_distribution<int64_t> steps(1, 5000);
+    size_t total_expired = 0;
+    while (!wheel_.empty())
+    {
+        elapsed += microseconds(steps(gen));
+        for (TimerWheelEntry* entry : advance(elapsed))
+        {
+            ASSERT_LE(entry->wheel_deadline, origin_ + elapsed);
+            ++total_expired;
+        }
+
+        for (auto& entry : entries)
+        {
+            if (nullptr != entry.wheel_slot)
+            {
+                ASSERT_GT(entry.wheel_deadline, origin_ + elapsed);
+                ASSERT_LE(wheel_.next_expiration(origin_ + hours(1)), entry.wheel_deadline);
+            }
+        }
+    }
+    EXPECT_EQ(num_entries, total_expired);
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,345 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fastdds/rtps/writer/ChangeForReaderRing.h>
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace eprosima::fastrtps;
+using namespace eprosima::fastrtps::rtps;
+
+static ChangeForReader_t change_with_status(
+        uint32_t seq,
+        ChangeForReaderStatus_t status)
+{
+    ChangeForReader_t change{SequenceNumber_t(0, seq)};
+    change.setStatus(status);
+    return change;
+}
+
+//! Sequence numbers and status of the changes of a ring, in order.
+static std::vector<std::pair<SequenceNumber_t, ChangeForReaderStatus_t>> contents(
+        const ChangeForReaderRing& ring)
+{
+    std::vector<std::pair<SequenceNumber_t, ChangeForReaderStatus_t>> result;
+    ring.for_each([&result](const ChangeForReader_t& change)
+            {
+                result.emplace_back(change.getSequenceNumber(), change.getStatus());
+            });
+    return result;
+}
+
+//! Sequence numbers visited by for_each_unsent, with true for unsent changes and false for holes.
+static std::vector<std::pair<SequenceNumber_t, bool>> unsent(
+        const ChangeForReaderRing& ring,
+        const SequenceNumber_t& first,
+        const SequenceNumber_t& last)
+{
+    std::vector<std::pair<SequenceNumber_t, bool>> result;
+    ring.for_each_unsent(first, last, [&result](const SequenceNumber_t& seq, const ChangeForReader_t* change)
+            {
+                if (change != nullptr)
+                {
+                    EXPECT_EQ(seq, change->getSequenceNumber());
+                }
+                result.emplace_back(seq, change != nullptr);
+            });
+    return result;
+}
+
+TEST(ChangeForReaderRingTests, find_and_erase)
+{
+    ChangeForReaderRing ring(ResourceLimitedContainerConfig{});
+    EXPECT_TRUE(ring.empty());
+    EXPECT_EQ(nullptr, ring.find(SequenceNumber_t(0, 1)));
+
+    for (uint32_t seq : {3u, 4u, 5u, 8u, 200u})
+    {
+        EXPECT_TRUE(ring.insert(change_with_status(seq, UNACKNOWLEDGED)));
+    }
+    EXPECT_EQ(5u, ring.size());
+    EXPECT_EQ(SequenceNumber_t(0, 3), ring.front().getSequenceNumber());
+    EXPECT_EQ(SequenceNumber_t(0, 200), ring.back().getSequenceNumber());
+    EXPECT_EQ(nullptr, ring.find(SequenceNumber_t(0, 6)));
+    ASSERT_NE(nullptr, ring.find(SequenceNumber_t(0, 8)));
+    EXPECT_EQ(SequenceNumber_t(0, 8), ring.find(SequenceNumber_t(0, 8))->getSequenceNumber());
+
+    // Removing the last change goes back to the previous one
+    ring.erase(SequenceNumber_t(0, 200));
+    EXPECT_EQ(SequenceNumber_t(0, 8), ring.back().getSequenceNumber());
+
+    // Removing the first ones
+    ring.erase(SequenceNumber_t(0, 3));
+    EXPECT_EQ(SequenceNumber_t(0, 4), ring.front().getSequenceNumber());
+    ring.erase_before(SequenceNumber_t(0, 8));
+    EXPECT_EQ(1u, ring.size());
+    EXPECT_EQ(SequenceNumber_t(0, 8), ring.front().getSequenceNumber());
+
+    // Changes before the first one, as added for late joiners
+    EXPECT_TRUE(ring.insert(change_with_status(1, UNACKNOWLEDGED)));
+    EXPECT_EQ(SequenceNumber_t(0, 1), ring.front().getSequenceNumber());
+    EXPECT_EQ(SequenceNumber_t(0, 8), ring.back().getSequenceNumber());
+
+    ring.erase_before(SequenceNumber_t(0, 9));
+    EXPECT_TRUE(ring.empty());
+}
+
+TEST(ChangeForReaderRingTests, maximum_size)
+{
+    ChangeForReaderRing ring(ResourceLimitedContainerConfig::fixed_size_configuration(2u));
+    EXPECT_TRUE(ring.insert(change_with_status(1, UNSENT)));
+    EXPECT_TRUE(ring.insert(change_with_status(1000, UNSENT)));
+    EXPECT_FALSE(ring.insert(change_with_status(1001, UNSENT)));
+}
+
+TEST(ChangeForReaderRingTests, status)
+{
+    ChangeForReaderRing ring(ResourceLimitedContainerConfig{});
+    ring.insert(change_with_status(1, UNDERWAY));
+    ring.insert(change_with_status(2, UNSENT));
+    ring.insert(change_with_status(4, UNDERWAY));
+    ring.insert(change_with_status(70, REQUESTED));
+
+    EXPECT_TRUE(ring.has_status(UNSENT));
+    EXPECT_FALSE(ring.has_status(UNACKNOWLEDGED));
+    EXPECT_FALSE(ring.convert_status(UNACKNOWLEDGED, UNSENT));
+
+    EXPECT_TRUE(ring.convert_status(UNDERWAY, UNACKNOWLEDGED));
+    EXPECT_FALSE(ring.has_status(UNDERWAY));
+    EXPECT_EQ(UNACKNOWLEDGED, ring.find(SequenceNumber_t(0, 4))->getStatus());
+
+    ring.set_status(*ring.find(SequenceNumber_t(0, 2)), UNDERWAY);
+    EXPECT_FALSE(ring.has_status(UNSENT));
+    EXPECT_TRUE(ring.convert_status(REQUESTED, UNSENT));
+
+    std::vector<std::pair<SequenceNumber_t, ChangeForReaderStatus_t>> expected{
+        {SequenceNumber_t(0, 1), UNACKNOWLEDGED}, {SequenceNumber_t(0, 2), UNDERWAY},
+        {SequenceNumber_t(0, 4), UNACKNOWLEDGED}, {SequenceNumber_t(0, 70), UNSENT}};
+    EXPECT_EQ(expected, contents(ring));
+
+    // Removing changes updates the status
+    ring.erase_before(SequenceNumber_t(0, 3));
+    EXPECT_FALSE(ring.has_status(UNDERWAY));
+    ring.erase(SequenceNumber_t(0, 70));
+    EXPECT_FALSE(ring.has_status(UNSENT));
+}
+
+TEST(ChangeForReaderRingTests, for_each_unsent)
+{
+    ChangeForReaderRing ring(ResourceLimitedContainerConfig{});
+
+    // Without changes, everything is a hole
+    std::vector<std::pair<SequenceNumber_t, bool>> expected{
+        {SequenceNumber_t(0, 5), false}, {SequenceNumber_t(0, 6), false}};
+    EXPECT_EQ(expected, unsent(ring, SequenceNumber_t(0, 5), SequenceNumber_t(0, 7)));
+
+    for (uint32_t seq = 10; seq < 300; ++seq)
+    {
+        if (seq != 150)
+        {
+            ring.insert(change_with_status(seq, seq == 200 ? UNSENT : UNDERWAY));
+        }
+    }
+
+    expected = {
+        {SequenceNumber_t(0, 8), false}, {SequenceNumber_t(0, 9), false}, {SequenceNumber_t(0, 150), false},
+        {SequenceNumber_t(0, 200), true}, {SequenceNumber_t(0, 300), false}, {SequenceNumber_t(0, 301), false}};
+    EXPECT_EQ(expected, unsent(ring, SequenceNumber_t(0, 8), SequenceNumber_t(0, 302)));
+
+    // The function may remove the changes being visited
+    std::vector<SequenceNumber_t> visited;
+    ring.for_each_unsent(SequenceNumber_t(0, 10), SequenceNumber_t(0, 400),
+            [&](const SequenceNumber_t& seq, const ChangeForReader_t*)
+            {
+                visited.push_back(seq);
+                ring.erase_before(seq + 1);
+            });
+    EXPECT_EQ(SequenceNumber_t(0, 150), visited.front());
+    EXPECT_EQ(SequenceNumber_t(0, 200), visited[1]);
+    EXPECT_EQ(SequenceNumber_t(0, 300), visited[2]);
+    EXPECT_TRUE(ring.empty());
+}
+
+TEST(ChangeForReaderRingTests, span_is_limited)
+{
+    // The span of the ring is limited by the maximum number of changes
+    ChangeForReaderRing ring(ResourceLimitedContainerConfig::fixed_size_configuration(100u));
+    EXPECT_EQ(128u, ring.max_span());
+
+    // An old change which is never acknowledged, while new changes keep coming
+    ASSERT_TRUE(ring.insert(change_with_status(1, UNACKNOWLEDGED)));
+    for (uint32_t seq = 1000; seq < 100000; ++seq)
+    {
+        ASSERT_TRUE(ring.insert(change_with_status(seq, UNSENT)));
+        if (seq >= 1010)
+        {
+            ring.erase(SequenceNumber_t(0, seq - 10));
+        }
+    }
+    EXPECT_EQ(11u, ring.size());
+    EXPECT_EQ(SequenceNumber_t(0, 1), ring.front().getSequenceNumber());
+    EXPECT_EQ(SequenceNumber_t(0, 99999), ring.back().getSequenceNumber());
+    ASSERT_NE(nullptr, ring.find(SequenceNumber_t(0, 99990)));
+    EXPECT_EQ(nullptr, ring.find(SequenceNumber_t(0, 99989)));
+    EXPECT_TRUE(ring.has_status(UNSENT));
+
+    // Removing the old change moves the rest to the ring
+    ring.erase(SequenceNumber_t(0, 1));
+    EXPECT_EQ(10u, ring.size());
+    EXPECT_EQ(SequenceNumber_t(0, 99990), ring.front().getSequenceNumber());
+    ASSERT_NE(nullptr, ring.find(SequenceNumber_t(0, 99995)));
+
+    std::vector<std::pair<SequenceNumber_t, bool>> expected{
+        {SequenceNumber_t(0, 99989), false}, {SequenceNumber_t(0, 99990), true}};
+    EXPECT_EQ(expected, unsent(ring, SequenceNumber_t(0, 99989), SequenceNumber_t(0, 99991)));
+}
+
+//! Applies the same random operations to a ring and to a map, checking they have the same changes.
+static void check_against_map(
+        const ResourceLimitedContainerConfig& allocation)
+{
+    std::mt19937 generator(1);
+    std::uniform_int_distribution<uint32_t> operation(0, 99);
+    std::uniform_int_distribution<uint32_t> distance(0, 300);
+    std::uniform_int_distribution<uint32_t> status(UNSENT, UNDERWAY);
+
+    ChangeForReaderRing ring(allocation);
+    std::map<SequenceNumber_t, ChangeForReaderStatus_t> reference;
+    uint32_t next_seq = 1000;
+
+    for (uint32_t i = 0; i < 20000; ++i)
+    {
+        uint32_t op = operation(generator);
+        SequenceNumber_t first = reference.empty() ? SequenceNumber_t(0, next_seq) : reference.begin()->first;
+        SequenceNumber_t seq = first + distance(generator);
+        if (op < 40)
+        {
+            ChangeForReaderStatus_t new_status = static_cast<ChangeForReaderStatus_t>(status(generator));
+            bool full = reference.size() >= allocation.maximum;
+            ASSERT_EQ(!full, ring.insert(change_with_status(next_seq, new_status)));
+            if (!full)
+            {
+                reference[SequenceNumber_t(0, next_seq)] = new_status;
+            }
+            next_seq += 1 + distance(generator) % 3;
+        }
+        else if (op < 45 && !reference.empty() && first > SequenceNumber_t(0, 300))
+        {
+            // Late joiner
+            SequenceNumber_t before = first - distance(generator);
+            if (reference.count(before) == 0)
+            {
+                bool full = reference.size() >= allocation.maximum;
+                ASSERT_EQ(!full, ring.insert(change_with_status(before.low, UNACKNOWLEDGED)));
+                if (!full)
+                {
+                    reference[before] = UNACKNOWLEDGED;
+                }
+            }
+        }
+        else if (op < 60)
+        {
+            if (reference.count(seq) != 0)
+            {
+                ring.erase(seq);
+                reference.erase(seq);
+            }
+        }
+        else if (op < 65)
+        {
+            ring.erase_before(seq);
+            reference.erase(reference.begin(), reference.lower_bound(seq));
+        }
+        else if (op < 80)
+        {
+            ChangeForReader_t* change = ring.find(seq);
+            ASSERT_EQ(reference.count(seq) != 0, change != nullptr);
+            if (change != nullptr)
+            {
+                ChangeForReaderStatus_t new_status = static_cast<ChangeForReaderStatus_t>(status(generator));
+                ring.set_status(*change, new_status);
+                reference[seq] = new_status;
+            }
+        }
+        else if (op < 85)
+        {
+            ChangeForReaderStatus_t previous = static_cast<ChangeForReaderStatus_t>(status(generator));
+            ChangeForReaderStatus_t next = static_cast<ChangeForReaderStatus_t>(status(generator));
+            bool modified = false;
+            for (auto& entry : reference)
+            {
+                if (entry.second == previous)
+                {
+                    entry.second = next;
+                    modified = true;
+                }
+            }
+            ASSERT_EQ(modified, ring.convert_status(previous, next));
+        }
+        else
+        {
+            SequenceNumber_t from = first - 5;
+            SequenceNumber_t to = first + 400;
+            std::vector<std::pair<SequenceNumber_t, bool>> expected;
+            for (SequenceNumber_t s = from; s < to; ++s)
+            {
+                auto it = reference.find(s);
+                if (it == reference.end())
+                {
+                    expected.emplace_back(s, false);
+                }
+                else if (it->second == UNSENT)
+                {
+                    expected.emplace_back(s, true);
+                }
+            }
+            ASSERT_EQ(expected, unsent(ring, from, to));
+        }
+
+        ASSERT_EQ(reference.size(), ring.size());
+        if (!reference.empty())
+        {
+            ASSERT_EQ(reference.begin()->first, ring.front().getSequenceNumber());
+            ASSERT_EQ(reference.rbegin()->first, ring.back().getSequenceNumber());
+        }
+    }
+
+    std::vector<std::pair<SequenceNumber_t, ChangeForReaderStatus_t>> expected(reference.begin(), reference.end());
+    EXPECT_EQ(expected, contents(ring));
+}
+
+TEST(ChangeForReaderRingTests, against_map)
+{
+    check_against_map(ResourceLimitedContainerConfig{10, 100000, 1});
+}
+
+//! Same as against_map, with changes that do not fit on the span of the ring
+TEST(ChangeForReaderRingTests, against_map_limited_span)
+{
+    check_against_map(ResourceLimitedContainerConfig{0, 100, 1});
+    check_against_map(ResourceLimitedContainerConfig::fixed_size_configuration(200u));
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
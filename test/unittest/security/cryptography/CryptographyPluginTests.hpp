@@ -1173,6 +1173,23 @@ TEST_F(CryptographyPluginTest, transform_SerializedPayload)
             *reader, *remote_writer, exception));
     ASSERT_TRUE(memcmp(plain_payload.data, decoded_payload.data, 18) == 0);
 
+    //Keep sending so the session changes several times, and cached session keys are renewed.
+    //Each message uses a block of the session, and a session has 32 blocks by default (maxblockspersession).
+    for (int i = 0; i < 4 * 32; ++i)
+    {
+        plain_payload.data[0] = static_cast<eprosima::fastrtps::rtps::octet>(i);
+        encoded_payload.pos = 0;
+        encoded_payload.length = 0;
+        decoded_payload.pos = 0;
+        decoded_payload.length = 0;
+        ASSERT_TRUE(CryptoPlugin->cryptotransform()->encode_serialized_payload(encoded_payload, inline_qos,
+                plain_payload, *writer, exception));
+        encoded_payload.pos = 0;
+        ASSERT_TRUE(CryptoPlugin->cryptotransform()->decode_serialized_payload(decoded_payload, encoded_payload,
+                inline_qos, *reader, *remote_writer, exception));
+        ASSERT_TRUE(memcmp(plain_payload.data, decoded_payload.data, 18) == 0);
+    }
+
     CryptoPlugin->keyfactory()->unregister_datawriter(writer, exception);
     CryptoPlugin->keyfactory()->unregister_datawriter(remote_writer, exception);
 
@@ -868,6 +868,78 @@ TEST_F(SHMTransportTests, send_and_receive_between_ports)
     sender_thread->join();
 }
 
+TEST_F(SHMTransportTests, send_loaned_buffer)
+{
+    const uint32_t loan_size = 300 * 1024;
+    descriptor.segment_size(512 * 1024);
+    SharedMemTransport transportUnderTest(descriptor);
+    ASSERT_TRUE(transportUnderTest.init());
+
+    Locator_t unicastLocator;
+    unicastLocator.kind = LOCATOR_KIND_SHM;
+    unicastLocator.port = g_default_port;
+
+    Locator_t outputChannelLocator;
+    outputChannelLocator.kind = LOCATOR_KIND_SHM;
+    outputChannelLocator.port = g_default_port + 1;
+
+    Semaphore sem;
+    MockReceiverResource receiver(transportUnderTest, unicastLocator);
+    MockMessageReceiver* msg_recv = dynamic_cast<MockMessageReceiver*>(receiver.CreateMessageReceiver());
+
+    eprosima::fastrtps::rtps::SendResourceList send_resource_list;
+    ASSERT_TRUE(transportUnderTest.OpenOutputChannel(send_resource_list, outputChannelLocator));
+    ASSERT_FALSE(send_resource_list.empty());
+
+    // The message is written directly on a buffer of the segment, bigger than the message
+    auto buffer = transportUnderTest.loan_buffer(loan_size, std::chrono::steady_clock::now());
+    ASSERT_NE(nullptr, buffer);
+    octet* message = static_cast<octet*>(buffer->data());
+    memcpy(message, "Hello", 5);
+
+    // Two buffers of that size do not fit on the segment
+    EXPECT_EQ(nullptr, transportUnderTest.loan_buffer(loan_size, std::chrono::steady_clock::now()));
+
+    std::function<void()> recCallback = [&]()
+            {
+                EXPECT_EQ(memcmp("Hello", msg_recv->data, 5), 0);
+                sem.post();
+            };
+    msg_recv->setCallback(recCallback);
+
+    LocatorList_t locator_list;
+    locator_list.push_back(unicastLocator);
+    Locators locators_begin(locator_list.begin());
+    Locators locators_end(locator_list.end());
+
+    EXPECT_TRUE(send_resource_list.at(0)->send(message, 5, &locators_begin, &locators_end,
+            (std::chrono::steady_clock::now() + std::chrono::microseconds(100))));
+    sem.wait();
+
+    // The loaned buffer was sent without copying it, and shrunk to the size of the message
+    auto other_buffer = transportUnderTest.loan_buffer(loan_size, std::chrono::steady_clock::now());
+    EXPECT_NE(nullptr, other_buffer);
+    transportUnderTest.return_loan(other_buffer);
+    other_buffer.reset();
+    transportUnderTest.return_loan(buffer);
+    buffer.reset();
+
+    // Data not coming from a loaned buffer is copied
+    octet copied[5] = { 'W', 'o', 'r', 'l', 'd' };
+    recCallback = [&]()
+            {
+                EXPECT_NE(copied, msg_recv->data);
+                EXPECT_EQ(memcmp(copied, msg_recv->data, 5), 0);
+                sem.post();
+            };
+    msg_recv->setCallback(recCallback);
+
+    locators_begin = Locators(locator_list.begin());
+    EXPECT_TRUE(send_resource_list.at(0)->send(copied, 5, &locators_begin, &locators_end,
+            (std::chrono::steady_clock::now() + std::chrono::microseconds(100))));
+    sem.wait();
+}
+
 TEST_F(SHMTransportTests, port_and_segment_overflow_discard)
 {
     SharedMemTransportDescriptor my_descriptor;
@@ -0,0 +1,142 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <rtps/transport/tcp/TCPChecksum.hpp>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace eprosima::fastdds::rtps;
+using eprosima::fastrtps::rtps::octet;
+
+//! Checksum of the TCP header as computed before TCPChecksum, one byte at a time.
+static uint32_t legacy_additive(
+        const octet* data,
+        size_t size)
+{
+    static uint32_t max = 0xffffffff;
+    uint32_t crc = 0;
+    for (size_t i = 0; i < size; ++i)
+    {
+        if (crc + data[i] < crc)
+        {
+            crc -= (max - data[i]);
+        }
+        else
+        {
+            crc += data[i];
+        }
+    }
+    return crc;
+}
+
+static std::vector<octet> random_data(
+        size_t size)
+{
+    std::mt19937 generator(static_cast<uint32_t>(size));
+    std::uniform_int_distribution<int> distribution(0, 255);
+    std::vector<octet> data(size);
+    for (octet& value : data)
+    {
+        value = static_cast<octet>(distribution(generator));
+    }
+    return data;
+}
+
+TEST(TCPChecksumTests, crc32c_known_values)
+{
+    const char* check = "123456789";
+    EXPECT_EQ(0xE3069283u, TCPChecksum::crc32c(reinterpret_cast<const octet*>(check), strlen(check)));
+    EXPECT_EQ(0xE3069283u, TCPChecksum::crc32c_software(reinterpret_cast<const octet*>(check), strlen(check)));
+    EXPECT_EQ(0u, TCPChecksum::crc32c(nullptr, 0));
+
+    // RFC 3720, B.4
+    std::vector<octet> zeros(32, 0x00);
+    EXPECT_EQ(0x8A9136AAu, TCPChecksum::crc32c(zeros.data(), zeros.size()));
+    std::vector<octet> ones(32, 0xFF);
+    EXPECT_EQ(0x62A8AB43u, TCPChecksum::crc32c(ones.data(), ones.size()));
+}
+
+TEST(TCPChecksumTests, crc32c_implementations_match)
+{
+    std::vector<octet> data = random_data(4096 + 7);
+
+    // Every length and alignment around the 8 bytes processed on each step
+    for (size_t offset = 0; offset < 8; ++offset)
+    {
+        for (size_t size = 0; size < 80; ++size)
+        {
+            ASSERT_EQ(TCPChecksum::crc32c_software(&data[offset], size),
+                    TCPChecksum::crc32c(&data[offset], size)) << "offset " << offset << " size " << size;
+        }
+    }
+
+    EXPECT_EQ(TCPChecksum::crc32c_software(data.data(), data.size()), TCPChecksum::crc32c(data.data(), data.size()));
+}
+
+TEST(TCPChecksumTests, additive_is_compatible)
+{
+    for (size_t size : {0u, 1u, 13u, 65500u})
+    {
+        std::vector<octet> data = random_data(size);
+        EXPECT_EQ(legacy_additive(data.data(), size), TCPChecksum::additive(data.data(), size));
+    }
+
+    // The sum overflows 32 bits several times, and goes through 0xFFFFFFFF
+    std::vector<octet> data(3 * (0xFFFFFFFFu / 255u) + 5, 0xFF);
+    EXPECT_EQ(legacy_additive(data.data(), data.size()), TCPChecksum::additive(data.data(), data.size()));
+    size_t wrap = 0xFFFFFFFFu / 255u;
+    EXPECT_EQ(legacy_additive(data.data(), wrap), TCPChecksum::additive(data.data(), wrap));
+    EXPECT_EQ(legacy_additive(data.data(), 2 * wrap), TCPChecksum::additive(data.data(), 2 * wrap));
+}
+
+//! Prints the throughput of the checksums on a 1 MB sample.
+TEST(TCPChecksumTests, benchmark)
+{
+    std::vector<octet> data = random_data(1024 * 1024);
+    const int repetitions = 20;
+
+    auto measure = [&](const char* name, uint32_t (* checksum)(const octet*, size_t))
+            {
+                volatile uint32_t result = 0;
+                auto start = std::chrono::steady_clock::now();
+                for (int i = 0; i < repetitions; ++i)
+                {
+                    result = result + checksum(data.data(), data.size());
+                }
+                auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+                std::cout << name << ": " << (repetitions * data.size()) / (elapsed * 1024 * 1024) << " MB/s" <<
+                    std::endl;
+            };
+
+    std::cout << "CRC32 instruction " << (TCPChecksum::crc32c_hardware_available() ? "available" : "not available") <<
+        std::endl;
+    measure("additive (byte by byte)", legacy_additive);
+    measure("additive", TCPChecksum::additive);
+    measure("crc32c (slice-by-8)", TCPChecksum::crc32c_software);
+    measure("crc32c", TCPChecksum::crc32c);
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,180 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <rtps/transport/tcp/TCPFramingBuffer.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace eprosima::fastdds::rtps;
+using eprosima::fastrtps::rtps::octet;
+
+//! Appends a message framed by a TCPHeader to a stream.
+static void add_message(
+        std::vector<octet>& stream,
+        const std::string& body,
+        uint16_t logical_port = 7410)
+{
+    TCPHeader header;
+    header.length = static_cast<uint32_t>(body.size() + TCPHeader::size());
+    header.logical_port = logical_port;
+    const octet* header_bytes = header.address();
+    stream.insert(stream.end(), header_bytes, header_bytes + TCPHeader::size());
+    stream.insert(stream.end(), body.begin(), body.end());
+}
+
+//! Feeds a stream to the buffer, in reads of at most read_size bytes, and returns the bodies received.
+static std::vector<std::string> receive(
+        TCPFramingBuffer& buffer,
+        const std::vector<octet>& stream,
+        size_t read_size,
+        std::vector<TCPFramingBuffer::Result>& events)
+{
+    std::vector<std::string> messages;
+    size_t position = 0;
+    while (position < stream.size())
+    {
+        size_t bytes = (std::min)((std::min)(read_size, buffer.free_space()), stream.size() - position);
+        EXPECT_LT(0u, bytes);
+        memcpy(buffer.write_position(), &stream[position], bytes);
+        buffer.commit(bytes);
+        position += bytes;
+
+        TCPHeader header;
+        octet* body = nullptr;
+        uint32_t body_size = 0;
+        TCPFramingBuffer::Result result;
+        while (TCPFramingBuffer::Result::NEED_MORE != (result = buffer.next_message(header, body, body_size)))
+        {
+            events.push_back(result);
+            if (TCPFramingBuffer::Result::MESSAGE == result)
+            {
+                messages.emplace_back(reinterpret_cast<char*>(body), body_size);
+            }
+            else if (TCPFramingBuffer::Result::BAD_HEADER == result)
+            {
+                return messages;
+            }
+        }
+        buffer.compact();
+    }
+    return messages;
+}
+
+TEST(TCPFramingBufferTests, several_messages_on_one_read)
+{
+    std::vector<octet> stream;
+    add_message(stream, "first");
+    add_message(stream, "");
+    add_message(stream, "third message");
+
+    TCPFramingBuffer buffer(100);
+    std::vector<TCPFramingBuffer::Result> events;
+    std::vector<std::string> messages = receive(buffer, stream, stream.size(), events);
+
+    ASSERT_EQ(3u, messages.size());
+    EXPECT_EQ("first", messages[0]);
+    EXPECT_EQ("", messages[1]);
+    EXPECT_EQ("third message", messages[2]);
+}
+
+TEST(TCPFramingBufferTests, messages_split_between_reads)
+{
+    std::vector<octet> stream;
+    std::vector<std::string> sent;
+    for (size_t i = 0; i < 20; ++i)
+    {
+        sent.push_back(std::string(i * 7, static_cast<char>('a' + i)));
+        add_message(stream, sent.back());
+    }
+
+    // Every read size, so headers and bodies are cut at every position
+    for (size_t read_size = 1; read_size < 200; ++read_size)
+    {
+        TCPFramingBuffer buffer(200);
+        std::vector<TCPFramingBuffer::Result> events;
+        EXPECT_EQ(sent, receive(buffer, stream, read_size, events)) << "read size " << read_size;
+    }
+}
+
+TEST(TCPFramingBufferTests, message_of_maximum_size)
+{
+    std::vector<octet> stream;
+    add_message(stream, "a");
+    add_message(stream, std::string(64, 'b'));
+    add_message(stream, "c");
+
+    // The maximum message arrives after part of a previous one, so the buffer has to be compacted to fit it
+    TCPFramingBuffer buffer(64);
+    std::vector<TCPFramingBuffer::Result> events;
+    std::vector<std::string> messages = receive(buffer, stream, 40, events);
+
+    ASSERT_EQ(3u, messages.size());
+    EXPECT_EQ(std::string(64, 'b'), messages[1]);
+    EXPECT_EQ("c", messages[2]);
+}
+
+TEST(TCPFramingBufferTests, message_too_big_is_skipped)
+{
+    std::vector<octet> stream;
+    add_message(stream, "before");
+    add_message(stream, std::string(500, 'x'));
+    add_message(stream, "after");
+
+    TCPFramingBuffer buffer(64);
+    std::vector<TCPFramingBuffer::Result> events;
+    std::vector<std::string> messages = receive(buffer, stream, 30, events);
+
+    ASSERT_EQ(2u, messages.size());
+    EXPECT_EQ("before", messages[0]);
+    EXPECT_EQ("after", messages[1]);
+    EXPECT_EQ(1, std::count(events.begin(), events.end(), TCPFramingBuffer::Result::TOO_BIG));
+}
+
+TEST(TCPFramingBufferTests, bad_header)
+{
+    std::vector<octet> stream;
+    add_message(stream, "good");
+    stream.insert(stream.end(), 20, 'Z');
+
+    TCPFramingBuffer buffer(64);
+    std::vector<TCPFramingBuffer::Result> events;
+    std::vector<std::string> messages = receive(buffer, stream, stream.size(), events);
+
+    ASSERT_EQ(1u, messages.size());
+    ASSERT_FALSE(events.empty());
+    EXPECT_EQ(TCPFramingBuffer::Result::BAD_HEADER, events.back());
+
+    // A length shorter than the header itself is not valid either
+    TCPHeader header;
+    header.length = 3;
+    TCPFramingBuffer short_buffer(64);
+    memcpy(short_buffer.write_position(), header.address(), TCPHeader::size());
+    short_buffer.commit(TCPHeader::size());
+    octet* body = nullptr;
+    uint32_t body_size = 0;
+    EXPECT_EQ(TCPFramingBuffer::Result::BAD_HEADER, short_buffer.next_message(header, body, body_size));
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -19,8 +19,11 @@
 #include <fastrtps/utils/IPLocator.h>
 #include <fastdds/dds/log/Log.hpp>
 #include <MockReceiverResource.h>
+#include <fastdds/rtps/transport/TCPChannelResourceBasic.h>
 #include "../../../src/cpp/rtps/transport/TCPSenderResource.hpp"
 
+#include <atomic>
+#include <future>
 #include <memory>
 #include <asio.hpp>
 #include <gtest/gtest.h>
@@ -227,6 +230,84 @@ TEST_F(TCPv4Tests, send_and_receive_between_ports)
     senderThread->join();
     sem.wait();
 }
+
+TEST_F(TCPv4Tests, send_and_receive_between_ports_with_reactor_threads)
+{
+    TCPv4TransportDescriptor recvDescriptor;
+    recvDescriptor.add_listener_port(g_default_port);
+    recvDescriptor.wait_for_tcp_negotiation = true;
+    recvDescriptor.reactor_threads = 2;
+    TCPv4Transport receiveTransportUnderTest(recvDescriptor);
+    receiveTransportUnderTest.init();
+
+    TCPv4TransportDescriptor sendDescriptor;
+    sendDescriptor.wait_for_tcp_negotiation = true;
+    sendDescriptor.reactor_threads = 1;
+    TCPv4Transport sendTransportUnderTest(sendDescriptor);
+    sendTransportUnderTest.init();
+
+    Locator_t inputLocator;
+    inputLocator.kind = LOCATOR_KIND_TCPv4;
+    inputLocator.port = g_default_port;
+    IPLocator::setIPv4(inputLocator, 127, 0, 0, 1);
+    IPLocator::setLogicalPort(inputLocator, 7410);
+
+    LocatorList_t locator_list;
+    locator_list.push_back(inputLocator);
+
+    Locator_t outputLocator;
+    outputLocator.kind = LOCATOR_KIND_TCPv4;
+    IPLocator::setIPv4(outputLocator, 127, 0, 0, 1);
+    outputLocator.port = g_default_port;
+    IPLocator::setLogicalPort(outputLocator, 7410);
+
+    MockReceiverResource receiver(receiveTransportUnderTest, inputLocator);
+    MockMessageReceiver *msg_recv = dynamic_cast<MockMessageReceiver*>(receiver.CreateMessageReceiver());
+    ASSERT_TRUE(receiveTransportUnderTest.IsInputChannelOpen(inputLocator));
+
+    SendResourceList send_resource_list;
+    ASSERT_TRUE(sendTransportUnderTest.OpenOutputChannel(send_resource_list, outputLocator));
+    ASSERT_FALSE(send_resource_list.empty());
+    octet message[5] = { 'H','e','l','l','o' };
+
+    // Messages sent in a burst are queued together on the socket, and read on the same call
+    const int burst = 100;
+    std::atomic<int> received(0);
+    Semaphore sem;
+    std::function<void()> recCallback = [&]()
+    {
+        EXPECT_EQ(memcmp(message, msg_recv->data, 5), 0);
+        if (burst == ++received)
+        {
+            sem.post();
+        }
+    };
+
+    msg_recv->setCallback(recCallback);
+
+    bool sent = false;
+    while (!sent)
+    {
+        Locators input_begin(locator_list.begin());
+        Locators input_end(locator_list.end());
+
+        sent = send_resource_list.at(0)->send(message, 5, &input_begin, &input_end,
+                (std::chrono::steady_clock::now()+ std::chrono::microseconds(100)));
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+
+    for (int i = 1; i < burst; ++i)
+    {
+        Locators input_begin(locator_list.begin());
+        Locators input_end(locator_list.end());
+
+        EXPECT_TRUE(send_resource_list.at(0)->send(message, 5, &input_begin, &input_end,
+                (std::chrono::steady_clock::now()+ std::chrono::microseconds(100))));
+    }
+
+    sem.wait();
+    EXPECT_EQ(burst, received.load());
+}
 #endif
 
 TEST_F(TCPv4Tests, send_is_rejected_if_buffer_size_is_bigger_to_size_specified_in_descriptor)
@@ -259,6 +340,87 @@ TEST_F(TCPv4Tests, send_is_rejected_if_buffer_size_is_bigger_to_size_specified_i
             &destination_begin, &destination_end, (std::chrono::steady_clock::now()+ std::chrono::microseconds(100))));
 }
 
+#if defined(__linux__) || defined(__APPLE__)
+TEST_F(TCPv4Tests, non_blocking_send_discards_messages_when_send_buffer_is_full)
+{
+    descriptor.non_blocking_send = true;
+    descriptor.sendBufferSize = 16384;
+    descriptor.receiveBufferSize = 16384;
+    TCPv4Transport transportUnderTest(descriptor);
+
+    // Peer which accepts the connection, but does not read from it
+    asio::io_service service;
+    asio::ip::tcp::acceptor acceptor(service, asio::ip::tcp::endpoint(asio::ip::address_v4::loopback(), 0));
+    std::shared_ptr<asio::ip::tcp::socket> socket = std::make_shared<asio::ip::tcp::socket>(service);
+    asio::ip::tcp::socket peer(service);
+    socket->connect(acceptor.local_endpoint());
+    acceptor.accept(peer);
+
+    eprosima::fastdds::rtps::TCPChannelResourceBasic channel(&transportUnderTest, service, socket,
+            descriptor.maxMessageSize);
+    channel.set_options(&descriptor);
+
+    std::vector<octet> header(14, 'R');
+    std::vector<octet> message(1000, 'H');
+
+    // Writes far more bytes than the buffers of both sockets can hold
+    auto discarded = std::async(std::launch::async, [&]()
+            {
+                for (size_t i = 0; i < 10000; ++i)
+                {
+                    asio::error_code ec;
+                    size_t sent = channel.send(header.data(), header.size(), message.data(), message.size(), ec);
+                    if (asio::error::would_block == ec)
+                    {
+                        EXPECT_EQ(sent, 0u);
+                        return true;
+                    }
+                    if (ec || sent != header.size() + message.size())
+                    {
+                        return false;
+                    }
+                }
+                return false;
+            });
+
+    bool blocked = std::future_status::ready != discarded.wait_for(std::chrono::seconds(10));
+    if (blocked)
+    {
+        // Unblocks the write
+        peer.close();
+    }
+    EXPECT_FALSE(blocked);
+    ASSERT_TRUE(discarded.get());
+
+    // RTCP control messages, which carry their own header, are not discarded
+    std::vector<octet> control_message(64, 'C');
+    auto control_sent = std::async(std::launch::async, [&]()
+            {
+                asio::error_code ec;
+                size_t sent = channel.send(nullptr, 0, control_message.data(), control_message.size(), ec);
+                EXPECT_FALSE(ec);
+                return sent;
+            });
+
+    // Lets the peer read, in case the control message did not fit on the socket
+    std::this_thread::sleep_for(std::chrono::seconds(1));
+    std::thread reader([&peer]()
+            {
+                std::vector<octet> buffer(65536);
+                asio::error_code ec;
+                while (!ec)
+                {
+                    peer.read_some(asio::buffer(buffer), ec);
+                }
+            });
+
+    EXPECT_EQ(control_sent.get(), control_message.size());
+
+    socket->close();
+    reader.join();
+}
+#endif // if defined(__linux__) || defined(__APPLE__)
+
 TEST_F(TCPv4Tests, RemoteToMainLocal_simply_strips_out_address_leaving_IP_ANY)
 {
     // Given
@@ -40,6 +40,71 @@ const uint32_t ReceiveBufferCapacity = 65536;
 
 static uint16_t g_default_port = 0;
 
+#ifdef __linux__
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cerrno>
+
+/**
+ * UDPv4Transport whose batched send reports that a destination would block with EAGAIN.
+ * Datagrams before it are sent, as the kernel does with a partial send.
+ */
+class WouldBlockUDPv4Transport : public UDPv4Transport
+{
+public:
+
+    WouldBlockUDPv4Transport(
+            const UDPv4TransportDescriptor& descriptor)
+        : UDPv4Transport(descriptor)
+    {
+    }
+
+    //! Destination port for which the batched send reports that it would block. Zero to disable.
+    std::atomic<uint16_t> would_block_port{0};
+
+protected:
+
+    int send_mmsg(
+            int fd,
+            mmsghdr* headers,
+            unsigned int count) override
+    {
+        uint16_t blocked = would_block_port;
+        if (0 != blocked)
+        {
+            if (0 < count && destination_port(headers[0]) == blocked)
+            {
+                errno = EAGAIN;
+                return -1;
+            }
+
+            for (unsigned int i = 1; i < count; ++i)
+            {
+                if (destination_port(headers[i]) == blocked)
+                {
+                    count = i;
+                    break;
+                }
+            }
+        }
+
+        return UDPv4Transport::send_mmsg(fd, headers, count);
+    }
+
+private:
+
+    static uint16_t destination_port(
+            const mmsghdr& header)
+    {
+        return ntohs(reinterpret_cast<const sockaddr_in*>(header.msg_hdr.msg_name)->sin_port);
+    }
+
+};
+#endif // ifdef __linux__
+
 uint16_t get_port()
 {
     uint16_t port = static_cast<uint16_t>(GET_PID());
@@ -458,6 +523,201 @@ TEST_F(UDPv4Tests, send_and_receive_between_allowed_sockets_using_localhost)
     sem.wait();
 }
 
+TEST_F(UDPv4Tests, send_and_receive_in_batches)
+{
+    descriptor.interfaceWhiteList.emplace_back("127.0.0.1");
+    descriptor.receive_batch_size = 8;
+    UDPv4Transport transportUnderTest(descriptor);
+    transportUnderTest.init();
+
+    Locator_t unicastLocator;
+    unicastLocator.port = g_default_port;
+    unicastLocator.kind = LOCATOR_KIND_UDPv4;
+    IPLocator::setIPv4(unicastLocator, "127.0.0.1");
+
+    LocatorList_t locator_list;
+    locator_list.push_back(unicastLocator);
+
+    Locator_t outputChannelLocator;
+    outputChannelLocator.port = g_default_port + 1;
+    outputChannelLocator.kind = LOCATOR_KIND_UDPv4;
+    IPLocator::setIPv4(outputChannelLocator, "127.0.0.1");
+
+    MockReceiverResource receiver(transportUnderTest, unicastLocator);
+    MockMessageReceiver* msg_recv = dynamic_cast<MockMessageReceiver*>(receiver.CreateMessageReceiver());
+
+    SendResourceList send_resource_list;
+    ASSERT_TRUE(transportUnderTest.OpenOutputChannel(send_resource_list, outputChannelLocator));
+    ASSERT_FALSE(send_resource_list.empty());
+    ASSERT_TRUE(transportUnderTest.IsInputChannelOpen(unicastLocator));
+
+    // More messages than the batch size, so several batches are received
+    const octet num_messages = 20;
+    octet message[5] = { 'H', 'e', 'l', 'l', 0 };
+    octet expected_index = 0;
+
+    Semaphore sem;
+    std::function<void()> recCallback = [&]()
+            {
+                EXPECT_EQ(memcmp(message, msg_recv->data, 4), 0);
+                EXPECT_EQ(expected_index, msg_recv->data[4]);
+                ++expected_index;
+                sem.post();
+            };
+
+    msg_recv->setCallback(recCallback);
+
+    auto sendThreadFunction = [&]()
+            {
+                for (octet i = 0; i < num_messages; ++i)
+                {
+                    Locators locators_begin(locator_list.begin());
+                    Locators locators_end(locator_list.end());
+
+                    message[4] = i;
+                    EXPECT_TRUE(send_resource_list.at(0)->send(message, 5, &locators_begin, &locators_end,
+                            (std::chrono::steady_clock::now() + std::chrono::microseconds(100))));
+                }
+            };
+
+    senderThread.reset(new std::thread(sendThreadFunction));
+    senderThread->join();
+    for (octet i = 0; i < num_messages; ++i)
+    {
+        sem.wait();
+    }
+}
+
+TEST_F(UDPv4Tests, send_to_several_destinations_in_batch)
+{
+    descriptor.interfaceWhiteList.emplace_back("127.0.0.1");
+    descriptor.batched_send = true;
+    UDPv4Transport transportUnderTest(descriptor);
+    transportUnderTest.init();
+
+    std::vector<Locator_t> destinations(2);
+    LocatorList_t locator_list;
+    for (uint32_t i = 0; i < destinations.size(); ++i)
+    {
+        destinations[i].port = g_default_port + 2 + i;
+        destinations[i].kind = LOCATOR_KIND_UDPv4;
+        IPLocator::setIPv4(destinations[i], "127.0.0.1");
+        locator_list.push_back(destinations[i]);
+    }
+
+    Locator_t outputChannelLocator;
+    outputChannelLocator.port = g_default_port + 1;
+    outputChannelLocator.kind = LOCATOR_KIND_UDPv4;
+    IPLocator::setIPv4(outputChannelLocator, "127.0.0.1");
+
+    MockReceiverResource receiver_1(transportUnderTest, destinations[0]);
+    MockMessageReceiver* msg_recv_1 = dynamic_cast<MockMessageReceiver*>(receiver_1.CreateMessageReceiver());
+    MockReceiverResource receiver_2(transportUnderTest, destinations[1]);
+    MockMessageReceiver* msg_recv_2 = dynamic_cast<MockMessageReceiver*>(receiver_2.CreateMessageReceiver());
+
+    SendResourceList send_resource_list;
+    ASSERT_TRUE(transportUnderTest.OpenOutputChannel(send_resource_list, outputChannelLocator));
+    ASSERT_FALSE(send_resource_list.empty());
+    octet message[5] = { 'H', 'e', 'l', 'l', 'o' };
+
+    Semaphore sem;
+    std::function<void()> recCallback_1 = [&]()
+            {
+                EXPECT_EQ(memcmp(message, msg_recv_1->data, 5), 0);
+                sem.post();
+            };
+    std::function<void()> recCallback_2 = [&]()
+            {
+                EXPECT_EQ(memcmp(message, msg_recv_2->data, 5), 0);
+                sem.post();
+            };
+
+    msg_recv_1->setCallback(recCallback_1);
+    msg_recv_2->setCallback(recCallback_2);
+
+    auto sendThreadFunction = [&]()
+            {
+                Locators locators_begin(locator_list.begin());
+                Locators locators_end(locator_list.end());
+
+                EXPECT_TRUE(send_resource_list.at(0)->send(message, 5, &locators_begin, &locators_end,
+                        (std::chrono::steady_clock::now() + std::chrono::microseconds(100))));
+            };
+
+    senderThread.reset(new std::thread(sendThreadFunction));
+    senderThread->join();
+    sem.wait();
+    sem.wait();
+}
+
+#ifdef __linux__
+TEST_F(UDPv4Tests, batch_send_skips_destination_that_would_block)
+{
+    descriptor.interfaceWhiteList.emplace_back("127.0.0.1");
+    descriptor.batched_send = true;
+    WouldBlockUDPv4Transport transportUnderTest(descriptor);
+    transportUnderTest.init();
+
+    std::vector<Locator_t> destinations(3);
+    LocatorList_t locator_list;
+    for (uint32_t i = 0; i < destinations.size(); ++i)
+    {
+        destinations[i].port = g_default_port + 2 + i;
+        destinations[i].kind = LOCATOR_KIND_UDPv4;
+        IPLocator::setIPv4(destinations[i], "127.0.0.1");
+        locator_list.push_back(destinations[i]);
+    }
+
+    Locator_t outputChannelLocator;
+    outputChannelLocator.port = g_default_port + 1;
+    outputChannelLocator.kind = LOCATOR_KIND_UDPv4;
+    IPLocator::setIPv4(outputChannelLocator, "127.0.0.1");
+
+    // The first destination would block. The rest should still be sent to.
+    MockReceiverResource receiver_2(transportUnderTest, destinations[1]);
+    MockMessageReceiver* msg_recv_2 = dynamic_cast<MockMessageReceiver*>(receiver_2.CreateMessageReceiver());
+    MockReceiverResource receiver_3(transportUnderTest, destinations[2]);
+    MockMessageReceiver* msg_recv_3 = dynamic_cast<MockMessageReceiver*>(receiver_3.CreateMessageReceiver());
+
+    SendResourceList send_resource_list;
+    ASSERT_TRUE(transportUnderTest.OpenOutputChannel(send_resource_list, outputChannelLocator));
+    ASSERT_FALSE(send_resource_list.empty());
+    octet message[5] = { 'H', 'e', 'l', 'l', 'o' };
+
+    Semaphore sem;
+    std::function<void()> recCallback_2 = [&]()
+            {
+                EXPECT_EQ(memcmp(message, msg_recv_2->data, 5), 0);
+                sem.post();
+            };
+    std::function<void()> recCallback_3 = [&]()
+            {
+                EXPECT_EQ(memcmp(message, msg_recv_3->data, 5), 0);
+                sem.post();
+            };
+
+    msg_recv_2->setCallback(recCallback_2);
+    msg_recv_3->setCallback(recCallback_3);
+
+    transportUnderTest.would_block_port = static_cast<uint16_t>(destinations[0].port);
+    auto sendThreadFunction = [&]()
+            {
+                Locators locators_begin(locator_list.begin());
+                Locators locators_end(locator_list.end());
+
+                // A datagram dropped because it would block is not an error
+                EXPECT_TRUE(send_resource_list.at(0)->send(message, 5, &locators_begin, &locators_end,
+                        (std::chrono::steady_clock::now() + std::chrono::microseconds(100))));
+            };
+
+    senderThread.reset(new std::thread(sendThreadFunction));
+    senderThread->join();
+    transportUnderTest.would_block_port = 0;
+    sem.wait();
+    sem.wait();
+}
+#endif // ifdef __linux__
+
 TEST_F(UDPv4Tests, send_and_receive_between_allowed_sockets_using_unicast)
 {
     std::vector<IPFinder::info_IP> interfaces;
@@ -694,6 +954,57 @@ TEST_F(UDPv4Tests, simple_throughput)
             , std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count() / (num_samples_per_batch * 1000.0));
 }
 
+TEST_F(UDPv4Tests, batched_send_throughput)
+{
+    const size_t sample_size = 1024;
+    const uint32_t num_destinations = 16;
+    const int num_samples = 20000;
+
+    octet sample_data[sample_size];
+    memset(sample_data, 0, sizeof(sample_data));
+
+    LocatorList_t send_locators_list;
+    for (uint32_t i = 0; i < num_destinations; ++i)
+    {
+        Locator_t destination;
+        destination.kind = LOCATOR_KIND_UDPv4;
+        destination.port = 50100 + i;
+        IPLocator::setIPv4(destination, 127, 0, 0, 1);
+        send_locators_list.push_back(destination);
+    }
+
+    for (bool batched_send : { false, true })
+    {
+        UDPv4TransportDescriptor my_descriptor;
+        my_descriptor.batched_send = batched_send;
+        UDPv4Transport pub_transport(my_descriptor);
+        ASSERT_TRUE(pub_transport.init());
+
+        SendResourceList send_resource_list;
+        ASSERT_TRUE(pub_transport.OpenOutputChannel(send_resource_list, *send_locators_list.begin()));
+
+        auto t0 = std::chrono::high_resolution_clock::now();
+
+        for (int i = 0; i < num_samples; i++)
+        {
+            Locators locators_begin(send_locators_list.begin());
+            Locators locators_end(send_locators_list.end());
+
+            EXPECT_TRUE(send_resource_list.at(0)->send(sample_data, sizeof(sample_data), &locators_begin,
+                    &locators_end, (std::chrono::steady_clock::now() + std::chrono::milliseconds(100))));
+        }
+
+        auto t1 = std::chrono::high_resolution_clock::now();
+
+        double elapsed_us = std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count() / 1000.0;
+        printf("batched_send %d: %u destinations, send_time_per_sample %.3f(us), %.0f datagrams/s\n"
+                , batched_send
+                , num_destinations
+                , elapsed_us / num_samples
+                , (num_samples * num_destinations) / (elapsed_us / 1e6));
+    }
+}
+
 void UDPv4Tests::HELPER_SetDescriptorDefaults()
 {
     descriptor.maxMessageSize = 5;
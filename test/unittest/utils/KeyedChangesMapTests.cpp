@@ -0,0 +1,123 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fastrtps/common/KeyedChangesMap.h>
+#include <gtest/gtest.h>
+
+using namespace eprosima::fastrtps;
+using namespace eprosima::fastrtps::rtps;
+
+static InstanceHandle_t make_handle(
+        uint32_t n)
+{
+    InstanceHandle_t handle;
+    handle.value[12] = static_cast<octet>(n >> 24);
+    handle.value[13] = static_cast<octet>(n >> 16);
+    handle.value[14] = static_cast<octet>(n >> 8);
+    handle.value[15] = static_cast<octet>(n);
+    return handle;
+}
+
+TEST(KeyedChangesMapTests, insert_and_find)
+{
+    KeyedChangesMap map;
+    map.reserve(100);
+
+    for (uint32_t i = 0; i < 100; ++i)
+    {
+        auto it = map.insert(make_handle(i));
+        EXPECT_EQ(make_handle(i), it->first);
+        EXPECT_TRUE(it->second.cache_changes.empty());
+    }
+    EXPECT_EQ(100u, map.size());
+
+    for (uint32_t i = 0; i < 100; ++i)
+    {
+        auto it = map.find(make_handle(i));
+        ASSERT_NE(map.end(), it);
+        EXPECT_EQ(make_handle(i), it->first);
+    }
+    EXPECT_EQ(map.end(), map.find(make_handle(100)));
+}
+
+TEST(KeyedChangesMapTests, replace_empty)
+{
+    CacheChange_t changes[3];
+    KeyedChangesMap map;
+
+    // No instances to replace
+    EXPECT_EQ(map.end(), map.replace_empty(make_handle(10)));
+
+    auto it0 = map.insert(make_handle(0));
+    auto it1 = map.insert(make_handle(1));
+    auto it2 = map.insert(make_handle(2));
+    map.push_change(it0, &changes[0]);
+    map.push_change(it1, &changes[1]);
+    map.push_change(it2, &changes[2]);
+
+    // All instances have changes
+    EXPECT_EQ(map.end(), map.replace_empty(make_handle(10)));
+
+    // Instances are replaced in the order they became empty
+    map.erase_change(it2, it2->second.cache_changes.begin());
+    map.erase_change(it0, it0->second.cache_changes.begin());
+
+    auto it = map.replace_empty(make_handle(10));
+    ASSERT_NE(map.end(), it);
+    EXPECT_EQ(make_handle(10), it->first);
+    EXPECT_EQ(map.end(), map.find(make_handle(2)));
+    EXPECT_NE(map.end(), map.find(make_handle(0)));
+
+    // An instance receiving a change is not empty anymore
+    map.push_change(map.find(make_handle(0)), &changes[0]);
+    it = map.replace_empty(make_handle(11));
+    ASSERT_NE(map.end(), it);
+    EXPECT_EQ(map.end(), map.find(make_handle(10)));
+    EXPECT_NE(map.end(), map.find(make_handle(0)));
+
+    // Erased instances are not replaced
+    map.erase(it);
+    EXPECT_EQ(map.end(), map.replace_empty(make_handle(12)));
+    EXPECT_EQ(2u, map.size());
+}
+
+TEST(KeyedChangesMapTests, erase_changes)
+{
+    CacheChange_t changes[4];
+    KeyedChangesMap map;
+
+    auto it = map.insert(make_handle(0));
+    for (auto& change : changes)
+    {
+        map.push_change(it, &change);
+    }
+
+    // Partially erasing the changes keeps the instance
+    map.erase_changes(it, it->second.cache_changes.begin(), it->second.cache_changes.begin() + 2);
+    ASSERT_EQ(2u, it->second.cache_changes.size());
+    EXPECT_EQ(&changes[2], it->second.cache_changes.front());
+    EXPECT_EQ(map.end(), map.replace_empty(make_handle(1)));
+
+    map.erase_changes(it, it->second.cache_changes.begin(), it->second.cache_changes.end());
+    EXPECT_NE(map.end(), map.replace_empty(make_handle(1)));
+    EXPECT_EQ(1u, map.size());
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
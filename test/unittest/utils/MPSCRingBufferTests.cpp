@@ -0,0 +1,175 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fastrtps/utils/MPSCRingBuffer.hpp>
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace eprosima::fastrtps;
+
+TEST(MPSCRingBufferTests, capacity_is_rounded_up)
+{
+    MPSCRingBuffer<int> queue(5);
+    EXPECT_EQ(8u, queue.capacity());
+
+    MPSCRingBuffer<int> exact(16);
+    EXPECT_EQ(16u, exact.capacity());
+}
+
+TEST(MPSCRingBufferTests, fifo_and_full)
+{
+    MPSCRingBuffer<std::string> queue(4);
+    EXPECT_TRUE(queue.empty());
+
+    // Several laps to go through the wraparound of positions
+    for (int lap = 0; lap < 3; ++lap)
+    {
+        for (int i = 0; i < 4; ++i)
+        {
+            std::string item = std::to_string(lap * 4 + i);
+            ASSERT_TRUE(queue.try_push(std::move(item)));
+        }
+
+        // Failed push should not move from the item
+        std::string extra("extra");
+        EXPECT_FALSE(queue.try_push(std::move(extra)));
+        EXPECT_EQ("extra", extra);
+        EXPECT_FALSE(queue.empty());
+
+        for (int i = 0; i < 4; ++i)
+        {
+            std::string item;
+            ASSERT_TRUE(queue.try_pop(item));
+            EXPECT_EQ(std::to_string(lap * 4 + i), item);
+        }
+
+        std::string item;
+        EXPECT_FALSE(queue.try_pop(item));
+        EXPECT_TRUE(queue.empty());
+    }
+}
+
+TEST(MPSCRingBufferTests, multiple_producers)
+{
+    constexpr int producers_number = 4;
+    constexpr int items_per_producer = 10000;
+
+    MPSCRingBuffer<int> queue(64);
+
+    std::vector<std::unique_ptr<std::thread> > producers;
+    for (int p = 0; p < producers_number; ++p)
+    {
+        producers.emplace_back(new std::thread([&queue, p]()
+                {
+                    for (int i = 0; i < items_per_producer; ++i)
+                    {
+                        int item = p * items_per_producer + i;
+                        while (!queue.try_push(std::move(item)))
+                        {
+                            std::this_thread::yield();
+                        }
+                    }
+                }));
+    }
+
+    // Items of each producer should be received in order
+    std::vector<int> next(producers_number, 0);
+    int received = 0;
+    while (received < producers_number * items_per_producer)
+    {
+        int item;
+        if (queue.try_pop(item))
+        {
+            int p = item / items_per_producer;
+            ASSERT_EQ(next[p], item % items_per_producer);
+            ++next[p];
+            ++received;
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    for (auto& producer : producers)
+    {
+        producer->join();
+    }
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(MPSCRingBufferTests, tickets)
+{
+    constexpr int producers_number = 4;
+    constexpr int items_per_producer = 10000;
+    constexpr int total = producers_number * items_per_producer;
+
+    MPSCRingBuffer<int> queue(64);
+    EXPECT_EQ(0u, queue.reserved());
+
+    // Ticket given to each item, and position at which it is popped
+    std::vector<size_t> tickets(total);
+    std::vector<size_t> positions(total);
+
+    std::vector<std::unique_ptr<std::thread> > producers;
+    for (int p = 0; p < producers_number; ++p)
+    {
+        producers.emplace_back(new std::thread([&queue, &tickets, p]()
+                {
+                    for (int i = 0; i < items_per_producer; ++i)
+                    {
+                        int item = p * items_per_producer + i;
+                        size_t ticket = 0;
+                        while (!queue.try_push(std::move(item), &ticket))
+                        {
+                            std::this_thread::yield();
+                        }
+                        tickets[p * items_per_producer + i] = ticket;
+                    }
+                }));
+    }
+
+    size_t received = 0;
+    while (received < total)
+    {
+        int item;
+        if (queue.try_pop(item))
+        {
+            positions[item] = received++;
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    for (auto& producer : producers)
+    {
+        producer->join();
+    }
+    EXPECT_EQ(tickets, positions);
+    EXPECT_EQ(static_cast<size_t>(total), queue.reserved());
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,149 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fastrtps/utils/SnapshotPtr.hpp>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace eprosima::fastrtps;
+
+TEST(SnapshotPtrTests, snapshots_are_not_modified)
+{
+    SnapshotPtr<std::vector<int> > value(std::vector<int>{1});
+
+    auto before = value.load();
+    EXPECT_TRUE(value.update([](std::vector<int>& v)
+            {
+                v.push_back(2);
+                return true;
+            }));
+    auto after = value.load();
+
+    EXPECT_EQ(std::vector<int>{1}, *before);
+    EXPECT_EQ((std::vector<int>{1, 2}), *after);
+}
+
+TEST(SnapshotPtrTests, unmodified_is_not_published)
+{
+    SnapshotPtr<std::vector<int> > value;
+
+    auto before = value.load();
+    EXPECT_FALSE(value.update([](std::vector<int>& v)
+            {
+                v.push_back(1);
+                return false;
+            }));
+    EXPECT_EQ(before, value.load());
+}
+
+TEST(SnapshotPtrTests, synchronize_waits_for_previous_snapshots)
+{
+    SnapshotPtr<int> value(0);
+    std::atomic<bool> updated(false);
+
+    auto snapshot = value.load();
+    std::thread updater([&]()
+            {
+                value.update_and_synchronize([](int& v)
+                {
+                    v = 1;
+                    return true;
+                });
+                updated = true;
+            });
+
+    // Snapshots taken after the update do not delay it
+    while (1 != *value.load())
+    {
+        std::this_thread::yield();
+    }
+    auto current = value.load();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_FALSE(updated);
+
+    snapshot.reset();
+    updater.join();
+    EXPECT_TRUE(updated);
+    EXPECT_EQ(1, *current);
+}
+
+TEST(SnapshotPtrTests, concurrent_readers)
+{
+    // Readers check that an element is never released while they can see it
+    struct Element
+    {
+        std::atomic<bool> alive{true};
+    };
+
+    SnapshotPtr<std::vector<Element*> > value;
+    std::atomic<bool> stop(false);
+    std::atomic<uint64_t> errors(0);
+
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 4; ++i)
+    {
+        readers.emplace_back([&]()
+                {
+                    while (!stop)
+                    {
+                        auto snapshot = value.load();
+                        for (Element* element : *snapshot)
+                        {
+                            if (!element->alive)
+                            {
+                                ++errors;
+                            }
+                        }
+                    }
+                });
+    }
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        std::unique_ptr<Element> element(new Element());
+        Element* ptr = element.get();
+        value.update([ptr](std::vector<Element*>& v)
+                {
+                    v.push_back(ptr);
+                    return true;
+                });
+        value.update_and_synchronize([ptr](std::vector<Element*>& v)
+                {
+                    v.erase(std::find(v.begin(), v.end(), ptr));
+                    return true;
+                });
+        element->alive = false;
+    }
+
+    stop = true;
+    for (std::thread& reader : readers)
+    {
+        reader.join();
+    }
+    EXPECT_EQ(0u, errors);
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
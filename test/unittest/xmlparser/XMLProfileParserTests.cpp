@@ -765,6 +765,8 @@ TEST_F(XMLProfileParserTests, UDP_transport_descriptors_config)
     EXPECT_EQ(descriptor->receiveBufferSize, 8192u);
     EXPECT_EQ(descriptor->TTL, 250u);
     EXPECT_EQ(descriptor->non_blocking_send, true);
+    EXPECT_EQ(descriptor->receive_batch_size, 32u);
+    EXPECT_EQ(descriptor->batched_send, true);
     EXPECT_EQ(descriptor->maxMessageSize, 16384u);
     EXPECT_EQ(descriptor->maxInitialPeersRange, 100u);
     EXPECT_EQ(descriptor->interfaceWhiteList.size(), 2u);
@@ -773,6 +775,27 @@ TEST_F(XMLProfileParserTests, UDP_transport_descriptors_config)
     EXPECT_EQ(descriptor->m_output_udp_socket, 5101u);
 }
 
+TEST_F(XMLProfileParserTests, TCP_transport_descriptors_config)
+{
+    ASSERT_EQ(xmlparser::XMLP_ret::XML_OK,
+            xmlparser::XMLProfileManager::loadXMLFile("TCP_transport_descriptors_config.xml"));
+
+    xmlparser::sp_transport_t transport = xmlparser::XMLProfileManager::getTransportById("Test");
+
+    using TCPDescriptor = std::shared_ptr<TCPTransportDescriptor>;
+    TCPDescriptor descriptor = std::dynamic_pointer_cast<TCPTransportDescriptor>(transport);
+
+    ASSERT_NE(descriptor, nullptr);
+    EXPECT_EQ(descriptor->sendBufferSize, 8192u);
+    EXPECT_EQ(descriptor->receiveBufferSize, 8192u);
+    EXPECT_EQ(descriptor->non_blocking_send, true);
+    EXPECT_EQ(descriptor->enable_tcp_nodelay, true);
+    EXPECT_EQ(descriptor->use_crc32c, false);
+    EXPECT_EQ(descriptor->reactor_threads, 4u);
+    EXPECT_EQ(descriptor->keep_alive_frequency_ms, 1000u);
+    EXPECT_EQ(descriptor->keep_alive_timeout_ms, 3000u);
+}
+
 TEST_F(XMLProfileParserTests, SHM_transport_descriptors_config)
 {
     ASSERT_EQ(xmlparser::XMLP_ret::XML_OK,
@@ -789,6 +812,7 @@ TEST_F(XMLProfileParserTests, SHM_transport_descriptors_config)
     ASSERT_EQ(descriptor->port_queue_capacity(), std::numeric_limits<uint32_t>::max());
     ASSERT_EQ(descriptor->healthy_check_timeout_ms(), std::numeric_limits<uint32_t>::max());
     ASSERT_EQ(descriptor->rtps_dump_file(), "test_file.dump");
+    ASSERT_TRUE(descriptor->keep_received_buffers());
     ASSERT_EQ(descriptor->maxMessageSize, 128000u);
     ASSERT_EQ(descriptor->max_message_size(), 128000u);
 }